@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// File: Benchmark.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Benchmark.h"
+#include "Object.h"
+
+CFlythroughBenchmark::CFlythroughBenchmark(UINT nFrames, bool bWarpDevice)
+{
+	m_nFrames = (nFrames > 0) ? nFrames : BENCHMARK_DEFAULT_FRAMES;
+	m_bWarpDevice = bWarpDevice;
+	m_vFrames.reserve(m_nFrames);
+	::ZeroMemory(&m_xFrame, sizeof(BENCHMARK_FRAME));
+}
+
+CFlythroughBenchmark::~CFlythroughBenchmark()
+{
+}
+
+void CFlythroughBenchmark::BuildPath(CHeightMapTerrain *pTerrain)
+{
+	m_pTerrain = pTerrain;
+	m_vControlPoints.clear();
+	if (!pTerrain) return;
+
+	//    Ÿ    ٲٸ         Ѵ.
+	float fWidth = pTerrain->GetWidth(), fLength = pTerrain->GetLength();
+	for (int i = 0; i < BENCHMARK_PATH_POINTS; i++)
+	{
+		float fAngle = XM_2PI * i / BENCHMARK_PATH_POINTS;
+		float fRadius = (i & 1) ? 0.22f : 0.38f;
+		float x = fWidth * (0.5f + fRadius * cosf(fAngle));
+		float z = fLength * (0.5f + fRadius * sinf(fAngle));
+		m_vControlPoints.push_back(XMFLOAT3(x, pTerrain->GetHeight(x, z) + BENCHMARK_ALTITUDE, z));
+	}
+}
+
+XMFLOAT3 CFlythroughBenchmark::GetPathPosition(float t)
+{
+	int nPoints = int(m_vControlPoints.size());
+	if (nPoints == 0) return(XMFLOAT3(0.0f, BENCHMARK_ALTITUDE, 0.0f));
+
+	//  ̹Ƿ [0, 1) Ƽ    ġ Ѵ.
+	t -= floorf(t);
+	float fSegment = t * nPoints;
+	int nSegment = int(fSegment);
+	float s = fSegment - nSegment;
+
+	XMVECTOR xmvPosition = XMVectorCatmullRom(
+		XMLoadFloat3(&m_vControlPoints[(nSegment + nPoints - 1) % nPoints]),
+		XMLoadFloat3(&m_vControlPoints[nSegment % nPoints]),
+		XMLoadFloat3(&m_vControlPoints[(nSegment + 1) % nPoints]),
+		XMLoadFloat3(&m_vControlPoints[(nSegment + 2) % nPoints]), s);
+	XMFLOAT3 xmf3Position;
+	XMStoreFloat3(&xmf3Position, xmvPosition);
+
+	//  ̿      ø.
+	if (m_pTerrain)
+	{
+		float fWidth = m_pTerrain->GetWidth(), fLength = m_pTerrain->GetLength();
+		float x = max(0.0f, min(xmf3Position.x, fWidth - 1.0f)), z = max(0.0f, min(xmf3Position.z, fLength - 1.0f));
+		xmf3Position.y = max(xmf3Position.y, m_pTerrain->GetHeight(x, z) + BENCHMARK_MIN_CLEARANCE);
+	}
+	return(xmf3Position);
+}
+
+void CFlythroughBenchmark::BeginFrame(CCamera *pCamera)
+{
+	auto tNow = std::chrono::high_resolution_clock::now();
+	if (m_bFrameStarted)
+	{
+		m_xFrame.m_fFrameTime = std::chrono::duration<float, std::milli>(tNow - m_tFrameStart).count();
+		if (m_nFrame > BENCHMARK_WARMUP_FRAMES) m_vFrames.push_back(m_xFrame);
+	}
+	::ZeroMemory(&m_xFrame, sizeof(BENCHMARK_FRAME));
+	m_bFrameStarted = true;
+	m_tFrameStart = m_tPhaseStart = tNow;
+
+	// ־  ü   θ   .
+	float t = float(m_nFrame++) / float(m_nFrames + BENCHMARK_WARMUP_FRAMES);
+	XMFLOAT3 xmf3Position = GetPathPosition(t);
+	XMFLOAT3 xmf3LookAt = GetPathPosition(t + BENCHMARK_LOOK_AHEAD);
+	xmf3LookAt.y -= BENCHMARK_ALTITUDE * 0.5f;
+
+	XMFLOAT3 xmf3WorldUp = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	XMFLOAT3 xmf3Look = Vector3::Subtract(xmf3LookAt, xmf3Position);
+	xmf3Look = Vector3::Normalize(xmf3Look);
+	pCamera->SetPosition(xmf3Position);
+	pCamera->GetRightVector() = Vector3::CrossProduct(xmf3WorldUp, xmf3Look, true);
+	pCamera->GetUpVector() = Vector3::CrossProduct(xmf3Look, pCamera->GetRightVector(), true);
+	pCamera->SetLookVector(xmf3Look);
+	pCamera->RegenerateViewMatrix();
+
+	MarkPhase(BENCHMARK_PHASE_UPDATE);
+}
+
+void CFlythroughBenchmark::MarkPhase(int nPhase)
+{
+	auto tNow = std::chrono::high_resolution_clock::now();
+	m_xFrame.m_pfPhaseTimes[nPhase] += std::chrono::duration<float, std::milli>(tNow - m_tPhaseStart).count();
+	m_tPhaseStart = tNow;
+}
+
+void CFlythroughBenchmark::EndFrame(UINT nDraws, UINT nTriangles, UINT nPoints, UINT nVisibleEntities)
+{
+	m_xFrame.m_nDraws = nDraws;
+	m_xFrame.m_nTriangles = nTriangles;
+	m_xFrame.m_nPoints = nPoints;
+	m_xFrame.m_nVisibleEntities = nVisibleEntities;
+}
+
+inline float GetPercentile(const vector<float>& vSorted, float fPercentile)
+{
+	if (vSorted.empty()) return(0.0f);
+	size_t nIndex = size_t(fPercentile * (vSorted.size() - 1) + 0.5f);
+	return(vSorted[min(nIndex, vSorted.size() - 1)]);
+}
+
+bool CFlythroughBenchmark::WriteReport(LPCTSTR pszFileName, int nWidth, int nHeight)
+{
+	static const TCHAR *ppszPhases[BENCHMARK_PHASES] = { _T("update"), _T("gpuWait"), _T("offscreenRecord"), _T("mainRecord"), _T("present") };
+
+	UINT nFrames = UINT(m_vFrames.size());
+	vector<float> vFrameTimes(nFrames);
+	double fTotalTime = 0.0, pfPhaseTimes[BENCHMARK_PHASES] = { 0.0 };
+	float pfMaxPhaseTimes[BENCHMARK_PHASES] = { 0.0f };
+	UINT64 nTotalDraws = 0, nTotalTriangles = 0, nTotalPoints = 0, nTotalVisibleEntities = 0;
+	UINT nMaxDraws = 0, nMaxTriangles = 0;
+	for (UINT i = 0; i < nFrames; i++)
+	{
+		const BENCHMARK_FRAME& xFrame = m_vFrames[i];
+		vFrameTimes[i] = xFrame.m_fFrameTime;
+		fTotalTime += xFrame.m_fFrameTime;
+		for (int j = 0; j < BENCHMARK_PHASES; j++)
+		{
+			pfPhaseTimes[j] += xFrame.m_pfPhaseTimes[j];
+			pfMaxPhaseTimes[j] = max(pfMaxPhaseTimes[j], xFrame.m_pfPhaseTimes[j]);
+		}
+		nTotalDraws += xFrame.m_nDraws;
+		nTotalTriangles += xFrame.m_nTriangles;
+		nTotalPoints += xFrame.m_nPoints;
+		nTotalVisibleEntities += xFrame.m_nVisibleEntities;
+		nMaxDraws = max(nMaxDraws, xFrame.m_nDraws);
+		nMaxTriangles = max(nMaxTriangles, xFrame.m_nTriangles);
+	}
+	std::sort(vFrameTimes.begin(), vFrameTimes.end());
+	double fFrames = (nFrames) ? double(nFrames) : 1.0;
+	float fAverage = float(fTotalTime / fFrames);
+
+	TCHAR pstrDebug[256];
+	_stprintf_s(pstrDebug, 256, _T("Benchmark: %u frames, avg %.3f ms (%.1f fps), p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms, %.0f draws, %.0f triangles\n"),
+		nFrames, fAverage, (fAverage > 0.0f) ? 1000.0f / fAverage : 0.0f, GetPercentile(vFrameTimes, 0.50f), GetPercentile(vFrameTimes, 0.95f), GetPercentile(vFrameTimes, 0.99f),
+		(nFrames) ? vFrameTimes.back() : 0.0f, nTotalDraws / fFrames, nTotalTriangles / fFrames);
+	::OutputDebugString(pstrDebug);
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (!pFile) return(false);
+
+	_ftprintf(pFile, _T("{\n"));
+	_ftprintf(pFile, _T("  \"benchmark\": \"flythrough\",\n"));
+	_ftprintf(pFile, _T("  \"device\": \"%s\",\n"), (m_bWarpDevice) ? _T("warp") : _T("hardware"));
+	_ftprintf(pFile, _T("  \"resolution\": [%d, %d],\n"), nWidth, nHeight);
+	_ftprintf(pFile, _T("  \"warmupFrames\": %u,\n"), BENCHMARK_WARMUP_FRAMES);
+	_ftprintf(pFile, _T("  \"frames\": %u,\n"), nFrames);
+	_ftprintf(pFile, _T("  \"totalTimeMs\": %.3f,\n"), fTotalTime);
+	_ftprintf(pFile, _T("  \"frameTimeMs\": { \"min\": %.4f, \"avg\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n"),
+		(nFrames) ? vFrameTimes.front() : 0.0f, fAverage, GetPercentile(vFrameTimes, 0.50f), GetPercentile(vFrameTimes, 0.95f), GetPercentile(vFrameTimes, 0.99f), (nFrames) ? vFrameTimes.back() : 0.0f);
+	_ftprintf(pFile, _T("  \"cpuPhasesMs\": {\n"));
+	for (int j = 0; j < BENCHMARK_PHASES; j++)
+	{
+		_ftprintf(pFile, _T("    \"%s\": { \"avg\": %.4f, \"max\": %.4f }%s\n"), ppszPhases[j], pfPhaseTimes[j] / fFrames, pfMaxPhaseTimes[j], (j < BENCHMARK_PHASES - 1) ? _T(",") : _T(""));
+	}
+	_ftprintf(pFile, _T("  },\n"));
+	_ftprintf(pFile, _T("  \"drawsPerFrame\": { \"avg\": %.1f, \"max\": %u },\n"), nTotalDraws / fFrames, nMaxDraws);
+	_ftprintf(pFile, _T("  \"trianglesPerFrame\": { \"avg\": %.1f, \"max\": %u },\n"), nTotalTriangles / fFrames, nMaxTriangles);
+	_ftprintf(pFile, _T("  \"pointsPerFrame\": { \"avg\": %.1f },\n"), nTotalPoints / fFrames);
+	_ftprintf(pFile, _T("  \"visibleEntitiesPerFrame\": { \"avg\": %.1f }\n"), nTotalVisibleEntities / fFrames);
+	_ftprintf(pFile, _T("}\n"));
+	fclose(pFile);
+
+	return(true);
+}
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// File: Benchmark.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define BENCHMARK_DEFAULT_FRAMES		1000
+#define BENCHMARK_WARMUP_FRAMES			60			// ʰ  ó   ( , ĳ )
+#define BENCHMARK_REPORT_NAME			_T("BenchmarkReport.json")
+
+#define BENCHMARK_PATH_POINTS			12			//   ö  
+#define BENCHMARK_ALTITUDE				60.0f		//    
+#define BENCHMARK_MIN_CLEARANCE			15.0f		//ī޶   ׻  ִ 
+#define BENCHMARK_LOOK_AHEAD			0.01f		//θ  ̸ŭ ( ̿  ) ٶ󺻴
+
+#define BENCHMARK_PHASE_UPDATE			0			//ī޶ ̵ (ùķ̼ )
+#define BENCHMARK_PHASE_GPU_WAIT		1			//FRAMES_IN_FLIGHT   GPU ۾ ,   ( ȿ GPU ٸ  )
+#define BENCHMARK_PHASE_OFFSCREEN		2			//ũ н 
+#define BENCHMARK_PHASE_MAIN			3			// н 
+#define BENCHMARK_PHASE_PRESENT			4			//Present(), 潺 ȣ
+#define BENCHMARK_PHASES				5
+
+class CCamera;
+class CHeightMapTerrain;
+
+struct BENCHMARK_FRAME
+{
+	float							m_fFrameTime;							//  ۺ   ۱ (ms)
+	float							m_pfPhaseTimes[BENCHMARK_PHASES];		//ms
+	UINT							m_nDraws;
+	UINT							m_nTriangles;
+	UINT							m_nPoints;								// ̴  ø 
+	UINT							m_nVisibleEntities;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//    Catmull-Rom ö  ī޶ ű   ŭ ׸  ð, ܰ躰 CPU ð,
+// ο ȣ ﰢ  JSON  . ī޶ ġ  ȣθ ϹǷ  ӵ  Ź  ȭ ´.
+class CFlythroughBenchmark
+{
+public:
+	CFlythroughBenchmark(UINT nFrames, bool bWarpDevice);
+	~CFlythroughBenchmark();
+
+private:
+	UINT							m_nFrames = BENCHMARK_DEFAULT_FRAMES;
+	UINT							m_nFrame = 0;							//־    ȣ
+	bool							m_bWarpDevice = false;
+
+	CHeightMapTerrain				*m_pTerrain = NULL;
+	vector<XMFLOAT3>				m_vControlPoints;
+
+	vector<BENCHMARK_FRAME>			m_vFrames;
+	BENCHMARK_FRAME					m_xFrame;
+	bool							m_bFrameStarted = false;
+	std::chrono::high_resolution_clock::time_point m_tFrameStart;
+	std::chrono::high_resolution_clock::time_point m_tPhaseStart;
+
+	XMFLOAT3 GetPathPosition(float t);
+
+public:
+	//  ũ ̷ θ .
+	void BuildPath(CHeightMapTerrain *pTerrain);
+
+	//  ۿ ҷ   ϰ   ġ ī޶ ű.
+	void BeginFrame(CCamera *pCamera);
+	//  ǥ   ð nPhase Ѵ.
+	void MarkPhase(int nPhase);
+	//   ̹  ο 踦 .
+	void EndFrame(UINT nDraws, UINT nTriangles, UINT nPoints, UINT nVisibleEntities);
+
+	bool IsFinished() { return(m_vFrames.size() >= m_nFrames); }
+	UINT GetRecordedFrames() { return(UINT(m_vFrames.size())); }
+	UINT GetFrames() { return(m_nFrames); }
+
+	// ּ///ִ  ð ܰ躰  ð, ο 踦 JSON    ¿ .
+	bool WriteReport(LPCTSTR pszFileName, int nWidth, int nHeight);
+};
@@ -0,0 +1,798 @@
+//-----------------------------------------------------------------------------
+// File: BoundingVolumeHierarchy.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "BoundingVolumeHierarchy.h"
+
+static_assert(BVH_SAH_MAX_DEPTH + 16 < BVH_MAX_DEPTH, "Build() must stay within BVH_MAX_DEPTH for up to 2^32 proxies");
+
+inline float SurfaceArea(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max)
+{
+	float dx = xmf3Max.x - xmf3Min.x, dy = xmf3Max.y - xmf3Min.y, dz = xmf3Max.z - xmf3Min.z;
+	if ((dx < 0.0f) || (dy < 0.0f) || (dz < 0.0f)) return(0.0f);
+	return(2.0f * ((dx * dy) + (dy * dz) + (dz * dx)));
+}
+
+inline void GrowBounds(XMFLOAT3& xmf3Min, XMFLOAT3& xmf3Max, const XMFLOAT3& xmf3OtherMin, const XMFLOAT3& xmf3OtherMax)
+{
+	xmf3Min.x = min(xmf3Min.x, xmf3OtherMin.x); xmf3Min.y = min(xmf3Min.y, xmf3OtherMin.y); xmf3Min.z = min(xmf3Min.z, xmf3OtherMin.z);
+	xmf3Max.x = max(xmf3Max.x, xmf3OtherMax.x); xmf3Max.y = max(xmf3Max.y, xmf3OtherMax.y); xmf3Max.z = max(xmf3Max.z, xmf3OtherMax.z);
+}
+
+inline void EmptyBounds(XMFLOAT3& xmf3Min, XMFLOAT3& xmf3Max)
+{
+	xmf3Min = XMFLOAT3(+FLT_MAX, +FLT_MAX, +FLT_MAX);
+	xmf3Max = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+CBoundingVolumeHierarchy::CBoundingVolumeHierarchy()
+{
+}
+
+CBoundingVolumeHierarchy::~CBoundingVolumeHierarchy()
+{
+}
+
+UINT CBoundingVolumeHierarchy::AllocateNode(UINT nParent)
+{
+	BVH_NODE xNode;
+	for (int i = 0; i < BVH_WIDTH; i++)
+	{
+		xNode.m_pfMinX[i] = xNode.m_pfMinY[i] = xNode.m_pfMinZ[i] = +FLT_MAX;
+		xNode.m_pfMaxX[i] = xNode.m_pfMaxY[i] = xNode.m_pfMaxZ[i] = -FLT_MAX;
+		xNode.m_pnChildren[i] = BVH_NULL;
+	}
+	xNode.m_nParent = nParent;
+	m_vNodes.push_back(xNode);
+	return(UINT(m_vNodes.size() - 1));
+}
+
+void CBoundingVolumeHierarchy::SetSlot(UINT nNode, int nSlot, UINT nChild, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max)
+{
+	BVH_NODE *pNode = &m_vNodes[nNode];
+	pNode->m_pnChildren[nSlot] = nChild;
+	pNode->m_pfMinX[nSlot] = xmf3Min.x; pNode->m_pfMinY[nSlot] = xmf3Min.y; pNode->m_pfMinZ[nSlot] = xmf3Min.z;
+	pNode->m_pfMaxX[nSlot] = xmf3Max.x; pNode->m_pfMaxY[nSlot] = xmf3Max.y; pNode->m_pfMaxZ[nSlot] = xmf3Max.z;
+
+	if (nChild == BVH_NULL) return;
+	if (nChild & BVH_LEAF)
+		m_vProxies[nChild & ~BVH_LEAF].m_nLocation = (nNode << 2) | nSlot;
+	else
+		m_vNodes[nChild].m_nParent = (nNode << 2) | nSlot;
+}
+
+void CBoundingVolumeHierarchy::ClearSlot(UINT nNode, int nSlot)
+{
+	XMFLOAT3 xmf3Min, xmf3Max;
+	EmptyBounds(xmf3Min, xmf3Max);
+	SetSlot(nNode, nSlot, BVH_NULL, xmf3Min, xmf3Max);
+}
+
+void CBoundingVolumeHierarchy::GetNodeBounds(UINT nNode, XMFLOAT3& xmf3Min, XMFLOAT3& xmf3Max) const
+{
+	const BVH_NODE *pNode = &m_vNodes[nNode];
+	EmptyBounds(xmf3Min, xmf3Max);
+	for (int i = 0; i < BVH_WIDTH; i++)
+	{
+		if (pNode->m_pnChildren[i] == BVH_NULL) continue;
+		GrowBounds(xmf3Min, xmf3Max, XMFLOAT3(pNode->m_pfMinX[i], pNode->m_pfMinY[i], pNode->m_pfMinZ[i]), XMFLOAT3(pNode->m_pfMaxX[i], pNode->m_pfMaxY[i], pNode->m_pfMaxZ[i]));
+	}
+}
+
+UINT CBoundingVolumeHierarchy::Insert(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max, UINT nUserData)
+{
+	UINT nProxy;
+	if (!m_vFreeProxies.empty())
+	{
+		nProxy = m_vFreeProxies.back();
+		m_vFreeProxies.pop_back();
+	}
+	else
+	{
+		nProxy = UINT(m_vProxies.size());
+		m_vProxies.push_back(BVH_PROXY());
+	}
+	BVH_PROXY *pProxy = &m_vProxies[nProxy];
+	pProxy->m_xmf3Min = xmf3Min;
+	pProxy->m_xmf3Max = xmf3Max;
+	pProxy->m_nUserData = nUserData;
+	pProxy->m_nLocation = BVH_NULL;
+
+	if (m_nRoot == BVH_NULL)
+	{
+		m_nRoot = AllocateNode(BVH_NULL);
+		SetSlot(m_nRoot, 0, BVH_LEAF | nProxy, xmf3Min, xmf3Max);
+		m_nDepth = 1;
+		return(nProxy);
+	}
+
+	//   ִ 带   ̰   þ ڽ . 鼭   ڸ Ű.
+	UINT nNode = m_nRoot, nDepth = 1;
+	while (true)
+	{
+		BVH_NODE *pNode = &m_vNodes[nNode];
+
+		int nEmptySlot = -1;
+		for (int i = 0; i < BVH_WIDTH; i++) if (pNode->m_pnChildren[i] == BVH_NULL) { nEmptySlot = i; break; }
+		if (nEmptySlot >= 0)
+		{
+			SetSlot(nNode, nEmptySlot, BVH_LEAF | nProxy, xmf3Min, xmf3Max);
+			break;
+		}
+
+		int nBestSlot = 0;
+		float fBestCost = FLT_MAX, fBestArea = FLT_MAX;
+		for (int i = 0; i < BVH_WIDTH; i++)
+		{
+			XMFLOAT3 xmf3SlotMin(pNode->m_pfMinX[i], pNode->m_pfMinY[i], pNode->m_pfMinZ[i]), xmf3SlotMax(pNode->m_pfMaxX[i], pNode->m_pfMaxY[i], pNode->m_pfMaxZ[i]);
+			float fArea = SurfaceArea(xmf3SlotMin, xmf3SlotMax);
+			GrowBounds(xmf3SlotMin, xmf3SlotMax, xmf3Min, xmf3Max);
+			float fCost = SurfaceArea(xmf3SlotMin, xmf3SlotMax) - fArea;
+			if ((fCost < fBestCost) || ((fCost == fBestCost) && (fArea < fBestArea)))
+			{
+				nBestSlot = i;
+				fBestCost = fCost;
+				fBestArea = fArea;
+			}
+		}
+
+		XMFLOAT3 xmf3SlotMin(pNode->m_pfMinX[nBestSlot], pNode->m_pfMinY[nBestSlot], pNode->m_pfMinZ[nBestSlot]), xmf3SlotMax(pNode->m_pfMaxX[nBestSlot], pNode->m_pfMaxY[nBestSlot], pNode->m_pfMaxZ[nBestSlot]);
+		GrowBounds(xmf3SlotMin, xmf3SlotMax, xmf3Min, xmf3Max);
+
+		UINT nChild = pNode->m_pnChildren[nBestSlot];
+		nDepth++;
+		if (nChild & BVH_LEAF)
+		{
+			// ̸  Ͻÿ  Ͻø   ٲ۴.
+			UINT nNewNode = AllocateNode((nNode << 2) | nBestSlot);
+			BVH_PROXY *pOldProxy = &m_vProxies[nChild & ~BVH_LEAF];
+			SetSlot(nNewNode, 0, nChild, pOldProxy->m_xmf3Min, pOldProxy->m_xmf3Max);
+			SetSlot(nNewNode, 1, BVH_LEAF | nProxy, xmf3Min, xmf3Max);
+			SetSlot(nNode, nBestSlot, nNewNode, xmf3SlotMin, xmf3SlotMax);
+			break;
+		}
+		SetSlot(nNode, nBestSlot, nChild, xmf3SlotMin, xmf3SlotMax);
+		nNode = nChild;
+	}
+	if (nDepth > m_nDepth) m_nDepth = nDepth;
+
+	//  ġģ  ̸ ȸ (BVH_STACK_SIZE)   Ƿ ٽ .
+	if (m_nDepth > BVH_MAX_DEPTH) Build();
+
+	return(nProxy);
+}
+
+bool CBoundingVolumeHierarchy::Remove(UINT nProxy)
+{
+	//  ִ Ͻô ׻ Ʈ ִ. (Insert() Build() ڸ Ѵ)
+	if ((nProxy >= UINT(m_vProxies.size())) || (m_vProxies[nProxy].m_nLocation == BVH_NULL)) return(false);
+
+	BVH_PROXY *pProxy = &m_vProxies[nProxy];
+	//   ڴ ״ ξ ̴. (Refit() پ)
+	ClearSlot(pProxy->m_nLocation >> 2, pProxy->m_nLocation & 3);
+	m_bRefitNeeded = true;
+	pProxy->m_nLocation = BVH_NULL;
+	m_vFreeProxies.push_back(nProxy);
+	return(true);
+}
+
+void CBoundingVolumeHierarchy::UpdateProxy(UINT nProxy, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max)
+{
+	BVH_PROXY *pProxy = &m_vProxies[nProxy];
+	pProxy->m_xmf3Min = xmf3Min;
+	pProxy->m_xmf3Max = xmf3Max;
+	if (pProxy->m_nLocation != BVH_NULL)
+	{
+		SetSlot(pProxy->m_nLocation >> 2, pProxy->m_nLocation & 3, BVH_LEAF | nProxy, xmf3Min, xmf3Max);
+		m_bRefitNeeded = true;
+	}
+}
+
+void CBoundingVolumeHierarchy::Refit()
+{
+	XMFLOAT3 xmf3Min, xmf3Max;
+	for (int i = int(m_vNodes.size()) - 1; i >= 0; i--)
+	{
+		for (int j = 0; j < BVH_WIDTH; j++)
+		{
+			UINT nChild = m_vNodes[i].m_pnChildren[j];
+			if (nChild == BVH_NULL) continue;
+			if (nChild & BVH_LEAF)
+			{
+				BVH_PROXY *pProxy = &m_vProxies[nChild & ~BVH_LEAF];
+				SetSlot(i, j, nChild, pProxy->m_xmf3Min, pProxy->m_xmf3Max);
+			}
+			else
+			{
+				GetNodeBounds(nChild, xmf3Min, xmf3Max);
+				SetSlot(i, j, nChild, xmf3Min, xmf3Max);
+			}
+		}
+	}
+	m_bRefitNeeded = false;
+}
+
+void CBoundingVolumeHierarchy::Clear()
+{
+	m_vProxies.clear();
+	m_vFreeProxies.clear();
+	m_vNodes.clear();
+	m_nRoot = BVH_NULL;
+	m_nDepth = 0;
+	m_bRefitNeeded = false;
+}
+
+UINT CBoundingVolumeHierarchy::SplitRange(UINT nBegin, UINT nEnd, UINT nDepth)
+{
+	//  SAH  ġģ   ̰  ʵ   .
+	if (nDepth >= BVH_SAH_MAX_DEPTH) return((nBegin + nEnd) / 2);
+
+	UINT *pnProxies = m_vBuildProxies.data();
+	XMFLOAT3 *pxmf3Centroids = m_vBuildCentroids.data();
+
+	XMFLOAT3 xmf3CentroidMin, xmf3CentroidMax;
+	EmptyBounds(xmf3CentroidMin, xmf3CentroidMax);
+	for (UINT i = nBegin; i < nEnd; i++) GrowBounds(xmf3CentroidMin, xmf3CentroidMax, pxmf3Centroids[pnProxies[i]], pxmf3Centroids[pnProxies[i]]);
+
+	// ߽  а   ϳ .
+	float pfExtents[3] = { xmf3CentroidMax.x - xmf3CentroidMin.x, xmf3CentroidMax.y - xmf3CentroidMin.y, xmf3CentroidMax.z - xmf3CentroidMin.z };
+	int nAxis = (pfExtents[0] > pfExtents[1]) ? ((pfExtents[0] > pfExtents[2]) ? 0 : 2) : ((pfExtents[1] > pfExtents[2]) ? 1 : 2);
+	float fAxisMin = (&xmf3CentroidMin.x)[nAxis];
+	UINT nMiddle = (nBegin + nEnd) / 2;
+	if (pfExtents[nAxis] <= FLT_EPSILON) return(nMiddle);
+
+	float fBinScale = float(BVH_BINS) * 0.9999f / pfExtents[nAxis];
+
+	UINT pnBinCounts[BVH_BINS];
+	XMFLOAT3 pxmf3BinMins[BVH_BINS], pxmf3BinMaxs[BVH_BINS];
+	for (int i = 0; i < BVH_BINS; i++)
+	{
+		pnBinCounts[i] = 0;
+		EmptyBounds(pxmf3BinMins[i], pxmf3BinMaxs[i]);
+	}
+	for (UINT i = nBegin; i < nEnd; i++)
+	{
+		BVH_PROXY *pProxy = &m_vProxies[pnProxies[i]];
+		int nBin = int(((&pxmf3Centroids[pnProxies[i]].x)[nAxis] - fAxisMin) * fBinScale);
+		pnBinCounts[nBin]++;
+		GrowBounds(pxmf3BinMins[nBin], pxmf3BinMaxs[nBin], pProxy->m_xmf3Min, pProxy->m_xmf3Max);
+	}
+
+	// ʺ  ̸  ΰ ʺ  ( x )   踦 ã´.
+	float pfRightAreas[BVH_BINS];
+	UINT pnRightCounts[BVH_BINS];
+	XMFLOAT3 xmf3Min, xmf3Max;
+	EmptyBounds(xmf3Min, xmf3Max);
+	UINT nCount = 0;
+	for (int i = BVH_BINS - 1; i > 0; i--)
+	{
+		GrowBounds(xmf3Min, xmf3Max, pxmf3BinMins[i], pxmf3BinMaxs[i]);
+		nCount += pnBinCounts[i];
+		pfRightAreas[i] = SurfaceArea(xmf3Min, xmf3Max);
+		pnRightCounts[i] = nCount;
+	}
+
+	int nBestSplit = -1;
+	float fBestCost = FLT_MAX;
+	EmptyBounds(xmf3Min, xmf3Max);
+	nCount = 0;
+	for (int i = 0; i < BVH_BINS - 1; i++)
+	{
+		GrowBounds(xmf3Min, xmf3Max, pxmf3BinMins[i], pxmf3BinMaxs[i]);
+		nCount += pnBinCounts[i];
+		if ((nCount == 0) || (pnRightCounts[i + 1] == 0)) continue;
+		float fCost = (SurfaceArea(xmf3Min, xmf3Max) * nCount) + (pfRightAreas[i + 1] * pnRightCounts[i + 1]);
+		if (fCost < fBestCost)
+		{
+			fBestCost = fCost;
+			nBestSplit = i;
+		}
+	}
+	if (nBestSplit < 0) return(nMiddle);
+
+	UINT *pnSplit = std::partition(pnProxies + nBegin, pnProxies + nEnd, [&](UINT nProxy)
+	{
+		return(int(((&pxmf3Centroids[nProxy].x)[nAxis] - fAxisMin) * fBinScale) <= nBestSplit);
+	});
+	UINT nSplit = UINT(pnSplit - pnProxies);
+	return(((nSplit == nBegin) || (nSplit == nEnd)) ? nMiddle : nSplit);
+}
+
+struct BVH_BUILD_TASK
+{
+	UINT							m_nBegin;
+	UINT							m_nEnd;
+	UINT							m_nParent;
+	UINT							m_nDepth;
+};
+
+void CBoundingVolumeHierarchy::Build()
+{
+	m_vNodes.clear();
+	m_nRoot = BVH_NULL;
+	m_nDepth = 0;
+
+	m_vBuildProxies.clear();
+	m_vBuildCentroids.resize(m_vProxies.size());
+	for (UINT i = 0; i < UINT(m_vProxies.size()); i++)
+	{
+		BVH_PROXY *pProxy = &m_vProxies[i];
+		pProxy->m_nLocation = BVH_NULL;
+		m_vBuildCentroids[i] = XMFLOAT3((pProxy->m_xmf3Min.x + pProxy->m_xmf3Max.x) * 0.5f, (pProxy->m_xmf3Min.y + pProxy->m_xmf3Max.y) * 0.5f, (pProxy->m_xmf3Min.z + pProxy->m_xmf3Max.z) * 0.5f);
+	}
+	//  Ͻô m_nLocation BVH_NULL ä ´.
+	vector<bool> vbFree(m_vProxies.size(), false);
+	for (size_t i = 0; i < m_vFreeProxies.size(); i++) vbFree[m_vFreeProxies[i]] = true;
+	for (UINT i = 0; i < UINT(m_vProxies.size()); i++) if (!vbFree[i]) m_vBuildProxies.push_back(i);
+	if (m_vBuildProxies.empty()) return;
+
+	m_vNodes.reserve((m_vBuildProxies.size() / (BVH_WIDTH - 1)) + 1);
+
+	//  ϳ ڽ 4    ū  ѷ ,   ̻   ڽ  .
+	vector<BVH_BUILD_TASK> vTasks;
+	vTasks.push_back({ 0, UINT(m_vBuildProxies.size()), BVH_NULL, 1 });
+	while (!vTasks.empty())
+	{
+		BVH_BUILD_TASK xTask = vTasks.back();
+		vTasks.pop_back();
+
+		UINT nNode = AllocateNode(xTask.m_nParent);
+		if (xTask.m_nParent == BVH_NULL)
+			m_nRoot = nNode;
+		else
+			m_vNodes[xTask.m_nParent >> 2].m_pnChildren[xTask.m_nParent & 3] = nNode;
+		if (xTask.m_nDepth > m_nDepth) m_nDepth = xTask.m_nDepth;
+
+		UINT pnBegins[BVH_WIDTH] = { xTask.m_nBegin }, pnEnds[BVH_WIDTH] = { xTask.m_nEnd };
+		int nRanges = 1;
+		while (nRanges < BVH_WIDTH)
+		{
+			int nLargest = -1;
+			UINT nLargestCount = 1;
+			for (int i = 0; i < nRanges; i++)
+			{
+				if (pnEnds[i] - pnBegins[i] > nLargestCount)
+				{
+					nLargest = i;
+					nLargestCount = pnEnds[i] - pnBegins[i];
+				}
+			}
+			if (nLargest < 0) break;
+
+			UINT nSplit = SplitRange(pnBegins[nLargest], pnEnds[nLargest], xTask.m_nDepth);
+			pnBegins[nRanges] = nSplit;
+			pnEnds[nRanges] = pnEnds[nLargest];
+			pnEnds[nLargest] = nSplit;
+			nRanges++;
+		}
+
+		for (int i = 0; i < nRanges; i++)
+		{
+			if (pnEnds[i] - pnBegins[i] == 1)
+			{
+				UINT nProxy = m_vBuildProxies[pnBegins[i]];
+				SetSlot(nNode, i, BVH_LEAF | nProxy, m_vProxies[nProxy].m_xmf3Min, m_vProxies[nProxy].m_xmf3Max);
+			}
+			else
+			{
+				vTasks.push_back({ pnBegins[i], pnEnds[i], (nNode << 2) | i, xTask.m_nDepth + 1 });
+			}
+		}
+	}
+
+	Refit();
+}
+
+void CBoundingVolumeHierarchy::AddSubtree(UINT nNode, vector<UINT>& vResults) const
+{
+	UINT pnStack[BVH_STACK_SIZE];
+	int nStack = 0;
+	pnStack[nStack++] = nNode;
+	while (nStack > 0)
+	{
+		const BVH_NODE *pNode = &m_vNodes[pnStack[--nStack]];
+		for (int i = 0; i < BVH_WIDTH; i++)
+		{
+			UINT nChild = pNode->m_pnChildren[i];
+			if (nChild == BVH_NULL) continue;
+			if (nChild & BVH_LEAF)
+				vResults.push_back(m_vProxies[nChild & ~BVH_LEAF].m_nUserData);
+			else
+				pnStack[nStack++] = nChild;
+		}
+	}
+}
+
+UINT CBoundingVolumeHierarchy::Cull(const XMFLOAT4 *pxmf4Planes, vector<UINT>& vResults) const
+{
+	if (m_nRoot == BVH_NULL) return(0);
+	size_t nResults = vResults.size();
+
+	__m128 pm128PlaneA[FRUSTUM_PLANES], pm128PlaneB[FRUSTUM_PLANES], pm128PlaneC[FRUSTUM_PLANES], pm128PlaneD[FRUSTUM_PLANES];
+	for (int i = 0; i < FRUSTUM_PLANES; i++)
+	{
+		pm128PlaneA[i] = _mm_set1_ps(pxmf4Planes[i].x);
+		pm128PlaneB[i] = _mm_set1_ps(pxmf4Planes[i].y);
+		pm128PlaneC[i] = _mm_set1_ps(pxmf4Planes[i].z);
+		pm128PlaneD[i] = _mm_set1_ps(pxmf4Planes[i].w);
+	}
+	__m128 m128Zero = _mm_setzero_ps();
+
+	UINT pnStack[BVH_STACK_SIZE];
+	int nStack = 0;
+	pnStack[nStack++] = m_nRoot;
+	while (nStack > 0)
+	{
+		const BVH_NODE *pNode = &m_vNodes[pnStack[--nStack]];
+		__m128 m128MinX = _mm_load_ps(pNode->m_pfMinX), m128MinY = _mm_load_ps(pNode->m_pfMinY), m128MinZ = _mm_load_ps(pNode->m_pfMinZ);
+		__m128 m128MaxX = _mm_load_ps(pNode->m_pfMaxX), m128MaxY = _mm_load_ps(pNode->m_pfMaxY), m128MaxZ = _mm_load_ps(pNode->m_pfMaxZ);
+
+		//      (p) ̸ ڴ ۿ ְ,   (n) ̸ 鿡  ִ.
+		__m128 m128Outside = m128Zero, m128Intersecting = m128Zero;
+		for (int i = 0; i < FRUSTUM_PLANES; i++)
+		{
+			bool bPositiveX = (pxmf4Planes[i].x >= 0.0f), bPositiveY = (pxmf4Planes[i].y >= 0.0f), bPositiveZ = (pxmf4Planes[i].z >= 0.0f);
+			__m128 m128DistanceP = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pm128PlaneA[i], bPositiveX ? m128MaxX : m128MinX), _mm_mul_ps(pm128PlaneB[i], bPositiveY ? m128MaxY : m128MinY)), _mm_mul_ps(pm128PlaneC[i], bPositiveZ ? m128MaxZ : m128MinZ)), pm128PlaneD[i]);
+			__m128 m128DistanceN = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pm128PlaneA[i], bPositiveX ? m128MinX : m128MaxX), _mm_mul_ps(pm128PlaneB[i], bPositiveY ? m128MinY : m128MaxY)), _mm_mul_ps(pm128PlaneC[i], bPositiveZ ? m128MinZ : m128MaxZ)), pm128PlaneD[i]);
+			m128Outside = _mm_or_ps(m128Outside, _mm_cmplt_ps(m128DistanceP, m128Zero));
+			m128Intersecting = _mm_or_ps(m128Intersecting, _mm_cmplt_ps(m128DistanceN, m128Zero));
+		}
+		int nVisible = ~_mm_movemask_ps(m128Outside) & 0x0F;
+		int nIntersecting = _mm_movemask_ps(m128Intersecting);
+
+		for (int i = 0; i < BVH_WIDTH; i++)
+		{
+			UINT nChild = pNode->m_pnChildren[i];
+			if (!(nVisible & (1 << i)) || (nChild == BVH_NULL)) continue;
+			if (nChild & BVH_LEAF)
+				vResults.push_back(m_vProxies[nChild & ~BVH_LEAF].m_nUserData);
+			else if (!(nIntersecting & (1 << i)))
+				AddSubtree(nChild, vResults);	// ̸  ˻ ʴ´.
+			else
+				pnStack[nStack++] = nChild;
+		}
+		assert(nStack + BVH_WIDTH <= BVH_STACK_SIZE);
+	}
+
+	return(UINT(vResults.size() - nResults));
+}
+
+UINT CBoundingVolumeHierarchy::Overlap(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max, vector<UINT>& vResults) const
+{
+	if (m_nRoot == BVH_NULL) return(0);
+	size_t nResults = vResults.size();
+
+	__m128 m128QueryMinX = _mm_set1_ps(xmf3Min.x), m128QueryMinY = _mm_set1_ps(xmf3Min.y), m128QueryMinZ = _mm_set1_ps(xmf3Min.z);
+	__m128 m128QueryMaxX = _mm_set1_ps(xmf3Max.x), m128QueryMaxY = _mm_set1_ps(xmf3Max.y), m128QueryMaxZ = _mm_set1_ps(xmf3Max.z);
+
+	UINT pnStack[BVH_STACK_SIZE];
+	int nStack = 0;
+	pnStack[nStack++] = m_nRoot;
+	while (nStack > 0)
+	{
+		const BVH_NODE *pNode = &m_vNodes[pnStack[--nStack]];
+
+		//     ľ Ѵ.   ڰ  Ƿ ׻ .
+		__m128 m128OverlapX = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(pNode->m_pfMinX), m128QueryMaxX), _mm_cmpge_ps(_mm_load_ps(pNode->m_pfMaxX), m128QueryMinX));
+		__m128 m128OverlapY = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(pNode->m_pfMinY), m128QueryMaxY), _mm_cmpge_ps(_mm_load_ps(pNode->m_pfMaxY), m128QueryMinY));
+		__m128 m128OverlapZ = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(pNode->m_pfMinZ), m128QueryMaxZ), _mm_cmpge_ps(_mm_load_ps(pNode->m_pfMaxZ), m128QueryMinZ));
+		int nOverlap = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(m128OverlapX, m128OverlapY), m128OverlapZ));
+
+		for (int i = 0; i < BVH_WIDTH; i++)
+		{
+			UINT nChild = pNode->m_pnChildren[i];
+			if (!(nOverlap & (1 << i)) || (nChild == BVH_NULL)) continue;
+			if (nChild & BVH_LEAF)
+				vResults.push_back(m_vProxies[nChild & ~BVH_LEAF].m_nUserData);
+			else
+				pnStack[nStack++] = nChild;
+		}
+		assert(nStack + BVH_WIDTH <= BVH_STACK_SIZE);
+	}
+
+	return(UINT(vResults.size() - nResults));
+}
+
+struct BVH_RAY_ENTRY
+{
+	UINT							m_nNode;
+	float							m_fDistance;
+};
+
+bool CBoundingVolumeHierarchy::Raycast(const XMFLOAT3& xmf3Origin, const XMFLOAT3& xmf3Direction, float fMaxDistance, UINT *pnUserData, float *pfDistance) const
+{
+	if (m_nRoot == BVH_NULL) return(false);
+
+	//   0̸    ū  Ἥ NaN Ѵ.
+	float fInverseX = (fabsf(xmf3Direction.x) > EPSILON) ? (1.0f / xmf3Direction.x) : ((xmf3Direction.x < 0.0f) ? -1.0e30f : 1.0e30f);
+	float fInverseY = (fabsf(xmf3Direction.y) > EPSILON) ? (1.0f / xmf3Direction.y) : ((xmf3Direction.y < 0.0f) ? -1.0e30f : 1.0e30f);
+	float fInverseZ = (fabsf(xmf3Direction.z) > EPSILON) ? (1.0f / xmf3Direction.z) : ((xmf3Direction.z < 0.0f) ? -1.0e30f : 1.0e30f);
+	__m128 m128OriginX = _mm_set1_ps(xmf3Origin.x), m128OriginY = _mm_set1_ps(xmf3Origin.y), m128OriginZ = _mm_set1_ps(xmf3Origin.z);
+	__m128 m128InverseX = _mm_set1_ps(fInverseX), m128InverseY = _mm_set1_ps(fInverseY), m128InverseZ = _mm_set1_ps(fInverseZ);
+
+	float fNearest = fMaxDistance;
+	UINT nNearest = BVH_NULL;
+
+	BVH_RAY_ENTRY pxStack[BVH_STACK_SIZE];
+	int nStack = 0;
+	pxStack[nStack++] = { m_nRoot, 0.0f };
+	while (nStack > 0)
+	{
+		BVH_RAY_ENTRY xEntry = pxStack[--nStack];
+		if (xEntry.m_fDistance > fNearest) continue;
+
+		const BVH_NODE *pNode = &m_vNodes[xEntry.m_nNode];
+		__m128 m128T1X = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMinX), m128OriginX), m128InverseX);
+		__m128 m128T2X = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMaxX), m128OriginX), m128InverseX);
+		__m128 m128T1Y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMinY), m128OriginY), m128InverseY);
+		__m128 m128T2Y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMaxY), m128OriginY), m128InverseY);
+		__m128 m128T1Z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMinZ), m128OriginZ), m128InverseZ);
+		__m128 m128T2Z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(pNode->m_pfMaxZ), m128OriginZ), m128InverseZ);
+		__m128 m128Near = _mm_max_ps(_mm_max_ps(_mm_min_ps(m128T1X, m128T2X), _mm_min_ps(m128T1Y, m128T2Y)), _mm_max_ps(_mm_min_ps(m128T1Z, m128T2Z), _mm_setzero_ps()));
+		__m128 m128Far = _mm_min_ps(_mm_min_ps(_mm_max_ps(m128T1X, m128T2X), _mm_max_ps(m128T1Y, m128T2Y)), _mm_min_ps(_mm_max_ps(m128T1Z, m128T2Z), _mm_set1_ps(fNearest)));
+		int nHits = _mm_movemask_ps(_mm_cmple_ps(m128Near, m128Far));
+		if (!nHits) continue;
+
+		XMFLOAT4A xmf4Near;
+		_mm_store_ps(&xmf4Near.x, m128Near);
+		const float *pfNear = &xmf4Near.x;
+
+		//  ڽ 带  ͺ ׾Ƽ    .
+		BVH_RAY_ENTRY pxChildren[BVH_WIDTH];
+		int nChildren = 0;
+		for (int i = 0; i < BVH_WIDTH; i++)
+		{
+			UINT nChild = pNode->m_pnChildren[i];
+			if (!(nHits & (1 << i)) || (nChild == BVH_NULL)) continue;
+			if (nChild & BVH_LEAF)
+			{
+				if (pfNear[i] < fNearest)
+				{
+					fNearest = pfNear[i];
+					nNearest = nChild & ~BVH_LEAF;
+				}
+			}
+			else
+			{
+				int j = nChildren++;
+				for ( ; (j > 0) && (pxChildren[j - 1].m_fDistance < pfNear[i]); j--) pxChildren[j] = pxChildren[j - 1];
+				pxChildren[j] = { nChild, pfNear[i] };
+			}
+		}
+		for (int i = 0; i < nChildren; i++) pxStack[nStack++] = pxChildren[i];
+		assert(nStack + BVH_WIDTH <= BVH_STACK_SIZE);
+	}
+
+	if (nNearest == BVH_NULL) return(false);
+	if (pnUserData) *pnUserData = m_vProxies[nNearest].m_nUserData;
+	if (pfDistance) *pfDistance = fNearest;
+	return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+static bool IsBoxOutside(const XMFLOAT4 *pxmf4Planes, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max)
+{
+	for (int i = 0; i < FRUSTUM_PLANES; i++)
+	{
+		float fDistance = (pxmf4Planes[i].x * ((pxmf4Planes[i].x >= 0.0f) ? xmf3Max.x : xmf3Min.x)) + (pxmf4Planes[i].y * ((pxmf4Planes[i].y >= 0.0f) ? xmf3Max.y : xmf3Min.y)) + (pxmf4Planes[i].z * ((pxmf4Planes[i].z >= 0.0f) ? xmf3Max.z : xmf3Min.z)) + pxmf4Planes[i].w;
+		if (fDistance < 0.0f) return(true);
+	}
+	return(false);
+}
+
+static bool IntersectRayBox(const XMFLOAT3& xmf3Origin, const XMFLOAT3& xmf3Direction, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max, float fMaxDistance, float *pfDistance)
+{
+	XMVECTOR xmvOrigin = XMLoadFloat3(&xmf3Origin), xmvDirection = XMLoadFloat3(&xmf3Direction);
+	BoundingBox xmBoundingBox;
+	BoundingBox::CreateFromPoints(xmBoundingBox, XMLoadFloat3(&xmf3Min), XMLoadFloat3(&xmf3Max));
+	float fDistance = 0.0f;
+	if (!xmBoundingBox.Intersects(xmvOrigin, xmvDirection, fDistance)) return(false);
+	fDistance = max(fDistance, 0.0f);	//  ̸  ´.
+	if (fDistance > fMaxDistance) return(false);
+	*pfDistance = fDistance;
+	return(true);
+}
+
+inline float RandomFloat(float fMin, float fMax) { return(fMin + ((fMax - fMin) * (rand() / float(RAND_MAX)))); }
+
+bool CBoundingVolumeHierarchy::RunBenchmark(LPCTSTR pszFileName)
+{
+	const UINT nProxies = 1 << 16;
+	const UINT nFrustums = 256;
+	const UINT nRays = 1 << 16;
+	const UINT nBruteForceRays = 1024;
+	const float fWorldSize = 4096.0f;
+
+	srand(35);
+
+	vector<XMFLOAT3> vxmf3Mins(nProxies), vxmf3Maxs(nProxies);
+	for (UINT i = 0; i < nProxies; i++)
+	{
+		XMFLOAT3 xmf3Center(RandomFloat(0.0f, fWorldSize), RandomFloat(0.0f, 256.0f), RandomFloat(0.0f, fWorldSize));
+		XMFLOAT3 xmf3Extents(RandomFloat(1.0f, 16.0f), RandomFloat(1.0f, 36.0f), RandomFloat(1.0f, 16.0f));
+		vxmf3Mins[i] = XMFLOAT3(xmf3Center.x - xmf3Extents.x, xmf3Center.y - xmf3Extents.y, xmf3Center.z - xmf3Extents.z);
+		vxmf3Maxs[i] = XMFLOAT3(xmf3Center.x + xmf3Extents.x, xmf3Center.y + xmf3Extents.y, xmf3Center.z + xmf3Extents.z);
+	}
+
+	vector<XMFLOAT4> vxmf4Planes(nFrustums * FRUSTUM_PLANES);
+	XMMATRIX xmmtxProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), float(FRAME_BUFFER_WIDTH) / float(FRAME_BUFFER_HEIGHT), 1.0f, 1000.0f);
+	for (UINT i = 0; i < nFrustums; i++)
+	{
+		float fYaw = RandomFloat(0.0f, XM_2PI);
+		XMVECTOR xmvPosition = XMVectorSet(RandomFloat(0.0f, fWorldSize), 150.0f, RandomFloat(0.0f, fWorldSize), 1.0f);
+		XMVECTOR xmvLook = XMVectorSet(sinf(fYaw), -0.3f, cosf(fYaw), 0.0f);
+		XMFLOAT4X4 xmf4x4ViewProjection;
+		XMStoreFloat4x4(&xmf4x4ViewProjection, XMMatrixMultiply(XMMatrixLookToLH(xmvPosition, xmvLook, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)), xmmtxProjection));
+		CFrustum xFrustum;
+		xFrustum.ExtractPlanes(xmf4x4ViewProjection);
+		for (int j = 0; j < FRUSTUM_PLANES; j++) vxmf4Planes[(i * FRUSTUM_PLANES) + j] = xFrustum.m_pxmf4Planes[j];
+	}
+
+	vector<XMFLOAT3> vxmf3Origins(nRays), vxmf3Directions(nRays);
+	for (UINT i = 0; i < nRays; i++)
+	{
+		vxmf3Origins[i] = XMFLOAT3(RandomFloat(0.0f, fWorldSize), RandomFloat(0.0f, 300.0f), RandomFloat(0.0f, fWorldSize));
+		XMFLOAT3 xmf3Direction(RandomFloat(-1.0f, 1.0f), RandomFloat(-0.5f, 0.5f), RandomFloat(-1.0f, 1.0f));
+		vxmf3Directions[i] = Vector3::Normalize(xmf3Direction);
+	}
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+	TCHAR pstrReport[160];
+	auto Report = [&]()
+	{
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+	};
+	auto Elapsed = [](std::chrono::high_resolution_clock::time_point tStart)
+	{
+		return(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count());
+	};
+
+	CBoundingVolumeHierarchy *pBvh = new CBoundingVolumeHierarchy();
+
+	// ü ̴ Ͻ   ˻ Ѵ. (  ϸ Ʋ 䳢   ִ)
+	//    ȣ̹Ƿ ϸ  ˻ ϰ ƾ Ѵ.
+	vector<UINT> vVisible, vExpected;
+	vVisible.reserve(nProxies);
+	vExpected.reserve(nProxies);
+	auto CountCullMismatches = [&]()
+	{
+		UINT nMismatches = 0;
+		for (UINT i = 0; i < nFrustums; i++)
+		{
+			vVisible.clear();
+			pBvh->Cull(&vxmf4Planes[i * FRUSTUM_PLANES], vVisible);
+			std::sort(vVisible.begin(), vVisible.end());
+			vExpected.clear();
+			for (UINT j = 0; j < nProxies; j++) if (!IsBoxOutside(&vxmf4Planes[i * FRUSTUM_PLANES], vxmf3Mins[j], vxmf3Maxs[j])) vExpected.push_back(j);
+			if (vVisible != vExpected) nMismatches++;
+		}
+		return(nMismatches);
+	};
+	//      Ÿ  ˻ Ѵ.
+	UINT nUserData = 0;
+	float fDistance = 0.0f;
+	auto CountRayMismatches = [&]()
+	{
+		UINT nMismatches = 0;
+		for (UINT i = 0; i < nBruteForceRays; i++)
+		{
+			float fNearest = 1000.0f, fBoxDistance = 0.0f;
+			bool bHit = false;
+			for (UINT j = 0; j < nProxies; j++)
+			{
+				if (IntersectRayBox(vxmf3Origins[i], vxmf3Directions[i], vxmf3Mins[j], vxmf3Maxs[j], fNearest, &fBoxDistance))
+				{
+					fNearest = fBoxDistance;
+					bHit = true;
+				}
+			}
+			bool bBvhHit = pBvh->Raycast(vxmf3Origins[i], vxmf3Directions[i], 1000.0f, &nUserData, &fDistance);
+			if ((bHit != bBvhHit) || (bHit && (fabsf(fNearest - fDistance) > 0.01f))) nMismatches++;
+		}
+		return(nMismatches);
+	};
+	bool bPassed = true;
+	auto Verify = [&](LPCTSTR pszStage)
+	{
+		UINT nCullMismatches = CountCullMismatches(), nRayMismatches = CountRayMismatches();
+		if (nCullMismatches || nRayMismatches) bPassed = false;
+		_stprintf_s(pstrReport, 160, _T("Check (%s): frustum mismatches %u / %u, ray mismatches %u / %u, depth %u\n"), pszStage, nCullMismatches, nFrustums, nRayMismatches, nBruteForceRays, pBvh->GetDepth());
+		Report();
+	};
+
+	// Ը  Ʈ
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nProxies; i++) pBvh->Insert(vxmf3Mins[i], vxmf3Maxs[i], i);
+	double fInsertTime = Elapsed(tStart);
+	UINT nInsertDepth = pBvh->GetDepth();
+	Verify(_T("incremental insert"));
+
+	tStart = std::chrono::high_resolution_clock::now();
+	pBvh->Build();
+	double fBuildTime = Elapsed(tStart);
+
+	_stprintf_s(pstrReport, 160, _T("Proxies: %u  Nodes: %u  Depth: %u (incremental %u)\n"), pBvh->GetProxies(), pBvh->GetNodes(), pBvh->GetDepth(), nInsertDepth);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Insert:  %8.3f ms (%.1f ns/proxy)\n"), fInsertTime, fInsertTime * 1.0e6 / nProxies);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Build:   %8.3f ms (SAH, %d bins)\n"), fBuildTime, BVH_BINS);
+	Report();
+
+	//  ڸ ݾ ̰  ڸ ٽ Ѵ.
+	for (UINT i = 0; i < nProxies; i++)
+	{
+		XMFLOAT3 xmf3Shift(RandomFloat(-2.0f, 2.0f), 0.0f, RandomFloat(-2.0f, 2.0f));
+		vxmf3Mins[i] = Vector3::Add(vxmf3Mins[i], xmf3Shift);
+		vxmf3Maxs[i] = Vector3::Add(vxmf3Maxs[i], xmf3Shift);
+	}
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nProxies; i++) pBvh->UpdateProxy(i, vxmf3Mins[i], vxmf3Maxs[i]);
+	pBvh->Refit();
+	double fRefitTime = Elapsed(tStart);
+	_stprintf_s(pstrReport, 160, _T("Refit:   %8.3f ms\n"), fRefitTime);
+	Report();
+	Verify(_T("build + refit"));
+
+	// ü ø  ó (  Ȯߴ)
+	UINT nVisible = 0;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nFrustums; i++)
+	{
+		vVisible.clear();
+		nVisible += pBvh->Cull(&vxmf4Planes[i * FRUSTUM_PLANES], vVisible);
+	}
+	double fCullTime = Elapsed(tStart);
+
+	tStart = std::chrono::high_resolution_clock::now();
+	UINT nBruteForceVisible = 0;
+	for (UINT i = 0; i < nFrustums; i++)
+	{
+		for (UINT j = 0; j < nProxies; j++) if (!IsBoxOutside(&vxmf4Planes[i * FRUSTUM_PLANES], vxmf3Mins[j], vxmf3Maxs[j])) nBruteForceVisible++;
+	}
+	double fBruteForceCullTime = Elapsed(tStart);
+
+	_stprintf_s(pstrReport, 160, _T("Cull:    %8.3f ms/frustum (brute force %.3f ms, %.1fx)  Visible: %u / %u\n"), fCullTime / nFrustums, fBruteForceCullTime / nFrustums, fBruteForceCullTime / fCullTime, nVisible / nFrustums, nProxies);
+	Report();
+
+	UINT nHits = 0;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nRays; i++) if (pBvh->Raycast(vxmf3Origins[i], vxmf3Directions[i], 1000.0f, &nUserData, &fDistance)) nHits++;
+	double fRayTime = Elapsed(tStart);
+
+	tStart = std::chrono::high_resolution_clock::now();
+	CountRayMismatches();
+	double fBruteForceRayTime = Elapsed(tStart);
+
+	_stprintf_s(pstrReport, 160, _T("Raycast: %8.3f Mrays/s (brute force %.4f Mrays/s)  Hits: %u / %u\n"), (nRays / fRayTime) * 1.0e-3, (nBruteForceRays / fBruteForceRayTime) * 1.0e-3, nHits, nRays);
+	Report();
+
+	// 10% ٰ ٽ ִ´.     Ǿ Ѵ.
+	UINT nChanges = nProxies / 10;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nChanges; i++) pBvh->Remove(i * 10);
+	for (UINT i = 0; i < nChanges; i++) pBvh->Insert(vxmf3Mins[i * 10], vxmf3Maxs[i * 10], i * 10);
+	double fChangeTime = Elapsed(tStart);
+	_stprintf_s(pstrReport, 160, _T("Remove + Insert %u: %8.3f ms  Depth: %u\n"), nChanges, fChangeTime, pBvh->GetDepth());
+	Report();
+	Verify(_T("remove + insert"));
+
+	UINT nProxy = pBvh->Insert(vxmf3Mins[0], vxmf3Maxs[0], 0);
+	bool bRemoved = pBvh->Remove(nProxy), bRemovedTwice = pBvh->Remove(nProxy);
+	if (!bRemoved || bRemovedTwice || (pBvh->GetProxies() != nProxies)) bPassed = false;
+	_stprintf_s(pstrReport, 160, _T("Double remove rejected: %s\n"), (bRemoved && !bRemovedTwice && (pBvh->GetProxies() == nProxies)) ? _T("ok") : _T("FAILED"));
+	Report();
+
+	pBvh->Refit();
+	Verify(_T("refit after changes"));
+
+	_stprintf_s(pstrReport, 160, _T("Result: %s\n"), (bPassed) ? _T("PASSED") : _T("FAILED"));
+	Report();
+
+	delete pBvh;
+	if (pFile) fclose(pFile);
+	return(bPassed);
+}
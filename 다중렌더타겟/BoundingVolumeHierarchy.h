@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// File: BoundingVolumeHierarchy.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Frustum.h"
+
+#define BVH_WIDTH					4
+#define BVH_BINS					16
+#define BVH_MAX_DEPTH				48			//Insert() ̺  Build() ٽ .
+#define BVH_SAH_MAX_DEPTH			24			//Build()  ̺ SAH    . ( ̰ log4(Ͻ )  ʴ´)
+#define BVH_STACK_SIZE				(BVH_MAX_DEPTH * (BVH_WIDTH - 1) + 1)	// 켱 ȸ ÿ  ̸  ƾ 3 δ.
+
+#define BVH_NULL					0xFFFFFFFF
+#define BVH_LEAF					0x80000000	//ڽ  = BVH_LEAF | Ͻ ε
+
+struct BVH_PROXY
+{
+	XMFLOAT3						m_xmf3Min;
+	XMFLOAT3						m_xmf3Max;
+	UINT							m_nUserData;
+	UINT							m_nLocation;	//( << 2) | , Ʈ  BVH_NULL
+};
+
+// ڽ 4  ڸ ະ  д. (SSE  ϳ   ڽ 4  )
+//   m_pnChildren BVH_NULL̰  ڴ (min > max) ִ.
+struct alignas(16) BVH_NODE
+{
+	float							m_pfMinX[BVH_WIDTH];
+	float							m_pfMinY[BVH_WIDTH];
+	float							m_pfMinZ[BVH_WIDTH];
+	float							m_pfMaxX[BVH_WIDTH];
+	float							m_pfMaxY[BVH_WIDTH];
+	float							m_pfMaxZ[BVH_WIDTH];
+	UINT							m_pnChildren[BVH_WIDTH];
+	UINT							m_nParent;		//(θ  << 2) | , Ʈ BVH_NULL
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ü AABB  4   .
+// Build() SAH  Ʈ  , Insert()/Remove() Ʈ  ä ģ.
+// UpdateProxy()  ü ڸ ٲ  Refit() ȣϸ  ״ ΰ  ڸ ٽ Ѵ.
+class CBoundingVolumeHierarchy
+{
+public:
+	CBoundingVolumeHierarchy();
+	~CBoundingVolumeHierarchy();
+
+private:
+	vector<BVH_PROXY>				m_vProxies;
+	vector<UINT>					m_vFreeProxies;
+
+	// θ  ׻ ڽ 庸 տ ִ. (Refit() ڿ Ѵ)
+	vector<BVH_NODE>				m_vNodes;
+	UINT							m_nRoot = BVH_NULL;
+	UINT							m_nDepth = 0;
+	bool							m_bRefitNeeded = false;
+
+	vector<UINT>					m_vBuildProxies;
+	vector<XMFLOAT3>				m_vBuildCentroids;
+
+	UINT AllocateNode(UINT nParent);
+	void SetSlot(UINT nNode, int nSlot, UINT nChild, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max);
+	void ClearSlot(UINT nNode, int nSlot);
+	void GetNodeBounds(UINT nNode, XMFLOAT3& xmf3Min, XMFLOAT3& xmf3Max) const;
+	UINT SplitRange(UINT nBegin, UINT nEnd, UINT nDepth);
+	void AddSubtree(UINT nNode, vector<UINT>& vResults) const;
+
+public:
+	// Ʈ BVH_MAX_DEPTH  Build() ٽ Ƿ ȸ  ġ ʴ´.
+	UINT Insert(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max, UINT nUserData);
+	// ̹ (Ǵ ) Ͻø ƹ͵  ʰ false ش.
+	bool Remove(UINT nProxy);
+	void UpdateProxy(UINT nProxy, const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max);
+
+	void Build();
+	void Refit();
+	void Clear();
+
+	// (ax + by + cz + d >= 0  ) ġ Ͻ   vResults ڿ ̰   ش.
+	UINT Cull(const XMFLOAT4 *pxmf4Planes, vector<UINT>& vResults) const;
+	// (xmf3Min ~ xmf3Max) ġ Ͻ   vResults ڿ ̰   ش.
+	UINT Overlap(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max, vector<UINT>& vResults) const;
+	//   Ͻ ڿ  Ÿ ã´.
+	bool Raycast(const XMFLOAT3& xmf3Origin, const XMFLOAT3& xmf3Direction, float fMaxDistance, UINT *pnUserData, float *pfDistance) const;
+
+	UINT GetProxies() { return(UINT(m_vProxies.size() - m_vFreeProxies.size())); }
+	UINT GetNodes() { return(UINT(m_vNodes.size())); }
+	UINT GetDepth() { return(m_nDepth); }
+	UINT GetUserData(UINT nProxy) { return(m_vProxies[nProxy].m_nUserData); }
+	bool IsRefitNeeded() { return(m_bRefitNeeded); }
+
+	//  ڵ //ø/ ó , Ը  Ʈ, Build() Refit() ,  ٽ  ڸ
+	// ü ̴ հ    Ÿ  ˻  ϰ  ¿ .   true.
+	static bool RunBenchmark(LPCTSTR pszFileName);
+};
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Player.h"
 #include "Camera.h"
+#include "RenderStats.h"
+#include "FrameUploadBuffer.h"
 
 CCamera::CCamera()
 {
@@ -20,6 +22,8 @@ CCamera::CCamera()
 	m_xmf3LookAtWorld = XMFLOAT3(0.0f, 0.0f, 0.0f);
 	m_nMode = 0x00;
 	m_pPlayer = NULL;
+	m_xmf3ViewPosition = m_xmf3ViewRight = m_xmf3ViewUp = m_xmf3ViewLook = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	ResetUpdateCounters();
 }
 
 CCamera::CCamera(CCamera *pCamera)
@@ -27,6 +31,8 @@ CCamera::CCamera(CCamera *pCamera)
 	if (pCamera)
 	{
 		*this = *pCamera;
+		//  ۸    Ƿ ó  ٽ .
+		m_nDirtyFlags = CAMERA_DIRTY_ALL;
 	}
 	else
 	{
@@ -46,6 +52,8 @@ CCamera::CCamera(CCamera *pCamera)
 		m_xmf3LookAtWorld = XMFLOAT3(0.0f, 0.0f, 0.0f);
 		m_nMode = 0x00;
 		m_pPlayer = NULL;
+		m_xmf3ViewPosition = m_xmf3ViewRight = m_xmf3ViewUp = m_xmf3ViewLook = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		ResetUpdateCounters();
 	}
 }
 
@@ -76,6 +84,8 @@ void CCamera::GenerateProjectionMatrix(float fNearPlaneDistance, float fFarPlane
 	m_xmf4x4Projection = Matrix4x4::PerspectiveFovLH(XMConvertToRadians(fFOVAngle), fAspectRatio, fNearPlaneDistance, fFarPlaneDistance);
 	//	XMMATRIX xmmtxProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(fFOVAngle), fAspectRatio, fNearPlaneDistance, fFarPlaneDistance);
 	//	XMStoreFloat4x4(&m_xmf4x4Projection, xmmtxProjection);
+	m_nDirtyFlags |= CAMERA_DIRTY_PROJECTION;
+	m_xUpdateCounters.m_nProjectionMatrices++;
 }
 
 void CCamera::GenerateViewMatrix(XMFLOAT3 xmf3Position, XMFLOAT3 xmf3LookAt, XMFLOAT3 xmf3Up)
@@ -89,54 +99,161 @@ void CCamera::GenerateViewMatrix(XMFLOAT3 xmf3Position, XMFLOAT3 xmf3LookAt, XMF
 
 void CCamera::GenerateViewMatrix()
 {
-	m_xmf4x4View = Matrix4x4::LookAtLH(m_xmf3Position, m_xmf3LookAtWorld, m_xmf3Up);
+	SetViewMatrix(Matrix4x4::LookAtLH(m_xmf3Position, m_xmf3LookAtWorld, m_xmf3Up));
+}
+
+inline bool IsIdentical(const XMFLOAT3& xmf3Vector1, const XMFLOAT3& xmf3Vector2)
+{
+	return((xmf3Vector1.x == xmf3Vector2.x) && (xmf3Vector1.y == xmf3Vector2.y) && (xmf3Vector1.z == xmf3Vector2.z));
 }
 
 void CCamera::RegenerateViewMatrix()
 {
+	// ÷̾ Ű ũ н   ӿ   ҸǷ ī޶ ǥ谡 ״̸ ǳʶڴ.
+	if (::IsIdentical(m_xmf3Position, m_xmf3ViewPosition) && ::IsIdentical(m_xmf3Right, m_xmf3ViewRight) && ::IsIdentical(m_xmf3Up, m_xmf3ViewUp) && ::IsIdentical(m_xmf3Look, m_xmf3ViewLook))
+	{
+		m_xUpdateCounters.m_nSkippedViewMatrices++;
+		return;
+	}
+
 	m_xmf3Look = Vector3::Normalize(m_xmf3Look);
 	m_xmf3Right = Vector3::CrossProduct(m_xmf3Up, m_xmf3Look, true);
 	m_xmf3Up = Vector3::CrossProduct(m_xmf3Look, m_xmf3Right, true);
 
-	m_xmf4x4View._11 = m_xmf3Right.x; m_xmf4x4View._12 = m_xmf3Up.x; m_xmf4x4View._13 = m_xmf3Look.x;
-	m_xmf4x4View._21 = m_xmf3Right.y; m_xmf4x4View._22 = m_xmf3Up.y; m_xmf4x4View._23 = m_xmf3Look.y;
-	m_xmf4x4View._31 = m_xmf3Right.z; m_xmf4x4View._32 = m_xmf3Up.z; m_xmf4x4View._33 = m_xmf3Look.z;
-	m_xmf4x4View._41 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Right);
-	m_xmf4x4View._42 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Up);
-	m_xmf4x4View._43 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Look);
+	XMFLOAT4X4 xmf4x4View = m_xmf4x4View;
+	xmf4x4View._11 = m_xmf3Right.x; xmf4x4View._12 = m_xmf3Up.x; xmf4x4View._13 = m_xmf3Look.x;
+	xmf4x4View._21 = m_xmf3Right.y; xmf4x4View._22 = m_xmf3Up.y; xmf4x4View._23 = m_xmf3Look.y;
+	xmf4x4View._31 = m_xmf3Right.z; xmf4x4View._32 = m_xmf3Up.z; xmf4x4View._33 = m_xmf3Look.z;
+	xmf4x4View._41 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Right);
+	xmf4x4View._42 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Up);
+	xmf4x4View._43 = -Vector3::DotProduct(m_xmf3Position, m_xmf3Look);
+	SetViewMatrix(xmf4x4View);
 }
 
-void CCamera::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
+void CCamera::SetViewMatrix(const XMFLOAT4X4& xmf4x4View)
 {
-	UINT ncbElementBytes = ((sizeof(VS_CB_CAMERA_INFO) + 255) & ~255); //256 
-	m_pd3dcbCamera = ::CreateBufferResource(pd3dDevice, pd3dCommandList, NULL, ncbElementBytes, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, NULL);
+	m_xmf3ViewPosition = m_xmf3Position;
+	m_xmf3ViewRight = m_xmf3Right;
+	m_xmf3ViewUp = m_xmf3Up;
+	m_xmf3ViewLook = m_xmf3Look;
+
+	m_xUpdateCounters.m_nViewMatrices++;
+	if (!::memcmp(&xmf4x4View, &m_xmf4x4View, sizeof(XMFLOAT4X4))) return;
 
-	m_pd3dcbCamera->Map(0, NULL, (void **)&m_pcbMappedCamera);
+	m_xmf4x4View = xmf4x4View;
+	m_nDirtyFlags |= CAMERA_DIRTY_VIEW;
 }
 
-void CCamera::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
+const XMFLOAT4X4& CCamera::GetViewProjectionMatrix()
+{
+	if (m_nDirtyFlags & CAMERA_DIRTY_VIEW_PROJECTION)
+	{
+		m_xmf4x4ViewProjection = Matrix4x4::Multiply(m_xmf4x4View, m_xmf4x4Projection);
+		m_nDirtyFlags &= ~CAMERA_DIRTY_VIEW_PROJECTION;
+		m_xUpdateCounters.m_nViewProjectionMatrices++;
+	}
+	return(m_xmf4x4ViewProjection);
+}
+
+const XMFLOAT4X4& CCamera::GetInverseViewMatrix()
 {
-	XMStoreFloat4x4(&m_pcbMappedCamera->m_xmf4x4View, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4View)));
-	XMStoreFloat4x4(&m_pcbMappedCamera->m_xmf4x4Projection, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4Projection)));
-	::memcpy(&m_pcbMappedCamera->m_xmf3Position, &m_xmf3Position, sizeof(XMFLOAT3));
+	if (m_nDirtyFlags & CAMERA_DIRTY_INVERSE_VIEW)
+	{
+		//   ȸ ̵̹Ƿ ȸ ġϰ ̵ ȸ  ǵ ȴ.
+		XMMATRIX xmmtxView = XMLoadFloat4x4(&m_xmf4x4View);
+		XMVECTOR xmvTranslation = xmmtxView.r[3];
+		xmmtxView.r[3] = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+		XMMATRIX xmmtxInverseView = XMMatrixTranspose(xmmtxView);
+		xmmtxInverseView.r[3] = XMVectorSetW(XMVectorNegate(XMVector3TransformNormal(xmvTranslation, xmmtxInverseView)), 1.0f);
+		XMStoreFloat4x4(&m_xmf4x4InverseView, xmmtxInverseView);
+		m_nDirtyFlags &= ~CAMERA_DIRTY_INVERSE_VIEW;
+		m_xUpdateCounters.m_nInverseViewMatrices++;
+	}
+	return(m_xmf4x4InverseView);
+}
 
-	D3D12_GPU_VIRTUAL_ADDRESS d3dGpuVirtualAddress = m_pd3dcbCamera->GetGPUVirtualAddress();
-	pd3dCommandList->SetGraphicsRootConstantBufferView(1, d3dGpuVirtualAddress);
+const XMFLOAT4X4& CCamera::GetInverseProjectionMatrix()
+{
+	if (m_nDirtyFlags & CAMERA_DIRTY_INVERSE_PROJECTION)
+	{
+		m_xmf4x4InverseProjection = Matrix4x4::Inverse(m_xmf4x4Projection);
+		m_nDirtyFlags &= ~CAMERA_DIRTY_INVERSE_PROJECTION;
+		m_xUpdateCounters.m_nInverseProjectionMatrices++;
+	}
+	return(m_xmf4x4InverseProjection);
 }
 
-void CCamera::ReleaseShaderVariables()
+const CFrustum& CCamera::GetFrustum()
+{
+	if (m_nDirtyFlags & CAMERA_DIRTY_FRUSTUM)
+	{
+		m_xFrustum.ExtractPlanes(GetViewProjectionMatrix());
+		m_nDirtyFlags &= ~CAMERA_DIRTY_FRUSTUM;
+		m_xUpdateCounters.m_nFrustums++;
+	}
+	return(m_xFrustum);
+}
+
+UINT CCamera::GetRecomputations()
+{
+	return(m_xUpdateCounters.m_nViewMatrices + m_xUpdateCounters.m_nProjectionMatrices + m_xUpdateCounters.m_nViewProjectionMatrices + m_xUpdateCounters.m_nInverseViewMatrices + m_xUpdateCounters.m_nInverseProjectionMatrices + m_xUpdateCounters.m_nFrustums + m_xUpdateCounters.m_nTransposedMatrices);
+}
+
+void CCamera::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	if (m_pd3dcbCamera)
+	//  ۴ ׸  gFrameUploadBuffer ޴´.
+	m_nDirtyFlags |= CAMERA_DIRTY_CONSTANT_BUFFER;
+}
+
+void CCamera::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	//  ۴ ī޶ ٲ  ó   ٽ . ġ ĵ ̸    Ѵ.
+	if (m_nDirtyFlags & CAMERA_DIRTY_TRANSPOSED_VIEW)
+	{
+		XMStoreFloat4x4(&m_xmf4x4TransposedView, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4View)));
+		m_nDirtyFlags &= ~CAMERA_DIRTY_TRANSPOSED_VIEW;
+		m_xUpdateCounters.m_nTransposedMatrices++;
+	}
+	if (m_nDirtyFlags & CAMERA_DIRTY_TRANSPOSED_PROJECTION)
 	{
-		m_pd3dcbCamera->Unmap(0, NULL);
-		m_pd3dcbCamera->Release();
+		XMStoreFloat4x4(&m_xmf4x4TransposedProjection, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4Projection)));
+		m_nDirtyFlags &= ~CAMERA_DIRTY_TRANSPOSED_PROJECTION;
+		m_xUpdateCounters.m_nTransposedMatrices++;
 	}
+	if (m_nDirtyFlags & CAMERA_DIRTY_CONSTANT_BUFFER)
+	{
+		m_xcbCamera.m_xmf4x4View = m_xmf4x4TransposedView;
+		m_xcbCamera.m_xmf4x4Projection = m_xmf4x4TransposedProjection;
+		m_xcbCamera.m_xmf3Position = m_xmf3ViewPosition;
+		m_nDirtyFlags &= ~CAMERA_DIRTY_CONSTANT_BUFFER;
+		m_nUploadFrame = 0;
+	}
+
+	//   ø ޸𸮴 GPU  а   Ƿ ī޶ ״ο Ӹ    ø.
+	//    н(ũ,  н) ī޶ ٸǷ  ø.
+	if (m_nUploadFrame != ::gFrameUploadBuffer.GetFrame())
+	{
+		VS_CB_CAMERA_INFO *pcbMappedCamera = (VS_CB_CAMERA_INFO *)::gFrameUploadBuffer.Allocate(sizeof(VS_CB_CAMERA_INFO), &m_d3dcbCamera);
+		if (pcbMappedCamera)
+		{
+			::memcpy(pcbMappedCamera, &m_xcbCamera, sizeof(VS_CB_CAMERA_INFO));
+			::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, sizeof(VS_CB_CAMERA_INFO));
+			m_nUploadFrame = ::gFrameUploadBuffer.GetFrame();
+			m_xUpdateCounters.m_nConstantBufferUpdates++;
+		}
+	}
+
+	::gFilteredCommandList.SetGraphicsRootConstantBufferView(pd3dCommandList, 1, m_d3dcbCamera);
+}
+
+void CCamera::ReleaseShaderVariables()
+{
 }
 
 void CCamera::SetViewportsAndScissorRects(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	pd3dCommandList->RSSetViewports(1, &m_d3dViewport);
-	pd3dCommandList->RSSetScissorRects(1, &m_d3dScissorRect);
+	::gFilteredCommandList.RSSetViewports(pd3dCommandList, 1, &m_d3dViewport);
+	::gFilteredCommandList.RSSetScissorRects(pd3dCommandList, 1, &m_d3dScissorRect);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1,11 +1,26 @@
 #pragma once
 
+#include "Frustum.h"
+
 #define ASPECT_RATIO				(float(FRAME_BUFFER_WIDTH) / float(FRAME_BUFFER_HEIGHT))
 
 #define FIRST_PERSON_CAMERA			0x01
 #define SPACESHIP_CAMERA			0x02
 #define THIRD_PERSON_CAMERA			0x03
 
+// ٽ ؾ ϴ (CCamera::m_nDirtyFlags)
+#define CAMERA_DIRTY_VIEW_PROJECTION		0x01
+#define CAMERA_DIRTY_INVERSE_VIEW			0x02
+#define CAMERA_DIRTY_INVERSE_PROJECTION		0x04
+#define CAMERA_DIRTY_FRUSTUM				0x08
+#define CAMERA_DIRTY_TRANSPOSED_VIEW		0x10
+#define CAMERA_DIRTY_TRANSPOSED_PROJECTION	0x20
+#define CAMERA_DIRTY_CONSTANT_BUFFER		0x40
+#define CAMERA_DIRTY_ALL					0x7F
+
+#define CAMERA_DIRTY_VIEW					(CAMERA_DIRTY_VIEW_PROJECTION | CAMERA_DIRTY_INVERSE_VIEW | CAMERA_DIRTY_FRUSTUM | CAMERA_DIRTY_TRANSPOSED_VIEW | CAMERA_DIRTY_CONSTANT_BUFFER)
+#define CAMERA_DIRTY_PROJECTION				(CAMERA_DIRTY_VIEW_PROJECTION | CAMERA_DIRTY_INVERSE_PROJECTION | CAMERA_DIRTY_FRUSTUM | CAMERA_DIRTY_TRANSPOSED_PROJECTION | CAMERA_DIRTY_CONSTANT_BUFFER)
+
 struct VS_CB_CAMERA_INFO
 {
 	XMFLOAT4X4						m_xmf4x4View;
@@ -13,6 +28,20 @@ struct VS_CB_CAMERA_INFO
 	XMFLOAT3						m_xmf3Position;
 };
 
+// ī޶   ٽ  Ƚ. ResetUpdateCounters() ȴ.
+struct CAMERA_UPDATE_COUNTERS
+{
+	UINT							m_nViewMatrices;
+	UINT							m_nSkippedViewMatrices;		//Է ״ο ǳʶ RegenerateViewMatrix()
+	UINT							m_nProjectionMatrices;
+	UINT							m_nViewProjectionMatrices;
+	UINT							m_nInverseViewMatrices;
+	UINT							m_nInverseProjectionMatrices;
+	UINT							m_nFrustums;
+	UINT							m_nTransposedMatrices;
+	UINT							m_nConstantBufferUpdates;
+};
+
 class CPlayer;
 
 class CCamera
@@ -36,13 +65,32 @@ protected:
 	XMFLOAT4X4						m_xmf4x4View;
 	XMFLOAT4X4						m_xmf4x4Projection;
 
+	//  Ǵ  Ŀ   ó ʿ  ϰ Է ٲ  ״ .
+	XMFLOAT4X4						m_xmf4x4ViewProjection;
+	XMFLOAT4X4						m_xmf4x4InverseView;
+	XMFLOAT4X4						m_xmf4x4InverseProjection;
+	XMFLOAT4X4						m_xmf4x4TransposedView;			// ۿ
+	XMFLOAT4X4						m_xmf4x4TransposedProjection;
+	CFrustum						m_xFrustum;
+	UINT							m_nDirtyFlags = CAMERA_DIRTY_ALL;
+
+	//     ī޶ ǥ. RegenerateViewMatrix() ̰Ͱ  ƹ͵  ʴ´.
+	XMFLOAT3						m_xmf3ViewPosition;
+	XMFLOAT3						m_xmf3ViewRight;
+	XMFLOAT3						m_xmf3ViewUp;
+	XMFLOAT3						m_xmf3ViewLook;
+
+	CAMERA_UPDATE_COUNTERS			m_xUpdateCounters;
+
 	D3D12_VIEWPORT					m_d3dViewport;
 	D3D12_RECT						m_d3dScissorRect;
 
 	CPlayer							*m_pPlayer;
 
-	ID3D12Resource					*m_pd3dcbCamera = NULL;
-	VS_CB_CAMERA_INFO				*m_pcbMappedCamera = NULL;
+	//    װ ̹ ӿ ø gFrameUploadBuffer ּ
+	VS_CB_CAMERA_INFO				m_xcbCamera;
+	D3D12_GPU_VIRTUAL_ADDRESS		m_d3dcbCamera = 0;
+	UINT64							m_nUploadFrame = 0;				//m_d3dcbCamera  gFrameUploadBuffer  (0̸ ٽ ø)
 
 public:
 	CCamera();
@@ -61,6 +109,11 @@ public:
 
 	void GenerateProjectionMatrix(float fNearPlaneDistance, float fFarPlaneDistance, float fAspectRatio, float fFOVAngle);
 
+private:
+	void SetViewMatrix(const XMFLOAT4X4& xmf4x4View);
+
+public:
+
 	void SetViewport(int xTopLeft, int yTopLeft, int nWidth, int nHeight, float fMinZ = 0.0f, float fMaxZ = 1.0f);
 	void SetScissorRect(LONG xLeft, LONG yTop, LONG xRight, LONG yBottom);
 
@@ -95,6 +148,14 @@ public:
 
 	XMFLOAT4X4 GetViewMatrix() { return(m_xmf4x4View); }
 	XMFLOAT4X4 GetProjectionMatrix() { return(m_xmf4x4Projection); }
+	const XMFLOAT4X4& GetViewProjectionMatrix();
+	const XMFLOAT4X4& GetInverseViewMatrix();
+	const XMFLOAT4X4& GetInverseProjectionMatrix();
+	const CFrustum& GetFrustum();
+
+	const CAMERA_UPDATE_COUNTERS& GetUpdateCounters() { return(m_xUpdateCounters); }
+	UINT GetRecomputations();
+	void ResetUpdateCounters() { ::ZeroMemory(&m_xUpdateCounters, sizeof(CAMERA_UPDATE_COUNTERS)); }
 	D3D12_VIEWPORT GetViewport() { return(m_d3dViewport); }
 	D3D12_RECT GetScissorRect() { return(m_d3dScissorRect); }
 
@@ -0,0 +1,394 @@
+//-----------------------------------------------------------------------------
+// File: Collision.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Collision.h"
+#include "Mesh.h"
+#include "JobSystem.h"
+
+inline float RandomFloat(float fMin, float fMax) { return(fMin + ((fMax - fMin) * (rand() / float(RAND_MAX)))); }
+
+CCollisionWorld::CCollisionWorld()
+{
+}
+
+CCollisionWorld::~CCollisionWorld()
+{
+	Clear();
+}
+
+void CCollisionWorld::SetTerrain(CHeightMapImage *pHeightMapImage)
+{
+	m_pHeightMapImage = pHeightMapImage;
+	m_xmf3Scale = pHeightMapImage->GetScale();
+
+	// CHeightMapImage::GetHeight() ʰ  ̿ ȼ Ƿ  ٿ   .
+	m_fMaxX = (pHeightMapImage->GetHeightMapWidth() - 1.001f) * m_xmf3Scale.x;
+	m_fMaxZ = (pHeightMapImage->GetHeightMapLength() - 1.001f) * m_xmf3Scale.z;
+
+	//    ĭ    ˻Ѵ.
+	m_fTerrainStep = 0.5f * min(m_xmf3Scale.x, m_xmf3Scale.z);
+}
+
+UINT CCollisionWorld::AddCylinder(const XMFLOAT3& xmf3Base, float fRadius, float fHeight)
+{
+	COLLISION_CYLINDER xCylinder = { xmf3Base, fRadius, fHeight };
+	m_vCylinders.push_back(xCylinder);
+	return(UINT(m_vCylinders.size() - 1));
+}
+
+void CCollisionWorld::Build()
+{
+	m_xCylinderHierarchy.Clear();
+	for (UINT i = 0; i < UINT(m_vCylinders.size()); i++)
+	{
+		const COLLISION_CYLINDER& xCylinder = m_vCylinders[i];
+		XMFLOAT3 xmf3Min(xCylinder.m_xmf3Base.x - xCylinder.m_fRadius, xCylinder.m_xmf3Base.y, xCylinder.m_xmf3Base.z - xCylinder.m_fRadius);
+		XMFLOAT3 xmf3Max(xCylinder.m_xmf3Base.x + xCylinder.m_fRadius, xCylinder.m_xmf3Base.y + xCylinder.m_fHeight, xCylinder.m_xmf3Base.z + xCylinder.m_fRadius);
+		m_xCylinderHierarchy.Insert(xmf3Min, xmf3Max, i);
+	}
+	m_xCylinderHierarchy.Build();
+}
+
+void CCollisionWorld::Clear()
+{
+	m_pHeightMapImage = NULL;
+	m_vCylinders.clear();
+	m_xCylinderHierarchy.Clear();
+}
+
+float CCollisionWorld::GetTerrainHeight(float x, float z) const
+{
+	if ((x < 0.0f) || (z < 0.0f) || (x >= m_fMaxX + m_xmf3Scale.x) || (z >= m_fMaxZ + m_xmf3Scale.z)) return(0.0f);
+	x = min(x, m_fMaxX);
+	z = min(z, m_fMaxZ);
+	bool bReverseQuad = ((int(z / m_xmf3Scale.z) % 2) != 0);
+	return(m_pHeightMapImage->GetHeight(x, z, bReverseQuad) * m_xmf3Scale.y);
+}
+
+XMFLOAT3 CCollisionWorld::GetTerrainNormal(float x, float z) const
+{
+	float dx = m_xmf3Scale.x, dz = m_xmf3Scale.z;
+	float fSlopeX = (GetTerrainHeight(x + dx, z) - GetTerrainHeight(x - dx, z)) / (2.0f * dx);
+	float fSlopeZ = (GetTerrainHeight(x, z + dz) - GetTerrainHeight(x, z - dz)) / (2.0f * dz);
+	float fInverseLength = 1.0f / sqrtf((fSlopeX * fSlopeX) + 1.0f + (fSlopeZ * fSlopeZ));
+	return(XMFLOAT3(-fSlopeX * fInverseLength, fInverseLength, -fSlopeZ * fInverseLength));
+}
+
+bool CCollisionWorld::SweepTerrain(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit) const
+{
+	if (!m_pHeightMapImage) return(false);
+
+	// ĸ ٴڰ  Ʒ    (  Ʒ)
+	float fBottom = xCapsule.m_fHalfHeight + xCapsule.m_fRadius;
+	XMFLOAT3 xmf3Shift(xmf3End.x - xmf3Start.x, xmf3End.y - xmf3Start.y, xmf3End.z - xmf3Start.z);
+	auto Clearance = [&](float t)
+	{
+		return((xmf3Start.y + (xmf3Shift.y * t)) - fBottom - GetTerrainHeight(xmf3Start.x + (xmf3Shift.x * t), xmf3Start.z + (xmf3Shift.z * t)));
+	};
+	if (Clearance(0.0f) < 0.0f) return(false);
+
+	// ̴ XZ ġθ ٲǷ  ̵ Ÿ  .
+	int nSteps = int(ceilf(sqrtf((xmf3Shift.x * xmf3Shift.x) + (xmf3Shift.z * xmf3Shift.z)) / m_fTerrainStep));
+	if (nSteps < 1) nSteps = 1;
+	for (int i = 1; i <= nSteps; i++)
+	{
+		if (Clearance(float(i) / nSteps) >= 0.0f) continue;
+
+		//  (fFree) Ʒ(fBlocked) ̸ .
+		float fFree = float(i - 1) / nSteps, fBlocked = float(i) / nSteps;
+		for (int j = 0; j < COLLISION_TERRAIN_REFINES; j++)
+		{
+			float fMiddle = (fFree + fBlocked) * 0.5f;
+			if (Clearance(fMiddle) >= 0.0f) fFree = fMiddle; else fBlocked = fMiddle;
+		}
+
+		pHit->m_fTime = fFree;
+		pHit->m_xmf3Position = XMFLOAT3(xmf3Start.x + (xmf3Shift.x * fFree), xmf3Start.y + (xmf3Shift.y * fFree) + COLLISION_SKIN, xmf3Start.z + (xmf3Shift.z * fFree));
+		pHit->m_xmf3Normal = GetTerrainNormal(pHit->m_xmf3Position.x, pHit->m_xmf3Position.z);
+		pHit->m_nType = COLLISION_HIT_TERRAIN;
+		pHit->m_nCylinder = 0;
+		return(true);
+	}
+	return(false);
+}
+
+bool CCollisionWorld::SweepCylinders(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit, bool bBruteForce) const
+{
+	if (m_vCylinders.empty()) return(false);
+
+	XMFLOAT3 xmf3Shift(xmf3End.x - xmf3Start.x, xmf3End.y - xmf3Start.y, xmf3End.z - xmf3Start.z);
+	float fExtentY = xCapsule.m_fHalfHeight + xCapsule.m_fRadius;
+
+	vector<UINT>& vCandidates = m_pvCandidates[::gJobSystem.GetThreadIndex()];
+	vCandidates.clear();
+	if (bBruteForce)
+	{
+		for (UINT i = 0; i < UINT(m_vCylinders.size()); i++) vCandidates.push_back(i);
+	}
+	else
+	{
+		// ̵  ü δ ڿ ġ ٱ⸸ ˻Ѵ.
+		XMFLOAT3 xmf3Min(min(xmf3Start.x, xmf3End.x) - xCapsule.m_fRadius, min(xmf3Start.y, xmf3End.y) - fExtentY, min(xmf3Start.z, xmf3End.z) - xCapsule.m_fRadius);
+		XMFLOAT3 xmf3Max(max(xmf3Start.x, xmf3End.x) + xCapsule.m_fRadius, max(xmf3Start.y, xmf3End.y) + fExtentY, max(xmf3Start.z, xmf3End.z) + xCapsule.m_fRadius);
+		if (!m_xCylinderHierarchy.Overlap(xmf3Min, xmf3Max, vCandidates)) return(false);
+	}
+
+	// XZ 鿡 |(p0 + td) - c| = r1 + r2    t
+	float a = (xmf3Shift.x * xmf3Shift.x) + (xmf3Shift.z * xmf3Shift.z);
+	float fNearest = FLT_MAX;
+	UINT nNearest = 0;
+	for (UINT nCylinder : vCandidates)
+	{
+		const COLLISION_CYLINDER& xCylinder = m_vCylinders[nCylinder];
+		float mx = xmf3Start.x - xCylinder.m_xmf3Base.x, mz = xmf3Start.z - xCylinder.m_xmf3Base.z;
+		float fRadius = xCapsule.m_fRadius + xCylinder.m_fRadius;
+		float b = (mx * xmf3Shift.x) + (mz * xmf3Shift.z);
+		float c = (mx * mx) + (mz * mz) - (fRadius * fRadius);
+		if (b >= 0.0f) continue;		//־ 
+
+		float t = 0.0f;
+		if (c > 0.0f)
+		{
+			float fDiscriminant = (b * b) - (a * c);
+			if (fDiscriminant < 0.0f) continue;
+			t = (-b - sqrtf(fDiscriminant)) / a;
+			if (t > 1.0f) continue;
+		}
+		if (t >= fNearest) continue;
+
+		//   ηε ľ Ѵ.
+		float y = xmf3Start.y + (xmf3Shift.y * t);
+		if ((y + fExtentY < xCylinder.m_xmf3Base.y) || (y - fExtentY > xCylinder.m_xmf3Base.y + xCylinder.m_fHeight)) continue;
+
+		fNearest = t;
+		nNearest = nCylinder;
+	}
+	if (fNearest == FLT_MAX) return(false);
+
+	const COLLISION_CYLINDER& xCylinder = m_vCylinders[nNearest];
+	XMFLOAT3 xmf3Position(xmf3Start.x + (xmf3Shift.x * fNearest), xmf3Start.y + (xmf3Shift.y * fNearest), xmf3Start.z + (xmf3Shift.z * fNearest));
+	float nx = xmf3Position.x - xCylinder.m_xmf3Base.x, nz = xmf3Position.z - xCylinder.m_xmf3Base.z;
+	float fLength = sqrtf((nx * nx) + (nz * nz));
+	if (fLength > EPSILON) { nx /= fLength; nz /= fLength; } else { nx = -xmf3Shift.x / sqrtf(a); nz = -xmf3Shift.z / sqrtf(a); }
+
+	pHit->m_fTime = fNearest;
+	pHit->m_xmf3Position = XMFLOAT3(xmf3Position.x + (nx * COLLISION_SKIN), xmf3Position.y, xmf3Position.z + (nz * COLLISION_SKIN));
+	pHit->m_xmf3Normal = XMFLOAT3(nx, 0.0f, nz);
+	pHit->m_nType = COLLISION_HIT_CYLINDER;
+	pHit->m_nCylinder = nNearest;
+	return(true);
+}
+
+bool CCollisionWorld::SweepCapsule(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit) const
+{
+	COLLISION_HIT xTerrainHit, xCylinderHit;
+	bool bTerrainHit = SweepTerrain(xmf3Start, xmf3End, xCapsule, &xTerrainHit);
+	bool bCylinderHit = SweepCylinders(xmf3Start, xmf3End, xCapsule, &xCylinderHit, false);
+	if (!bTerrainHit && !bCylinderHit) return(false);
+
+	*pHit = (bTerrainHit && (!bCylinderHit || (xTerrainHit.m_fTime <= xCylinderHit.m_fTime))) ? xTerrainHit : xCylinderHit;
+	return(true);
+}
+
+UINT CCollisionWorld::MoveCapsule(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, XMFLOAT3 *pxmf3Position, XMFLOAT3 *pxmf3Normal) const
+{
+	XMFLOAT3 xmf3Position = xmf3Start, xmf3Target = xmf3End;
+	UINT nHits = 0;
+	COLLISION_HIT xHit;
+	for (int i = 0; i < COLLISION_MAX_SLIDES; i++)
+	{
+		if (!SweepCapsule(xmf3Position, xmf3Target, xCapsule, &xHit))
+		{
+			xmf3Position = xmf3Target;
+			break;
+		}
+		nHits++;
+		if (pxmf3Normal) *pxmf3Normal = xHit.m_xmf3Normal;
+		xmf3Position = xHit.m_xmf3Position;
+
+		//  ̵ ˸  ϴ   ٽ  .
+		XMFLOAT3 xmf3Remaining(xmf3Target.x - xmf3Position.x, xmf3Target.y - xmf3Position.y, xmf3Target.z - xmf3Position.z);
+		float fInto = (xmf3Remaining.x * xHit.m_xmf3Normal.x) + (xmf3Remaining.y * xHit.m_xmf3Normal.y) + (xmf3Remaining.z * xHit.m_xmf3Normal.z);
+		if (fInto < 0.0f)
+		{
+			xmf3Remaining.x -= xHit.m_xmf3Normal.x * fInto;
+			xmf3Remaining.y -= xHit.m_xmf3Normal.y * fInto;
+			xmf3Remaining.z -= xHit.m_xmf3Normal.z * fInto;
+		}
+		if (((xmf3Remaining.x * xmf3Remaining.x) + (xmf3Remaining.y * xmf3Remaining.y) + (xmf3Remaining.z * xmf3Remaining.z)) < (COLLISION_SKIN * COLLISION_SKIN)) break;
+		xmf3Target = XMFLOAT3(xmf3Position.x + xmf3Remaining.x, xmf3Position.y + xmf3Remaining.y, xmf3Position.z + xmf3Remaining.z);
+	}
+
+	//   ̹  Ʒ ٴ   ø.
+	if (m_pHeightMapImage)
+	{
+		float fGround = GetTerrainHeight(xmf3Position.x, xmf3Position.z) + xCapsule.m_fHalfHeight + xCapsule.m_fRadius;
+		if (xmf3Position.y < fGround)
+		{
+			xmf3Position.y = fGround;
+			if (pxmf3Normal) *pxmf3Normal = GetTerrainNormal(xmf3Position.x, xmf3Position.z);
+			nHits++;
+		}
+	}
+
+	*pxmf3Position = xmf3Position;
+	return(nHits);
+}
+
+void CCollisionWorld::RunBenchmark(LPCTSTR pszFileName, UINT nAgents)
+{
+	if (!m_pHeightMapImage) return;
+
+	const UINT nSteps = 240;
+	const float fTimeStep = 1.0f / 60.0f;
+	const UINT nVerifySweeps = 1 << 14;
+	const COLLISION_CAPSULE xCapsule = { 3.0f, 3.0f };
+	float fBottom = xCapsule.m_fHalfHeight + xCapsule.m_fRadius;
+
+	srand(41);
+
+	//  ܿ    ĭ   δ.
+	auto IsInsideCylinder = [&](float x, float z)
+	{
+		for (const COLLISION_CYLINDER& xCylinder : m_vCylinders)
+		{
+			float dx = x - xCylinder.m_xmf3Base.x, dz = z - xCylinder.m_xmf3Base.z, fRadius = xCapsule.m_fRadius + xCylinder.m_fRadius;
+			if ((dx * dx) + (dz * dz) < (fRadius * fRadius)) return(true);
+		}
+		return(false);
+	};
+	vector<XMFLOAT3> vxmf3StartPositions(nAgents), vxmf3StartVelocities(nAgents);
+	for (UINT i = 0; i < nAgents; i++)
+	{
+		float x, z;
+		do { x = RandomFloat(0.0f, m_fMaxX); z = RandomFloat(0.0f, m_fMaxZ); } while (IsInsideCylinder(x, z));
+		vxmf3StartPositions[i] = XMFLOAT3(x, GetTerrainHeight(x, z) + fBottom + RandomFloat(0.0f, 20.0f), z);
+		float fYaw = RandomFloat(0.0f, XM_2PI), fSpeed = RandomFloat(50.0f, 600.0f);
+		vxmf3StartVelocities[i] = XMFLOAT3(sinf(fYaw) * fSpeed, RandomFloat(-50.0f, 50.0f), cosf(fYaw) * fSpeed);
+	}
+	vector<XMFLOAT3> vxmf3Positions, vxmf3Velocities;
+	std::atomic<UINT> nContacts;
+
+	auto Simulate = [&](UINT nBegin, UINT nEnd)
+	{
+		UINT nBlocked = 0;
+		for (UINT i = nBegin; i < nEnd; i++)
+		{
+			XMFLOAT3& xmf3Position = vxmf3Positions[i];
+			XMFLOAT3& xmf3Velocity = vxmf3Velocities[i];
+			XMFLOAT3 xmf3End(xmf3Position.x + (xmf3Velocity.x * fTimeStep), xmf3Position.y + (xmf3Velocity.y * fTimeStep), xmf3Position.z + (xmf3Velocity.z * fTimeStep));
+			XMFLOAT3 xmf3Normal;
+			if (MoveCapsule(xmf3Position, xmf3End, xCapsule, &xmf3Position, &xmf3Normal))
+			{
+				//  鿡  ݻؼ  ε Ѵ.
+				float fInto = (xmf3Velocity.x * xmf3Normal.x) + (xmf3Velocity.y * xmf3Normal.y) + (xmf3Velocity.z * xmf3Normal.z);
+				if (fInto < 0.0f)
+				{
+					xmf3Velocity.x -= 2.0f * fInto * xmf3Normal.x;
+					xmf3Velocity.y -= 2.0f * fInto * xmf3Normal.y;
+					xmf3Velocity.z -= 2.0f * fInto * xmf3Normal.z;
+				}
+				nBlocked++;
+			}
+			//    ǵ.
+			if ((xmf3Position.x < 0.0f) || (xmf3Position.x > m_fMaxX)) xmf3Velocity.x = -xmf3Velocity.x;
+			if ((xmf3Position.z < 0.0f) || (xmf3Position.z > m_fMaxZ)) xmf3Velocity.z = -xmf3Velocity.z;
+		}
+		nContacts += nBlocked;
+	};
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+	TCHAR pstrReport[160];
+	auto Report = [&]()
+	{
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+	};
+	auto Elapsed = [](std::chrono::high_resolution_clock::time_point tStart)
+	{
+		return(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count());
+	};
+
+	_stprintf_s(pstrReport, 160, _T("Agents: %u  Steps: %u  Cylinders: %u  Terrain step: %.2f\n"), nAgents, nSteps, GetCylinders(), m_fTerrainStep);
+	Report();
+
+	//  
+	vxmf3Positions = vxmf3StartPositions;
+	vxmf3Velocities = vxmf3StartVelocities;
+	nContacts = 0;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nSteps; i++) Simulate(0, nAgents);
+	double fSingleTime = Elapsed(tStart);
+	UINT nSingleContacts = nContacts;
+
+	// ۾ ý (ܸ Ʈ  óѴ)
+	vxmf3Positions = vxmf3StartPositions;
+	vxmf3Velocities = vxmf3StartVelocities;
+	nContacts = 0;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nSteps; i++) ::gJobSystem.ParallelFor(nAgents, 32, Simulate);
+	double fParallelTime = Elapsed(tStart);
+
+	double fMoves = double(nAgents) * nSteps;
+	_stprintf_s(pstrReport, 160, _T("Move (1 thread):   %8.3f ms  %10.0f moves/s  %6.1f us/frame  contacts %u\n"), fSingleTime, fMoves * 1000.0 / fSingleTime, fSingleTime * 1000.0 / nSteps, nSingleContacts);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Move (%d threads): %8.3f ms  %10.0f moves/s  %6.1f us/frame  contacts %u\n"), ::gJobSystem.GetActiveThreads(), fParallelTime, fMoves * 1000.0 / fParallelTime, fParallelTime * 1000.0 / nSteps, UINT(nContacts));
+	Report();
+
+	//   ڿ  Ʒ ٱ ȿ  ĸ  Ѵ.
+	UINT nTerrainPenetrations = 0, nCylinderPenetrations = 0;
+	for (UINT i = 0; i < nAgents; i++)
+	{
+		const XMFLOAT3& xmf3Position = vxmf3Positions[i];
+		if (xmf3Position.y - fBottom < GetTerrainHeight(xmf3Position.x, xmf3Position.z) - 0.05f) nTerrainPenetrations++;
+		for (const COLLISION_CYLINDER& xCylinder : m_vCylinders)
+		{
+			float dx = xmf3Position.x - xCylinder.m_xmf3Base.x, dz = xmf3Position.z - xCylinder.m_xmf3Base.z;
+			float fRadius = xCapsule.m_fRadius + xCylinder.m_fRadius - 0.05f;
+			if (((dx * dx) + (dz * dz) < (fRadius * fRadius)) && (xmf3Position.y + fBottom >= xCylinder.m_xmf3Base.y) && (xmf3Position.y - fBottom <= xCylinder.m_xmf3Base.y + xCylinder.m_fHeight)) nCylinderPenetrations++;
+		}
+	}
+	_stprintf_s(pstrReport, 160, _T("Penetrations: terrain %u  cylinders %u\n"), nTerrainPenetrations, nCylinderPenetrations);
+	Report();
+
+	//   ĺ  ˻  ƾ Ѵ.
+	vector<XMFLOAT3> vxmf3Starts(nVerifySweeps), vxmf3Ends(nVerifySweeps);
+	for (UINT i = 0; i < nVerifySweeps; i++)
+	{
+		float x = RandomFloat(0.0f, m_fMaxX), z = RandomFloat(0.0f, m_fMaxZ);
+		vxmf3Starts[i] = XMFLOAT3(x, GetTerrainHeight(x, z) + fBottom + RandomFloat(0.0f, 40.0f), z);
+		vxmf3Ends[i] = XMFLOAT3(x + RandomFloat(-200.0f, 200.0f), vxmf3Starts[i].y + RandomFloat(-20.0f, 20.0f), z + RandomFloat(-200.0f, 200.0f));
+	}
+	vector<COLLISION_HIT> vHits(nVerifySweeps);
+	vector<bool> vbHits(nVerifySweeps);
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nVerifySweeps; i++) vbHits[i] = SweepCylinders(vxmf3Starts[i], vxmf3Ends[i], xCapsule, &vHits[i], false);
+	double fIndexTime = Elapsed(tStart);
+
+	UINT nHits = 0, nMismatches = 0;
+	COLLISION_HIT xHit;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (UINT i = 0; i < nVerifySweeps; i++)
+	{
+		bool bHit = SweepCylinders(vxmf3Starts[i], vxmf3Ends[i], xCapsule, &xHit, true);
+		if (bHit) nHits++;
+		if ((bHit != vbHits[i]) || (bHit && ((xHit.m_nCylinder != vHits[i].m_nCylinder) || (xHit.m_fTime != vHits[i].m_fTime)))) nMismatches++;
+	}
+	double fBruteForceTime = Elapsed(tStart);
+
+	_stprintf_s(pstrReport, 160, _T("Cylinder sweep (BVH):         %8.3f ms  %10.0f sweeps/s\n"), fIndexTime, nVerifySweeps * 1000.0 / fIndexTime);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Cylinder sweep (brute force): %8.3f ms  %10.0f sweeps/s\n"), fBruteForceTime, nVerifySweeps * 1000.0 / fBruteForceTime);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Sweeps: %u  Hits: %u  Mismatches: %u\n"), nVerifySweeps, nHits, nMismatches);
+	Report();
+
+	bool bPassed = (nMismatches == 0) && (nTerrainPenetrations == 0) && (nCylinderPenetrations == 0);
+	_stprintf_s(pstrReport, 160, _T("Collision test %s\n"), bPassed ? _T("PASSED") : _T("FAILED"));
+	Report();
+
+	if (pFile) fclose(pFile);
+}
@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// File: Collision.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BoundingVolumeHierarchy.h"
+
+#define COLLISION_MAX_SLIDES		4			//  ̵ ˸  ̲ ִ Ƚ
+#define COLLISION_SKIN				0.01f		// 鿡  δ Ÿ
+#define COLLISION_TERRAIN_REFINES	8			//  ð ̺й  Ƚ
+#define COLLISION_MAX_THREADS		64			//MAX_JOB_WORKERS
+
+#define COLLISION_HIT_NONE			0
+#define COLLISION_HIT_TERRAIN		1
+#define COLLISION_HIT_CYLINDER		2
+
+class CHeightMapImage;
+
+// η  ĸ. ߽ɿ Ʒ m_fHalfHeight ŭ  m_fRadius Ѵ. (m_fHalfHeight 0̸ )
+struct COLLISION_CAPSULE
+{
+	float							m_fRadius;
+	float							m_fHalfHeight;
+};
+
+// η   ( ٱ)
+struct COLLISION_CYLINDER
+{
+	XMFLOAT3						m_xmf3Base;
+	float							m_fRadius;
+	float							m_fHeight;
+};
+
+struct COLLISION_HIT
+{
+	float							m_fTime;			//̵  ó   [0, 1]
+	XMFLOAT3						m_xmf3Position;		//  ĸ ߽
+	XMFLOAT3						m_xmf3Normal;
+	UINT							m_nType;			//COLLISION_HIT_TERRAIN, ...
+	UINT							m_nCylinder;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//     ٱ տ  ĸ (sweep) 浹.
+//  ̵ θ     Ϸ  ĸ ٴ  Ʒ  ù  ã,
+//     ̵ θ  ڿ ġ ͸ Ƽ XZ    ˻Ѵ.
+//  Լ ¸ ٲ Ƿ  ۾ 忡 ÿ ҷ ȴ. (ĺ 迭 帶  )
+class CCollisionWorld
+{
+public:
+	CCollisionWorld();
+	~CCollisionWorld();
+
+private:
+	CHeightMapImage					*m_pHeightMapImage = NULL;
+	XMFLOAT3						m_xmf3Scale = XMFLOAT3(1.0f, 1.0f, 1.0f);
+	float							m_fMaxX = 0.0f;
+	float							m_fMaxZ = 0.0f;
+	float							m_fTerrainStep = 1.0f;
+
+	vector<COLLISION_CYLINDER>		m_vCylinders;
+	CBoundingVolumeHierarchy		m_xCylinderHierarchy;
+
+	mutable vector<UINT>			m_pvCandidates[COLLISION_MAX_THREADS];
+
+	float GetTerrainHeight(float x, float z) const;
+	XMFLOAT3 GetTerrainNormal(float x, float z) const;
+
+	bool SweepTerrain(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit) const;
+	// bBruteForce̸   ʰ   ˻Ѵ. (ġũ  )
+	bool SweepCylinders(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit, bool bBruteForce) const;
+
+public:
+	void SetTerrain(CHeightMapImage *pHeightMapImage);
+	UINT AddCylinder(const XMFLOAT3& xmf3Base, float fRadius, float fHeight);
+	//       ȣѴ.
+	void Build();
+	void Clear();
+
+	UINT GetCylinders() { return(UINT(m_vCylinders.size())); }
+	const COLLISION_CYLINDER& GetCylinder(UINT nCylinder) { return(m_vCylinders[nCylinder]); }
+
+	// ĸ ߽ xmf3Start xmf3End ű      ã´.
+	//   ̹  Ʒ   Ѵ. (MoveCapsule()  ø)
+	bool SweepCapsule(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, COLLISION_HIT *pHit) const;
+	//   ̵ ˸鿡 ؼ ̲ ű.  ġ pxmf3Position,  ˸  pxmf3Normal   Ƚ ش.
+	UINT MoveCapsule(const XMFLOAT3& xmf3Start, const XMFLOAT3& xmf3End, const COLLISION_CAPSULE& xCapsule, XMFLOAT3 *pxmf3Position, XMFLOAT3 *pxmf3Normal = NULL) const;
+
+	// nAgents ĸ       ʴ ̵  ( , ۾ ý) 
+	//   ˻  ϸ ̳ ٱ⸦ հ  ĸ   ϰ  ¿ .
+	void RunBenchmark(LPCTSTR pszFileName, UINT nAgents);
+};
@@ -0,0 +1,62 @@
+//-----------------------------------------------------------------------------
+// File: DeferredDeletion.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DeferredDeletion.h"
+
+CDeferredDeletionQueue gDeferredDeletionQueue;
+
+CDeferredDeletionQueue::CDeferredDeletionQueue()
+{
+	m_nCurrentFrame = 0;
+}
+
+CDeferredDeletionQueue::~CDeferredDeletionQueue()
+{
+}
+
+void CDeferredDeletionQueue::Push(void *pObject, DEFERRED_DELETE_FUNCTION pfnDelete)
+{
+	DEFERRED_DELETION xDeletion = { pObject, pfnDelete, m_nCurrentFrame.load() };
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_vPending.push_back(xDeletion);
+	m_nDeferredObjects++;
+}
+
+void CDeferredDeletionQueue::Collect(UINT64 nCompletedFrame)
+{
+	vector<DEFERRED_DELETION> vDeletions;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_vPending.empty()) return;
+
+		//   ִ ͸ . (Ҹ ȿ Push() ٽ θ  Ƿ  ۿ )
+		size_t nKept = 0;
+		for (size_t i = 0; i < m_vPending.size(); i++)
+		{
+			if (m_vPending[i].m_nFrame <= nCompletedFrame)
+				vDeletions.push_back(m_vPending[i]);
+			else
+				m_vPending[nKept++] = m_vPending[i];
+		}
+		m_vPending.resize(nKept);
+	}
+
+	for (size_t i = 0; i < vDeletions.size(); i++) (vDeletions[i].m_pfnDelete)(vDeletions[i].m_pObject);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_nDeletedObjects += UINT(vDeletions.size());
+}
+
+void CDeferredDeletionQueue::Flush()
+{
+	while (GetPendingObjects() > 0) Collect(UINT64(-1));
+}
+
+UINT CDeferredDeletionQueue::GetPendingObjects()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return(UINT(m_vPending.size()));
+}
@@ -0,0 +1,54 @@
+//-----------------------------------------------------------------------------
+// File: DeferredDeletion.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+typedef void (*DEFERRED_DELETE_FUNCTION)(void *pObject);
+
+struct DEFERRED_DELETION
+{
+	void							*m_pObject;
+	DEFERRED_DELETE_FUNCTION		m_pfnDelete;
+	UINT64							m_nFrame;		//   (  GPU ۾    ִ)
+};
+
+template <class T> void DeleteDeferredObject(void *pObject) { delete (T *)pObject; }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  īƮ 0  ü ٷ  ʰ  ξٰ,  ü   ־  GPU ۾  ڿ  忡 .
+// Push()  忡 ȣ  ִ.
+class CDeferredDeletionQueue
+{
+public:
+	CDeferredDeletionQueue();
+	~CDeferredDeletionQueue();
+
+private:
+	std::mutex						m_Mutex;
+	vector<DEFERRED_DELETION>		m_vPending;
+
+	std::atomic<UINT64>				m_nCurrentFrame;
+
+	UINT							m_nDeferredObjects = 0;
+	UINT							m_nDeletedObjects = 0;
+
+public:
+	void Push(void *pObject, DEFERRED_DELETE_FUNCTION pfnDelete);
+
+	//    ϱ  ȣϰ   ȣ ش.
+	UINT64 BeginFrame() { return(++m_nCurrentFrame); }
+	UINT64 GetCurrentFrame() { return(m_nCurrentFrame.load()); }
+
+	// nCompletedFrame GPU ۾   ȣѴ.  ̿   ü .
+	void Collect(UINT64 nCompletedFrame);
+	// GPU  ()  ü  . Ҹڰ ٽ   ü .
+	void Flush();
+
+	UINT GetPendingObjects();
+	UINT GetDeferredObjects() { return(m_nDeferredObjects); }
+	UINT GetDeletedObjects() { return(m_nDeletedObjects); }
+	void ResetCounters() { m_nDeferredObjects = 0; m_nDeletedObjects = 0; }
+};
+
+extern CDeferredDeletionQueue gDeferredDeletionQueue;
@@ -0,0 +1,397 @@
+//-----------------------------------------------------------------------------
+// File: Entity.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Entity.h"
+#include "Shader.h"
+#include "RenderQueue.h"
+#include "JobSystem.h"
+
+CEntityManager gEntityManager;
+
+UINT CArchetype::AddRow(ENTITY nEntity)
+{
+	m_vEntities.push_back(nEntity);
+	if (m_nSignature & COMPONENT_TRANSFORM) m_vTransforms.push_back(TRANSFORM_HANDLE_NULL);
+	if (m_nSignature & COMPONENT_MESH) m_vMeshes.push_back(MESH_COMPONENT());
+	if (m_nSignature & COMPONENT_MATERIAL) m_vMaterials.push_back(MATERIAL_COMPONENT());
+	if (m_nSignature & COMPONENT_ROTATION) m_vRotations.push_back(ROTATION_COMPONENT());
+	if (m_nSignature & COMPONENT_REVOLUTION) m_vRevolutions.push_back(REVOLUTION_COMPONENT());
+	if (m_nSignature & COMPONENT_BILLBOARD) m_vBillboards.push_back(BILLBOARD_COMPONENT());
+
+	return(UINT(m_vEntities.size() - 1));
+}
+
+template <typename T>
+static void SwapRemove(vector<T>& vComponents, UINT nRow)
+{
+	if (vComponents.empty()) return;
+	vComponents[nRow] = vComponents.back();
+	vComponents.pop_back();
+}
+
+ENTITY CArchetype::RemoveRow(UINT nRow)
+{
+	UINT nLastRow = UINT(m_vEntities.size() - 1);
+	ENTITY nMovedEntity = (nRow != nLastRow) ? m_vEntities[nLastRow] : ENTITY_NULL;
+
+	SwapRemove(m_vEntities, nRow);
+	SwapRemove(m_vTransforms, nRow);
+	SwapRemove(m_vMeshes, nRow);
+	SwapRemove(m_vMaterials, nRow);
+	SwapRemove(m_vRotations, nRow);
+	SwapRemove(m_vRevolutions, nRow);
+	SwapRemove(m_vBillboards, nRow);
+
+	return(nMovedEntity);
+}
+
+void CArchetype::CopyRow(CArchetype *pSource, UINT nSourceRow, UINT nRow)
+{
+	UINT nComponents = m_nSignature & pSource->m_nSignature;
+	if (nComponents & COMPONENT_TRANSFORM) m_vTransforms[nRow] = pSource->m_vTransforms[nSourceRow];
+	if (nComponents & COMPONENT_MESH) m_vMeshes[nRow] = pSource->m_vMeshes[nSourceRow];
+	if (nComponents & COMPONENT_MATERIAL) m_vMaterials[nRow] = pSource->m_vMaterials[nSourceRow];
+	if (nComponents & COMPONENT_ROTATION) m_vRotations[nRow] = pSource->m_vRotations[nSourceRow];
+	if (nComponents & COMPONENT_REVOLUTION) m_vRevolutions[nRow] = pSource->m_vRevolutions[nSourceRow];
+	if (nComponents & COMPONENT_BILLBOARD) m_vBillboards[nRow] = pSource->m_vBillboards[nSourceRow];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+CEntityManager::CEntityManager()
+{
+}
+
+CEntityManager::~CEntityManager()
+{
+	//  ü Ҹ    Ƿ ⼭ ȯ Ҹ ǵ帮 ʴ´.
+	// (Ƽ  ʿ ReleaseObjects()  )
+	for (size_t i = 0; i < m_vArchetypes.size(); i++) delete m_vArchetypes[i];
+}
+
+CArchetype *CEntityManager::FindArchetype(UINT nSignature)
+{
+	for (size_t i = 0; i < m_vArchetypes.size(); i++)
+	{
+		if (m_vArchetypes[i]->m_nSignature == nSignature) return(m_vArchetypes[i]);
+	}
+	CArchetype *pArchetype = new CArchetype(nSignature);
+	m_vArchetypes.push_back(pArchetype);
+	return(pArchetype);
+}
+
+bool CEntityManager::IsAlive(ENTITY nEntity)
+{
+	if (nEntity == ENTITY_NULL) return(false);
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	if (nIndex >= m_vEntityArchetypes.size()) return(false);
+	return(m_vEntityArchetypes[nIndex] && (m_vGenerations[nIndex] == (nEntity >> ENTITY_INDEX_BITS)));
+}
+
+ENTITY CEntityManager::CreateEntity(UINT nSignature, TRANSFORM_HANDLE hTransform)
+{
+	UINT nIndex;
+	if (!m_vFreeIndices.empty())
+	{
+		nIndex = m_vFreeIndices.back();
+		m_vFreeIndices.pop_back();
+	}
+	else
+	{
+		nIndex = UINT(m_vEntityArchetypes.size());
+		m_vEntityArchetypes.push_back(NULL);
+		m_vEntityRows.push_back(0);
+		m_vGenerations.push_back(0);
+	}
+	ENTITY nEntity = (UINT(m_vGenerations[nIndex]) << ENTITY_INDEX_BITS) | nIndex;
+
+	CArchetype *pArchetype = FindArchetype(nSignature);
+	UINT nRow = pArchetype->AddRow(nEntity);
+	m_vEntityArchetypes[nIndex] = pArchetype;
+	m_vEntityRows[nIndex] = nRow;
+
+	if (nSignature & COMPONENT_TRANSFORM) pArchetype->m_vTransforms[nRow] = (hTransform != TRANSFORM_HANDLE_NULL) ? hTransform : ::gTransformStorage.Allocate();
+
+	return(nEntity);
+}
+
+void CEntityManager::ReleaseComponents(CArchetype *pArchetype, UINT nRow, UINT nComponents)
+{
+	nComponents &= pArchetype->m_nSignature;
+	if (nComponents & COMPONENT_TRANSFORM)
+	{
+		::gTransformStorage.Free(pArchetype->m_vTransforms[nRow]);
+		pArchetype->m_vTransforms[nRow] = TRANSFORM_HANDLE_NULL;
+	}
+	if (nComponents & COMPONENT_MESH)
+	{
+		if (pArchetype->m_vMeshes[nRow].m_pMesh) pArchetype->m_vMeshes[nRow].m_pMesh->Release();
+		pArchetype->m_vMeshes[nRow].m_pMesh = NULL;
+	}
+	if (nComponents & COMPONENT_MATERIAL)
+	{
+		if (pArchetype->m_vMaterials[nRow].m_pMaterial) pArchetype->m_vMaterials[nRow].m_pMaterial->Release();
+		pArchetype->m_vMaterials[nRow].m_pMaterial = NULL;
+	}
+}
+
+void CEntityManager::MoveEntity(ENTITY nEntity, UINT nSignature)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pSource = m_vEntityArchetypes[nIndex];
+	UINT nSourceRow = m_vEntityRows[nIndex];
+	if (pSource->m_nSignature == nSignature) return;
+
+	CArchetype *pArchetype = FindArchetype(nSignature);
+	UINT nRow = pArchetype->AddRow(nEntity);
+	pArchetype->CopyRow(pSource, nSourceRow, nRow);
+
+	ENTITY nMovedEntity = pSource->RemoveRow(nSourceRow);
+	if (nMovedEntity != ENTITY_NULL) m_vEntityRows[nMovedEntity & ENTITY_INDEX_MASK] = nSourceRow;
+
+	m_vEntityArchetypes[nIndex] = pArchetype;
+	m_vEntityRows[nIndex] = nRow;
+}
+
+void CEntityManager::DestroyEntity(ENTITY nEntity)
+{
+	if (!IsAlive(nEntity)) return;
+
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	UINT nRow = m_vEntityRows[nIndex];
+
+	ReleaseComponents(pArchetype, nRow, pArchetype->m_nSignature);
+
+	ENTITY nMovedEntity = pArchetype->RemoveRow(nRow);
+	if (nMovedEntity != ENTITY_NULL) m_vEntityRows[nMovedEntity & ENTITY_INDEX_MASK] = nRow;
+
+	m_vEntityArchetypes[nIndex] = NULL;
+	m_vGenerations[nIndex] = (m_vGenerations[nIndex] + 1) & ENTITY_GENERATION_MASK;
+	m_vFreeIndices.push_back(nIndex);
+}
+
+void CEntityManager::DestroyAllEntities()
+{
+	for (size_t i = 0; i < m_vArchetypes.size(); i++)
+	{
+		CArchetype *pArchetype = m_vArchetypes[i];
+		while (pArchetype->GetRows() > 0) DestroyEntity(pArchetype->m_vEntities.back());
+	}
+}
+
+void CEntityManager::AddComponents(ENTITY nEntity, UINT nComponents)
+{
+	if (!IsAlive(nEntity)) return;
+
+	UINT nSignature = GetSignature(nEntity);
+	UINT nAdded = nComponents & ~nSignature;
+	if (!nAdded) return;
+
+	MoveEntity(nEntity, nSignature | nAdded);
+
+	if (nAdded & COMPONENT_TRANSFORM)
+	{
+		UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+		m_vEntityArchetypes[nIndex]->m_vTransforms[m_vEntityRows[nIndex]] = ::gTransformStorage.Allocate();
+	}
+}
+
+void CEntityManager::RemoveComponents(ENTITY nEntity, UINT nComponents)
+{
+	if (!IsAlive(nEntity)) return;
+
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	UINT nSignature = GetSignature(nEntity);
+	UINT nRemoved = nComponents & nSignature;
+	if (!nRemoved) return;
+
+	ReleaseComponents(m_vEntityArchetypes[nIndex], m_vEntityRows[nIndex], nRemoved);
+	MoveEntity(nEntity, nSignature & ~nRemoved);
+}
+
+TRANSFORM_HANDLE CEntityManager::GetTransform(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_TRANSFORM) ? pArchetype->m_vTransforms[m_vEntityRows[nIndex]] : TRANSFORM_HANDLE_NULL);
+}
+
+MESH_COMPONENT *CEntityManager::GetMesh(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_MESH) ? &pArchetype->m_vMeshes[m_vEntityRows[nIndex]] : NULL);
+}
+
+MATERIAL_COMPONENT *CEntityManager::GetMaterial(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_MATERIAL) ? &pArchetype->m_vMaterials[m_vEntityRows[nIndex]] : NULL);
+}
+
+ROTATION_COMPONENT *CEntityManager::GetRotation(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_ROTATION) ? &pArchetype->m_vRotations[m_vEntityRows[nIndex]] : NULL);
+}
+
+REVOLUTION_COMPONENT *CEntityManager::GetRevolution(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_REVOLUTION) ? &pArchetype->m_vRevolutions[m_vEntityRows[nIndex]] : NULL);
+}
+
+BILLBOARD_COMPONENT *CEntityManager::GetBillboard(ENTITY nEntity)
+{
+	UINT nIndex = nEntity & ENTITY_INDEX_MASK;
+	CArchetype *pArchetype = m_vEntityArchetypes[nIndex];
+	return((pArchetype->m_nSignature & COMPONENT_BILLBOARD) ? &pArchetype->m_vBillboards[m_vEntityRows[nIndex]] : NULL);
+}
+
+void CEntityManager::SetMesh(ENTITY nEntity, CMesh *pMesh)
+{
+	MESH_COMPONENT *pComponent = GetMesh(nEntity);
+	if (!pComponent) return;
+
+	if (pMesh) pMesh->AddRef();
+	if (pComponent->m_pMesh) pComponent->m_pMesh->Release();
+	pComponent->m_pMesh = pMesh;
+}
+
+void CEntityManager::SetMaterial(ENTITY nEntity, CMaterial *pMaterial, CShader *pShader, UINT nConstantBufferIndex, UINT nRenderPass)
+{
+	MATERIAL_COMPONENT *pComponent = GetMaterial(nEntity);
+	if (!pComponent) return;
+
+	if (pMaterial) pMaterial->AddRef();
+	if (pComponent->m_pMaterial) pComponent->m_pMaterial->Release();
+	pComponent->m_pMaterial = pMaterial;
+	pComponent->m_pShader = pShader;
+	pComponent->m_nConstantBufferIndex = nConstantBufferIndex;
+	pComponent->m_nRenderPass = nRenderPass;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+void RotationSystem(CEntityManager *pEntityManager, float fTimeElapsed)
+{
+	for (int i = 0; i < pEntityManager->GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = pEntityManager->GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_TRANSFORM | COMPONENT_ROTATION)) continue;
+
+		TRANSFORM_HANDLE *phTransforms = pArchetype->m_vTransforms.data();
+		ROTATION_COMPONENT *pRotations = pArchetype->m_vRotations.data();
+		::gJobSystem.ParallelFor(pArchetype->GetRows(), ENTITY_SYSTEM_GRAIN, [=](UINT nBegin, UINT nEnd)
+		{
+			for (UINT j = nBegin; j < nEnd; j++)
+			{
+				XMMATRIX mtxRotate = XMMatrixRotationAxis(XMLoadFloat3(&pRotations[j].m_xmf3Axis), XMConvertToRadians(pRotations[j].m_fSpeed * fTimeElapsed));
+				::gTransformStorage.PreMultiply(phTransforms[j], mtxRotate);
+			}
+		});
+	}
+}
+
+void RevolutionSystem(CEntityManager *pEntityManager, float fTimeElapsed)
+{
+	for (int i = 0; i < pEntityManager->GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = pEntityManager->GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_TRANSFORM | COMPONENT_REVOLUTION)) continue;
+
+		TRANSFORM_HANDLE *phTransforms = pArchetype->m_vTransforms.data();
+		REVOLUTION_COMPONENT *pRevolutions = pArchetype->m_vRevolutions.data();
+		::gJobSystem.ParallelFor(pArchetype->GetRows(), ENTITY_SYSTEM_GRAIN, [=](UINT nBegin, UINT nEnd)
+		{
+			for (UINT j = nBegin; j < nEnd; j++)
+			{
+				XMMATRIX mtxRotate = XMMatrixRotationAxis(XMLoadFloat3(&pRevolutions[j].m_xmf3Axis), XMConvertToRadians(pRevolutions[j].m_fSpeed * fTimeElapsed));
+				::gTransformStorage.PostMultiply(phTransforms[j], mtxRotate);
+			}
+		});
+	}
+}
+
+void BillboardSystem(CEntityManager *pEntityManager, const XMFLOAT3& xmf3CameraPosition)
+{
+	for (int i = 0; i < pEntityManager->GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = pEntityManager->GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_TRANSFORM | COMPONENT_BILLBOARD)) continue;
+
+		TRANSFORM_HANDLE *phTransforms = pArchetype->m_vTransforms.data();
+		BILLBOARD_COMPONENT *pBillboards = pArchetype->m_vBillboards.data();
+		XMFLOAT3 xmf3Target = xmf3CameraPosition;
+		::gJobSystem.ParallelFor(pArchetype->GetRows(), ENTITY_SYSTEM_GRAIN, [=](UINT nBegin, UINT nEnd)
+		{
+			for (UINT j = nBegin; j < nEnd; j++)
+			{
+				// CGameObject::SetLookAt()  
+				XMFLOAT3 xmf3Position = ::gTransformStorage.GetPosition(phTransforms[j]);
+				XMFLOAT3 xmf3Look = Vector3::Subtract(xmf3Target, xmf3Position);
+				XMFLOAT3 xmf3Right = Vector3::CrossProduct(pBillboards[j].m_xmf3Up, xmf3Look, true);
+				::gTransformStorage.SetRotation(phTransforms[j], xmf3Right, pBillboards[j].m_xmf3Up, xmf3Look);
+			}
+		});
+	}
+}
+
+void RenderSystem(CEntityManager *pEntityManager, CRenderQueue *pRenderQueue, CCamera *pCamera)
+{
+	XMFLOAT3 xmf3CameraPosition = (pCamera) ? pCamera->GetPosition() : XMFLOAT3(0.0f, 0.0f, 0.0f);
+	const XMFLOAT4X4 *pxmf4x4Worlds = ::gTransformStorage.GetWorldMatrices();
+
+	for (int i = 0; i < pEntityManager->GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = pEntityManager->GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_RENDERABLE)) continue;
+
+		TRANSFORM_HANDLE *phTransforms = pArchetype->m_vTransforms.data();
+		MESH_COMPONENT *pMeshes = pArchetype->m_vMeshes.data();
+		MATERIAL_COMPONENT *pMaterials = pArchetype->m_vMaterials.data();
+		for (UINT j = 0; j < pArchetype->GetRows(); j++)
+		{
+			if (!pMeshes[j].m_pMesh) continue;
+
+			const XMFLOAT4X4& xmf4x4World = pxmf4x4Worlds[::gTransformStorage.GetIndex(phTransforms[j])];
+			XMFLOAT3 xmf3ToCamera = XMFLOAT3(xmf4x4World._41 - xmf3CameraPosition.x, xmf4x4World._42 - xmf3CameraPosition.y, xmf4x4World._43 - xmf3CameraPosition.z);
+			float fDepth = Vector3::Length(xmf3ToCamera);
+
+			MATERIAL_COMPONENT *pMaterial = &pMaterials[j];
+			CShader *pShader = (pMaterial->m_pMaterial && pMaterial->m_pMaterial->m_pShader) ? pMaterial->m_pMaterial->m_pShader : pMaterial->m_pShader;
+			CTexture *pTexture = (pMaterial->m_pMaterial) ? pMaterial->m_pMaterial->m_pTexture : NULL;
+			D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject = (pMaterial->m_pShader) ? pMaterial->m_pShader->GetObjectConstantBuffer(pMaterial->m_nConstantBufferIndex) : 0;
+			pRenderQueue->Submit(pMaterial->m_nRenderPass, pShader, pTexture, pMeshes[j].m_pMesh, d3dcbGameObject, fDepth);
+		}
+	}
+}
+
+void RenderSystem(CEntityManager *pEntityManager, CRenderQueue *pRenderQueue, CCamera *pCamera, const ENTITY *pnEntities, UINT nEntities)
+{
+	XMFLOAT3 xmf3CameraPosition = (pCamera) ? pCamera->GetPosition() : XMFLOAT3(0.0f, 0.0f, 0.0f);
+	const XMFLOAT4X4 *pxmf4x4Worlds = ::gTransformStorage.GetWorldMatrices();
+
+	for (UINT i = 0; i < nEntities; i++)
+	{
+		if (!pEntityManager->IsAlive(pnEntities[i])) continue;
+		MESH_COMPONENT *pMesh = pEntityManager->GetMesh(pnEntities[i]);
+		MATERIAL_COMPONENT *pMaterial = pEntityManager->GetMaterial(pnEntities[i]);
+		if (!pMesh || !pMesh->m_pMesh || !pMaterial) continue;
+
+		const XMFLOAT4X4& xmf4x4World = pxmf4x4Worlds[::gTransformStorage.GetIndex(pEntityManager->GetTransform(pnEntities[i]))];
+		XMFLOAT3 xmf3ToCamera = XMFLOAT3(xmf4x4World._41 - xmf3CameraPosition.x, xmf4x4World._42 - xmf3CameraPosition.y, xmf4x4World._43 - xmf3CameraPosition.z);
+		float fDepth = Vector3::Length(xmf3ToCamera);
+
+		CShader *pShader = (pMaterial->m_pMaterial && pMaterial->m_pMaterial->m_pShader) ? pMaterial->m_pMaterial->m_pShader : pMaterial->m_pShader;
+		CTexture *pTexture = (pMaterial->m_pMaterial) ? pMaterial->m_pMaterial->m_pTexture : NULL;
+		D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject = (pMaterial->m_pShader) ? pMaterial->m_pShader->GetObjectConstantBuffer(pMaterial->m_nConstantBufferIndex) : 0;
+		pRenderQueue->Submit(pMaterial->m_nRenderPass, pShader, pTexture, pMesh->m_pMesh, d3dcbGameObject, fDepth);
+	}
+}
@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------
+// File: Entity.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Transform.h"
+
+class CMesh;
+class CMaterial;
+class CShader;
+class CCamera;
+class CRenderQueue;
+
+// Ƽ = ( 12Ʈ) | ε( 20Ʈ)
+typedef UINT						ENTITY;
+
+#define ENTITY_NULL					0xFFFFFFFF
+#define ENTITY_INDEX_BITS			20
+#define ENTITY_INDEX_MASK			((1 << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GENERATION_MASK		0x0FFF
+
+#define COMPONENT_TRANSFORM			0x01
+#define COMPONENT_MESH				0x02
+#define COMPONENT_MATERIAL			0x04
+#define COMPONENT_ROTATION			0x08
+#define COMPONENT_REVOLUTION		0x10
+#define COMPONENT_BILLBOARD			0x20
+
+#define COMPONENT_RENDERABLE		(COMPONENT_TRANSFORM | COMPONENT_MESH | COMPONENT_MATERIAL)
+
+struct MESH_COMPONENT
+{
+	CMesh							*m_pMesh = NULL;
+};
+
+struct MATERIAL_COMPONENT
+{
+	CMaterial						*m_pMaterial = NULL;
+	CShader							*m_pShader = NULL;	// ¿    ̴
+	UINT							m_nConstantBufferIndex = 0;	//m_pShader->GetObjectConstantBuffer() ȣ
+	UINT							m_nRenderPass = 0;
+};
+
+struct ROTATION_COMPONENT
+{
+	XMFLOAT3						m_xmf3Axis = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	float							m_fSpeed = 0.0f;	//ʴ (degree)
+};
+
+struct REVOLUTION_COMPONENT
+{
+	XMFLOAT3						m_xmf3Axis = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	float							m_fSpeed = 0.0f;
+};
+
+struct BILLBOARD_COMPONENT
+{
+	XMFLOAT3						m_xmf3Up = XMFLOAT3(0.0f, 1.0f, 0.0f);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Ʈ (ñ׳)  Ƽ  д.
+// Ʈ 迭  ְ   ȣ  Ƽ̴. ñ׳Ŀ  迭  ִ.
+// Ƽ     ڸ űǷ 迭 ƴ .
+class CArchetype
+{
+public:
+	CArchetype(UINT nSignature) { m_nSignature = nSignature; }
+	~CArchetype() { }
+
+	UINT							m_nSignature = 0;
+
+	vector<ENTITY>					m_vEntities;
+	vector<TRANSFORM_HANDLE>		m_vTransforms;
+	vector<MESH_COMPONENT>			m_vMeshes;
+	vector<MATERIAL_COMPONENT>		m_vMaterials;
+	vector<ROTATION_COMPONENT>		m_vRotations;
+	vector<REVOLUTION_COMPONENT>	m_vRevolutions;
+	vector<BILLBOARD_COMPONENT>		m_vBillboards;
+
+	bool Has(UINT nComponents) { return((m_nSignature & nComponents) == nComponents); }
+	UINT GetRows() { return(UINT(m_vEntities.size())); }
+
+	UINT AddRow(ENTITY nEntity);
+	//    ڸ Ű Ƽ ش. ( ̾ ENTITY_NULL)
+	ENTITY RemoveRow(UINT nRow);
+	//  ŰŸԿ  Ʈ Ѵ.
+	void CopyRow(CArchetype *pSource, UINT nSourceRow, UINT nRow);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+class CEntityManager
+{
+public:
+	CEntityManager();
+	~CEntityManager();
+
+private:
+	vector<CArchetype *>			m_vArchetypes;
+
+	// Ƽ ε -> (ŰŸ, )
+	vector<CArchetype *>			m_vEntityArchetypes;
+	vector<UINT>					m_vEntityRows;
+	vector<USHORT>					m_vGenerations;
+	vector<UINT>					m_vFreeIndices;
+
+	CArchetype *FindArchetype(UINT nSignature);
+	void MoveEntity(ENTITY nEntity, UINT nSignature);
+	void ReleaseComponents(CArchetype *pArchetype, UINT nRow, UINT nComponents);
+
+public:
+	// COMPONENT_TRANSFORM  hTransform ϰ, (NULL)  ҴѴ.
+	ENTITY CreateEntity(UINT nSignature, TRANSFORM_HANDLE hTransform = TRANSFORM_HANDLE_NULL);
+	void DestroyEntity(ENTITY nEntity);
+	void DestroyAllEntities();
+
+	bool IsAlive(ENTITY nEntity);
+	UINT GetEntities() { return(UINT(m_vEntityArchetypes.size() - m_vFreeIndices.size())); }
+
+	void AddComponents(ENTITY nEntity, UINT nComponents);
+	void RemoveComponents(ENTITY nEntity, UINT nComponents);
+	UINT GetSignature(ENTITY nEntity) { return(m_vEntityArchetypes[nEntity & ENTITY_INDEX_MASK]->m_nSignature); }
+
+	// ȯ ʹ  ٲ(//Ʈ ߰ ) ȿ ȴ.
+	TRANSFORM_HANDLE GetTransform(ENTITY nEntity);
+	MESH_COMPONENT *GetMesh(ENTITY nEntity);
+	MATERIAL_COMPONENT *GetMaterial(ENTITY nEntity);
+	ROTATION_COMPONENT *GetRotation(ENTITY nEntity);
+	REVOLUTION_COMPONENT *GetRevolution(ENTITY nEntity);
+	BILLBOARD_COMPONENT *GetBillboard(ENTITY nEntity);
+
+	void SetMesh(ENTITY nEntity, CMesh *pMesh);
+	void SetMaterial(ENTITY nEntity, CMaterial *pMaterial, CShader *pShader, UINT nConstantBufferIndex, UINT nRenderPass);
+
+	int GetArchetypes() { return(int(m_vArchetypes.size())); }
+	CArchetype *GetArchetype(int nIndex) { return(m_vArchetypes[nIndex]); }
+};
+
+extern CEntityManager gEntityManager;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ý: ʿ Ʈ   ŰŸԵ 迭 ó  ȸѴ.
+//   ڱ ȯ Ը Ƿ ENTITY_SYSTEM_GRAIN ྿  ķ óѴ. (   )
+#define ENTITY_SYSTEM_GRAIN			1024
+
+void RotationSystem(CEntityManager *pEntityManager, float fTimeElapsed);
+void RevolutionSystem(CEntityManager *pEntityManager, float fTimeElapsed);
+void BillboardSystem(CEntityManager *pEntityManager, const XMFLOAT3& xmf3CameraPosition);
+void RenderSystem(CEntityManager *pEntityManager, CRenderQueue *pRenderQueue, CCamera *pCamera);
+// ø  Ƽ ϸ Ѵ.
+void RenderSystem(CEntityManager *pEntityManager, CRenderQueue *pRenderQueue, CCamera *pCamera, const ENTITY *pnEntities, UINT nEntities);
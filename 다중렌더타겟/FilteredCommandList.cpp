@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// File: FilteredCommandList.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "FilteredCommandList.h"
+#include "RenderStats.h"
+
+CFilteredCommandList gFilteredCommandList;
+
+CFilteredCommandList::CFilteredCommandList()
+{
+	Invalidate();
+	ResetCounters();
+}
+
+CFilteredCommandList::~CFilteredCommandList()
+{
+}
+
+void CFilteredCommandList::InvalidateRootArguments()
+{
+	for (int i = 0; i < FILTERED_MAX_ROOT_PARAMETERS; i++)
+	{
+		m_pnRootArguments[i] = 0;
+		m_pbRootDescriptorTables[i] = false;
+	}
+}
+
+void CFilteredCommandList::InvalidateRootDescriptorTables()
+{
+	for (int i = 0; i < FILTERED_MAX_ROOT_PARAMETERS; i++)
+	{
+		if (m_pbRootDescriptorTables[i]) m_pnRootArguments[i] = 0;
+	}
+}
+
+void CFilteredCommandList::Invalidate()
+{
+	m_pd3dRootSignature = NULL;
+	m_pd3dPipelineState = NULL;
+	m_pd3dDescriptorHeap = NULL;
+	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+	for (int i = 0; i < FILTERED_MAX_VERTEX_BUFFERS; i++) m_pbVertexBufferViews[i] = false;
+	m_bIndexBufferView = false;
+	m_bViewport = false;
+	m_bScissorRect = false;
+
+	InvalidateRootArguments();
+}
+
+void CFilteredCommandList::Begin(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	m_pd3dCommandList = pd3dCommandList;
+	Invalidate();
+}
+
+void CFilteredCommandList::SetGraphicsRootSignature(ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dRootSignature)
+{
+	m_pnCalls[FILTERED_ROOT_SIGNATURE]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if (pd3dRootSignature == m_pd3dRootSignature)
+		{
+			m_pnFilteredCalls[FILTERED_ROOT_SIGNATURE]++;
+			return;
+		}
+		m_pd3dRootSignature = pd3dRootSignature;
+		// Ʈ ñ׳İ ٲ Ʈ ڵ  ǵ  ° ȴ.
+		InvalidateRootArguments();
+	}
+	pd3dCommandList->SetGraphicsRootSignature(pd3dRootSignature);
+}
+
+void CFilteredCommandList::SetPipelineState(ID3D12GraphicsCommandList *pd3dCommandList, ID3D12PipelineState *pd3dPipelineState)
+{
+	m_pnCalls[FILTERED_PIPELINE_STATE]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if (pd3dPipelineState == m_pd3dPipelineState)
+		{
+			m_pnFilteredCalls[FILTERED_PIPELINE_STATE]++;
+			return;
+		}
+		m_pd3dPipelineState = pd3dPipelineState;
+	}
+	::gRenderStats.Add(RENDER_STAT_PIPELINE_STATES);
+	pd3dCommandList->SetPipelineState(pd3dPipelineState);
+}
+
+void CFilteredCommandList::SetDescriptorHeaps(ID3D12GraphicsCommandList *pd3dCommandList, UINT nDescriptorHeaps, ID3D12DescriptorHeap *const *ppd3dDescriptorHeaps)
+{
+	m_pnCalls[FILTERED_DESCRIPTOR_HEAPS]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if ((nDescriptorHeaps == 1) && (ppd3dDescriptorHeaps[0] == m_pd3dDescriptorHeap))
+		{
+			m_pnFilteredCalls[FILTERED_DESCRIPTOR_HEAPS]++;
+			return;
+		}
+		// ÷  Բ ϴ   ʴ´.
+		m_pd3dDescriptorHeap = (nDescriptorHeaps == 1) ? ppd3dDescriptorHeaps[0] : NULL;
+		//  ٲ   Ű  ̺ ٽ ؾ Ѵ. Ʈ   ּҴ ״ ȿϴ.
+		InvalidateRootDescriptorTables();
+	}
+	::gRenderStats.Add(RENDER_STAT_DESCRIPTOR_HEAPS);
+	pd3dCommandList->SetDescriptorHeaps(nDescriptorHeaps, ppd3dDescriptorHeaps);
+}
+
+void CFilteredCommandList::IASetPrimitiveTopology(ID3D12GraphicsCommandList *pd3dCommandList, D3D12_PRIMITIVE_TOPOLOGY d3dPrimitiveTopology)
+{
+	m_pnCalls[FILTERED_PRIMITIVE_TOPOLOGY]++;
+	m_d3dDrawPrimitiveTopology = d3dPrimitiveTopology;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if (d3dPrimitiveTopology == m_d3dPrimitiveTopology)
+		{
+			m_pnFilteredCalls[FILTERED_PRIMITIVE_TOPOLOGY]++;
+			return;
+		}
+		m_d3dPrimitiveTopology = d3dPrimitiveTopology;
+	}
+	pd3dCommandList->IASetPrimitiveTopology(d3dPrimitiveTopology);
+}
+
+void CFilteredCommandList::IASetVertexBuffers(ID3D12GraphicsCommandList *pd3dCommandList, UINT nStartSlot, UINT nViews, const D3D12_VERTEX_BUFFER_VIEW *pd3dVertexBufferViews)
+{
+	m_pnCalls[FILTERED_VERTEX_BUFFERS]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if ((nViews == 1) && (nStartSlot < FILTERED_MAX_VERTEX_BUFFERS))
+		{
+			if (m_pbVertexBufferViews[nStartSlot] && !::memcmp(&m_pd3dVertexBufferViews[nStartSlot], pd3dVertexBufferViews, sizeof(D3D12_VERTEX_BUFFER_VIEW)))
+			{
+				m_pnFilteredCalls[FILTERED_VERTEX_BUFFERS]++;
+				return;
+			}
+			m_pbVertexBufferViews[nStartSlot] = true;
+			m_pd3dVertexBufferViews[nStartSlot] = pd3dVertexBufferViews[0];
+		}
+		else
+		{
+			for (UINT i = nStartSlot; (i < nStartSlot + nViews) && (i < FILTERED_MAX_VERTEX_BUFFERS); i++) m_pbVertexBufferViews[i] = false;
+		}
+	}
+	pd3dCommandList->IASetVertexBuffers(nStartSlot, nViews, pd3dVertexBufferViews);
+}
+
+void CFilteredCommandList::IASetIndexBuffer(ID3D12GraphicsCommandList *pd3dCommandList, const D3D12_INDEX_BUFFER_VIEW *pd3dIndexBufferView)
+{
+	m_pnCalls[FILTERED_INDEX_BUFFER]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if (m_bIndexBufferView && pd3dIndexBufferView && !::memcmp(&m_d3dIndexBufferView, pd3dIndexBufferView, sizeof(D3D12_INDEX_BUFFER_VIEW)))
+		{
+			m_pnFilteredCalls[FILTERED_INDEX_BUFFER]++;
+			return;
+		}
+		m_bIndexBufferView = (pd3dIndexBufferView != NULL);
+		if (pd3dIndexBufferView) m_d3dIndexBufferView = *pd3dIndexBufferView;
+	}
+	pd3dCommandList->IASetIndexBuffer(pd3dIndexBufferView);
+}
+
+void CFilteredCommandList::RSSetViewports(ID3D12GraphicsCommandList *pd3dCommandList, UINT nViewports, const D3D12_VIEWPORT *pd3dViewports)
+{
+	m_pnCalls[FILTERED_VIEWPORTS]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if ((nViewports == 1) && m_bViewport && !::memcmp(&m_d3dViewport, pd3dViewports, sizeof(D3D12_VIEWPORT)))
+		{
+			m_pnFilteredCalls[FILTERED_VIEWPORTS]++;
+			return;
+		}
+		m_bViewport = (nViewports == 1);
+		if (m_bViewport) m_d3dViewport = pd3dViewports[0];
+	}
+	pd3dCommandList->RSSetViewports(nViewports, pd3dViewports);
+}
+
+void CFilteredCommandList::RSSetScissorRects(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRects, const D3D12_RECT *pd3dRects)
+{
+	m_pnCalls[FILTERED_SCISSOR_RECTS]++;
+	if (IsFiltering(pd3dCommandList))
+	{
+		if ((nRects == 1) && m_bScissorRect && !::memcmp(&m_d3dScissorRect, pd3dRects, sizeof(D3D12_RECT)))
+		{
+			m_pnFilteredCalls[FILTERED_SCISSOR_RECTS]++;
+			return;
+		}
+		m_bScissorRect = (nRects == 1);
+		if (m_bScissorRect) m_d3dScissorRect = pd3dRects[0];
+	}
+	pd3dCommandList->RSSetScissorRects(nRects, pd3dRects);
+}
+
+void CFilteredCommandList::SetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE d3dBaseDescriptor)
+{
+	m_pnCalls[FILTERED_ROOT_DESCRIPTOR_TABLE]++;
+	if (IsFiltering(pd3dCommandList) && (nRootParameterIndex < FILTERED_MAX_ROOT_PARAMETERS))
+	{
+		if (m_pbRootDescriptorTables[nRootParameterIndex] && (m_pnRootArguments[nRootParameterIndex] == d3dBaseDescriptor.ptr))
+		{
+			m_pnFilteredCalls[FILTERED_ROOT_DESCRIPTOR_TABLE]++;
+			return;
+		}
+		m_pnRootArguments[nRootParameterIndex] = d3dBaseDescriptor.ptr;
+		m_pbRootDescriptorTables[nRootParameterIndex] = true;
+	}
+	::gRenderStats.Add(RENDER_STAT_ROOT_ARGUMENTS);
+	pd3dCommandList->SetGraphicsRootDescriptorTable(nRootParameterIndex, d3dBaseDescriptor);
+}
+
+void CFilteredCommandList::SetGraphicsRootConstantBufferView(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS d3dBufferLocation)
+{
+	m_pnCalls[FILTERED_ROOT_CONSTANT_BUFFER]++;
+	if (IsFiltering(pd3dCommandList) && (nRootParameterIndex < FILTERED_MAX_ROOT_PARAMETERS))
+	{
+		if (!m_pbRootDescriptorTables[nRootParameterIndex] && (m_pnRootArguments[nRootParameterIndex] == d3dBufferLocation))
+		{
+			m_pnFilteredCalls[FILTERED_ROOT_CONSTANT_BUFFER]++;
+			return;
+		}
+		m_pnRootArguments[nRootParameterIndex] = d3dBufferLocation;
+		m_pbRootDescriptorTables[nRootParameterIndex] = false;
+	}
+	::gRenderStats.Add(RENDER_STAT_ROOT_ARGUMENTS);
+	pd3dCommandList->SetGraphicsRootConstantBufferView(nRootParameterIndex, d3dBufferLocation);
+}
+
+void CFilteredCommandList::CountPrimitives(UINT nVertices, UINT nInstances)
+{
+	UINT nTriangles = 0, nPoints = 0;
+	switch (m_d3dDrawPrimitiveTopology)
+	{
+		case D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST:
+			nTriangles = (nVertices / 3) * nInstances;
+			break;
+		case D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP:
+			if (nVertices >= 3) nTriangles = (nVertices - 2) * nInstances;
+			break;
+		case D3D_PRIMITIVE_TOPOLOGY_POINTLIST:
+			nPoints = nVertices * nInstances;
+			break;
+	}
+	m_nDraws++;
+	m_nTriangles += nTriangles;
+	m_nPoints += nPoints;
+	::gRenderStats.AddDraw(nInstances, nTriangles, nPoints);
+}
+
+void CFilteredCommandList::DrawInstanced(ID3D12GraphicsCommandList *pd3dCommandList, UINT nVertices, UINT nInstances, UINT nStartVertex, UINT nStartInstance)
+{
+	CountPrimitives(nVertices, nInstances);
+	pd3dCommandList->DrawInstanced(nVertices, nInstances, nStartVertex, nStartInstance);
+}
+
+void CFilteredCommandList::DrawIndexedInstanced(ID3D12GraphicsCommandList *pd3dCommandList, UINT nIndices, UINT nInstances, UINT nStartIndex, INT nBaseVertex, UINT nStartInstance)
+{
+	CountPrimitives(nIndices, nInstances);
+	pd3dCommandList->DrawIndexedInstanced(nIndices, nInstances, nStartIndex, nBaseVertex, nStartInstance);
+}
+
+UINT CFilteredCommandList::GetTotalCalls()
+{
+	UINT nCalls = 0;
+	for (int i = 0; i < FILTERED_STATE_TYPES; i++) nCalls += m_pnCalls[i];
+	return(nCalls);
+}
+
+UINT CFilteredCommandList::GetTotalFilteredCalls()
+{
+	UINT nFilteredCalls = 0;
+	for (int i = 0; i < FILTERED_STATE_TYPES; i++) nFilteredCalls += m_pnFilteredCalls[i];
+	return(nFilteredCalls);
+}
+
+void CFilteredCommandList::ResetCounters()
+{
+	for (int i = 0; i < FILTERED_STATE_TYPES; i++)
+	{
+		m_pnCalls[i] = 0;
+		m_pnFilteredCalls[i] = 0;
+	}
+	m_nDraws = 0;
+	m_nTriangles = 0;
+	m_nPoints = 0;
+}
+
+void CFilteredCommandList::OutputDebugCounters()
+{
+	static const TCHAR *ppszStateTypes[FILTERED_STATE_TYPES] = { _T("RootSignature"), _T("PipelineState"), _T("DescriptorHeaps"), _T("PrimitiveTopology"), _T("VertexBuffers"), _T("IndexBuffer"), _T("Viewports"), _T("ScissorRects"), _T("RootDescriptorTable"), _T("RootConstantBufferView") };
+
+	TCHAR pstrDebug[128];
+	for (int i = 0; i < FILTERED_STATE_TYPES; i++)
+	{
+		_stprintf_s(pstrDebug, 128, _T("%-24s %6u / %6u filtered\n"), ppszStateTypes[i], m_pnFilteredCalls[i], m_pnCalls[i]);
+		::OutputDebugString(pstrDebug);
+	}
+}
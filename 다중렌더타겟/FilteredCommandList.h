@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// File: FilteredCommandList.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define FILTERED_ROOT_SIGNATURE			0
+#define FILTERED_PIPELINE_STATE			1
+#define FILTERED_DESCRIPTOR_HEAPS		2
+#define FILTERED_PRIMITIVE_TOPOLOGY		3
+#define FILTERED_VERTEX_BUFFERS			4
+#define FILTERED_INDEX_BUFFER			5
+#define FILTERED_VIEWPORTS				6
+#define FILTERED_SCISSOR_RECTS			7
+#define FILTERED_ROOT_DESCRIPTOR_TABLE	8
+#define FILTERED_ROOT_CONSTANT_BUFFER	9
+#define FILTERED_STATE_TYPES			10
+
+#define FILTERED_MAX_ROOT_PARAMETERS	16
+#define FILTERED_MAX_VERTEX_BUFFERS		8
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ŀǵ Ʈ   ¸ ϰ   ٽ ϴ ȣ .
+// Begin()  Ŀǵ Ʈ ؼ ɷ, ٸ Ŀǵ Ʈ ״ Ѵ.
+// ¸ ϴ  ȣ  ü ľ ĳð  ¿ ߳ ʴ´.
+class CFilteredCommandList
+{
+public:
+	CFilteredCommandList();
+	~CFilteredCommandList();
+
+private:
+	ID3D12GraphicsCommandList		*m_pd3dCommandList = NULL;
+	bool							m_bEnabled = true;
+
+	ID3D12RootSignature				*m_pd3dRootSignature = NULL;
+	ID3D12PipelineState				*m_pd3dPipelineState = NULL;
+	ID3D12DescriptorHeap			*m_pd3dDescriptorHeap = NULL;
+	D3D12_PRIMITIVE_TOPOLOGY		m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+	bool							m_pbVertexBufferViews[FILTERED_MAX_VERTEX_BUFFERS];
+	D3D12_VERTEX_BUFFER_VIEW		m_pd3dVertexBufferViews[FILTERED_MAX_VERTEX_BUFFERS];
+	bool							m_bIndexBufferView = false;
+	D3D12_INDEX_BUFFER_VIEW			m_d3dIndexBufferView;
+
+	bool							m_bViewport = false;
+	D3D12_VIEWPORT					m_d3dViewport;
+	bool							m_bScissorRect = false;
+	D3D12_RECT						m_d3dScissorRect;
+
+	// Ʈ Ű    ̺ ڵ Ǵ   ּ (0 = )
+	UINT64							m_pnRootArguments[FILTERED_MAX_ROOT_PARAMETERS];
+	//  ڰ  ̸̺ true (Ʈ   ּҴ  )
+	bool							m_pbRootDescriptorTables[FILTERED_MAX_ROOT_PARAMETERS];
+
+	UINT							m_pnCalls[FILTERED_STATE_TYPES];
+	UINT							m_pnFilteredCalls[FILTERED_STATE_TYPES];
+
+	// ο .  ɷ    ̴.
+	D3D12_PRIMITIVE_TOPOLOGY		m_d3dDrawPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	UINT							m_nDraws = 0;
+	UINT							m_nTriangles = 0;
+	UINT							m_nPoints = 0;
+
+	void CountPrimitives(UINT nVertices, UINT nInstances);
+
+	bool IsFiltering(ID3D12GraphicsCommandList *pd3dCommandList) { return(m_bEnabled && (pd3dCommandList == m_pd3dCommandList)); }
+	void InvalidateRootArguments();
+	void InvalidateRootDescriptorTables();
+
+public:
+	// Ŀǵ Ʈ Reset() Ŀ ȣѴ. (Reset  ¸ ʱȭѴ)
+	void Begin(ID3D12GraphicsCommandList *pd3dCommandList);
+	void Invalidate();
+
+	void SetEnabled(bool bEnabled) { m_bEnabled = bEnabled; Invalidate(); }
+	bool IsEnabled() { return(m_bEnabled); }
+
+	void SetGraphicsRootSignature(ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dRootSignature);
+	void SetPipelineState(ID3D12GraphicsCommandList *pd3dCommandList, ID3D12PipelineState *pd3dPipelineState);
+	void SetDescriptorHeaps(ID3D12GraphicsCommandList *pd3dCommandList, UINT nDescriptorHeaps, ID3D12DescriptorHeap *const *ppd3dDescriptorHeaps);
+	void IASetPrimitiveTopology(ID3D12GraphicsCommandList *pd3dCommandList, D3D12_PRIMITIVE_TOPOLOGY d3dPrimitiveTopology);
+	void IASetVertexBuffers(ID3D12GraphicsCommandList *pd3dCommandList, UINT nStartSlot, UINT nViews, const D3D12_VERTEX_BUFFER_VIEW *pd3dVertexBufferViews);
+	void IASetIndexBuffer(ID3D12GraphicsCommandList *pd3dCommandList, const D3D12_INDEX_BUFFER_VIEW *pd3dIndexBufferView);
+	void RSSetViewports(ID3D12GraphicsCommandList *pd3dCommandList, UINT nViewports, const D3D12_VIEWPORT *pd3dViewports);
+	void RSSetScissorRects(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRects, const D3D12_RECT *pd3dRects);
+	void SetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE d3dBaseDescriptor);
+	void SetGraphicsRootConstantBufferView(ID3D12GraphicsCommandList *pd3dCommandList, UINT nRootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS d3dBufferLocation);
+
+	// ɷ ʰ ״ ϸ鼭 ο ȣ ׸ ﰢ()  . (CRenderStats ˸)
+	void DrawInstanced(ID3D12GraphicsCommandList *pd3dCommandList, UINT nVertices, UINT nInstances, UINT nStartVertex, UINT nStartInstance);
+	void DrawIndexedInstanced(ID3D12GraphicsCommandList *pd3dCommandList, UINT nIndices, UINT nInstances, UINT nStartIndex, INT nBaseVertex, UINT nStartInstance);
+
+	UINT GetCalls(int nType) { return(m_pnCalls[nType]); }
+	UINT GetFilteredCalls(int nType) { return(m_pnFilteredCalls[nType]); }
+	UINT GetTotalCalls();
+	UINT GetTotalFilteredCalls();
+	UINT GetDraws() { return(m_nDraws); }
+	UINT GetTriangles() { return(m_nTriangles); }
+	UINT GetPoints() { return(m_nPoints); }
+	void ResetCounters();
+	//  ȣ  ɷ    â .
+	void OutputDebugCounters();
+};
+
+extern CFilteredCommandList gFilteredCommandList;
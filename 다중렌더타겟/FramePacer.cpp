@@ -0,0 +1,240 @@
+//-----------------------------------------------------------------------------
+// File: FramePacer.cpp
+//-----------------------------------------------------------------------------
+
+#include "FramePacer.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+CFakePacerClock::CFakePacerClock(int64_t nSleepGranularity, int64_t nMaxOversleep, int64_t nSpinTime)
+{
+	m_nSleepGranularity = nSleepGranularity;
+	m_nMaxOversleep = nMaxOversleep;
+	m_nSpinTime = nSpinTime;
+}
+
+void CFakePacerClock::Sleep(int64_t nTime)
+{
+	if (m_nSleepGranularity > 0) nTime = ((nTime + m_nSleepGranularity - 1) / m_nSleepGranularity) * m_nSleepGranularity;
+	m_nRandom = m_nRandom * 1664525 + 1013904223;
+	m_nTime += nTime + int64_t(double(m_nRandom >> 8) / double(1 << 24) * m_nMaxOversleep);
+}
+
+CFramePacer::CFramePacer(CPacerClock *pClock)
+{
+	m_pClock = pClock;
+	for (int i = 0; i < PACER_OVERSLEEP_SAMPLES; i++) m_pnOversleeps[i] = PACER_INITIAL_OVERSLEEP;
+	ResetStats();
+}
+
+CFramePacer::~CFramePacer()
+{
+	if (m_pClock) delete m_pClock;
+}
+
+void CFramePacer::SetTargetFrameRate(float fFramesPerSecond)
+{
+	int64_t nPeriod = (fFramesPerSecond > 0.0f) ? int64_t(1.0e9 / fFramesPerSecond + 0.5) : 0;
+	if (nPeriod == m_nPeriod) return;
+	m_nPeriod = nPeriod;
+	m_nDeadline = 0;
+}
+
+void CFramePacer::SetTargetRefreshRate(unsigned int nNumerator, unsigned int nDenominator, unsigned int nInterval)
+{
+	if (nNumerator == 0)
+	{
+		Disable();
+		return;
+	}
+	m_nPeriod = int64_t(1000000000.0 * nDenominator * std::max(nInterval, 1U) / nNumerator + 0.5);
+	m_nDeadline = 0;
+}
+
+int64_t CFramePacer::GetSpinThreshold()
+{
+	return(std::min(std::max(m_nOversleep + PACER_SPIN_MARGIN, int64_t(PACER_MIN_SPIN)), int64_t(PACER_MAX_SPIN)));
+}
+
+int64_t CFramePacer::WaitForNextFrame()
+{
+	int64_t nTime = m_pClock->GetTime();
+	if (m_nPeriod <= 0) return(nTime);
+
+	// ó̰ų  ֱ Ѱ ʾ и  Ƽ ׸ ʰ ݺ ٽ .
+	if ((m_nDeadline == 0) || (nTime - m_nDeadline > m_nPeriod))
+	{
+		if (m_nDeadline != 0) m_xStats.m_nLateFrames++;
+		m_nDeadline = nTime;
+	}
+	m_nDeadline += m_nPeriod;
+
+	int64_t nWaitStart = nTime;
+	int64_t nSpinThreshold = GetSpinThreshold();
+	while (m_nDeadline - nTime > nSpinThreshold)
+	{
+		int64_t nSleep = m_nDeadline - nTime - nSpinThreshold;
+		m_pClock->Sleep(nSleep);
+		int64_t nWakeTime = m_pClock->GetTime();
+
+		// ʰ   ٷ ݿϰ, پ  ū    ڿ ݿѴ.
+		m_pnOversleeps[m_nNextOversleep] = (nWakeTime - nTime) - nSleep;
+		m_nNextOversleep = (m_nNextOversleep + 1) % PACER_OVERSLEEP_SAMPLES;
+		m_nOversleep = m_pnOversleeps[0];
+		for (int i = 1; i < PACER_OVERSLEEP_SAMPLES; i++) m_nOversleep = std::max(m_nOversleep, m_pnOversleeps[i]);
+		nTime = nWakeTime;
+		nSpinThreshold = GetSpinThreshold();
+	}
+
+	int64_t nSpinStart = nTime;
+	while (nTime < m_nDeadline)
+	{
+		m_pClock->Spin();
+		nTime = m_pClock->GetTime();
+	}
+
+	int64_t nLateness = nTime - m_nDeadline;
+	m_xStats.m_nFrames++;
+	m_xStats.m_fLatenessSum += double(nLateness);
+	m_xStats.m_fLatenessSquareSum += double(nLateness) * double(nLateness);
+	m_xStats.m_nMaxLateness = std::max(m_xStats.m_nMaxLateness, nLateness);
+	m_xStats.m_nLastLateness = nLateness;
+	m_xStats.m_nWaitTime += nTime - nWaitStart;
+	m_xStats.m_nSpinTime += nTime - nSpinStart;
+
+	return(nTime);
+}
+
+float CFramePacer::GetMeanLateness()
+{
+	if (m_xStats.m_nFrames == 0) return(0.0f);
+	return(float(m_xStats.m_fLatenessSum / m_xStats.m_nFrames * 1.0e-6));
+}
+
+float CFramePacer::GetLatenessJitter()
+{
+	if (m_xStats.m_nFrames == 0) return(0.0f);
+	double fMean = m_xStats.m_fLatenessSum / m_xStats.m_nFrames;
+	double fVariance = m_xStats.m_fLatenessSquareSum / m_xStats.m_nFrames - fMean * fMean;
+	return(float(sqrt(std::max(fVariance, 0.0)) * 1.0e-6));
+}
+
+float CFramePacer::GetSpinFraction()
+{
+	if (m_xStats.m_nWaitTime <= 0) return(0.0f);
+	return(float(double(m_xStats.m_nSpinTime) / double(m_xStats.m_nWaitTime)));
+}
+
+void CFramePacer::ResetStats()
+{
+	memset(&m_xStats, 0, sizeof(FRAME_PACER_STATS));
+}
+
+//  ۾ ð 䳻  nFrames  ٸ,  ð  ش.
+static void RunPacedFrames(CFramePacer *pFramePacer, CFakePacerClock *pClock, unsigned int nFrames, int64_t nWorkTime, std::vector<int64_t>& vIntervals)
+{
+	int64_t nLastTime = pFramePacer->WaitForNextFrame();
+	for (unsigned int i = 0; i < nFrames; i++)
+	{
+		pClock->Advance(nWorkTime + (i % 7) * 500000);
+		int64_t nTime = pFramePacer->WaitForNextFrame();
+		vIntervals.push_back(nTime - nLastTime);
+		nLastTime = nTime;
+	}
+}
+
+bool CFramePacer::RunFakeClockTest(std::string *pstrReport)
+{
+	const int64_t nMillisecond = 1000000;
+	const int64_t nSpinTime = 2000;			//   2us
+
+	*pstrReport = "FramePacer Fake Clock Test\n";
+	char pstrLine[256];
+	unsigned int nFailed = 0;
+	auto Check = [&](bool bResult, const char *pszTest) {
+		*pstrReport += std::string(" ") + pszTest + ": " + ((bResult) ? "ok" : "FAILED") + "\n";
+		if (!bResult) nFailed++;
+	};
+
+	// 1. 1ms ػ󵵿 ִ 1ms  ʰ  ð迡 60fps: ó  (  ) ڷδ     ȿ .
+	{
+		CFakePacerClock *pClock = new CFakePacerClock(nMillisecond, nMillisecond, nSpinTime);
+		CFramePacer xFramePacer(pClock);
+		xFramePacer.SetTargetFrameRate(60.0f);
+		std::vector<int64_t> vIntervals;
+		RunPacedFrames(&xFramePacer, pClock, 60, 5 * nMillisecond, vIntervals);
+		xFramePacer.ResetStats();
+		vIntervals.clear();
+		RunPacedFrames(&xFramePacer, pClock, 600, 5 * nMillisecond, vIntervals);
+
+		int64_t nMaxError = 0;
+		for (int64_t nInterval : vIntervals) nMaxError = std::max(nMaxError, int64_t(llabs(nInterval - xFramePacer.GetPeriod())));
+		snprintf(pstrLine, sizeof(pstrLine), " 60 fps: lateness %.4f ms (jitter %.4f, max %.4f), interval error max %.4f ms, spinning %.1f%% of wait\n", xFramePacer.GetMeanLateness(), xFramePacer.GetLatenessJitter(),
+			xFramePacer.GetStats().m_nMaxLateness * 1.0e-6, nMaxError * 1.0e-6, xFramePacer.GetSpinFraction() * 100.0f);
+		*pstrReport += pstrLine;
+		Check(xFramePacer.GetStats().m_nMaxLateness <= nSpinTime, "Deadline accuracy");
+		Check(nMaxError <= 2 * nSpinTime, "Interval jitter");
+		Check(xFramePacer.GetSpinFraction() < 0.3f, "Sleeps most of the wait");
+	}
+
+	// 2.   ڱ ø   ȿ    . (ػ ø ִ 3.5ms)
+	{
+		CFakePacerClock *pClock = new CFakePacerClock(nMillisecond, 500000, nSpinTime);
+		CFramePacer xFramePacer(pClock);
+		xFramePacer.SetTargetFrameRate(60.0f);
+		std::vector<int64_t> vIntervals;
+		RunPacedFrames(&xFramePacer, pClock, 120, 5 * nMillisecond, vIntervals);
+		pClock->SetMaxOversleep(5 * nMillisecond / 2);
+		xFramePacer.ResetStats();
+		//   ݱ   ū ̹Ƿ ׺  ʰ  幮 Ӹ ʴ´.
+		unsigned int nEarlyLateFrames = 0, nLateFrames = 0;
+		for (unsigned int i = 0; i < 1000; i++)
+		{
+			pClock->Advance(5 * nMillisecond);
+			xFramePacer.WaitForNextFrame();
+			if (xFramePacer.GetStats().m_nLastLateness > nSpinTime) ((i < 30) ? nEarlyLateFrames : nLateFrames)++;
+		}
+		snprintf(pstrLine, sizeof(pstrLine), " Oversleep 0.5 -> 2.5 ms: %u late frames in the first 30, %u in the next 970, spin threshold %.3f ms\n", nEarlyLateFrames, nLateFrames, xFramePacer.GetSpinThreshold() * 1.0e-6);
+		*pstrReport += pstrLine;
+		Check(nLateFrames <= 10, "Oversleep adaptation");
+	}
+
+	// 3. 59.94Hz  ǥ    ̾ Ƿ   ߳ ʴ´.
+	{
+		CFakePacerClock *pClock = new CFakePacerClock(nMillisecond, nMillisecond, nSpinTime);
+		CFramePacer xFramePacer(pClock);
+		xFramePacer.SetTargetRefreshRate(60000, 1001);
+		std::vector<int64_t> vIntervals;
+		RunPacedFrames(&xFramePacer, pClock, 60, 5 * nMillisecond, vIntervals);
+		int64_t nStart = pClock->GetTime();
+		vIntervals.clear();
+		RunPacedFrames(&xFramePacer, pClock, 6000, 5 * nMillisecond, vIntervals);
+		double fDrift = double(pClock->GetTime() - nStart) - 6001.0 * 1.0e9 * 1001.0 / 60000.0;
+		snprintf(pstrLine, sizeof(pstrLine), " 59.94 Hz: period %.6f ms, drift over 6000 frames %.4f ms\n", xFramePacer.GetPeriod() * 1.0e-6, fDrift * 1.0e-6);
+		*pstrReport += pstrLine;
+		Check((xFramePacer.GetPeriod() == 16683333) && (fabs(fDrift) < 0.05 * nMillisecond), "Refresh rate target");
+	}
+
+	// 4.  ֱ⺸   ڿ и  Ƽ  ʴ´.
+	{
+		CFakePacerClock *pClock = new CFakePacerClock(nMillisecond, nMillisecond, nSpinTime);
+		CFramePacer xFramePacer(pClock);
+		xFramePacer.SetTargetFrameRate(60.0f);
+		std::vector<int64_t> vIntervals;
+		RunPacedFrames(&xFramePacer, pClock, 60, 5 * nMillisecond, vIntervals);
+		pClock->Advance(40 * nMillisecond);
+		vIntervals.clear();
+		RunPacedFrames(&xFramePacer, pClock, 10, 5 * nMillisecond, vIntervals);
+		int64_t nMinInterval = vIntervals[0];
+		for (int64_t nInterval : vIntervals) nMinInterval = std::min(nMinInterval, nInterval);
+		Check((xFramePacer.GetStats().m_nLateFrames == 1) && (nMinInterval >= xFramePacer.GetPeriod() - nSpinTime), "No catch-up burst after a long frame");
+	}
+
+	*pstrReport += std::string(" Result: ") + ((nFailed == 0) ? "PASSED" : "FAILED") + "\n";
+	return(nFailed == 0);
+}
@@ -0,0 +1,109 @@
+//-----------------------------------------------------------------------------
+// File: FramePacer.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+// stdafx.h(Windows)  ȴ. ý ð(CSystemPacerClock) SystemPacerClock.h ִ.
+// (Tests/FramePacerTest.cpp  ϸ    )
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#define PACER_INITIAL_OVERSLEEP			1000000		//ó    ()
+#define PACER_SPIN_MARGIN				200000		//  ̸ŭ   
+#define PACER_MIN_SPIN					200000
+#define PACER_MAX_SPIN					4000000		//̺  ð ª  ʰ 
+#define PACER_OVERSLEEP_SAMPLES			64			//ֱ ̸ŭ     ū    
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  ̼  ð. ð (steady_clock  ð)̴.
+class CPacerClock
+{
+public:
+	virtual ~CPacerClock() { }
+
+	virtual int64_t GetTime() = 0;
+	//  nTime  . ( ʰ   ִ)
+	virtual void Sleep(int64_t nTime) = 0;
+	// 鼭 ٸ   (CPU  ȴٰ ˸)
+	virtual void Spin() = 0;
+};
+
+//  (ػ󵵿  ø +  )    ð 䳻  ð. ð θ  .
+class CFakePacerClock : public CPacerClock
+{
+public:
+	CFakePacerClock(int64_t nSleepGranularity, int64_t nMaxOversleep, int64_t nSpinTime);
+	virtual ~CFakePacerClock() { }
+
+private:
+	int64_t							m_nTime = 0;
+	int64_t							m_nSleepGranularity;
+	int64_t							m_nMaxOversleep;
+	int64_t							m_nSpinTime;
+	unsigned int					m_nRandom = 12345;
+
+public:
+	void Advance(int64_t nTime) { m_nTime += nTime; }
+	void SetMaxOversleep(int64_t nMaxOversleep) { m_nMaxOversleep = nMaxOversleep; }
+
+	virtual int64_t GetTime() { return(m_nTime); }
+	virtual void Sleep(int64_t nTime);
+	virtual void Spin() { m_nTime += m_nSpinTime; }
+};
+
+struct FRAME_PACER_STATS
+{
+	unsigned int					m_nFrames;
+	unsigned int					m_nLateFrames;			// ֱ Ѱ ʾ  ٽ  
+	double							m_fLatenessSum;			// ʰ  ð ()
+	double							m_fLatenessSquareSum;
+	int64_t							m_nMaxLateness;
+	int64_t							m_nLastLateness;		// 
+	int64_t							m_nWaitTime;			//ٸ ü ð
+	int64_t							m_nSpinTime;			//  鼭 ٸ ð
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   ð ǥ ֱ⸶ .  (   + )   鼭 ٸ.
+//    ֱ⸦ ؼ Ƿ  ð   ʴ´.
+class CFramePacer
+{
+public:
+	// ð CFramePacer .
+	CFramePacer(CPacerClock *pClock);
+	~CFramePacer();
+
+private:
+	CPacerClock						*m_pClock = NULL;
+	int64_t							m_nPeriod = 0;			//0̸ ٸ ʴ´
+	int64_t							m_nDeadline = 0;
+	int64_t							m_pnOversleeps[PACER_OVERSLEEP_SAMPLES];
+	unsigned int					m_nNextOversleep = 0;
+	int64_t							m_nOversleep = PACER_INITIAL_OVERSLEEP;
+
+	FRAME_PACER_STATS				m_xStats;
+
+public:
+	void SetTargetFrameRate(float fFramesPerSecond);
+	// ÷ (: 60000/1001) ǥ ´. nInterval  Ÿ  .
+	void SetTargetRefreshRate(unsigned int nNumerator, unsigned int nDenominator, unsigned int nInterval = 1);
+	void Disable() { m_nPeriod = 0; m_nDeadline = 0; }
+	bool IsEnabled() { return(m_nPeriod > 0); }
+	int64_t GetPeriod() { return(m_nPeriod); }
+	int64_t GetSpinThreshold();
+
+	//    ٸ  ð ش.
+	int64_t WaitForNextFrame();
+
+	const FRAME_PACER_STATS& GetStats() { return(m_xStats); }
+	//  ʰ  ð հ ǥ  (ms), ٸ ð   
+	float GetMeanLateness();
+	float GetLatenessJitter();
+	float GetSpinFraction();
+	void ResetStats();
+
+	// ¥ ð ,  ,  ǥ,   ó ˻ϰ  pstrReport .
+	static bool RunFakeClockTest(std::string *pstrReport);
+};
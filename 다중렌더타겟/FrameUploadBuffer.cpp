@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// File: FrameUploadBuffer.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "FrameUploadBuffer.h"
+#include "MemoryTracker.h"
+#include "DeferredDeletion.h"
+
+CFrameUploadBuffer gFrameUploadBuffer;
+
+static void ReleaseDeferredResource(void *pObject)
+{
+	((ID3D12Resource *)pObject)->Release();
+}
+
+CFrameUploadBuffer::CFrameUploadBuffer()
+{
+}
+
+CFrameUploadBuffer::~CFrameUploadBuffer()
+{
+}
+
+bool CFrameUploadBuffer::Create(ID3D12Device *pd3dDevice, UINT nRegionBytes)
+{
+	m_pd3dDevice = pd3dDevice;
+	m_nRegionBytes = (nRegionBytes + (FRAME_UPLOAD_ALIGNMENT - 1)) & ~(FRAME_UPLOAD_ALIGNMENT - 1);
+
+	MEMORY_TAG_SCOPE(MEMORY_TAG_CONSTANT_BUFFER);
+	m_pd3dUploadBuffer = ::CreateBufferResource(pd3dDevice, NULL, NULL, m_nRegionBytes * FRAMES_IN_FLIGHT, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ, NULL);
+	if (!m_pd3dUploadBuffer) return(false);
+
+	// ε   ä ᵵ ȴ. CPU ⸸ Ѵ.
+	D3D12_RANGE d3dReadRange = { 0, 0 };
+	m_pd3dUploadBuffer->Map(0, &d3dReadRange, (void **)&m_pMappedUploadBuffer);
+	m_d3dGpuVirtualAddress = m_pd3dUploadBuffer->GetGPUVirtualAddress();
+
+	m_nRegion = 0;
+	m_nOffset = 0;
+	return(true);
+}
+
+void CFrameUploadBuffer::Release()
+{
+	if (m_pd3dUploadBuffer)
+	{
+		m_pd3dUploadBuffer->Unmap(0, NULL);
+		m_pd3dUploadBuffer->Release();
+	}
+	m_pd3dUploadBuffer = NULL;
+	m_pMappedUploadBuffer = NULL;
+	m_d3dGpuVirtualAddress = 0;
+	m_pd3dDevice = NULL;
+}
+
+void CFrameUploadBuffer::BeginFrame(UINT nRegion)
+{
+	m_nPeakBytes = max(m_nPeakBytes, m_nOffset);
+	m_nRegion = nRegion % FRAMES_IN_FLIGHT;
+	m_nOffset = 0;
+	m_nFrame++;
+}
+
+void *CFrameUploadBuffer::Allocate(UINT nBytes, D3D12_GPU_VIRTUAL_ADDRESS *pd3dGpuVirtualAddress, UINT nAlignment)
+{
+	*pd3dGpuVirtualAddress = 0;
+	if (!m_pd3dUploadBuffer) return(NULL);
+
+	UINT nOffset = (m_nOffset + (nAlignment - 1)) & ~(nAlignment - 1);
+	if ((nOffset <= m_nRegionBytes) && (nBytes <= m_nRegionBytes - nOffset))
+	{
+		m_nOffset = nOffset + nBytes;
+		UINT64 nBufferOffset = UINT64(m_nRegion) * m_nRegionBytes + nOffset;
+		*pd3dGpuVirtualAddress = m_d3dGpuVirtualAddress + nBufferOffset;
+		return(m_pMappedUploadBuffer + nBufferOffset);
+	}
+
+	//  ڶ ̹ û  ۸ .   GPU ۾    ť Ѵ.
+	if (m_nOverflows++ == 0) ::OutputDebugString(_T("FrameUploadBuffer: region is full, creating a dedicated upload buffer\n"));
+
+	MEMORY_TAG_SCOPE(MEMORY_TAG_CONSTANT_BUFFER);
+	ID3D12Resource *pd3dBuffer = ::CreateBufferResource(m_pd3dDevice, NULL, NULL, max(nBytes, UINT(FRAME_UPLOAD_ALIGNMENT)), D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ, NULL);
+	if (!pd3dBuffer) return(NULL);
+
+	void *pMappedBuffer = NULL;
+	D3D12_RANGE d3dReadRange = { 0, 0 };
+	pd3dBuffer->Map(0, &d3dReadRange, &pMappedBuffer);
+	*pd3dGpuVirtualAddress = pd3dBuffer->GetGPUVirtualAddress();
+	::gDeferredDeletionQueue.Push(pd3dBuffer, ::ReleaseDeferredResource);
+	return(pMappedBuffer);
+}
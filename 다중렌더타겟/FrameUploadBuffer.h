@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// File: FrameUploadBuffer.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define FRAME_UPLOAD_REGION_BYTES		(8 * 1024 * 1024)	// ϳ   ִ ũ
+#define FRAME_UPLOAD_ALIGNMENT			256					//   ּ  (D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  (н) CPU    ۿ  ۸ ߶ ִ ε .
+//     ϳ FRAMES_IN_FLIGHT   Ӹ ڱ  տ ʷ ش.
+// CGameFramework  ٽ       潺 ٸǷ GPU д  ޸𸮸  ʴ´.
+//  ڶ   ۸ ְ   ť  ش.  忡 .
+class CFrameUploadBuffer
+{
+public:
+	CFrameUploadBuffer();
+	~CFrameUploadBuffer();
+
+private:
+	ID3D12Device					*m_pd3dDevice = NULL;
+	ID3D12Resource					*m_pd3dUploadBuffer = NULL;
+	UINT8							*m_pMappedUploadBuffer = NULL;
+	D3D12_GPU_VIRTUAL_ADDRESS		m_d3dGpuVirtualAddress = 0;
+	UINT							m_nRegionBytes = 0;
+
+	UINT							m_nRegion = 0;
+	UINT							m_nOffset = 0;			//m_nRegion ȿ   ġ
+	UINT64							m_nFrame = 0;
+
+	UINT							m_nPeakBytes = 0;		// ӿ    ũ
+	UINT							m_nOverflows = 0;		// ڶ    
+
+public:
+	bool Create(ID3D12Device *pd3dDevice, UINT nRegionBytes = FRAME_UPLOAD_REGION_BYTES);
+	// GPU  ڿ θ.
+	void Release();
+	bool IsCreated() { return(m_pd3dUploadBuffer != NULL); }
+
+	// nRegion(0 ~ FRAMES_IN_FLIGHT-1)    ϱ  θ.     GPU ۾  ־ Ѵ.
+	void BeginFrame(UINT nRegion);
+	// ̹  GPU ۾   ȿ nBytes ũ ޸𸮸 ְ  GPU ּ(nAlignment ) pd3dGpuVirtualAddress .
+	//  ʾҰų ۸    NULL ش.
+	void *Allocate(UINT nBytes, D3D12_GPU_VIRTUAL_ADDRESS *pd3dGpuVirtualAddress, UINT nAlignment = FRAME_UPLOAD_ALIGNMENT);
+
+	// ī޶ó   ȿ   ٽ     ȣ ̹ ӿ  ޸ ȮѴ.
+	UINT64 GetFrame() { return(m_nFrame); }
+	UINT GetRegionBytes() { return(m_nRegionBytes); }
+	UINT GetUsedBytes() { return(m_nOffset); }
+	UINT GetPeakBytes() { return(m_nPeakBytes); }
+	UINT GetOverflows() { return(m_nOverflows); }
+};
+
+extern CFrameUploadBuffer gFrameUploadBuffer;
@@ -0,0 +1,399 @@
+//-----------------------------------------------------------------------------
+// File: Frustum.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Frustum.h"
+#include <intrin.h>
+#include <immintrin.h>
+
+// ó   CPU ° .
+static int gnFrustumKernel = -1;
+
+inline UINT CountBits(UINT nBits)
+{
+	nBits = nBits - ((nBits >> 1) & 0x55555555);
+	nBits = (nBits & 0x33333333) + ((nBits >> 2) & 0x33333333);
+	return((((nBits + (nBits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
+
+CFrustum::CFrustum()
+{
+	for (int i = 0; i < FRUSTUM_PLANES; i++) m_pxmf4Planes[i] = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void CFrustum::ExtractPlanes(const XMFLOAT4X4& xmf4x4ViewProjection)
+{
+	//   Ծ(p * M)̹Ƿ Ŭ ǥ     ̴.
+	const XMFLOAT4X4& m = xmf4x4ViewProjection;
+	m_pxmf4Planes[0] = XMFLOAT4(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41);	//: x >= -w
+	m_pxmf4Planes[1] = XMFLOAT4(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41);	//: x <= w
+	m_pxmf4Planes[2] = XMFLOAT4(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42);	//Ʒ: y >= -w
+	m_pxmf4Planes[3] = XMFLOAT4(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42);	//: y <= w
+	m_pxmf4Planes[4] = XMFLOAT4(m._13, m._23, m._33, m._43);									//: z >= 0
+	m_pxmf4Planes[5] = XMFLOAT4(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43);	//: z <= w
+
+	for (int i = 0; i < FRUSTUM_PLANES; i++)
+	{
+		float fLength = sqrtf((m_pxmf4Planes[i].x * m_pxmf4Planes[i].x) + (m_pxmf4Planes[i].y * m_pxmf4Planes[i].y) + (m_pxmf4Planes[i].z * m_pxmf4Planes[i].z));
+		if (fLength > EPSILON) m_pxmf4Planes[i] = XMFLOAT4(m_pxmf4Planes[i].x / fLength, m_pxmf4Planes[i].y / fLength, m_pxmf4Planes[i].z / fLength, m_pxmf4Planes[i].w / fLength);
+	}
+}
+
+bool CFrustum::IsSphereVisible(const XMFLOAT3& xmf3Center, float fRadius) const
+{
+	for (int i = 0; i < FRUSTUM_PLANES; i++)
+	{
+		const XMFLOAT4& xmf4Plane = m_pxmf4Planes[i];
+		float fDistance = (xmf4Plane.x * xmf3Center.x) + (xmf4Plane.y * xmf3Center.y) + (xmf4Plane.z * xmf3Center.z) + xmf4Plane.w;
+		if (fDistance < -fRadius) return(false);
+	}
+	return(true);
+}
+
+bool CFrustum::IsBoxVisible(const XMFLOAT3& xmf3Center, const XMFLOAT3& xmf3Extents) const
+{
+	// ߽ Ÿ  ũ⸦   ̸ ϸ     (p-vertex) Ÿ̴.
+	for (int i = 0; i < FRUSTUM_PLANES; i++)
+	{
+		const XMFLOAT4& xmf4Plane = m_pxmf4Planes[i];
+		float fDistance = (xmf4Plane.x * xmf3Center.x) + (xmf4Plane.y * xmf3Center.y) + (xmf4Plane.z * xmf3Center.z) + xmf4Plane.w;
+		fDistance += (fabsf(xmf4Plane.x) * xmf3Extents.x) + (fabsf(xmf4Plane.y) * xmf3Extents.y) + (fabsf(xmf4Plane.z) * xmf3Extents.z);
+		if (fDistance < 0.0f) return(false);
+	}
+	return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ŀ [nBegin, nEnd) óѴ. SSE/AVX Ŀ 4/8  ó  ϰ  ġ ش.
+static UINT TestSpheresScalar(const CFrustum *pFrustum, const FRUSTUM_SPHERES& xSpheres, UINT nBegin, UINT nEnd, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	for (UINT i = nBegin; i < nEnd; i++)
+	{
+		if (pFrustum->IsSphereVisible(XMFLOAT3(xSpheres.m_pfCenterX[i], xSpheres.m_pfCenterY[i], xSpheres.m_pfCenterZ[i]), xSpheres.m_pfRadius[i]))
+		{
+			pnVisibleMasks[i >> 5] |= 1u << (i & 31);
+			(*pnVisible)++;
+		}
+	}
+	return(nEnd);
+}
+
+static UINT TestBoxesScalar(const CFrustum *pFrustum, const FRUSTUM_BOXES& xBoxes, UINT nBegin, UINT nEnd, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	for (UINT i = nBegin; i < nEnd; i++)
+	{
+		if (pFrustum->IsBoxVisible(XMFLOAT3(xBoxes.m_pfCenterX[i], xBoxes.m_pfCenterY[i], xBoxes.m_pfCenterZ[i]), XMFLOAT3(xBoxes.m_pfExtentX[i], xBoxes.m_pfExtentY[i], xBoxes.m_pfExtentZ[i])))
+		{
+			pnVisibleMasks[i >> 5] |= 1u << (i & 31);
+			(*pnVisible)++;
+		}
+	}
+	return(nEnd);
+}
+
+static UINT TestSpheresSse(const CFrustum *pFrustum, const FRUSTUM_SPHERES& xSpheres, UINT nCount, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	__m128 pxmmPlaneX[FRUSTUM_PLANES], pxmmPlaneY[FRUSTUM_PLANES], pxmmPlaneZ[FRUSTUM_PLANES], pxmmPlaneW[FRUSTUM_PLANES];
+	for (int j = 0; j < FRUSTUM_PLANES; j++)
+	{
+		pxmmPlaneX[j] = _mm_set1_ps(pFrustum->m_pxmf4Planes[j].x); pxmmPlaneY[j] = _mm_set1_ps(pFrustum->m_pxmf4Planes[j].y);
+		pxmmPlaneZ[j] = _mm_set1_ps(pFrustum->m_pxmf4Planes[j].z); pxmmPlaneW[j] = _mm_set1_ps(pFrustum->m_pxmf4Planes[j].w);
+	}
+
+	UINT i = 0;
+	for ( ; i + 4 <= nCount; i += 4)
+	{
+		__m128 xmmX = _mm_loadu_ps(xSpheres.m_pfCenterX + i), xmmY = _mm_loadu_ps(xSpheres.m_pfCenterY + i), xmmZ = _mm_loadu_ps(xSpheres.m_pfCenterZ + i);
+		__m128 xmmNegativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(xSpheres.m_pfRadius + i));
+		__m128 xmmOutside = _mm_setzero_ps();
+		for (int j = 0; j < FRUSTUM_PLANES; j++)
+		{
+			__m128 xmmDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, pxmmPlaneX[j]), _mm_mul_ps(xmmY, pxmmPlaneY[j])), _mm_add_ps(_mm_mul_ps(xmmZ, pxmmPlaneZ[j]), pxmmPlaneW[j]));
+			xmmOutside = _mm_or_ps(xmmOutside, _mm_cmplt_ps(xmmDistance, xmmNegativeRadius));
+		}
+		UINT nMask = ~UINT(_mm_movemask_ps(xmmOutside)) & 0x0F;
+		pnVisibleMasks[i >> 5] |= nMask << (i & 31);
+		*pnVisible += CountBits(nMask);
+	}
+	return(i);
+}
+
+static UINT TestBoxesSse(const CFrustum *pFrustum, const FRUSTUM_BOXES& xBoxes, UINT nCount, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	__m128 pxmmPlaneX[FRUSTUM_PLANES], pxmmPlaneY[FRUSTUM_PLANES], pxmmPlaneZ[FRUSTUM_PLANES], pxmmPlaneW[FRUSTUM_PLANES];
+	__m128 pxmmAbsX[FRUSTUM_PLANES], pxmmAbsY[FRUSTUM_PLANES], pxmmAbsZ[FRUSTUM_PLANES];
+	for (int j = 0; j < FRUSTUM_PLANES; j++)
+	{
+		const XMFLOAT4& xmf4Plane = pFrustum->m_pxmf4Planes[j];
+		pxmmPlaneX[j] = _mm_set1_ps(xmf4Plane.x); pxmmPlaneY[j] = _mm_set1_ps(xmf4Plane.y); pxmmPlaneZ[j] = _mm_set1_ps(xmf4Plane.z); pxmmPlaneW[j] = _mm_set1_ps(xmf4Plane.w);
+		pxmmAbsX[j] = _mm_set1_ps(fabsf(xmf4Plane.x)); pxmmAbsY[j] = _mm_set1_ps(fabsf(xmf4Plane.y)); pxmmAbsZ[j] = _mm_set1_ps(fabsf(xmf4Plane.z));
+	}
+
+	UINT i = 0;
+	for ( ; i + 4 <= nCount; i += 4)
+	{
+		__m128 xmmX = _mm_loadu_ps(xBoxes.m_pfCenterX + i), xmmY = _mm_loadu_ps(xBoxes.m_pfCenterY + i), xmmZ = _mm_loadu_ps(xBoxes.m_pfCenterZ + i);
+		__m128 xmmExtentX = _mm_loadu_ps(xBoxes.m_pfExtentX + i), xmmExtentY = _mm_loadu_ps(xBoxes.m_pfExtentY + i), xmmExtentZ = _mm_loadu_ps(xBoxes.m_pfExtentZ + i);
+		__m128 xmmOutside = _mm_setzero_ps();
+		for (int j = 0; j < FRUSTUM_PLANES; j++)
+		{
+			__m128 xmmDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, pxmmPlaneX[j]), _mm_mul_ps(xmmY, pxmmPlaneY[j])), _mm_add_ps(_mm_mul_ps(xmmZ, pxmmPlaneZ[j]), pxmmPlaneW[j]));
+			xmmDistance = _mm_add_ps(xmmDistance, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmExtentX, pxmmAbsX[j]), _mm_mul_ps(xmmExtentY, pxmmAbsY[j])), _mm_mul_ps(xmmExtentZ, pxmmAbsZ[j])));
+			xmmOutside = _mm_or_ps(xmmOutside, _mm_cmplt_ps(xmmDistance, _mm_setzero_ps()));
+		}
+		UINT nMask = ~UINT(_mm_movemask_ps(xmmOutside)) & 0x0F;
+		pnVisibleMasks[i >> 5] |= nMask << (i & 31);
+		*pnVisible += CountBits(nMask);
+	}
+	return(i);
+}
+
+static UINT TestSpheresAvx(const CFrustum *pFrustum, const FRUSTUM_SPHERES& xSpheres, UINT nCount, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	__m256 pymmPlaneX[FRUSTUM_PLANES], pymmPlaneY[FRUSTUM_PLANES], pymmPlaneZ[FRUSTUM_PLANES], pymmPlaneW[FRUSTUM_PLANES];
+	for (int j = 0; j < FRUSTUM_PLANES; j++)
+	{
+		pymmPlaneX[j] = _mm256_set1_ps(pFrustum->m_pxmf4Planes[j].x); pymmPlaneY[j] = _mm256_set1_ps(pFrustum->m_pxmf4Planes[j].y);
+		pymmPlaneZ[j] = _mm256_set1_ps(pFrustum->m_pxmf4Planes[j].z); pymmPlaneW[j] = _mm256_set1_ps(pFrustum->m_pxmf4Planes[j].w);
+	}
+
+	UINT i = 0;
+	for ( ; i + 8 <= nCount; i += 8)
+	{
+		__m256 ymmX = _mm256_loadu_ps(xSpheres.m_pfCenterX + i), ymmY = _mm256_loadu_ps(xSpheres.m_pfCenterY + i), ymmZ = _mm256_loadu_ps(xSpheres.m_pfCenterZ + i);
+		__m256 ymmNegativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(xSpheres.m_pfRadius + i));
+		__m256 ymmOutside = _mm256_setzero_ps();
+		for (int j = 0; j < FRUSTUM_PLANES; j++)
+		{
+			__m256 ymmDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, pymmPlaneX[j]), _mm256_mul_ps(ymmY, pymmPlaneY[j])), _mm256_add_ps(_mm256_mul_ps(ymmZ, pymmPlaneZ[j]), pymmPlaneW[j]));
+			ymmOutside = _mm256_or_ps(ymmOutside, _mm256_cmp_ps(ymmDistance, ymmNegativeRadius, _CMP_LT_OQ));
+		}
+		UINT nMask = ~UINT(_mm256_movemask_ps(ymmOutside)) & 0xFF;
+		pnVisibleMasks[i >> 5] |= nMask << (i & 31);
+		*pnVisible += CountBits(nMask);
+	}
+	_mm256_zeroupper();
+	return(i);
+}
+
+static UINT TestBoxesAvx(const CFrustum *pFrustum, const FRUSTUM_BOXES& xBoxes, UINT nCount, UINT *pnVisibleMasks, UINT *pnVisible)
+{
+	__m256 pymmPlaneX[FRUSTUM_PLANES], pymmPlaneY[FRUSTUM_PLANES], pymmPlaneZ[FRUSTUM_PLANES], pymmPlaneW[FRUSTUM_PLANES];
+	__m256 pymmAbsX[FRUSTUM_PLANES], pymmAbsY[FRUSTUM_PLANES], pymmAbsZ[FRUSTUM_PLANES];
+	for (int j = 0; j < FRUSTUM_PLANES; j++)
+	{
+		const XMFLOAT4& xmf4Plane = pFrustum->m_pxmf4Planes[j];
+		pymmPlaneX[j] = _mm256_set1_ps(xmf4Plane.x); pymmPlaneY[j] = _mm256_set1_ps(xmf4Plane.y); pymmPlaneZ[j] = _mm256_set1_ps(xmf4Plane.z); pymmPlaneW[j] = _mm256_set1_ps(xmf4Plane.w);
+		pymmAbsX[j] = _mm256_set1_ps(fabsf(xmf4Plane.x)); pymmAbsY[j] = _mm256_set1_ps(fabsf(xmf4Plane.y)); pymmAbsZ[j] = _mm256_set1_ps(fabsf(xmf4Plane.z));
+	}
+
+	UINT i = 0;
+	for ( ; i + 8 <= nCount; i += 8)
+	{
+		__m256 ymmX = _mm256_loadu_ps(xBoxes.m_pfCenterX + i), ymmY = _mm256_loadu_ps(xBoxes.m_pfCenterY + i), ymmZ = _mm256_loadu_ps(xBoxes.m_pfCenterZ + i);
+		__m256 ymmExtentX = _mm256_loadu_ps(xBoxes.m_pfExtentX + i), ymmExtentY = _mm256_loadu_ps(xBoxes.m_pfExtentY + i), ymmExtentZ = _mm256_loadu_ps(xBoxes.m_pfExtentZ + i);
+		__m256 ymmOutside = _mm256_setzero_ps();
+		for (int j = 0; j < FRUSTUM_PLANES; j++)
+		{
+			__m256 ymmDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmX, pymmPlaneX[j]), _mm256_mul_ps(ymmY, pymmPlaneY[j])), _mm256_add_ps(_mm256_mul_ps(ymmZ, pymmPlaneZ[j]), pymmPlaneW[j]));
+			ymmDistance = _mm256_add_ps(ymmDistance, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ymmExtentX, pymmAbsX[j]), _mm256_mul_ps(ymmExtentY, pymmAbsY[j])), _mm256_mul_ps(ymmExtentZ, pymmAbsZ[j])));
+			ymmOutside = _mm256_or_ps(ymmOutside, _mm256_cmp_ps(ymmDistance, _mm256_setzero_ps(), _CMP_LT_OQ));
+		}
+		UINT nMask = ~UINT(_mm256_movemask_ps(ymmOutside)) & 0xFF;
+		pnVisibleMasks[i >> 5] |= nMask << (i & 31);
+		*pnVisible += CountBits(nMask);
+	}
+	_mm256_zeroupper();
+	return(i);
+}
+
+UINT CFrustum::TestSpheres(const FRUSTUM_SPHERES& xSpheres, UINT nSpheres, UINT *pnVisibleMasks) const
+{
+	::memset(pnVisibleMasks, 0, ((nSpheres + 31) / 32) * sizeof(UINT));
+
+	UINT nVisible = 0, nTested = 0;
+	int nKernel = GetKernel();
+	if (nKernel == FRUSTUM_KERNEL_AVX)
+		nTested = TestSpheresAvx(this, xSpheres, nSpheres, pnVisibleMasks, &nVisible);
+	else if (nKernel == FRUSTUM_KERNEL_SSE)
+		nTested = TestSpheresSse(this, xSpheres, nSpheres, pnVisibleMasks, &nVisible);
+	TestSpheresScalar(this, xSpheres, nTested, nSpheres, pnVisibleMasks, &nVisible);
+
+	return(nVisible);
+}
+
+UINT CFrustum::TestBoxes(const FRUSTUM_BOXES& xBoxes, UINT nBoxes, UINT *pnVisibleMasks) const
+{
+	::memset(pnVisibleMasks, 0, ((nBoxes + 31) / 32) * sizeof(UINT));
+
+	UINT nVisible = 0, nTested = 0;
+	int nKernel = GetKernel();
+	if (nKernel == FRUSTUM_KERNEL_AVX)
+		nTested = TestBoxesAvx(this, xBoxes, nBoxes, pnVisibleMasks, &nVisible);
+	else if (nKernel == FRUSTUM_KERNEL_SSE)
+		nTested = TestBoxesSse(this, xBoxes, nBoxes, pnVisibleMasks, &nVisible);
+	TestBoxesScalar(this, xBoxes, nTested, nBoxes, pnVisibleMasks, &nVisible);
+
+	return(nVisible);
+}
+
+bool CFrustum::IsAvxSupported()
+{
+	// CPU AVX ϰ ü YMM ͸ (OSXSAVE, XCR0 1, 2 Ʈ)ؾ Ѵ.
+	int pnRegisters[4];
+	__cpuid(pnRegisters, 1);
+	bool bAvx = ((pnRegisters[2] & (1 << 28)) != 0) && ((pnRegisters[2] & (1 << 27)) != 0);
+	return(bAvx && ((_xgetbv(0) & 0x06) == 0x06));
+}
+
+int CFrustum::GetKernel()
+{
+	if (gnFrustumKernel < 0) gnFrustumKernel = IsAvxSupported() ? FRUSTUM_KERNEL_AVX : FRUSTUM_KERNEL_SSE;
+	return(gnFrustumKernel);
+}
+
+void CFrustum::SetKernel(int nKernel)
+{
+	if ((nKernel == FRUSTUM_KERNEL_AVX) && !IsAvxSupported()) return;
+	gnFrustumKernel = nKernel;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+static float RandomFloat(float fMin, float fMax)
+{
+	return(fMin + ((fMax - fMin) * (float(rand()) / float(RAND_MAX))));
+}
+
+bool CFrustum::RunTests(LPCTSTR pszFileName)
+{
+	const UINT nFrustums = 64;
+	const UINT nTestBounds = 4093;				//8  ƴϹǷ SSE/AVX ڿ  鵵 Į ˻ 񱳵ȴ
+	const UINT nBenchmarkBounds = 1 << 20;
+	const UINT nBenchmarkIterations = 16;
+
+	srand(37);
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+	TCHAR pstrReport[160];
+	auto Report = [&]()
+	{
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+	};
+
+	// ī޶ ֺ 3000 ȿ   ڸ  ´.
+	UINT nBounds = max(nTestBounds, nBenchmarkBounds);
+	vector<float> vfCenterX(nBounds), vfCenterY(nBounds), vfCenterZ(nBounds), vfRadius(nBounds), vfExtentX(nBounds), vfExtentY(nBounds), vfExtentZ(nBounds);
+	for (UINT i = 0; i < nBounds; i++)
+	{
+		vfCenterX[i] = RandomFloat(-3000.0f, 3000.0f); vfCenterY[i] = RandomFloat(-3000.0f, 3000.0f); vfCenterZ[i] = RandomFloat(-3000.0f, 3000.0f);
+		vfRadius[i] = RandomFloat(1.0f, 100.0f);
+		vfExtentX[i] = RandomFloat(1.0f, 100.0f); vfExtentY[i] = RandomFloat(1.0f, 100.0f); vfExtentZ[i] = RandomFloat(1.0f, 100.0f);
+	}
+	FRUSTUM_SPHERES xSpheres = { vfCenterX.data(), vfCenterY.data(), vfCenterZ.data(), vfRadius.data() };
+	FRUSTUM_BOXES xBoxes = { vfCenterX.data(), vfCenterY.data(), vfCenterZ.data(), vfExtentX.data(), vfExtentY.data(), vfExtentZ.data() };
+
+	int nRestoreKernel = GetKernel();
+	int nKernels = IsAvxSupported() ? 3 : 2;
+	LPCTSTR ppszKernels[3] = { _T("Scalar"), _T("SSE"), _T("AVX") };
+
+	// 1. Ȯ:  ˻ BoundingFrustum ģٰ ϴ 踦   ǰ(ħ), Ŀγ  ƾ Ѵ.
+	XMMATRIX xmmtxProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), ASPECT_RATIO, 1.01f, 5000.0f);
+	UINT nWords = (nTestBounds + 31) / 32;
+	vector<UINT> vnReferenceMasks(nWords), vnMasks(nWords);
+	UINT nMissedSpheres = 0, nMissedBoxes = 0, nExtraSpheres = 0, nExtraBoxes = 0, nKernelMismatches = 0, nVisibleSpheres = 0, nVisibleBoxes = 0;
+	for (UINT f = 0; f < nFrustums; f++)
+	{
+		XMFLOAT3 xmf3Eye(RandomFloat(-500.0f, 500.0f), RandomFloat(-500.0f, 500.0f), RandomFloat(-500.0f, 500.0f));
+		XMFLOAT3 xmf3Look(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+		if (Vector3::Length(xmf3Look) < 0.1f) xmf3Look = XMFLOAT3(0.0f, 0.0f, 1.0f);
+		XMFLOAT3 xmf3Up = (fabsf(Vector3::Normalize(xmf3Look).y) > 0.99f) ? XMFLOAT3(1.0f, 0.0f, 0.0f) : XMFLOAT3(0.0f, 1.0f, 0.0f);
+		XMMATRIX xmmtxView = XMMatrixLookToLH(XMLoadFloat3(&xmf3Eye), XMLoadFloat3(&xmf3Look), XMLoadFloat3(&xmf3Up));
+
+		XMFLOAT4X4 xmf4x4ViewProjection;
+		XMStoreFloat4x4(&xmf4x4ViewProjection, XMMatrixMultiply(xmmtxView, xmmtxProjection));
+		CFrustum xFrustum;
+		xFrustum.ExtractPlanes(xmf4x4ViewProjection);
+
+		BoundingFrustum xmBoundingFrustum(xmmtxProjection);
+		xmBoundingFrustum.Transform(xmBoundingFrustum, XMMatrixInverse(NULL, xmmtxView));
+
+		for (int nShape = 0; nShape < 2; nShape++)
+		{
+			SetKernel(FRUSTUM_KERNEL_SCALAR);
+			UINT nVisible = (nShape == 0) ? xFrustum.TestSpheres(xSpheres, nTestBounds, vnReferenceMasks.data()) : xFrustum.TestBoxes(xBoxes, nTestBounds, vnReferenceMasks.data());
+			((nShape == 0) ? nVisibleSpheres : nVisibleBoxes) += nVisible;
+
+			for (UINT i = 0; i < nTestBounds; i++)
+			{
+				bool bVisible = (vnReferenceMasks[i >> 5] & (1u << (i & 31))) != 0;
+				bool bIntersects = (nShape == 0) ? xmBoundingFrustum.Intersects(BoundingSphere(XMFLOAT3(vfCenterX[i], vfCenterY[i], vfCenterZ[i]), vfRadius[i])) : xmBoundingFrustum.Intersects(BoundingBox(XMFLOAT3(vfCenterX[i], vfCenterY[i], vfCenterZ[i]), XMFLOAT3(vfExtentX[i], vfExtentY[i], vfExtentZ[i])));
+				if (bIntersects && !bVisible) ((nShape == 0) ? nMissedSpheres : nMissedBoxes)++;
+				if (!bIntersects && bVisible) ((nShape == 0) ? nExtraSpheres : nExtraBoxes)++;
+			}
+
+			for (int nKernel = FRUSTUM_KERNEL_SSE; nKernel < nKernels; nKernel++)
+			{
+				SetKernel(nKernel);
+				if (nShape == 0) xFrustum.TestSpheres(xSpheres, nTestBounds, vnMasks.data()); else xFrustum.TestBoxes(xBoxes, nTestBounds, vnMasks.data());
+				if (vnMasks != vnReferenceMasks) nKernelMismatches++;
+			}
+		}
+	}
+
+	bool bPassed = (nMissedSpheres == 0) && (nMissedBoxes == 0) && (nKernelMismatches == 0);
+	_stprintf_s(pstrReport, 160, _T("Frustums: %u  Bounds: %u  Visible spheres: %u  Visible boxes: %u\n"), nFrustums, nTestBounds, nVisibleSpheres, nVisibleBoxes);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("BoundingFrustum: missed spheres %u, missed boxes %u (must be 0)  conservative extras %u, %u\n"), nMissedSpheres, nMissedBoxes, nExtraSpheres, nExtraBoxes);
+	Report();
+	_stprintf_s(pstrReport, 160, _T("Kernel mismatches against scalar: %u\n"), nKernelMismatches);
+	Report();
+
+	// 2. ó:  ü 2^20 ݺؼ ˻Ѵ.
+	XMMATRIX xmmtxView = XMMatrixLookToLH(XMVectorZero(), XMVectorSet(0.3f, -0.1f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMFLOAT4X4 xmf4x4ViewProjection;
+	XMStoreFloat4x4(&xmf4x4ViewProjection, XMMatrixMultiply(xmmtxView, xmmtxProjection));
+	CFrustum xFrustum;
+	xFrustum.ExtractPlanes(xmf4x4ViewProjection);
+	vector<UINT> vnBenchmarkMasks((nBenchmarkBounds + 31) / 32);
+	for (int nKernel = FRUSTUM_KERNEL_SCALAR; nKernel < nKernels; nKernel++)
+	{
+		SetKernel(nKernel);
+		for (int nShape = 0; nShape < 2; nShape++)
+		{
+			UINT nVisible = 0;
+			auto tStart = std::chrono::high_resolution_clock::now();
+			for (UINT k = 0; k < nBenchmarkIterations; k++) nVisible += (nShape == 0) ? xFrustum.TestSpheres(xSpheres, nBenchmarkBounds, vnBenchmarkMasks.data()) : xFrustum.TestBoxes(xBoxes, nBenchmarkBounds, vnBenchmarkMasks.data());
+			double fTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+			_stprintf_s(pstrReport, 160, _T("%-6s %-7s %8.3f ms  %8.1f Mbounds/s  (visible %u)\n"), ppszKernels[nKernel], (nShape == 0) ? _T("Spheres") : _T("Boxes"), fTime, (double(nBenchmarkBounds) * nBenchmarkIterations) / (fTime * 1000.0), nVisible / nBenchmarkIterations);
+			Report();
+		}
+	}
+	SetKernel(nRestoreKernel);
+
+	//  : DirectX::BoundingFrustum ϳ ˻Ѵ.
+	BoundingFrustum xmBoundingFrustum(xmmtxProjection);
+	xmBoundingFrustum.Transform(xmBoundingFrustum, XMMatrixInverse(NULL, xmmtxView));
+	for (int nShape = 0; nShape < 2; nShape++)
+	{
+		UINT nVisible = 0;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (UINT i = 0; i < nBenchmarkBounds; i++)
+		{
+			bool bIntersects = (nShape == 0) ? xmBoundingFrustum.Intersects(BoundingSphere(XMFLOAT3(vfCenterX[i], vfCenterY[i], vfCenterZ[i]), vfRadius[i])) : xmBoundingFrustum.Intersects(BoundingBox(XMFLOAT3(vfCenterX[i], vfCenterY[i], vfCenterZ[i]), XMFLOAT3(vfExtentX[i], vfExtentY[i], vfExtentZ[i])));
+			if (bIntersects) nVisible++;
+		}
+		double fTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+		_stprintf_s(pstrReport, 160, _T("%-6s %-7s %8.3f ms  %8.1f Mbounds/s  (visible %u, 1 pass)\n"), _T("DXMath"), (nShape == 0) ? _T("Spheres") : _T("Boxes"), fTime, double(nBenchmarkBounds) / (fTime * 1000.0), nVisible);
+		Report();
+	}
+
+	_stprintf_s(pstrReport, 160, _T("Frustum Tests: %s\n"), bPassed ? _T("PASSED") : _T("FAILED"));
+	Report();
+	if (pFile) fclose(pFile);
+
+	return(bPassed);
+}
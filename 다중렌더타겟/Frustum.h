@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------------------
+// File: Frustum.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define FRUSTUM_PLANES				6
+
+#define FRUSTUM_KERNEL_SCALAR		0
+#define FRUSTUM_KERNEL_SSE			1			//4
+#define FRUSTUM_KERNEL_AVX			2			//8
+
+//   迭(SoA)
+struct FRUSTUM_SPHERES
+{
+	const float						*m_pfCenterX;
+	const float						*m_pfCenterY;
+	const float						*m_pfCenterZ;
+	const float						*m_pfRadius;
+};
+
+//     迭(SoA, ߽ɰ  ũ)
+struct FRUSTUM_BOXES
+{
+	const float						*m_pfCenterX;
+	const float						*m_pfCenterY;
+	const float						*m_pfCenterZ;
+	const float						*m_pfExtentX;
+	const float						*m_pfExtentY;
+	const float						*m_pfExtentZ;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ü  6(, , Ʒ, , , ).   ϰ ̴ 1̴. (ax + by + cz + d >= 0  )
+// TestSpheres()/TestBoxes()   ʿ ġ 踦 ̴  Ͽ i°  
+// pnVisibleMasks[i / 32] (i % 32)° Ʈ  ̴   ش. (pnVisibleMasks (n + 31) / 32)
+//  ˻縸 ϹǷ ü 𼭸 ٱ 踦 ̴     ̴ 踦  ʴ´.
+class CFrustum
+{
+public:
+	CFrustum();
+	~CFrustum() { }
+
+	XMFLOAT4						m_pxmf4Planes[FRUSTUM_PLANES];
+
+	void ExtractPlanes(const XMFLOAT4X4& xmf4x4ViewProjection);
+
+	bool IsSphereVisible(const XMFLOAT3& xmf3Center, float fRadius) const;
+	bool IsBoxVisible(const XMFLOAT3& xmf3Center, const XMFLOAT3& xmf3Extents) const;
+
+	UINT TestSpheres(const FRUSTUM_SPHERES& xSpheres, UINT nSpheres, UINT *pnVisibleMasks) const;
+	UINT TestBoxes(const FRUSTUM_BOXES& xBoxes, UINT nBoxes, UINT *pnVisibleMasks) const;
+
+	//   CPU ϴ   Ŀ . SetKernel() ٲ  ִ. (  Ѵ)
+	static int GetKernel();
+	static void SetKernel(int nKernel);
+	static bool IsAvxSupported();
+
+	// DirectX::BoundingFrustum  ϰ Ŀκ ó 缭 ϰ  ¿ .
+	static bool RunTests(LPCTSTR pszFileName);
+};
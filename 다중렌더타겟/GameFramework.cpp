@@ -5,6 +5,11 @@
 #include "stdafx.h"
 #include "GameFramework.h"
 
+#define _WITH_FIXED_TIMESTEP
+
+#define FIXED_TIMESTEP				(1.0f / 60.0f)
+#define MAX_SIMULATION_STEPS		5			// ӿ  ִ   (Ѵ ð )
+
 CGameFramework::CGameFramework()
 {
 	m_pdxgiFactory = NULL;
@@ -14,7 +19,8 @@ CGameFramework::CGameFramework()
 	for (int i = 0; i < m_nSwapChainBuffers; i++) m_ppd3dSwapChainBackBuffers[i] = NULL;
 	m_nSwapChainBufferIndex = 0;
 
-	m_pd3dCommandAllocator = NULL;
+	for (int i = 0; i < FRAMES_IN_FLIGHT; i++) ::ZeroMemory(&m_pFrameContexts[i], sizeof(FRAME_CONTEXT));
+	m_nFrameContext = 0;
 	m_pd3dCommandQueue = NULL;
 	m_pd3dCommandList = NULL;
 
@@ -26,7 +32,7 @@ CGameFramework::CGameFramework()
 
 	m_hFenceEvent = NULL;
 	m_pd3dFence = NULL;
-	for (int i = 0; i < m_nSwapChainBuffers; i++) m_nFenceValues[i] = 0;
+	m_nFenceValue = 0;
 
 	m_nWndClientWidth = FRAME_BUFFER_WIDTH;
 	m_nWndClientHeight = FRAME_BUFFER_HEIGHT;
@@ -35,6 +41,7 @@ CGameFramework::CGameFramework()
 	m_pPlayer = NULL;
 
 	_tcscpy_s(m_pszFrameRate, _T("LabProject ("));
+	_tcscpy_s(m_pszInputFileName, INPUT_FILE_NAME);
 }
 
 CGameFramework::~CGameFramework()
@@ -46,6 +53,8 @@ bool CGameFramework::OnCreate(HINSTANCE hInstance, HWND hMainWnd)
 	m_hInstance = hInstance;
 	m_hWnd = hMainWnd;
 
+	::gJobSystem.Initialize();
+
 	CreateDirect3DDevice();
 	CreateCommandQueueAndList();
 	CreateRtvAndDsvDescriptorHeaps();
@@ -55,9 +64,7 @@ bool CGameFramework::OnCreate(HINSTANCE hInstance, HWND hMainWnd)
 
 	CreateOffScreenRenderTargetViews();
 
-	BuildObjects();
-
-	return(true);
+	return(BuildObjects());
 }
 
 //#define _WITH_SWAPCHAIN
@@ -149,7 +156,8 @@ void CGameFramework::CreateDirect3DDevice()
 
 	IDXGIAdapter1 *pd3dAdapter = NULL;
 
-	for (UINT i = 0; DXGI_ERROR_NOT_FOUND != m_pdxgiFactory->EnumAdapters1(i, &pd3dAdapter); i++)
+	// 帮 ġũ GPU      ֵ WARP(Ʈ) ͸ .
+	for (UINT i = 0; !m_bWarpDevice && (DXGI_ERROR_NOT_FOUND != m_pdxgiFactory->EnumAdapters1(i, &pd3dAdapter)); i++)
 	{
 		DXGI_ADAPTER_DESC1 dxgiAdapterDesc;
 		pd3dAdapter->GetDesc1(&dxgiAdapterDesc);
@@ -180,7 +188,6 @@ void CGameFramework::CreateDirect3DDevice()
 	m_bMsaa4xEnable = (m_nMsaa4xQualityLevels > 1) ? true : false;
 
 	hResult = m_pd3dDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, __uuidof(ID3D12Fence), (void **)&m_pd3dFence);
-	for (UINT i = 0; i < m_nSwapChainBuffers; i++) m_nFenceValues[i] = 1;
 	m_hFenceEvent = ::CreateEvent(NULL, FALSE, FALSE, NULL);
 
 	::gnCbvSrvDescriptorIncrementSize = m_pd3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -196,10 +203,23 @@ void CGameFramework::CreateCommandQueueAndList()
 	d3dCommandQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
 	HRESULT hResult = m_pd3dDevice->CreateCommandQueue(&d3dCommandQueueDesc, _uuidof(ID3D12CommandQueue), (void **)&m_pd3dCommandQueue);
 
-	hResult = m_pd3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, __uuidof(ID3D12CommandAllocator), (void **)&m_pd3dCommandAllocator);
+	// GPU   ϴ    ϹǷ  ڸ Ҵڸ  д.
+	for (int i = 0; i < FRAMES_IN_FLIGHT; i++)
+	{
+		hResult = m_pd3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, __uuidof(ID3D12CommandAllocator), (void **)&m_pFrameContexts[i].m_pd3dCommandAllocator);
+	}
 
-	hResult = m_pd3dDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_pd3dCommandAllocator, NULL, __uuidof(ID3D12GraphicsCommandList), (void **)&m_pd3dCommandList);
+	hResult = m_pd3dDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, GetCommandAllocator(), NULL, __uuidof(ID3D12GraphicsCommandList), (void **)&m_pd3dCommandList);
 	hResult = m_pd3dCommandList->Close();
+
+	::gFrameUploadBuffer.Create(m_pd3dDevice);
+
+	// Ӹ GPU_TIMER_QUERIES_PER_FRAME Ÿӽ GPU_TIMER_FRAMES    ִ´.
+	CD3D12TimestampBackend *pTimestampBackend = new CD3D12TimestampBackend(m_pd3dDevice, m_pd3dCommandQueue, GPU_TIMER_FRAMES * GPU_TIMER_QUERIES_PER_FRAME);
+	if (pTimestampBackend->IsValid())
+		::gGpuTimer.SetBackend(pTimestampBackend);
+	else
+		delete pTimestampBackend;
 }
 
 void CGameFramework::CreateSwapChainRenderTargetViews()
@@ -216,6 +236,7 @@ void CGameFramework::CreateSwapChainRenderTargetViews()
 	{
 		m_pd3dRtvSwapChainBackBufferCPUHandles[i] = d3dRtvCPUDescriptorHandle;
 		m_pdxgiSwapChain->GetBuffer(i, __uuidof(ID3D12Resource), (void **)&m_ppd3dSwapChainBackBuffers[i]);
+		::gMemoryTracker.TrackResource(m_ppd3dSwapChainBackBuffers[i], MEMORY_TAG_RENDER_TARGET);
 		m_pd3dDevice->CreateRenderTargetView(m_ppd3dSwapChainBackBuffers[i], &d3dRenderTargetViewDesc, m_pd3dRtvSwapChainBackBufferCPUHandles[i]);
 		d3dRtvCPUDescriptorHandle.ptr += m_nRtvDescriptorIncrementSize;
 	}
@@ -244,6 +265,7 @@ void CGameFramework::CreateRenderTargetViews()
 	for (UINT i = 0; i < m_nSwapChainBuffers; i++)
 	{
 		m_pdxgiSwapChain->GetBuffer(i, __uuidof(ID3D12Resource), (void **)&m_ppd3dSwapChainBackBuffers[i]);
+		::gMemoryTracker.TrackResource(m_ppd3dSwapChainBackBuffers[i], MEMORY_TAG_RENDER_TARGET);
 		m_pd3dDevice->CreateRenderTargetView(m_ppd3dSwapChainBackBuffers[i], NULL, d3dRtvCPUDescriptorHandle);
 		d3dRtvCPUDescriptorHandle.ptr += m_nRtvDescriptorIncrementSize;
 	}
@@ -278,6 +300,7 @@ void CGameFramework::CreateDepthStencilView()
 	d3dClearValue.DepthStencil.Stencil = 0;
 
 	m_pd3dDevice->CreateCommittedResource(&d3dHeapProperties, D3D12_HEAP_FLAG_NONE, &d3dResourceDesc, D3D12_RESOURCE_STATE_DEPTH_WRITE, &d3dClearValue, __uuidof(ID3D12Resource), (void **)&m_pd3dDepthStencilBuffer);
+	::gMemoryTracker.TrackResource(m_pd3dDepthStencilBuffer, MEMORY_TAG_RENDER_TARGET);
 
 	m_d3dDsvDepthStencilBufferCPUHandle = m_pd3dDsvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
 	m_pd3dDevice->CreateDepthStencilView(m_pd3dDepthStencilBuffer, NULL, m_d3dDsvDepthStencilBufferCPUHandle);
@@ -287,7 +310,9 @@ void CGameFramework::OnResizeBackBuffers()
 {
 	WaitForGpuComplete();
 
-	m_pd3dCommandList->Reset(m_pd3dCommandAllocator, NULL);
+	GetCommandAllocator()->Reset();
+	m_pd3dCommandList->Reset(GetCommandAllocator(), NULL);
+	::gFilteredCommandList.Begin(m_pd3dCommandList);
 
 	for (int i = 0; i < m_nSwapChainBuffers; i++) if (m_ppd3dSwapChainBackBuffers[i]) m_ppd3dSwapChainBackBuffers[i]->Release();
 	if (m_pd3dDepthStencilBuffer) m_pd3dDepthStencilBuffer->Release();
@@ -310,6 +335,7 @@ void CGameFramework::OnResizeBackBuffers()
 
 	ID3D12CommandList *ppd3dCommandLists[] ={ m_pd3dCommandList };
 	m_pd3dCommandQueue->ExecuteCommandLists(1, ppd3dCommandLists);
+	::gRenderStats.Add(RENDER_STAT_COMMAND_LISTS);
 
 	WaitForGpuComplete();
 }
@@ -413,9 +439,39 @@ void CGameFramework::OnProcessingKeyboardMessage(HWND hWnd, UINT nMessageID, WPA
 		case VK_F1:
 		case VK_F2:
 		case VK_F3:
-			m_pCamera = m_pPlayer->ChangeCamera((DWORD)(wParam - VK_F1 + 1), m_GameTimer.GetTimeElapsed());
+			// ī޶ 浵 Է ϵǵ  ùķ̼ ܿ ٲ۴.
+			m_nInputCameraMode = (DWORD)(wParam - VK_F1 + 1);
 			//					m_pCamera->CreateShaderVariables(m_pd3dDevice, m_pd3dCommandList);
 			break;
+		case VK_F5:
+			CGpuTimer::RunMockTest(_T("GpuTimerTest.txt"));
+			break;
+		case VK_INSERT:
+			::RunFramePacerTest(_T("FramePacerTest.txt"));
+			break;
+		case VK_HOME:
+			::gMemoryTracker.WriteReport(MEMORY_REPORT_NAME);
+			break;
+		case VK_END:
+			//   ̴  
+			::gRenderStats.Dump();
+			::gRenderStats.WriteReport(RENDER_STATS_REPORT_NAME);
+			break;
+		case VK_F4:
+			//   ĸ Ʈ 512 ̵ 浹 ó .
+			if (m_pScene && m_pScene->GetCollisionWorld()) m_pScene->GetCollisionWorld()->RunBenchmark(_T("CollisionBenchmark.txt"), 512);
+			break;
+		case VK_F6:
+			CFrustum::RunTests(_T("FrustumTest.txt"));
+			break;
+		case VK_F7:
+			//     ۸ ̹  ռ   ̹ ȸ ˻縦 Ѵ.
+			if (m_pScene && m_pScene->GetOcclusionCuller()) m_pScene->GetOcclusionCuller()->WriteDepthImage(_T("OcclusionDepth.pgm"));
+			COcclusionCuller::RunReferenceTest(_T("Tests/OcclusionReference.pgm"), _T("OcclusionReport.txt"));
+			break;
+		case VK_F8:
+			CBoundingVolumeHierarchy::RunBenchmark(_T("BvhBenchmark.txt"));
+			break;
 		case VK_F9:
 		{
 			BOOL bFullScreenState = FALSE;
@@ -436,7 +492,16 @@ void CGameFramework::OnProcessingKeyboardMessage(HWND hWnd, UINT nMessageID, WPA
 
 			break;
 		}
+		case VK_F11:
+			::gJobSystem.RunScalingBenchmark(_T("JobSystemBenchmark.txt"));
+			if (m_pScene) m_pScene->RunAnimationScalingTest(_T("AnimationScaling.txt"));
+			break;
+		case VK_F12:
+			::gProfiler.StartCapture();
+			break;
 		case VK_F10:
+			::gFilteredCommandList.OutputDebugCounters();
+			::gFilteredCommandList.SetEnabled(!::gFilteredCommandList.IsEnabled());
 			break;
 		default:
 			break;
@@ -484,8 +549,18 @@ LRESULT CALLBACK CGameFramework::OnProcessingWindowMessage(HWND hWnd, UINT nMess
 
 void CGameFramework::OnDestroy()
 {
+	::gProfiler.WriteAtExit();
+
+	if (m_InputStream.IsRecording()) m_InputStream.StopRecording(m_xCurrentPlayerState.m_xmf3Position);
+	if (m_pBenchmark) delete m_pBenchmark;
+	m_pBenchmark = NULL;
+
 	ReleaseObjects();
 
+	::gJobSystem.Shutdown();
+	::gGpuTimer.Release();
+	::gFrameUploadBuffer.Release();
+
 	::CloseHandle(m_hFenceEvent);
 
 #if defined(_DEBUG)
@@ -498,7 +573,7 @@ void CGameFramework::OnDestroy()
 	for (int i = 0; i < m_nSwapChainBuffers; i++) if (m_ppd3dSwapChainBackBuffers[i]) m_ppd3dSwapChainBackBuffers[i]->Release();
 	if (m_pd3dRtvDescriptorHeap) m_pd3dRtvDescriptorHeap->Release();
 
-	if (m_pd3dCommandAllocator) m_pd3dCommandAllocator->Release();
+	for (int i = 0; i < FRAMES_IN_FLIGHT; i++) if (m_pFrameContexts[i].m_pd3dCommandAllocator) m_pFrameContexts[i].m_pd3dCommandAllocator->Release();
 	if (m_pd3dCommandQueue) m_pd3dCommandQueue->Release();
 	if (m_pd3dCommandList) m_pd3dCommandList->Release();
 
@@ -510,43 +585,133 @@ void CGameFramework::OnDestroy()
 	if (m_pdxgiFactory) m_pdxgiFactory->Release();
 }
 
-void CGameFramework::BuildObjects()
+bool CGameFramework::BuildObjects()
 {
-	m_pd3dCommandList->Reset(m_pd3dCommandAllocator, NULL);
+	PROFILE_FUNCTION();
+
+	m_pd3dCommandList->Reset(GetCommandAllocator(), NULL);
+	::gFilteredCommandList.Begin(m_pd3dCommandList);
+
+	auto tBuildStart = std::chrono::high_resolution_clock::now();
+	UINT nAllocations = ::gObjectPool.GetAllocations();
 
 	m_pScene = new CScene();
-	m_pScene->BuildObjects(m_pd3dDevice, m_pd3dCommandList);
+	if (!m_pScene->BuildObjects(m_pd3dDevice, m_pd3dCommandList))
+	{
+		m_pd3dCommandList->Close();
+		delete m_pScene;
+		m_pScene = NULL;
+		MessageBox(NULL, L"Scene Data Cannot be Loaded.", L"Error", MB_OK);
+		return(false);
+	}
 
-	m_pPostProcessingShader = new CPostProcessingShader();
-	m_pPostProcessingShader->CreateShader(m_pd3dDevice, m_pScene->GetGraphicsRootSignature());
-	m_pPostProcessingShader->BuildObjects(m_pd3dDevice, m_pd3dCommandList, pTextureForPostProcessing);
+	{
+		PROFILE_SCOPE("CGameFramework::BuildObjects(PostProcessing)");
+		m_pPostProcessingShader = new CPostProcessingShader();
+		m_pPostProcessingShader->CreateShader(m_pd3dDevice, m_pScene->GetGraphicsRootSignature());
+		m_pPostProcessingShader->BuildObjects(m_pd3dDevice, m_pd3dCommandList, pTextureForPostProcessing);
+	}
 
-	m_pScene->m_pPlayer = m_pPlayer = new CTerrainPlayer(m_pd3dDevice, m_pd3dCommandList, m_pScene->GetGraphicsRootSignature(), m_pScene->GetTerrain(), 1);
+	CTerrainPlayer *pTerrainPlayer = new CTerrainPlayer(m_pd3dDevice, m_pd3dCommandList, m_pScene->GetGraphicsRootSignature(), m_pScene->GetTerrain(), 1);
+	pTerrainPlayer->SetCollisionWorld(m_pScene->GetCollisionWorld());
+	m_pScene->m_pPlayer = m_pPlayer = pTerrainPlayer;
 	m_pCamera = m_pPlayer->GetCamera();
+	ResetSimulationState();
+
+	if (m_pBenchmark) m_pBenchmark->BuildPath(m_pScene->GetTerrain());
+
+	if (m_nInputStreamMode == INPUT_STREAM_RECORD) m_InputStream.StartRecording(m_pszInputFileName, FIXED_TIMESTEP);
+	if ((m_nInputStreamMode == INPUT_STREAM_REPLAY) && !m_InputStream.StartReplay(m_pszInputFileName))
+	{
+		TCHAR pstrDebug[MAX_PATH + 64];
+		_stprintf_s(pstrDebug, MAX_PATH + 64, _T("Input: cannot replay %s\n"), m_pszInputFileName);
+		::OutputDebugString(pstrDebug);
+	}
+	m_tReplayStart = std::chrono::high_resolution_clock::now();
 
 	m_pd3dCommandList->Close();
 	ID3D12CommandList *ppd3dCommandLists[] ={ m_pd3dCommandList };
 	m_pd3dCommandQueue->ExecuteCommandLists(1, ppd3dCommandLists);
+	::gRenderStats.Add(RENDER_STAT_COMMAND_LISTS);
 
 	WaitForGpuComplete();
 	if (m_pScene) m_pScene->ReleaseUploadBuffers();
 
+	m_fBuildTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tBuildStart).count();
+	m_nBuildAllocations = ::gObjectPool.GetAllocations() - nAllocations;
+	m_nBuildPoolBlocks = ::gObjectPool.GetBlocks();
+	m_nBuildArenaAllocations = ::gLevelArena.GetAllocations();
+	m_nBuildArenaBytes = ::gLevelArena.GetAllocatedBytes();
+
 	m_GameTimer.Reset();
+
+	return(true);
 }
 
 void CGameFramework::ReleaseObjects()
 {
+	WaitForGpuComplete();
+
+	auto tTeardownStart = std::chrono::high_resolution_clock::now();
+	UINT nFrees = ::gObjectPool.GetFrees();
+
 	if (m_pPlayer) delete m_pPlayer;
 
 	if (m_pScene) m_pScene->ReleaseObjects();
 	if (m_pScene) delete m_pScene;
+
+	// ó ̴ ũ ؽó Ѵ.
+	if (m_pPostProcessingShader) m_pPostProcessingShader->Release();
+	m_pPostProcessingShader = NULL;
+	pTextureForPostProcessing = NULL;
+
+	// GPU  Ƿ  ü ٷ .
+	::gDeferredDeletionQueue.Flush();
+
+	//  ü ȯǾ Ǯ    Ѵ.
+	bool bBlocksReleased = ::gObjectPool.ReleaseBlocks();
+
+	double fTeardownTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tTeardownStart).count();
+	WriteMemoryPoolReport(_T("MemoryPoolReport.txt"), fTeardownTime, ::gObjectPool.GetFrees() - nFrees, bBlocksReleased);
+}
+
+void CGameFramework::WriteMemoryPoolReport(LPCTSTR pszFileName, double fTeardownTime, UINT nFreedObjects, bool bBlocksReleased)
+{
+#ifdef _WITH_POOLED_ALLOCATION
+	const TCHAR *pszAllocator = _T("Pool");
+	UINT nHeapAllocations = m_nBuildPoolBlocks + ((m_nBuildArenaAllocations > 0) ? 1 : 0);
+#else
+	const TCHAR *pszAllocator = _T("Heap");
+	UINT nHeapAllocations = m_nBuildAllocations + m_nBuildArenaAllocations;
+#endif
+
+	TCHAR pstrReport[4][160];
+	_stprintf_s(pstrReport[0], 160, _T("Allocator: %s\n"), pszAllocator);
+	_stprintf_s(pstrReport[1], 160, _T("Build:    %u objects, %u arena arrays (%u KB), %u heap allocations, %.3f ms\n"), m_nBuildAllocations, m_nBuildArenaAllocations, UINT(m_nBuildArenaBytes / 1024), nHeapAllocations, m_fBuildTime);
+	_stprintf_s(pstrReport[2], 160, _T("Teardown: %u objects, %.3f ms\n"), nFreedObjects, fTeardownTime);
+	_stprintf_s(pstrReport[3], 160, _T("Pool:     %u objects alive, blocks %s\n"), ::gObjectPool.GetLiveObjects(), bBlocksReleased ? _T("released") : _T("kept"));
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+	for (int i = 0; i < 4; i++)
+	{
+		::OutputDebugString(pstrReport[i]);
+		if (pFile) _fputts(pstrReport[i], pFile);
+	}
+	if (pFile) fclose(pFile);
 }
 
 void CGameFramework::ProcessInput()
 {
+	PROFILE_FUNCTION();
+
+	//  ߿ Ű 콺  ʴ´. (SimulateStep()  Է )
+	if (m_InputStream.IsReplaying()) return;
+
 	static UCHAR pKeysBuffer[256];
 	bool bProcessedByScene = false;
 	if (GetKeyboardState(pKeysBuffer) && m_pScene) bProcessedByScene = m_pScene->ProcessInput(pKeysBuffer);
+	m_dwInputDirection = 0;
 	if (!bProcessedByScene)
 	{
 		DWORD dwDirection = 0;
@@ -568,95 +733,302 @@ void CGameFramework::ProcessInput()
 			SetCursorPos(m_ptOldCursorPos.x, m_ptOldCursorPos.y);
 		}
 
-		if ((dwDirection != 0) || (cxDelta != 0.0f) || (cyDelta != 0.0f))
+		// ȸ ð  Ƿ    콺 ̵  ξٰ  ܿ   Ѵ.
+		if (cxDelta || cyDelta)
 		{
-			if (cxDelta || cyDelta)
-			{
-				if (pKeysBuffer[VK_RBUTTON] & 0xF0)
-					m_pPlayer->Rotate(cyDelta, 0.0f, -cxDelta);
-				else
-					m_pPlayer->Rotate(cyDelta, cxDelta, 0.0f);
-			}
-			if (dwDirection) m_pPlayer->Move(dwDirection, 50.0f * m_GameTimer.GetTimeElapsed(), true);
+			m_xmf3InputRotation.x += cyDelta;
+			if (pKeysBuffer[VK_RBUTTON] & 0xF0)
+				m_xmf3InputRotation.z -= cxDelta;
+			else
+				m_xmf3InputRotation.y += cxDelta;
 		}
+		m_dwInputDirection = dwDirection;
 	}
-	m_pPlayer->Update(m_GameTimer.GetTimeElapsed());
 }
 
-void CGameFramework::AnimateObjects()
+void CGameFramework::AnimateObjects(float fTimeElapsed)
 {
-	if (m_pScene) m_pScene->AnimateObjects(m_GameTimer.GetTimeElapsed());
+	PROFILE_FUNCTION();
+	if (m_pScene) m_pScene->AnimateObjects(fTimeElapsed);
 }
 
-void CGameFramework::WaitForGpuComplete()
+void CGameFramework::SimulateStep(float fTimeElapsed)
 {
-	const UINT64 nFenceValue = ++m_nFenceValues[m_nSwapChainBufferIndex];
-	HRESULT hResult = m_pd3dCommandQueue->Signal(m_pd3dFence, nFenceValue);
+	PROFILE_FUNCTION();
+
+	//  ̸ ̹  Է ,  ̸ Ͽ  Է ٲ۴.
+	INPUT_FRAME xInput = { m_dwInputDirection, m_xmf3InputRotation, m_nInputCameraMode };
+	m_InputStream.Process(&xInput);
+	m_xmf3InputRotation = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	m_nInputCameraMode = 0;
+
+	if (xInput.m_nCameraMode)
+	{
+		m_pCamera = m_pPlayer->ChangeCamera(xInput.m_nCameraMode, fTimeElapsed);
+		ResetSimulationState();
+	}
+	if ((xInput.m_xmf3Rotation.x != 0.0f) || (xInput.m_xmf3Rotation.y != 0.0f) || (xInput.m_xmf3Rotation.z != 0.0f))
+	{
+		m_pPlayer->Rotate(xInput.m_xmf3Rotation.x, xInput.m_xmf3Rotation.y, xInput.m_xmf3Rotation.z);
+	}
+	if (xInput.m_dwDirection) m_pPlayer->Move(xInput.m_dwDirection, 50.0f * fTimeElapsed, true);
+	m_pPlayer->Update(fTimeElapsed);
 
+	AnimateObjects(fTimeElapsed);
+}
+
+void CGameFramework::ResetSimulationState()
+{
+	m_pPlayer->GetState(&m_xCurrentPlayerState);
+	m_xPreviousPlayerState = m_xCurrentPlayerState;
+}
+
+void CGameFramework::SetInputStream(int nMode, LPCTSTR pszFileName)
+{
+	m_nInputStreamMode = nMode;
+	if (pszFileName && pszFileName[0]) _tcscpy_s(m_pszInputFileName, MAX_PATH, pszFileName);
+}
+
+void CGameFramework::SetBenchmark(UINT nFrames, bool bHeadless)
+{
+	if (m_pBenchmark) delete m_pBenchmark;
+	m_bWarpDevice = bHeadless;
+	m_pBenchmark = new CFlythroughBenchmark(nFrames, bHeadless);
+}
+
+void CGameFramework::SetFrameRateLimit(float fFramesPerSecond)
+{
+	CFramePacer *pFramePacer = m_GameTimer.GetFramePacer();
+	UINT nNumerator = 0, nDenominator = 1;
+	if (fFramesPerSecond > 0.0f)
+		pFramePacer->SetTargetFrameRate(fFramesPerSecond);
+	else if (::GetDisplayRefreshRate(&nNumerator, &nDenominator))
+		pFramePacer->SetTargetRefreshRate(nNumerator, nDenominator);
+	else
+		pFramePacer->SetTargetFrameRate(60.0f);
+}
+
+bool CGameFramework::FinishReplay(LPCTSTR pszReportFileName)
+{
+	double fElapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_tReplayStart).count();
+	UINT nSteps = m_InputStream.GetFrame();
+	XMFLOAT3 xmf3Recorded = m_InputStream.GetEndPosition();
+	XMFLOAT3 xmf3Replayed = m_xCurrentPlayerState.m_xmf3Position;
+	XMFLOAT3 xmf3Error = Vector3::Subtract(xmf3Replayed, xmf3Recorded);
+	float fError = Vector3::Length(xmf3Error);
+	bool bMatch = (m_InputStream.GetTimeStep() == FIXED_TIMESTEP) && (fError == 0.0f);
+	m_InputStream.StopReplay();
+
+	TCHAR pstrReport[1024];
+	_stprintf_s(pstrReport, 1024, _T("Replay: %s\n Steps: %u (%.4f s/step)\n Rendered Frames: %u\n Time: %.1f ms (%.3f ms/frame, %.3f ms/step)\n Recorded End: (%.4f, %.4f, %.4f)\n Replayed End: (%.4f, %.4f, %.4f)\n Error: %g\n Result: %s\n"),
+		m_InputStream.GetFileName(), nSteps, m_InputStream.GetTimeStep(), m_nReplayRenderedFrames,
+		fElapsed, (m_nReplayRenderedFrames) ? fElapsed / m_nReplayRenderedFrames : 0.0, (nSteps) ? fElapsed / nSteps : 0.0,
+		xmf3Recorded.x, xmf3Recorded.y, xmf3Recorded.z, xmf3Replayed.x, xmf3Replayed.y, xmf3Replayed.z, fError, (bMatch) ? _T("MATCH") : _T("MISMATCH"));
+	::OutputDebugString(pstrReport);
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszReportFileName, _T("wt"));
+	if (pFile)
+	{
+		_fputts(pstrReport, pFile);
+		fclose(pFile);
+	}
+	return(bMatch);
+}
+
+bool CGameFramework::RunHeadlessReplay(LPCTSTR pszReportFileName)
+{
+	if (!m_InputStream.IsReplaying() || (m_InputStream.GetTimeStep() != FIXED_TIMESTEP))
+	{
+		::OutputDebugString(_T("Input: headless replay needs a recording made with the same fixed timestep\n"));
+		return(false);
+	}
+
+	//   ܸ .   â   () ŵд.
+	m_nReplayRenderedFrames = 0;
+	m_tReplayStart = std::chrono::high_resolution_clock::now();
+	while (!m_InputStream.IsFinished())
+	{
+		UINT64 nFrame = ::gDeferredDeletionQueue.BeginFrame();
+		SimulateStep(FIXED_TIMESTEP);
+		m_pPlayer->GetState(&m_xCurrentPlayerState);
+		::gDeferredDeletionQueue.Collect(nFrame);
+	}
+	return(FinishReplay(pszReportFileName));
+}
+
+// gGpuTimer.BeginFrame() WaitForFrameContext()  ҸǷ  FRAMES_IN_FLIGHT   ־ Ѵ.
+static_assert(FRAMES_IN_FLIGHT < GPU_TIMER_FRAMES, "GPU timer ring must hold more frames than FRAMES_IN_FLIGHT");
+
+void CGameFramework::WaitForFenceValue(UINT64 nFenceValue)
+{
 	if (m_pd3dFence->GetCompletedValue() < nFenceValue)
 	{
-		hResult = m_pd3dFence->SetEventOnCompletion(nFenceValue, m_hFenceEvent);
+		HRESULT hResult = m_pd3dFence->SetEventOnCompletion(nFenceValue, m_hFenceEvent);
 		::WaitForSingleObject(m_hFenceEvent, INFINITE);
 	}
 }
 
+void CGameFramework::WaitForGpuComplete()
+{
+	PROFILE_FUNCTION();
+	// 潺  ϳ īͷ øǷ    ռ ȣ  ӵ  ̴.
+	const UINT64 nFenceValue = ++m_nFenceValue;
+	HRESULT hResult = m_pd3dCommandQueue->Signal(m_pd3dFence, nFenceValue);
+	WaitForFenceValue(nFenceValue);
+}
+
+void CGameFramework::WaitForFrameContext()
+{
+	PROFILE_FUNCTION();
+	FRAME_CONTEXT *pFrameContext = &m_pFrameContexts[m_nFrameContext];
+	if (pFrameContext->m_nFenceValue == 0) return;
+
+	WaitForFenceValue(pFrameContext->m_nFenceValue);
+
+	//  ӱ   ü   Ÿӽ  GPU  ʴ´.
+	::gDeferredDeletionQueue.Collect(pFrameContext->m_nDeletionFrame);
+	::gGpuTimer.Collect(pFrameContext->m_nGpuTimerFrame);
+	pFrameContext->m_nFenceValue = 0;
+}
+
 void CGameFramework::MoveToNextFrame()
 {
+	PROFILE_FUNCTION();
 	m_nSwapChainBufferIndex = m_pdxgiSwapChain->GetCurrentBackBufferIndex();
-	//m_nSwapChainBufferIndex = (m_nSwapChainBufferIndex + 1) % m_nSwapChainBuffers;
 
-	UINT64 nFenceValue = ++m_nFenceValues[m_nSwapChainBufferIndex];
+	const UINT64 nFenceValue = ++m_nFenceValue;
 	HRESULT hResult = m_pd3dCommandQueue->Signal(m_pd3dFence, nFenceValue);
+	m_pFrameContexts[m_nFrameContext].m_nFenceValue = nFenceValue;
 
-	if (m_pd3dFence->GetCompletedValue() < nFenceValue)
+	m_nFrameContext = (m_nFrameContext + 1) % FRAMES_IN_FLIGHT;
+}
+
+void CGameFramework::AdvanceSimulation()
+{
+#ifdef _WITH_FIXED_TIMESTEP
+	//   ð( ƴ) Ƽ   ùķ̼Ѵ.  Է̸  ӵ    ´.
+	//      ,   ӿ MAX_SIMULATION_STEPS ´.
+	m_fAccumulatedTime += min(m_GameTimer.GetFrameTimeElapsed(), FIXED_TIMESTEP * MAX_SIMULATION_STEPS);
+	m_nSimulationSteps = 0;
+	while ((m_fAccumulatedTime >= FIXED_TIMESTEP) && !m_InputStream.IsFinished())
 	{
-		hResult = m_pd3dFence->SetEventOnCompletion(nFenceValue, m_hFenceEvent);
-		::WaitForSingleObject(m_hFenceEvent, INFINITE);
+		m_xPreviousPlayerState = m_xCurrentPlayerState;
+		SimulateStep(FIXED_TIMESTEP);
+		m_pPlayer->GetState(&m_xCurrentPlayerState);
+		m_fAccumulatedTime -= FIXED_TIMESTEP;
+		m_nSimulationSteps++;
+	}
+	m_nTotalSimulationSteps += m_nSimulationSteps;
+
+	if (m_InputStream.IsReplaying())
+	{
+		m_nReplayRenderedFrames++;
+		if (m_InputStream.IsFinished())
+		{
+			FinishReplay(_T("ReplayReport.txt"));
+			::PostQuitMessage(0);
+		}
 	}
+
+	//    ̸  ð   · ׸   ǵ.
+	PLAYER_STATE xRenderState;
+	CPlayer::InterpolateState(m_xPreviousPlayerState, m_xCurrentPlayerState, m_fAccumulatedTime / FIXED_TIMESTEP, &xRenderState);
+	m_pPlayer->SetState(xRenderState);
+
+	//   ī޶ ġ Ƿ  ī޶ ٽ Ѵ. (  ùķ̼ ī޶ ٽ )
+	// RotationSystem/RevolutionSystemó ð  ̴ ȯ  ʰ   · ׸.
+	if (m_pScene) m_pScene->UpdateCameraFacingObjects();
+#else
+	SimulateStep(m_GameTimer.GetTimeElapsed());
+#endif
 }
 
 //#define _WITH_PLAYER_TOP
 
 void CGameFramework::FrameAdvance()
 {
+	// Ű  ĸĴ     迡 Ѱ .
+	::gProfiler.BeginFrame();
+	PROFILE_FUNCTION();
+
 	m_GameTimer.Tick(0.0f);
+	::gMemoryTracker.Update(m_GameTimer.GetFrameTimeElapsed());
 
-	ProcessInput();
+	if (m_pBenchmark)
+	{
+		// ġũ Է° ùķ̼   θ  ī޶ ű.
+		m_pBenchmark->BeginFrame(m_pCamera);
+		if (m_pBenchmark->IsFinished())
+		{
+			bool bWritten = m_pBenchmark->WriteReport(BENCHMARK_REPORT_NAME, m_nWndClientWidth, m_nWndClientHeight);
+			::PostQuitMessage(bWritten ? 0 : 1);
+			return;
+		}
+	}
 
-	AnimateObjects();
+	UINT64 nFrame = ::gDeferredDeletionQueue.BeginFrame();
+	UINT64 nGpuTimerFrame = ::gGpuTimer.BeginFrame();
 
-	HRESULT hResult = m_pd3dCommandAllocator->Reset();
-	hResult = m_pd3dCommandList->Reset(m_pd3dCommandAllocator, NULL);
-	float pfClearColor[4] = { 0.0f, 0.125f, 0.3f, 1.0f };
+	::gTransformStorage.ResetCounters();
+	if (m_pScene) m_pScene->GetRenderQueue()->ResetCounters();
+	::gFilteredCommandList.ResetCounters();
+	::gRenderStats.BeginFrame();
+	if (m_pCamera) m_pCamera->ResetUpdateCounters();
 
-	for (int i = 0; i < m_nOffScreenRenderTargetBuffers; ++i) {
-		::SynchronizeResourceTransition(
-			m_pd3dCommandList,
-			m_ppd3dOffScreenRenderTargetBuffers[i],
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			D3D12_RESOURCE_STATE_RENDER_TARGET);
+	if (!m_pBenchmark)
+	{
+		ProcessInput();
+		AdvanceSimulation();
 	}
 
-	for (int i = 0; i < m_nOffScreenRenderTargetBuffers; ++i) {
-		m_pd3dCommandList->ClearRenderTargetView(m_pd3dOffScreenRenderTargetBufferCPUHandles[i], pfClearColor, 0, NULL);
-	}
-	m_pd3dCommandList->ClearDepthStencilView(m_d3dDsvDepthStencilBufferCPUHandle, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.f, 0, 0, NULL);
-	m_pd3dCommandList->OMSetRenderTargets(m_nOffScreenRenderTargetBuffers, m_pd3dOffScreenRenderTargetBufferCPUHandles, TRUE, &m_d3dDsvDepthStencilBufferCPUHandle);
+	//  ڸ   (FRAMES_IN_FLIGHT  )  Ҵڿ ε  ٽ   ִ.
+	// CPU GPU ٸ   ȿ ̴. ùķ̼ GPU   ׸   д.
+	WaitForFrameContext();
+	if (m_pBenchmark) m_pBenchmark->MarkPhase(BENCHMARK_PHASE_GPU_WAIT);
 
-	m_pCamera->SetLookVector(Vector3::Multiply(-1, m_pCamera->GetLookVector()));
-	m_pCamera->RegenerateViewMatrix();
+	FRAME_CONTEXT *pFrameContext = &m_pFrameContexts[m_nFrameContext];
+	pFrameContext->m_nDeletionFrame = nFrame;
+	pFrameContext->m_nGpuTimerFrame = nGpuTimerFrame;
+	::gFrameUploadBuffer.BeginFrame(m_nFrameContext);
+
+	HRESULT hResult = pFrameContext->m_pd3dCommandAllocator->Reset();
+	hResult = m_pd3dCommandList->Reset(pFrameContext->m_pd3dCommandAllocator, NULL);
+	::gFilteredCommandList.Begin(m_pd3dCommandList);
+	float pfClearColor[4] = { 0.0f, 0.125f, 0.3f, 1.0f };
+
+	{
+		GPU_PROFILE_SCOPE(m_pd3dCommandList, "Offscreen Pass");
+		for (int i = 0; i < m_nOffScreenRenderTargetBuffers; ++i) {
+			::SynchronizeResourceTransition(
+				m_pd3dCommandList,
+				m_ppd3dOffScreenRenderTargetBuffers[i],
+				D3D12_RESOURCE_STATE_GENERIC_READ,
+				D3D12_RESOURCE_STATE_RENDER_TARGET);
+		}
+
+		for (int i = 0; i < m_nOffScreenRenderTargetBuffers; ++i) {
+			m_pd3dCommandList->ClearRenderTargetView(m_pd3dOffScreenRenderTargetBufferCPUHandles[i], pfClearColor, 0, NULL);
+		}
+		m_pd3dCommandList->ClearDepthStencilView(m_d3dDsvDepthStencilBufferCPUHandle, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.f, 0, 0, NULL);
+		m_pd3dCommandList->OMSetRenderTargets(m_nOffScreenRenderTargetBuffers, m_pd3dOffScreenRenderTargetBufferCPUHandles, TRUE, &m_d3dDsvDepthStencilBufferCPUHandle);
+
+		m_pCamera->SetLookVector(Vector3::Multiply(-1, m_pCamera->GetLookVector()));
+		m_pCamera->RegenerateViewMatrix();
 
-	m_pScene->Render(m_pd3dCommandList, m_pCamera);
+		m_pScene->Render(m_pd3dCommandList, m_pCamera);
+	}
 
 	hResult = m_pd3dCommandList->Close();
+	if (m_pBenchmark) m_pBenchmark->MarkPhase(BENCHMARK_PHASE_OFFSCREEN);
 
 	ID3D12CommandList *ppd3dCommandLists[] = { m_pd3dCommandList };
 	m_pd3dCommandQueue->ExecuteCommandLists(1, ppd3dCommandLists);
+	::gRenderStats.Add(RENDER_STAT_COMMAND_LISTS);
 
-	WaitForGpuComplete();
-
-	hResult = m_pd3dCommandAllocator->Reset();
-	hResult = m_pd3dCommandList->Reset(m_pd3dCommandAllocator, NULL);
+	// ť Ʈ   ϹǷ ũ н ٸ ʰ  Ҵڿ  н ̾ Ѵ.
+	hResult = m_pd3dCommandList->Reset(pFrameContext->m_pd3dCommandAllocator, NULL);
+	::gFilteredCommandList.Begin(m_pd3dCommandList);
 
 	for (int i = 0; i < m_nOffScreenRenderTargetBuffers; ++i) {
 		::SynchronizeResourceTransition(
@@ -679,40 +1051,108 @@ void CGameFramework::FrameAdvance()
 	m_pCamera->SetLookVector(Vector3::Multiply(-1, m_pCamera->GetLookVector()));
 	m_pCamera->RegenerateViewMatrix();
 
-	m_pScene->Render(m_pd3dCommandList, m_pCamera);
-
-	m_pPostProcessingShader->Render(m_pd3dCommandList, m_pCamera);
+	{
+		GPU_PROFILE_SCOPE(m_pd3dCommandList, "Main Scene Pass");
+		m_pScene->Render(m_pd3dCommandList, m_pCamera);
+	}
+	{
+		GPU_PROFILE_SCOPE(m_pd3dCommandList, "Post Processing");
+		m_pPostProcessingShader->Render(m_pd3dCommandList, m_pCamera);
+	}
+	{
+		GPU_PROFILE_SCOPE(m_pd3dCommandList, "Player");
+		m_pPlayer->Render(m_pd3dCommandList, m_pCamera);
+	}
 
-	m_pPlayer->Render(m_pd3dCommandList, m_pCamera);
+#ifdef _WITH_FIXED_TIMESTEP
+	//  ۴ ̹ ϵǾǷ   ̾ ùķ̼ · ǵ.
+	m_pPlayer->SetState(m_xCurrentPlayerState);
+#endif
 
 	::SynchronizeResourceTransition(m_pd3dCommandList, m_ppd3dSwapChainBackBuffers[m_nSwapChainBufferIndex], D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
 
+	::gGpuTimer.EndFrame(m_pd3dCommandList);
 	hResult = m_pd3dCommandList->Close();
+	if (m_pBenchmark) m_pBenchmark->MarkPhase(BENCHMARK_PHASE_MAIN);
 
 	ID3D12CommandList *ppd3dCommandLists2[] ={ m_pd3dCommandList };
 	m_pd3dCommandQueue->ExecuteCommandLists(1, ppd3dCommandLists2);
+	::gRenderStats.Add(RENDER_STAT_COMMAND_LISTS);
 
-	WaitForGpuComplete();
-
+	{
+		PROFILE_SCOPE("Present");
 #ifdef _WITH_PRESENT_PARAMETERS
-	DXGI_PRESENT_PARAMETERS dxgiPresentParameters;
-	dxgiPresentParameters.DirtyRectsCount = 0;
-	dxgiPresentParameters.pDirtyRects = NULL;
-	dxgiPresentParameters.pScrollRect = NULL;
-	dxgiPresentParameters.pScrollOffset = NULL;
-	m_pdxgiSwapChain->Present1(1, 0, &dxgiPresentParameters);
+		DXGI_PRESENT_PARAMETERS dxgiPresentParameters;
+		dxgiPresentParameters.DirtyRectsCount = 0;
+		dxgiPresentParameters.pDirtyRects = NULL;
+		dxgiPresentParameters.pScrollRect = NULL;
+		dxgiPresentParameters.pScrollOffset = NULL;
+		m_pdxgiSwapChain->Present1(1, 0, &dxgiPresentParameters);
 #else
 #ifdef _WITH_SYNCH_SWAPCHAIN
-	m_pdxgiSwapChain->Present(1, 0);
+		m_pdxgiSwapChain->Present(1, 0);
 #else
-	m_pdxgiSwapChain->Present(0, 0);
+		m_pdxgiSwapChain->Present(0, 0);
 #endif
 #endif
+	}
 
 	//	m_nSwapChainBufferIndex = m_pdxgiSwapChain->GetCurrentBackBufferIndex();
+	//  ӿ   ü Ÿӽ FRAMES_IN_FLIGHT   WaitForFrameContext() ŵд.
 	MoveToNextFrame();
 
+	if (m_pBenchmark)
+	{
+		m_pBenchmark->MarkPhase(BENCHMARK_PHASE_PRESENT);
+		m_pBenchmark->EndFrame(::gFilteredCommandList.GetDraws(), ::gFilteredCommandList.GetTriangles(), ::gFilteredCommandList.GetPoints(), m_pScene->GetVisibleEntities());
+	}
+
 	m_GameTimer.GetFrameRate(m_pszFrameRate + 12, 37);
+	size_t nLength = _tcslen(m_pszFrameRate);
+	_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" p99: %.1f ms Worst: %.1f ms Hitches: %u"), m_GameTimer.GetPercentile(0.99f) * 1000.0f, m_GameTimer.GetWorstFrameTime() * 1000.0f, m_GameTimer.GetHitches());
+	nLength = _tcslen(m_pszFrameRate);
+	_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Matrices: %u"), ::gTransformStorage.GetRecomputedMatrices());
+	nLength = _tcslen(m_pszFrameRate);
+	_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Camera: %u (Skip %u)"), m_pCamera->GetRecomputations(), m_pCamera->GetUpdateCounters().m_nSkippedViewMatrices);
+#ifdef _WITH_FIXED_TIMESTEP
+	nLength = _tcslen(m_pszFrameRate);
+	_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Steps: %u"), m_nSimulationSteps);
+#endif
+	if (m_pScene)
+	{
+		CRenderQueue *pRenderQueue = m_pScene->GetRenderQueue();
+		nLength = _tcslen(m_pszFrameRate);
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" PSO: %u Heap: %u / %u Draws"), pRenderQueue->GetPipelineStateChanges(), pRenderQueue->GetDescriptorHeapChanges(), pRenderQueue->GetSubmittedPackets());
+		CBoundingVolumeHierarchy *pBoundingVolumeHierarchy = m_pScene->GetBoundingVolumeHierarchy();
+		nLength = _tcslen(m_pszFrameRate);
+		if (pBoundingVolumeHierarchy) _stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Visible: %u/%u"), m_pScene->GetVisibleEntities(), pBoundingVolumeHierarchy->GetProxies());
+		COcclusionCuller *pOcclusionCuller = m_pScene->GetOcclusionCuller();
+		nLength = _tcslen(m_pszFrameRate);
+		if (pOcclusionCuller) _stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Occluded: %u/%u (%.2f ms)"), pOcclusionCuller->GetOccludedBoxes(), pOcclusionCuller->GetTestedBoxes(), pOcclusionCuller->GetRenderTime());
+	}
+	nLength = _tcslen(m_pszFrameRate);
+	if (::gFilteredCommandList.IsEnabled())
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Filtered: %u/%u"), ::gFilteredCommandList.GetTotalFilteredCalls(), ::gFilteredCommandList.GetTotalCalls());
+	else
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Filter Off"));
+	nLength = _tcslen(m_pszFrameRate);
+	if (m_InputStream.IsRecording())
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Rec: %u"), m_InputStream.GetFrame());
+	else if (m_InputStream.IsReplaying())
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Replay: %u/%u"), m_InputStream.GetFrame(), m_InputStream.GetFrames());
+	nLength = _tcslen(m_pszFrameRate);
+	_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Mem: %.1f/%.1f MB"), ::gMemoryTracker.GetBytes(MEMORY_POOL_CPU) / (1024.0 * 1024.0), ::gMemoryTracker.GetBytes(MEMORY_POOL_GPU) / (1024.0 * 1024.0));
+	CFramePacer *pFramePacer = m_GameTimer.GetFramePacer();
+	if (pFramePacer->IsEnabled())
+	{
+		nLength = _tcslen(m_pszFrameRate);
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" Pace: +%.3f ms (%.3f) Spin: %.0f%%"), pFramePacer->GetMeanLateness(), pFramePacer->GetLatenessJitter(), pFramePacer->GetSpinFraction() * 100.0f);
+	}
+	if (::gGpuTimer.IsEnabled())
+	{
+		nLength = _tcslen(m_pszFrameRate);
+		_stprintf_s(m_pszFrameRate + nLength, _countof(m_pszFrameRate) - nLength, _T(" GPU: %.2f/%.2f/%.2f ms"), ::gGpuTimer.GetRegionTime("Offscreen Pass"), ::gGpuTimer.GetRegionTime("Main Scene Pass"), ::gGpuTimer.GetRegionTime("Post Processing"));
+	}
 	::SetWindowText(m_hWnd, m_pszFrameRate);
 }
 
@@ -4,6 +4,23 @@
 #include "Timer.h"
 #include "Player.h"
 #include "Scene.h"
+#include "JobSystem.h"
+#include "InputStream.h"
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "GpuTimer.h"
+#include "MemoryTracker.h"
+#include "RenderStats.h"
+#include "FrameUploadBuffer.h"
+
+//  ̰ų GPU     ִ  ϳ  ͵. FRAMES_IN_FLIGHT  .
+struct FRAME_CONTEXT
+{
+	ID3D12CommandAllocator			*m_pd3dCommandAllocator;
+	UINT64							m_nFenceValue;			//   Ŀǵ Ʈ ڿ ȣ  (0̸   ʾҴ)
+	UINT64							m_nDeletionFrame;		//gDeferredDeletionQueue  ȣ
+	UINT64							m_nGpuTimerFrame;		//gGpuTimer  ȣ
+};
 
 class CGameFramework
 {
@@ -31,14 +48,34 @@ public:
 
 	void OnResizeBackBuffers();
 
-    void BuildObjects();
+    bool BuildObjects();
     void ReleaseObjects();
 
     void ProcessInput();
-    void AnimateObjects();
+    void AnimateObjects(float fTimeElapsed);
+	// Է ϰ ÷̾  fTimeElapsedŭ Ѵ.
+	void SimulateStep(float fTimeElapsed);
+	// ī޶ ٲٴ  ° ҿ ٲ  ´.
+	void ResetSimulationState();
+
+	// OnCreate()  ȣѴ. BuildObjects()  Է ̳  Ѵ.
+	void SetInputStream(int nMode, LPCTSTR pszFileName);
+	// â ׸ ʰ ϵ Է  ð   ùķ̼ؼ ð . ϰ   true.
+	bool RunHeadlessReplay(LPCTSTR pszReportFileName);
+	// OnCreate()  ȣѴ. Է   η nFrames  ׸    . bHeadless̸ WARP ̽ .
+	void SetBenchmark(UINT nFrames, bool bHeadless);
+	//    . 0̸ ÷  .
+	void SetFrameRateLimit(float fFramesPerSecond);
+
+	// Է  ð  ùķ̼  ϰ ׸ ¸ Ѵ.
+	void AdvanceSimulation();
     void FrameAdvance();
 
+	// ť   ۾   ٸ. (, ũ , )
 	void WaitForGpuComplete();
+	//   ڸ   (FRAMES_IN_FLIGHT  )   ٸ   ڿ ŵд.
+	void WaitForFrameContext();
+	//    潺 ȣϰ   ڸ ű. ٸ ʴ´.
 	void MoveToNextFrame();
 
 	void OnProcessingMouseMessage(HWND hWnd, UINT nMessageID, WPARAM wParam, LPARAM lParam);
@@ -73,14 +110,20 @@ private:
 	D3D12_CPU_DESCRIPTOR_HANDLE m_d3dDsvDepthStencilBufferCPUHandle;
 
 
-	ID3D12CommandAllocator		*m_pd3dCommandAllocator = NULL;
 	ID3D12CommandQueue			*m_pd3dCommandQueue = NULL;
 	ID3D12GraphicsCommandList	*m_pd3dCommandList = NULL;
 
+	//  ڸ  ü  ȣ  .
+	FRAME_CONTEXT				m_pFrameContexts[FRAMES_IN_FLIGHT];
+	UINT						m_nFrameContext = 0;
+
 	ID3D12Fence					*m_pd3dFence = NULL;
-	UINT64						m_nFenceValues[m_nSwapChainBuffers];
+	UINT64						m_nFenceValue = 0;			// ȣ  ( Ѵ)
 	HANDLE						m_hFenceEvent;
 
+	void WaitForFenceValue(UINT64 nFenceValue);
+	ID3D12CommandAllocator *GetCommandAllocator() { return(m_pFrameContexts[m_nFrameContext].m_pd3dCommandAllocator); }
+
 	CTexture					*pTextureForPostProcessing = NULL;
 
 #if defined(_DEBUG)
@@ -101,6 +144,40 @@ private:
 
 	POINT						m_ptOldCursorPos;
 
-	_TCHAR						m_pszFrameRate[50];
+	// ProcessInput()  Է ( ùķ̼ ܿ )
+	DWORD						m_dwInputDirection = 0;
+	XMFLOAT3					m_xmf3InputRotation = XMFLOAT3(0.0f, 0.0f, 0.0f);	//(pitch, yaw, roll)
+	DWORD						m_nInputCameraMode = 0;
+
+	// ܸ  Է /
+	CInputStream				m_InputStream;
+	int							m_nInputStreamMode = INPUT_STREAM_LIVE;
+	TCHAR						m_pszInputFileName[MAX_PATH];
+	UINT						m_nReplayRenderedFrames = 0;
+	std::chrono::high_resolution_clock::time_point m_tReplayStart;
+
+	//  ( , ð, ϵ  ġ ) ϰ  ¿ .  ġ  true.
+	bool FinishReplay(LPCTSTR pszReportFileName);
+
+	CFlythroughBenchmark		*m_pBenchmark = NULL;
+	bool						m_bWarpDevice = false;
+
+	//  ð  ùķ̼
+	float						m_fAccumulatedTime = 0.0f;
+	UINT						m_nSimulationSteps = 0;			//̹ 
+	UINT64						m_nTotalSimulationSteps = 0;
+	PLAYER_STATE				m_xPreviousPlayerState;
+	PLAYER_STATE				m_xCurrentPlayerState;
+
+	_TCHAR						m_pszFrameRate[384];
+
+	//  /  (MemoryPoolReport.txt)
+	UINT						m_nBuildAllocations = 0;
+	UINT						m_nBuildPoolBlocks = 0;
+	UINT						m_nBuildArenaAllocations = 0;
+	size_t						m_nBuildArenaBytes = 0;
+	double						m_fBuildTime = 0.0;
+
+	void WriteMemoryPoolReport(LPCTSTR pszFileName, double fTeardownTime, UINT nFreedObjects, bool bBlocksReleased);
 };
 
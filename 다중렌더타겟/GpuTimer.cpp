@@ -0,0 +1,31 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimer.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "GpuTimer.h"
+
+// D3D12 鿣 GpuTimerD3D12.cpp,  ¥ 鿣 GpuTimestampRing.cpp ִ.   D3D12 Լ θ ʴ´.
+
+CGpuTimer gGpuTimer;
+
+void CGpuTimer::OnReadRegion(const GPU_TIMER_RESULT& xResult)
+{
+	if (::gProfiler.IsEnabled()) ::gProfiler.AddGpuEvent(xResult.m_pszName, GetCpuTime(xResult.m_nBeginTimestamp), GetCpuTime(xResult.m_nEndTimestamp));
+}
+
+bool CGpuTimer::RunMockTest(LPCTSTR pszFileName)
+{
+	std::string strReport;
+	bool bPassed = CGpuTimestampRing::RunMockTest(&strReport);
+	::OutputDebugStringA(strReport.c_str());
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (pFile)
+	{
+		fputs(strReport.c_str(), pFile);
+		fclose(pFile);
+	}
+	return(bPassed);
+}
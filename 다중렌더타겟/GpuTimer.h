@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimer.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Profiler.h"
+
+#include "GpuTimestampRing.h"
+
+class CD3D12TimestampBackend : public CGpuTimestampBackend
+{
+public:
+	CD3D12TimestampBackend(ID3D12Device *pd3dDevice, ID3D12CommandQueue *pd3dCommandQueue, UINT nQueries);
+	virtual ~CD3D12TimestampBackend();
+
+private:
+	ID3D12CommandQueue				*m_pd3dCommandQueue = NULL;
+	ID3D12QueryHeap					*m_pd3dQueryHeap = NULL;
+	ID3D12Resource					*m_pd3dReadbackBuffer = NULL;
+	UINT64							m_nFrequency = 1;
+
+public:
+	bool IsValid() { return(m_pd3dQueryHeap && m_pd3dReadbackBuffer); }
+
+	virtual UINT64 GetFrequency() { return(m_nFrequency); }
+	virtual bool GetClockCalibration(UINT64 *pnGpuTimestamp, __int64 *pnCpuTime);
+	virtual void WriteTimestamp(ID3D12GraphicsCommandList *pd3dCommandList, UINT nQuery);
+	virtual void Resolve(ID3D12GraphicsCommandList *pd3dCommandList, UINT nFirstQuery, UINT nQueries);
+	virtual bool ReadTimestamps(UINT nFirstQuery, UINT nQueries, UINT64 *pnTimestamps);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   GPU Ÿ̸.  CGpuTimestampRing ϰ, ⼭   Ϸ "GPU" Ʈ .
+class CGpuTimer : public CGpuTimestampRing
+{
+protected:
+	virtual void OnReadRegion(const GPU_TIMER_RESULT& xResult);
+
+public:
+	// CGpuTimestampRing::RunMockTest()  ϰ  ¿ . ( ˻簡 Tests/GpuTimerTest.cpp  ȴ)
+	static bool RunMockTest(LPCTSTR pszFileName);
+};
+
+extern CGpuTimer gGpuTimer;
+
+class CGpuTimerScope
+{
+public:
+	CGpuTimerScope(ID3D12GraphicsCommandList *pd3dCommandList, const char *pszName) { if (::gGpuTimer.IsEnabled()) { m_pd3dCommandList = pd3dCommandList; m_nRegion = ::gGpuTimer.BeginRegion(pd3dCommandList, pszName); } }
+	~CGpuTimerScope() { if (m_pd3dCommandList) ::gGpuTimer.EndRegion(m_pd3dCommandList, m_nRegion); }
+
+private:
+	ID3D12GraphicsCommandList		*m_pd3dCommandList = NULL;
+	UINT							m_nRegion = 0;
+};
+
+#define GPU_PROFILE_SCOPE(pd3dCommandList, name)	CGpuTimerScope PROFILE_CONCATENATE(xGpuTimerScope, __LINE__)(pd3dCommandList, name)
@@ -0,0 +1,65 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimerD3D12.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "GpuTimer.h"
+
+CD3D12TimestampBackend::CD3D12TimestampBackend(ID3D12Device *pd3dDevice, ID3D12CommandQueue *pd3dCommandQueue, UINT nQueries)
+{
+	m_pd3dCommandQueue = pd3dCommandQueue;
+	m_pd3dCommandQueue->AddRef();
+	if (FAILED(m_pd3dCommandQueue->GetTimestampFrequency(&m_nFrequency))) return;
+
+	D3D12_QUERY_HEAP_DESC d3dQueryHeapDesc;
+	::ZeroMemory(&d3dQueryHeapDesc, sizeof(D3D12_QUERY_HEAP_DESC));
+	d3dQueryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	d3dQueryHeapDesc.Count = nQueries;
+	d3dQueryHeapDesc.NodeMask = 0;
+	if (FAILED(pd3dDevice->CreateQueryHeap(&d3dQueryHeapDesc, __uuidof(ID3D12QueryHeap), (void **)&m_pd3dQueryHeap))) return;
+
+	m_pd3dReadbackBuffer = ::CreateBufferResource(pd3dDevice, NULL, NULL, nQueries * sizeof(UINT64), D3D12_HEAP_TYPE_READBACK, D3D12_RESOURCE_STATE_COPY_DEST);
+}
+
+CD3D12TimestampBackend::~CD3D12TimestampBackend()
+{
+	if (m_pd3dReadbackBuffer) m_pd3dReadbackBuffer->Release();
+	if (m_pd3dQueryHeap) m_pd3dQueryHeap->Release();
+	if (m_pd3dCommandQueue) m_pd3dCommandQueue->Release();
+}
+
+bool CD3D12TimestampBackend::GetClockCalibration(UINT64 *pnGpuTimestamp, __int64 *pnCpuTime)
+{
+	UINT64 nCpuTimestamp = 0;
+	if (FAILED(m_pd3dCommandQueue->GetClockCalibration(pnGpuTimestamp, &nCpuTimestamp))) return(false);
+
+	// CPU  QueryPerformanceCounter ̴. Ϸ ð(steady_clock) ű   ð ̸ Ѵ.
+	LARGE_INTEGER nFrequency, nCounter;
+	::QueryPerformanceFrequency(&nFrequency);
+	::QueryPerformanceCounter(&nCounter);
+	__int64 nNow = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	double fAgo = double(nCounter.QuadPart - __int64(nCpuTimestamp)) * 1.0e9 / double(nFrequency.QuadPart);
+	*pnCpuTime = nNow - __int64(fAgo);
+	return(true);
+}
+
+void CD3D12TimestampBackend::WriteTimestamp(ID3D12GraphicsCommandList *pd3dCommandList, UINT nQuery)
+{
+	pd3dCommandList->EndQuery(m_pd3dQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, nQuery);
+}
+
+void CD3D12TimestampBackend::Resolve(ID3D12GraphicsCommandList *pd3dCommandList, UINT nFirstQuery, UINT nQueries)
+{
+	pd3dCommandList->ResolveQueryData(m_pd3dQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, nFirstQuery, nQueries, m_pd3dReadbackBuffer, nFirstQuery * sizeof(UINT64));
+}
+
+bool CD3D12TimestampBackend::ReadTimestamps(UINT nFirstQuery, UINT nQueries, UINT64 *pnTimestamps)
+{
+	D3D12_RANGE d3dReadRange = { nFirstQuery * sizeof(UINT64), (nFirstQuery + nQueries) * sizeof(UINT64) };
+	UINT8 *pReadback = NULL;
+	if (FAILED(m_pd3dReadbackBuffer->Map(0, &d3dReadRange, (void **)&pReadback))) return(false);
+	::memcpy(pnTimestamps, pReadback + d3dReadRange.Begin, nQueries * sizeof(UINT64));
+	D3D12_RANGE d3dWriteRange = { 0, 0 };
+	m_pd3dReadbackBuffer->Unmap(0, &d3dWriteRange);
+	return(true);
+}
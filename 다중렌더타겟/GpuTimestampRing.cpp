@@ -0,0 +1,288 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimestampRing.cpp
+//-----------------------------------------------------------------------------
+
+#include "GpuTimestampRing.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+inline int64_t GetGpuTimerCpuTime()
+{
+	return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CMockTimestampBackend::CMockTimestampBackend(unsigned int nQueries, uint64_t nFrequency, uint64_t nTicksPerTimestamp)
+{
+	m_nFrequency = nFrequency;
+	m_nTicksPerTimestamp = nTicksPerTimestamp;
+	m_vQueries.resize(nQueries, 0);
+	m_vReadback.resize(nQueries, 0);
+}
+
+bool CMockTimestampBackend::GetClockCalibration(uint64_t *pnGpuTimestamp, int64_t *pnCpuTime)
+{
+	*pnGpuTimestamp = m_nTicks;
+	*pnCpuTime = GetGpuTimerCpuTime();
+	return(true);
+}
+
+void CMockTimestampBackend::WriteTimestamp(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nQuery)
+{
+	if (nQuery >= m_vQueries.size()) return;
+	m_nTicks += m_nTicksPerTimestamp;
+	m_vQueries[nQuery] = m_nTicks;
+}
+
+void CMockTimestampBackend::Resolve(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nFirstQuery, unsigned int nQueries)
+{
+	for (unsigned int i = nFirstQuery; (i < nFirstQuery + nQueries) && (i < m_vQueries.size()); i++) m_vReadback[i] = m_vQueries[i];
+}
+
+bool CMockTimestampBackend::ReadTimestamps(unsigned int nFirstQuery, unsigned int nQueries, uint64_t *pnTimestamps)
+{
+	if (nFirstQuery + nQueries > m_vReadback.size()) return(false);
+	for (unsigned int i = 0; i < nQueries; i++) pnTimestamps[i] = m_vReadback[nFirstQuery + i];
+	return(true);
+}
+
+CGpuTimestampRing::CGpuTimestampRing()
+{
+	memset(m_pFrames, 0, sizeof(m_pFrames));
+}
+
+CGpuTimestampRing::~CGpuTimestampRing()
+{
+	Release();
+}
+
+void CGpuTimestampRing::SetBackend(CGpuTimestampBackend *pBackend)
+{
+	Release();
+
+	m_pBackend = pBackend;
+	m_nFrame = 0;
+	memset(m_pFrames, 0, sizeof(m_pFrames));
+	m_nOpenRegions = 0;
+	m_vResults.clear();
+	m_nResultFrame = 0;
+	m_nDroppedRegions = 0;
+	m_nOverwrittenFrames = 0;
+	if (m_pBackend) m_pBackend->GetClockCalibration(&m_nCalibrationGpuTimestamp, &m_nCalibrationCpuTime);
+}
+
+void CGpuTimestampRing::Release()
+{
+	if (m_pBackend) delete m_pBackend;
+	m_pBackend = NULL;
+	m_pCurrentFrame = NULL;
+}
+
+uint64_t CGpuTimestampRing::BeginFrame()
+{
+	m_nFrame++;
+	if (!m_pBackend) return(m_nFrame);
+
+	GPU_TIMER_FRAME *pFrame = &m_pFrames[m_nFrame % GPU_TIMER_FRAMES];
+	// Collect() GPU_TIMER_FRAMES  ̻      .
+	if (pFrame->m_bPending) m_nOverwrittenFrames++;
+	pFrame->m_nFrame = m_nFrame;
+	pFrame->m_bPending = false;
+	pFrame->m_nRegions = 0;
+
+	m_pCurrentFrame = pFrame;
+	m_nOpenRegions = 0;
+	return(m_nFrame);
+}
+
+void CGpuTimestampRing::EndFrame(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	if (!m_pCurrentFrame) return;
+
+	//    ⼭ ݴ´.
+	while (m_nOpenRegions > 0) EndRegion(pd3dCommandList, m_pnOpenRegions[m_nOpenRegions - 1]);
+
+	if (m_pCurrentFrame->m_nRegions > 0)
+	{
+		unsigned int nFirstQuery = (unsigned int)(m_pCurrentFrame - m_pFrames) * GPU_TIMER_QUERIES_PER_FRAME;
+		m_pBackend->Resolve(pd3dCommandList, nFirstQuery, m_pCurrentFrame->m_nRegions * 2);
+		m_pCurrentFrame->m_bPending = true;
+	}
+	m_pCurrentFrame = NULL;
+}
+
+unsigned int CGpuTimestampRing::BeginRegion(ID3D12GraphicsCommandList *pd3dCommandList, const char *pszName)
+{
+	if (!m_pCurrentFrame || (m_pCurrentFrame->m_nRegions >= GPU_TIMER_MAX_REGIONS) || (m_nOpenRegions >= GPU_TIMER_MAX_DEPTH))
+	{
+		m_nDroppedRegions++;
+		return(GPU_TIMER_MAX_REGIONS);
+	}
+
+	unsigned int nRegion = m_pCurrentFrame->m_nRegions++;
+	m_pCurrentFrame->m_ppszNames[nRegion] = pszName;
+	m_pCurrentFrame->m_pnDepths[nRegion] = m_nOpenRegions;
+	m_pnOpenRegions[m_nOpenRegions++] = nRegion;
+
+	unsigned int nFirstQuery = (unsigned int)(m_pCurrentFrame - m_pFrames) * GPU_TIMER_QUERIES_PER_FRAME;
+	m_pBackend->WriteTimestamp(pd3dCommandList, nFirstQuery + nRegion * 2);
+	return(nRegion);
+}
+
+void CGpuTimestampRing::EndRegion(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nRegion)
+{
+	if (!m_pCurrentFrame || (nRegion >= GPU_TIMER_MAX_REGIONS) || (m_nOpenRegions == 0)) return;
+
+	unsigned int nFirstQuery = (unsigned int)(m_pCurrentFrame - m_pFrames) * GPU_TIMER_QUERIES_PER_FRAME;
+	m_pBackend->WriteTimestamp(pd3dCommandList, nFirstQuery + nRegion * 2 + 1);
+	m_nOpenRegions--;
+}
+
+void CGpuTimestampRing::Collect(uint64_t nCompletedFrame)
+{
+	if (!m_pBackend) return;
+
+	//  Ӻ о m_vResults  ֱٿ   ´.
+	for (unsigned int i = GPU_TIMER_FRAMES; i > 0; i--)
+	{
+		if (m_nFrame < i - 1) continue;
+		uint64_t nFrame = m_nFrame - (i - 1);
+		if (nFrame > nCompletedFrame) break;
+		GPU_TIMER_FRAME *pFrame = &m_pFrames[nFrame % GPU_TIMER_FRAMES];
+		if (pFrame->m_bPending && (pFrame->m_nFrame == nFrame)) ReadFrame(pFrame);
+	}
+}
+
+void CGpuTimestampRing::ReadFrame(GPU_TIMER_FRAME *pFrame)
+{
+	pFrame->m_bPending = false;
+
+	uint64_t pnTimestamps[GPU_TIMER_QUERIES_PER_FRAME];
+	unsigned int nFirstQuery = (unsigned int)(pFrame - m_pFrames) * GPU_TIMER_QUERIES_PER_FRAME;
+	if (!m_pBackend->ReadTimestamps(nFirstQuery, pFrame->m_nRegions * 2, pnTimestamps)) return;
+
+	double fFrequency = double(std::max(m_pBackend->GetFrequency(), uint64_t(1)));
+
+	m_vResults.resize(pFrame->m_nRegions);
+	m_nResultFrame = pFrame->m_nFrame;
+	for (unsigned int i = 0; i < pFrame->m_nRegions; i++)
+	{
+		GPU_TIMER_RESULT& xResult = m_vResults[i];
+		xResult.m_pszName = pFrame->m_ppszNames[i];
+		xResult.m_nDepth = pFrame->m_pnDepths[i];
+		xResult.m_nBeginTimestamp = pnTimestamps[i * 2];
+		xResult.m_nEndTimestamp = std::max(pnTimestamps[i * 2 + 1], xResult.m_nBeginTimestamp);
+		xResult.m_fTime = float((xResult.m_nEndTimestamp - xResult.m_nBeginTimestamp) * 1000.0 / fFrequency);
+
+		OnReadRegion(xResult);
+	}
+}
+
+int64_t CGpuTimestampRing::GetCpuTime(uint64_t nTimestamp)
+{
+	double fFrequency = double(std::max(m_pBackend->GetFrequency(), uint64_t(1)));
+	//   ռ Ÿӽ  Ƿ ȣ ִ ̷ ٲ۴.
+	double fTime = double(int64_t(nTimestamp - m_nCalibrationGpuTimestamp)) * 1.0e9 / fFrequency;
+	return(m_nCalibrationCpuTime + int64_t(fTime));
+}
+
+float CGpuTimestampRing::GetRegionTime(const char *pszName)
+{
+	float fTime = 0.0f;
+	for (const GPU_TIMER_RESULT& xResult : m_vResults)
+	{
+		if (!strcmp(xResult.m_pszName, pszName)) fTime += xResult.m_fTime;
+	}
+	return(fTime);
+}
+
+bool CGpuTimestampRing::RunMockTest(std::string *pstrReport)
+{
+	// 1MHz ð迡 Ÿӽ 500ƽ(0.5ms) .
+	const uint64_t nFrequency = 1000000, nTicksPerTimestamp = 500;
+	const float fStep = 0.5f;
+
+	// OnReadRegion()   ̹Ƿ ĸ   Ͽ ¥   ʴ´.
+	CGpuTimestampRing xTimer;
+	xTimer.SetBackend(new CMockTimestampBackend(GPU_TIMER_FRAMES * GPU_TIMER_QUERIES_PER_FRAME, nFrequency, nTicksPerTimestamp));
+
+	*pstrReport = "GpuTimer Mock Test\n";
+	unsigned int nFailed = 0;
+	auto Check = [&](bool bResult, const char *pszTest) {
+		*pstrReport += std::string(" ") + pszTest + ": " + ((bResult) ? "ok" : "FAILED") + "\n";
+		if (!bResult) nFailed++;
+	};
+	auto RecordFrame = [&]() {
+		uint64_t nFrame = xTimer.BeginFrame();
+		unsigned int nFrameRegion = xTimer.BeginRegion(NULL, "Frame");
+		unsigned int nOffscreen = xTimer.BeginRegion(NULL, "Offscreen");
+		xTimer.EndRegion(NULL, nOffscreen);
+		unsigned int nMain = xTimer.BeginRegion(NULL, "Main");
+		unsigned int nPost = xTimer.BeginRegion(NULL, "Post");
+		xTimer.EndRegion(NULL, nPost);
+		xTimer.EndRegion(NULL, nMain);
+		xTimer.EndRegion(NULL, nFrameRegion);
+		xTimer.EndFrame(NULL);
+		return(nFrame);
+	};
+
+	// 1.   ʰ б:      ٰ ˸ ڿ ´.
+	bool bLag = true, bDurations = true, bDepths = true;
+	for (int i = 0; i < 12; i++)
+	{
+		uint64_t nFrame = RecordFrame();
+		if (nFrame <= 2)
+		{
+			xTimer.Collect(0);
+			bLag &= (xTimer.GetResults().size() == 0);
+			continue;
+		}
+		xTimer.Collect(nFrame - 2);
+		bLag &= (xTimer.GetResultFrame() == nFrame - 2);
+
+		const std::vector<GPU_TIMER_RESULT>& vResults = xTimer.GetResults();
+		if (vResults.size() != 4)
+		{
+			bDurations = bDepths = false;
+			continue;
+		}
+		// Ÿӽ : Frame(1) Offscreen(2, 3) Main(4) Post(5, 6) Main(7) Frame(8)
+		bDurations &= (fabsf(vResults[0].m_fTime - 7 * fStep) < 1.0e-4f) && (fabsf(vResults[1].m_fTime - 1 * fStep) < 1.0e-4f);
+		bDurations &= (fabsf(vResults[2].m_fTime - 3 * fStep) < 1.0e-4f) && (fabsf(vResults[3].m_fTime - 1 * fStep) < 1.0e-4f);
+		bDurations &= (fabsf(xTimer.GetRegionTime("Main") - 3 * fStep) < 1.0e-4f);
+		bDepths &= (vResults[0].m_nDepth == 0) && (vResults[1].m_nDepth == 1) && (vResults[2].m_nDepth == 1) && (vResults[3].m_nDepth == 2);
+	}
+	Check(bLag, "Results after completion (2 frame lag)");
+	Check(bDurations, "Nested region durations");
+	Check(bDepths, "Nested region depths");
+
+	// 2. GPU_TIMER_FRAMES  ̻     .    .
+	unsigned int nOverwritten = xTimer.GetOverwrittenFrames();
+	uint64_t nLastFrame = 0;
+	for (int i = 0; i < GPU_TIMER_FRAMES + 2; i++) nLastFrame = RecordFrame();
+	// 1.    Ӱ   ó   δ.
+	Check(xTimer.GetOverwrittenFrames() - nOverwritten == 4, "Ring overwrite detection");
+	xTimer.Collect(nLastFrame);
+	Check((xTimer.GetResultFrame() == nLastFrame) && (xTimer.GetResults().size() == 4), "Collect after overwrite");
+
+	// 3.     ̸   .
+	uint64_t nFrame = xTimer.BeginFrame();
+	unsigned int nDropped = xTimer.GetDroppedRegions();
+	unsigned int pnRegions[GPU_TIMER_MAX_DEPTH + 1];
+	for (int i = 0; i <= GPU_TIMER_MAX_DEPTH; i++) pnRegions[i] = xTimer.BeginRegion(NULL, "Deep");
+	for (int i = GPU_TIMER_MAX_DEPTH; i >= 0; i--) xTimer.EndRegion(NULL, pnRegions[i]);
+	for (int i = 0; i < GPU_TIMER_MAX_REGIONS; i++) xTimer.EndRegion(NULL, xTimer.BeginRegion(NULL, "Flat"));
+	xTimer.EndFrame(NULL);
+	xTimer.Collect(nFrame);
+	// ̸  1, "Deep"  GPU_TIMER_MAX_DEPTHŭ ڶ "Flat" .
+	Check((xTimer.GetDroppedRegions() - nDropped == 1 + GPU_TIMER_MAX_DEPTH) && (xTimer.GetResults().size() == GPU_TIMER_MAX_REGIONS), "Region overflow");
+
+	// 4. Ϸ  ð:   1(nFrequencyƽ) ڴ CPU ðε 1 ̴.
+	int64_t nCpuTime = xTimer.GetCpuTime(xTimer.m_nCalibrationGpuTimestamp + nFrequency);
+	Check(nCpuTime - xTimer.m_nCalibrationCpuTime == 1000000000, "Timestamp to profiler time");
+
+	*pstrReport += std::string(" Result: ") + ((nFailed == 0) ? "PASSED" : "FAILED") + "\n";
+	return(nFailed == 0);
+}
@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimestampRing.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+// stdafx.h d3d12.h  ȴ. Ŀǵ Ʈ 鿣忡 ״ ѱ⸸ ϹǷ   ȴ.
+// (Tests/GpuTimerTest.cpp  ϸ    )
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <string>
+
+struct ID3D12GraphicsCommandList;
+
+#define GPU_TIMER_FRAMES				4			// б   ִ   (б  ũ)
+#define GPU_TIMER_MAX_REGIONS			32			//  ִ  
+#define GPU_TIMER_QUERIES_PER_FRAME		(GPU_TIMER_MAX_REGIONS * 2)
+#define GPU_TIMER_MAX_DEPTH				8
+
+struct GPU_TIMER_RESULT
+{
+	const char						*m_pszName;
+	unsigned int					m_nDepth;				//ٱ  ȿ   (0  ٱ)
+	uint64_t						m_nBeginTimestamp;		//GPU ƽ
+	uint64_t						m_nEndTimestamp;
+	float							m_fTime;				//ms
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ÿӽ ϰ о  . D3D12  (CD3D12TimestampBackend, GpuTimer.h)  ¥  ִ 鿣 ٲ㼭
+//  , б ,  GPU (ٸ ÷) ˻  ִ.
+class CGpuTimestampBackend
+{
+public:
+	virtual ~CGpuTimestampBackend() { }
+
+	// ƽ/
+	virtual uint64_t GetFrequency() = 0;
+	//   GPU Ÿӽ CPU ð(steady_clock ). Ϸ CPU  ð ߴ  .
+	virtual bool GetClockCalibration(uint64_t *pnGpuTimestamp, int64_t *pnCpuTime) = 0;
+
+	virtual void WriteTimestamp(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nQuery) = 0;
+	// [nFirstQuery, nFirstQuery + nQueries) б   ġ ϴ  Ѵ.
+	virtual void Resolve(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nFirstQuery, unsigned int nQueries) = 0;
+	// Resolve()  GPU ۾  ڿ θ.
+	virtual bool ReadTimestamps(unsigned int nFirstQuery, unsigned int nQueries, uint64_t *pnTimestamps) = 0;
+};
+
+// Ÿӽ   GPU ð谡 m_nTicksPerTimestamp ٰ ٹδ. Resolve()    ִ.
+class CMockTimestampBackend : public CGpuTimestampBackend
+{
+public:
+	CMockTimestampBackend(unsigned int nQueries, uint64_t nFrequency, uint64_t nTicksPerTimestamp);
+	virtual ~CMockTimestampBackend() { }
+
+private:
+	uint64_t						m_nFrequency;
+	uint64_t						m_nTicksPerTimestamp;
+	uint64_t						m_nTicks = 0;
+	std::vector<uint64_t>			m_vQueries;
+	std::vector<uint64_t>			m_vReadback;
+
+public:
+	virtual uint64_t GetFrequency() { return(m_nFrequency); }
+	virtual bool GetClockCalibration(uint64_t *pnGpuTimestamp, int64_t *pnCpuTime);
+	virtual void WriteTimestamp(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nQuery);
+	virtual void Resolve(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nFirstQuery, unsigned int nQueries);
+	virtual bool ReadTimestamps(unsigned int nFirstQuery, unsigned int nQueries, uint64_t *pnTimestamps);
+};
+
+struct GPU_TIMER_FRAME
+{
+	uint64_t						m_nFrame;
+	bool							m_bPending;				//Resolve()   ʾҴ
+	unsigned int					m_nRegions;
+	const char						*m_ppszNames[GPU_TIMER_MAX_REGIONS];
+	unsigned int					m_pnDepths[GPU_TIMER_MAX_REGIONS];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ŀǵ Ʈ ̸   ۰  Ÿӽ ϰ,   GPU ۾  (  ) о  ð Ѵ.
+// Ӹ  б    Ƿ(GPU_TIMER_FRAMES ) ٸ ʰ     ִ.
+//  ȣ  忡 Ѵ.   Ϸ   CGpuTimer(GpuTimer.h) OnReadRegion() Ѵ.
+class CGpuTimestampRing
+{
+public:
+	CGpuTimestampRing();
+	virtual ~CGpuTimestampRing();
+
+private:
+	CGpuTimestampBackend			*m_pBackend = NULL;
+	uint64_t						m_nFrame = 0;
+	GPU_TIMER_FRAME					m_pFrames[GPU_TIMER_FRAMES];
+	GPU_TIMER_FRAME					*m_pCurrentFrame = NULL;
+
+	unsigned int					m_pnOpenRegions[GPU_TIMER_MAX_DEPTH];
+	unsigned int					m_nOpenRegions = 0;
+
+	//  ֱٿ   
+	std::vector<GPU_TIMER_RESULT>	m_vResults;
+	uint64_t						m_nResultFrame = 0;
+
+	unsigned int					m_nDroppedRegions = 0;
+	unsigned int					m_nOverwrittenFrames = 0;	//б       
+
+	// GPU Ÿӽ Ϸ ð() ٲ۴.
+	uint64_t						m_nCalibrationGpuTimestamp = 0;
+	int64_t							m_nCalibrationCpuTime = 0;
+
+	void ReadFrame(GPU_TIMER_FRAME *pFrame);
+
+protected:
+	//  ϳ   Ҹ.
+	virtual void OnReadRegion(const GPU_TIMER_RESULT& xResult) { }
+
+public:
+	// 鿣 CGpuTimestampRing .
+	void SetBackend(CGpuTimestampBackend *pBackend);
+	void Release();
+	bool IsEnabled() { return(m_pBackend != NULL); }
+
+	//  ù  ϱ  θ   ȣ ش.
+	uint64_t BeginFrame();
+	//   Ŀǵ Ʈ ݱ  θ. Ÿӽ б ۷ ϴ  Ѵ.
+	void EndFrame(ID3D12GraphicsCommandList *pd3dCommandList);
+	// nCompletedFrame GPU ۾   θ. ׶  ӵ Ÿӽ д´.
+	void Collect(uint64_t nCompletedFrame);
+
+	// pszName ڿ  Ѵ.  ȣ EndRegion() ѱ.
+	unsigned int BeginRegion(ID3D12GraphicsCommandList *pd3dCommandList, const char *pszName);
+	void EndRegion(ID3D12GraphicsCommandList *pd3dCommandList, unsigned int nRegion);
+
+	const std::vector<GPU_TIMER_RESULT>& GetResults() { return(m_vResults); }
+	uint64_t GetResultFrame() { return(m_nResultFrame); }
+	//  ֱ  ̸   ð  (ms)
+	float GetRegionTime(const char *pszName);
+	unsigned int GetDroppedRegions() { return(m_nDroppedRegions); }
+	unsigned int GetOverwrittenFrames() { return(m_nOverwrittenFrames); }
+
+	// GPU Ÿӽ  CPU ð(steady_clock ) ٲ۴.
+	int64_t GetCpuTime(uint64_t nTimestamp);
+
+	// ¥ 鿣  ø,    б,  , Ϸ ð ȯ ˻ϰ  pstrReport .
+	static bool RunMockTest(std::string *pstrReport);
+};
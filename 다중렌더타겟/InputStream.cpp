@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// File: InputStream.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "InputStream.h"
+
+bool CInputStream::StartRecording(LPCTSTR pszFileName, float fTimeStep)
+{
+	m_nMode = INPUT_STREAM_RECORD;
+	m_vFrames.clear();
+	m_vFrames.reserve(60 * 60 * 10);
+	m_nFrame = 0;
+	m_fTimeStep = fTimeStep;
+	_tcscpy_s(m_pszFileName, MAX_PATH, pszFileName);
+	return(true);
+}
+
+bool CInputStream::StopRecording(const XMFLOAT3& xmf3EndPosition)
+{
+	if (!IsRecording()) return(false);
+	m_nMode = INPUT_STREAM_LIVE;
+	m_xmf3EndPosition = xmf3EndPosition;
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, m_pszFileName, _T("wb"));
+	if (!pFile) return(false);
+
+	INPUT_FILE_HEADER xHeader = { INPUT_FILE_MAGIC, INPUT_FILE_VERSION, UINT(m_vFrames.size()), m_fTimeStep, xmf3EndPosition };
+	bool bWritten = (fwrite(&xHeader, sizeof(INPUT_FILE_HEADER), 1, pFile) == 1);
+	if (bWritten && !m_vFrames.empty()) bWritten = (fwrite(m_vFrames.data(), sizeof(INPUT_FRAME), m_vFrames.size(), pFile) == m_vFrames.size());
+	fclose(pFile);
+
+	TCHAR pstrDebug[MAX_PATH + 64];
+	_stprintf_s(pstrDebug, MAX_PATH + 64, _T("Input: %u steps recorded to %s\n"), UINT(m_vFrames.size()), m_pszFileName);
+	::OutputDebugString(pstrDebug);
+	return(bWritten);
+}
+
+bool CInputStream::StartReplay(LPCTSTR pszFileName)
+{
+	m_nMode = INPUT_STREAM_LIVE;
+	m_vFrames.clear();
+	m_nFrame = 0;
+	_tcscpy_s(m_pszFileName, MAX_PATH, pszFileName);
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("rb"));
+	if (!pFile) return(false);
+
+	INPUT_FILE_HEADER xHeader;
+	bool bValid = (fread(&xHeader, sizeof(INPUT_FILE_HEADER), 1, pFile) == 1) && (xHeader.m_nMagic == INPUT_FILE_MAGIC) && (xHeader.m_nVersion == INPUT_FILE_VERSION);
+	// ߸ų ջ  ū 迭 Ҵ ʵ     ũ Ѵ. (NaN ݵ ⼭ ɷ)
+	if (bValid) bValid = (xHeader.m_fTimeStep > 0.0f);
+	if (bValid)
+	{
+		__int64 nHeaderEnd = _ftelli64(pFile);
+		bValid = (_fseeki64(pFile, 0, SEEK_END) == 0);
+		__int64 nRemaining = _ftelli64(pFile) - nHeaderEnd;
+		bValid = bValid && (nRemaining >= 0) && (UINT64(xHeader.m_nFrames) * sizeof(INPUT_FRAME) <= UINT64(nRemaining)) && (_fseeki64(pFile, nHeaderEnd, SEEK_SET) == 0);
+	}
+	if (bValid)
+	{
+		m_vFrames.resize(xHeader.m_nFrames);
+		if (xHeader.m_nFrames) bValid = (fread(m_vFrames.data(), sizeof(INPUT_FRAME), xHeader.m_nFrames, pFile) == xHeader.m_nFrames);
+	}
+	fclose(pFile);
+	if (!bValid)
+	{
+		m_vFrames.clear();
+		return(false);
+	}
+
+	m_nMode = INPUT_STREAM_REPLAY;
+	m_fTimeStep = xHeader.m_fTimeStep;
+	m_xmf3EndPosition = xHeader.m_xmf3EndPosition;
+	return(true);
+}
+
+void CInputStream::StopReplay()
+{
+	if (IsReplaying()) m_nMode = INPUT_STREAM_LIVE;
+}
+
+bool CInputStream::Process(INPUT_FRAME *pFrame)
+{
+	switch (m_nMode)
+	{
+		case INPUT_STREAM_RECORD:
+			m_vFrames.push_back(*pFrame);
+			m_nFrame++;
+			break;
+		case INPUT_STREAM_REPLAY:
+			if (m_nFrame >= UINT(m_vFrames.size())) return(false);
+			*pFrame = m_vFrames[m_nFrame++];
+			break;
+	}
+	return(true);
+}
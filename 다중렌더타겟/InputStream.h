@@ -0,0 +1,68 @@
+//-----------------------------------------------------------------------------
+// File: InputStream.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define INPUT_FILE_MAGIC			0x31504E49	//"INP1"
+#define INPUT_FILE_VERSION			1
+#define INPUT_FILE_NAME				_T("Input.rec")
+
+#define INPUT_STREAM_LIVE			0
+#define INPUT_STREAM_RECORD			1
+#define INPUT_STREAM_REPLAY			2
+
+// ùķ̼  ϳ ϴ Է
+struct INPUT_FRAME
+{
+	DWORD							m_dwDirection;		//DIR_FORWARD, ...
+	XMFLOAT3						m_xmf3Rotation;		//(pitch, yaw, roll) 콺 ̵
+	DWORD							m_nCameraMode;		//ٲ ī޶ (0̸ ״)
+};
+
+struct INPUT_FILE_HEADER
+{
+	UINT							m_nMagic;
+	UINT							m_nVersion;
+	UINT							m_nFrames;
+	float							m_fTimeStep;
+	XMFLOAT3						m_xmf3EndPosition;	//   ÷̾ ġ (  Ѵ)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ùķ̼ ܸ  Է Ϸ ϰų Ͽ о ״ ٽ Ѵ.
+//   ¿  ð  ϸ N°      ȸ Ƿ  .
+class CInputStream
+{
+public:
+	CInputStream() { }
+	~CInputStream() { }
+
+private:
+	int								m_nMode = INPUT_STREAM_LIVE;
+	vector<INPUT_FRAME>				m_vFrames;
+	UINT							m_nFrame = 0;		//  
+	float							m_fTimeStep = 0.0f;
+	XMFLOAT3						m_xmf3EndPosition = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	TCHAR							m_pszFileName[MAX_PATH];
+
+public:
+	bool StartRecording(LPCTSTR pszFileName, float fTimeStep);
+	bool StopRecording(const XMFLOAT3& xmf3EndPosition);
+	bool StartReplay(LPCTSTR pszFileName);
+	void StopReplay();
+
+	//  ̸ pFrame ϰ,  ̸ pFrame    ٲ۴.    false.
+	bool Process(INPUT_FRAME *pFrame);
+
+	int GetMode() { return(m_nMode); }
+	bool IsRecording() { return(m_nMode == INPUT_STREAM_RECORD); }
+	bool IsReplaying() { return(m_nMode == INPUT_STREAM_REPLAY); }
+	bool IsFinished() { return(IsReplaying() && (m_nFrame >= UINT(m_vFrames.size()))); }
+
+	UINT GetFrame() { return(m_nFrame); }
+	UINT GetFrames() { return(UINT(m_vFrames.size())); }
+	float GetTimeStep() { return(m_fTimeStep); }
+	const XMFLOAT3& GetEndPosition() { return(m_xmf3EndPosition); }
+	LPCTSTR GetFileName() { return(m_pszFileName); }
+};
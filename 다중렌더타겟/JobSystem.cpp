@@ -0,0 +1,305 @@
+//-----------------------------------------------------------------------------
+// File: JobSystem.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+CJobSystem gJobSystem;
+
+// ۾ 尡 ƴϸ(  ) 0
+static thread_local int tnThreadIndex = 0;
+
+void CJobQueue::Push(JOB *pJob)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_dqJobs.push_back(pJob);
+}
+
+JOB *CJobQueue::Pop()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_dqJobs.empty()) return(NULL);
+	JOB *pJob = m_dqJobs.back();
+	m_dqJobs.pop_back();
+	return(pJob);
+}
+
+JOB *CJobQueue::Steal()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_dqJobs.empty()) return(NULL);
+	JOB *pJob = m_dqJobs.front();
+	m_dqJobs.pop_front();
+	return(pJob);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+CJobSystem::CJobSystem()
+{
+	m_bRunning = false;
+	m_nActiveThreads = 0;
+	m_nQueuedJobs = 0;
+	m_nExecutedJobs = 0;
+	m_nStolenJobs = 0;
+}
+
+CJobSystem::~CJobSystem()
+{
+	Shutdown();
+}
+
+void CJobSystem::Initialize(int nWorkers)
+{
+	Shutdown();
+
+	if (nWorkers < 0) nWorkers = int(std::thread::hardware_concurrency()) - 1;
+	if (nWorkers < 0) nWorkers = 0;
+	if (nWorkers > MAX_JOB_WORKERS - 1) nWorkers = MAX_JOB_WORKERS - 1;
+
+	m_nThreads = nWorkers + 1;
+	m_nActiveThreads = m_nThreads;
+	m_pJobQueues = new CJobQueue[m_nThreads];
+	m_pJobPool = new JOB[m_nThreads * MAX_JOBS_PER_THREAD];
+	for (int i = 0; i < m_nThreads * MAX_JOBS_PER_THREAD; i++) m_pJobPool[i].m_nUnfinishedJobs = 0;
+	m_pnAllocatedJobs = new UINT[m_nThreads];
+	for (int i = 0; i < m_nThreads; i++) m_pnAllocatedJobs[i] = 0;
+
+	tnThreadIndex = 0;
+	m_bRunning = true;
+	m_pWorkerThreads = new std::thread[m_nThreads];
+	for (int i = 1; i < m_nThreads; i++) m_pWorkerThreads[i] = std::thread(&CJobSystem::WorkerThread, this, i);
+}
+
+void CJobSystem::Shutdown()
+{
+	if (!m_pWorkerThreads) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_WakeMutex);
+		m_bRunning = false;
+	}
+	m_WakeCondition.notify_all();
+	for (int i = 1; i < m_nThreads; i++) m_pWorkerThreads[i].join();
+
+	delete[] m_pWorkerThreads;
+	delete[] m_pJobQueues;
+	delete[] m_pJobPool;
+	delete[] m_pnAllocatedJobs;
+	m_pWorkerThreads = NULL;
+	m_pJobQueues = NULL;
+	m_pJobPool = NULL;
+	m_pnAllocatedJobs = NULL;
+	m_nThreads = 0;
+	m_nActiveThreads = 0;
+	m_nQueuedJobs = 0;
+}
+
+void CJobSystem::SetActiveThreads(int nThreads)
+{
+	m_nActiveThreads = max(1, min(nThreads, m_nThreads));
+	m_WakeCondition.notify_all();
+}
+
+int CJobSystem::GetThreadIndex()
+{
+	return(tnThreadIndex);
+}
+
+void CJobSystem::WorkerThread(int nThread)
+{
+	tnThreadIndex = nThread;
+
+	while (m_bRunning)
+	{
+		JOB *pJob = (nThread < m_nActiveThreads.load()) ? GetJob(nThread) : NULL;
+		if (pJob)
+		{
+			Execute(pJob);
+		}
+		else
+		{
+			//    . (Run() , ģ ȣ  ª ٸ)
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_WakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this, nThread]() { return(!m_bRunning || ((m_nQueuedJobs.load() > 0) && (nThread < m_nActiveThreads.load()))); });
+		}
+	}
+}
+
+JOB *CJobSystem::GetJob(int nThread)
+{
+	JOB *pJob = m_pJobQueues[nThread].Pop();
+	if (pJob) return(pJob);
+
+	//   ť ۾ .
+	int nActiveThreads = m_nActiveThreads.load();
+	for (int i = 1; i < nActiveThreads; i++)
+	{
+		int nVictim = (nThread + i) % nActiveThreads;
+		pJob = m_pJobQueues[nVictim].Steal();
+		if (pJob)
+		{
+			m_nStolenJobs++;
+			return(pJob);
+		}
+	}
+	return(NULL);
+}
+
+JOB *CJobSystem::CreateJob(JOB_FUNCTION pfnFunction, JOB *pParent)
+{
+	int nThread = tnThreadIndex;
+	UINT nIndex = m_pnAllocatedJobs[nThread]++;
+	JOB *pJob = &m_pJobPool[(nThread * MAX_JOBS_PER_THREAD) + (nIndex & (MAX_JOBS_PER_THREAD - 1))];
+	//  ۸     ڸ   ʾ   ۾  ȴ.
+	assert(IsFinished(pJob));
+
+	pJob->m_pfnFunction = pfnFunction;
+	pJob->m_pParent = pParent;
+	pJob->m_nUnfinishedJobs = 1;
+	if (pParent) pParent->m_nUnfinishedJobs.fetch_add(1);
+
+	return(pJob);
+}
+
+JOB *CJobSystem::CreateJob(JOB_FUNCTION pfnFunction, const void *pData, size_t nDataBytes, JOB *pParent)
+{
+	assert(nDataBytes <= JOB_DATA_BYTES);
+
+	JOB *pJob = CreateJob(pfnFunction, pParent);
+	::memcpy(pJob->m_pData, pData, nDataBytes);
+	return(pJob);
+}
+
+void CJobSystem::Run(JOB *pJob)
+{
+	if (m_nActiveThreads.load() <= 1)
+	{
+		// ۾ 尡  ٷ Ѵ.
+		Execute(pJob);
+		return;
+	}
+
+	m_pJobQueues[tnThreadIndex].Push(pJob);
+	m_nQueuedJobs++;
+	m_WakeCondition.notify_one();
+}
+
+void CJobSystem::Execute(JOB *pJob)
+{
+	if (m_nActiveThreads.load() > 1) m_nQueuedJobs--;
+	if (pJob->m_pfnFunction)
+	{
+		PROFILE_SCOPE("Job");
+		(pJob->m_pfnFunction)(pJob, pJob->m_pData);
+	}
+	m_nExecutedJobs++;
+	Finish(pJob);
+}
+
+void CJobSystem::Finish(JOB *pJob)
+{
+	//  ڽ  θ .
+	if (pJob->m_nUnfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		if (pJob->m_pParent) Finish(pJob->m_pParent);
+	}
+}
+
+void CJobSystem::Wait(JOB *pJob)
+{
+	while (!IsFinished(pJob))
+	{
+		JOB *pNextJob = (m_nActiveThreads.load() > 1) ? GetJob(tnThreadIndex) : NULL;
+		if (pNextJob)
+			Execute(pNextJob);
+		else
+			std::this_thread::yield();
+	}
+}
+
+struct PARALLEL_FOR_DATA
+{
+	PARALLEL_FOR_FUNCTION			m_pfnBody;
+	const void						*m_pContext;
+	UINT							m_nBegin;
+	UINT							m_nEnd;
+};
+
+static void ParallelForJob(JOB *pJob, const void *pData)
+{
+	const PARALLEL_FOR_DATA *pParallelFor = (const PARALLEL_FOR_DATA *)pData;
+	(pParallelFor->m_pfnBody)(pParallelFor->m_pContext, pParallelFor->m_nBegin, pParallelFor->m_nEnd);
+}
+
+void CJobSystem::ParallelFor(UINT nCount, UINT nGrainSize, PARALLEL_FOR_FUNCTION pfnBody, const void *pContext)
+{
+	if (nCount == 0) return;
+	if (nGrainSize == 0) nGrainSize = 1;
+
+	if ((m_nActiveThreads.load() <= 1) || (nCount <= nGrainSize))
+	{
+		pfnBody(pContext, 0, nCount);
+		return;
+	}
+
+	JOB *pRoot = CreateJob(NULL);
+	for (UINT nBegin = 0; nBegin < nCount; nBegin += nGrainSize)
+	{
+		PARALLEL_FOR_DATA xParallelFor = { pfnBody, pContext, nBegin, min(nBegin + nGrainSize, nCount) };
+		Run(CreateJob(ParallelForJob, &xParallelFor, sizeof(PARALLEL_FOR_DATA), pRoot));
+	}
+	Run(pRoot);
+	Wait(pRoot);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+void CJobSystem::RunScalingBenchmark(LPCTSTR pszFileName)
+{
+	const UINT nElements = 1 << 16;
+	const UINT nIterations = 64;
+
+	XMFLOAT4X4 *pxmf4x4Results = new XMFLOAT4X4[nElements];
+
+	// 带 ٽ  ʰ óϴ   δ.
+	int nMaxThreads = max(1, m_nThreads);
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+
+	TCHAR pstrReport[128];
+	double fSingleThreadTime = 0.0;
+	for (int nThreads = 1; nThreads <= nMaxThreads; nThreads++)
+	{
+		SetActiveThreads(nThreads);
+
+		auto tStart = std::chrono::high_resolution_clock::now();
+		ParallelFor(nElements, 256, [&](UINT nBegin, UINT nEnd)
+		{
+			for (UINT i = nBegin; i < nEnd; i++)
+			{
+				XMMATRIX mtxResult = XMMatrixIdentity();
+				XMMATRIX mtxRotate = XMMatrixRotationRollPitchYaw(float(i) * 0.001f, 0.01f, 0.02f);
+				for (UINT j = 0; j < nIterations; j++) mtxResult = XMMatrixMultiply(mtxResult, mtxRotate);
+				XMStoreFloat4x4(&pxmf4x4Results[i], mtxResult);
+			}
+		});
+		auto tEnd = std::chrono::high_resolution_clock::now();
+
+		double fTime = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+		if (nThreads == 1) fSingleThreadTime = fTime;
+
+		_stprintf_s(pstrReport, 128, _T("Threads: %2d  Time: %8.3f ms  Speedup: %5.2fx  Stolen: %u\n"), nThreads, fTime, fSingleThreadTime / fTime, GetStolenJobs());
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+		ResetCounters();
+	}
+
+	if (pFile) fclose(pFile);
+	delete[] pxmf4x4Results;
+
+	SetActiveThreads(m_nThreads);
+}
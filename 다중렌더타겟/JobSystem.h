@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// File: JobSystem.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define MAX_JOB_WORKERS				64
+#define MAX_JOBS_PER_THREAD			4096	//2 ŵ (帶  ۷ )
+#define JOB_DATA_BYTES				40
+
+struct JOB;
+typedef void (*JOB_FUNCTION)(JOB *pJob, const void *pData);
+typedef void (*PARALLEL_FOR_FUNCTION)(const void *pContext, UINT nBegin, UINT nEnd);
+
+// ĳ (64Ʈ) ϳ .
+struct JOB
+{
+	JOB_FUNCTION					m_pfnFunction;
+	JOB								*m_pParent;
+	std::atomic<int>				m_nUnfinishedJobs;		//ڽ +   ڽ ۾ 
+	char							m_pData[JOB_DATA_BYTES];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+class CJobQueue
+{
+public:
+	CJobQueue() { }
+	~CJobQueue() { }
+
+private:
+	std::mutex						m_Mutex;
+	std::deque<JOB *>				m_dqJobs;
+
+public:
+	//   ʿ ְ (LIFO), ٸ  ʿ  (FIFO).
+	void Push(JOB *pJob);
+	JOB *Pop();
+	JOB *Steal();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ۾ ġ(work-stealing) ٷ.
+//  0 () ̰ Wait() ٸ   ۾ óѴ.
+// ۾ ü    ۿ ҴǹǷ   ۾  忡 MAX_JOBS_PER_THREAD    ȴ.
+// ( CreateJob() assert Ѵ)
+// ۾ 尡 ƴ      0  ۿ ť Ƿ,  尡 ƴ ٸ 忡
+// CreateJob()̳ Run() θ m_pnAllocatedJobs[0]  Ͼ. ۾  峪 ۾ ȿ .
+class CJobSystem
+{
+public:
+	CJobSystem();
+	~CJobSystem();
+
+private:
+	int								m_nThreads = 0;			//  
+	std::atomic<int>				m_nActiveThreads;		//۾ óϴ   (տ, m_nThreads )
+	std::thread						*m_pWorkerThreads = NULL;
+	CJobQueue						*m_pJobQueues = NULL;
+	JOB								*m_pJobPool = NULL;
+	UINT							*m_pnAllocatedJobs = NULL;
+
+	std::atomic<bool>				m_bRunning;
+	std::atomic<int>				m_nQueuedJobs;
+	std::mutex						m_WakeMutex;
+	std::condition_variable			m_WakeCondition;
+
+	std::atomic<UINT>				m_nExecutedJobs;
+	std::atomic<UINT>				m_nStolenJobs;
+
+	void WorkerThread(int nThread);
+	JOB *GetJob(int nThread);
+	void Execute(JOB *pJob);
+	void Finish(JOB *pJob);
+
+	template <class Function> static void ParallelForBody(const void *pContext, UINT nBegin, UINT nEnd) { (*(const Function *)pContext)(nBegin, nEnd); }
+
+public:
+	// nWorkers < 0̸ (ϵ   - 1) ۾ 带 . (0̸  常 )
+	void Initialize(int nWorkers = -1);
+	void Shutdown();
+
+	int GetThreads() { return(m_nThreads); }
+	int GetActiveThreads() { return(m_nActiveThreads.load()); }
+	//  ȣ nThreads ̻ ۾  ۾ ó ʰ . 带 ٽ  Ƿ  ȣ 
+	// (Ϸ, 浹 ĺ ) ״ ȿϴ.   ۾    忡 θ.
+	void SetActiveThreads(int nThreads);
+	// ۾ 尡 ƴϸ(  ) 0
+	int GetThreadIndex();
+
+	JOB *CreateJob(JOB_FUNCTION pfnFunction, JOB *pParent = NULL);
+	JOB *CreateJob(JOB_FUNCTION pfnFunction, const void *pData, size_t nDataBytes, JOB *pParent = NULL);
+	void Run(JOB *pJob);
+	// ۾(  ڽ ۾)   ٸ ۾ óϸ鼭 ٸ.
+	void Wait(JOB *pJob);
+	bool IsFinished(JOB *pJob) { return(pJob->m_nUnfinishedJobs.load(std::memory_order_acquire) <= 0); }
+
+	// [0, nCount) nGrainSize   ķ óϰ   ƿ´.
+	// Լ ü ۾ Ϳ ּҸ ϹǷ std::functionó Ÿ ų  Ҵ ʴ´.
+	template <class Function> void ParallelFor(UINT nCount, UINT nGrainSize, const Function& fnBody) { ParallelFor(nCount, nGrainSize, ParallelForBody<Function>, &fnBody); }
+	void ParallelFor(UINT nCount, UINT nGrainSize, PARALLEL_FOR_FUNCTION pfnBody, const void *pContext);
+
+	UINT GetExecutedJobs() { return(m_nExecutedJobs.load()); }
+	UINT GetStolenJobs() { return(m_nStolenJobs.load()); }
+	void ResetCounters() { m_nExecutedJobs = 0; m_nStolenJobs = 0; }
+
+	// 1 ʱȭ   óϴ   ÷  ϸ óϰ  ϰ  ¿ .
+	void RunScalingBenchmark(LPCTSTR pszFileName);
+};
+
+extern CJobSystem gJobSystem;
@@ -21,7 +21,49 @@ INT_PTR CALLBACK About(HWND, UINT, WPARAM, LPARAM);
 int APIENTRY _tWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLine, int nCmdShow)
 {
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
+
+	// LabProject08-1.exe /writescene [ ̸]:    Ϸ  . (â ̽  ʴ´)
+	if (!_tcsncmp(lpCmdLine, _T("/writescene"), 11))
+	{
+		LPCTSTR pszFileName = lpCmdLine + 11;
+		while (*pszFileName == _T(' ')) pszFileName++;
+		return(CScene::WriteProceduralSceneFile(*pszFileName ? pszFileName : SCENE_FILE_NAME) ? 0 : 1);
+	}
+
+	// /record [ ̸]: ùķ̼ ܸ Է ϰ   Ϸ .
+	// /replay [ ̸]: ϵ Է â ׸鼭 ϰ  ReplayReport.txt  .
+	// /replayheadless [ ̸]: â  ʰ     ܸ ؼ ReplayReport.txt  .
+	int nInputMode = INPUT_STREAM_LIVE, nOption = 0;
+	if (!_tcsncmp(lpCmdLine, _T("/record"), 7)) nInputMode = INPUT_STREAM_RECORD, nOption = 7;
+	else if (!_tcsncmp(lpCmdLine, _T("/replayheadless"), 15)) nInputMode = INPUT_STREAM_REPLAY, nOption = 15;
+	else if (!_tcsncmp(lpCmdLine, _T("/replay"), 7)) nInputMode = INPUT_STREAM_REPLAY, nOption = 7;
+	bool bHeadless = (nOption == 15);
+
+	// /benchmark [ ] [/headless]: Է    η ī޶ ű ׸ BenchmarkReport.json  .
+	// /headless ̸ â  ʰ WARP ̽ ׸.
+	if (!_tcsncmp(lpCmdLine, _T("/benchmark"), 10))
+	{
+		bHeadless = (_tcsstr(lpCmdLine, _T("/headless")) != NULL);
+		gGameFramework.SetBenchmark(UINT(_tcstoul(lpCmdLine + 10, NULL, 10)), bHeadless);
+	}
+	if (nInputMode != INPUT_STREAM_LIVE)
+	{
+		LPCTSTR pszFileName = lpCmdLine + nOption;
+		while (*pszFileName == _T(' ')) pszFileName++;
+		gGameFramework.SetInputStream(nInputMode, pszFileName);
+	}
+
+	// /profile: (ε)   CPU  ؼ ProfileTrace.json . ٸ ɼǰ Բ   ִ. (F12 120 Ӹ ´)
+	if (_tcsstr(lpCmdLine, _T("/profile"))) ::gProfiler.EnableUntilExit();
+
+	// /fps [ʴ   | refresh]:    .  ð κ   鼭 ٸ. (refresh ÷ )
+	LPCTSTR pszFrameRate = _tcsstr(lpCmdLine, _T("/fps"));
+	if (pszFrameRate)
+	{
+		pszFrameRate += 4;
+		while (*pszFrameRate == _T(' ')) pszFrameRate++;
+		gGameFramework.SetFrameRateLimit((!_tcsncmp(pszFrameRate, _T("refresh"), 7)) ? 0.0f : float(_tcstod(pszFrameRate, NULL)));
+	}
 
 	MSG msg;
 	HACCEL hAccelTable;
@@ -30,7 +72,14 @@ int APIENTRY _tWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCm
 	::LoadString(hInstance, IDC_LABPROJECT081, szWindowClass, MAX_LOADSTRING);
 	MyRegisterClass(hInstance);
 
-	if (!InitInstance(hInstance, nCmdShow)) return(FALSE);
+	if (!InitInstance(hInstance, (bHeadless) ? SW_HIDE : nCmdShow)) return(FALSE);
+
+	if (bHeadless && (nInputMode == INPUT_STREAM_REPLAY))
+	{
+		bool bMatch = gGameFramework.RunHeadlessReplay(_T("ReplayReport.txt"));
+		gGameFramework.OnDestroy();
+		return(bMatch ? 0 : 1);
+	}
 
 	hAccelTable = ::LoadAccelerators(hInstance, MAKEINTRESOURCE(IDC_LABPROJECT081));
 
@@ -87,7 +136,7 @@ BOOL InitInstance(HINSTANCE hInstance, int nCmdShow)
 
 	if (!hMainWnd) return(FALSE);
 
-	gGameFramework.OnCreate(hInstance, hMainWnd);
+	if (!gGameFramework.OnCreate(hInstance, hMainWnd)) return(FALSE);
 
 	::ShowWindow(hMainWnd, nCmdShow);
 	::UpdateWindow(hMainWnd);
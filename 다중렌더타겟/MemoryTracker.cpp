@@ -0,0 +1,248 @@
+//-----------------------------------------------------------------------------
+// File: MemoryTracker.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "MemoryTracker.h"
+
+CMemoryTracker gMemoryTracker;
+
+static thread_local UINT tnMemoryTag = MEMORY_TAG_OTHER;
+
+// {6D3C2A71-4B1E-4F0A-9C52-1E7B33A84D10}
+static const GUID MEMORY_TRACKER_GUID = { 0x6d3c2a71, 0x4b1e, 0x4f0a, { 0x9c, 0x52, 0x1e, 0x7b, 0x33, 0xa8, 0x4d, 0x10 } };
+
+CMemoryTagScope::CMemoryTagScope(UINT nTag)
+{
+	m_nPreviousTag = tnMemoryTag;
+	tnMemoryTag = nTag;
+}
+
+CMemoryTagScope::~CMemoryTagScope()
+{
+	tnMemoryTag = m_nPreviousTag;
+}
+
+UINT CMemoryTagScope::GetCurrentTag()
+{
+	return(tnMemoryTag);
+}
+
+inline void AddMemoryCounters(MEMORY_COUNTERS *pCounters, __int64 nBytes)
+{
+	__int64 nCurrentBytes = pCounters->m_nBytes.fetch_add(nBytes) + nBytes;
+	pCounters->m_nAllocations.fetch_add(1);
+	__int64 nPeakBytes = pCounters->m_nPeakBytes.load();
+	while ((nCurrentBytes > nPeakBytes) && !pCounters->m_nPeakBytes.compare_exchange_weak(nPeakBytes, nCurrentBytes));
+}
+
+void CMemoryTracker::Allocate(UINT nPool, UINT nTag, __int64 nBytes)
+{
+	AddMemoryCounters(GetCounters(nPool, nTag), nBytes);
+	AddMemoryCounters(&m_ppCounters[nPool][MEMORY_TAGS], nBytes);
+}
+
+void CMemoryTracker::Free(UINT nPool, UINT nTag, __int64 nBytes)
+{
+	MEMORY_COUNTERS *pCounters = GetCounters(nPool, nTag);
+	pCounters->m_nBytes.fetch_sub(nBytes);
+	pCounters->m_nAllocations.fetch_sub(1);
+	m_ppCounters[nPool][MEMORY_TAGS].m_nBytes.fetch_sub(nBytes);
+	m_ppCounters[nPool][MEMORY_TAGS].m_nAllocations.fetch_sub(1);
+}
+
+// Ҵ տ ũ ±׸ ξ    ±׿ .
+// 32Ʈ 16Ʈ ǵ äǷ Ӹ  ޸𸮴 malloc()  (x64 16Ʈ, Win32 8Ʈ) ״ .
+struct MEMORY_BLOCK_HEADER
+{
+	size_t							m_nBytes;
+	UINT							m_nTag;
+	BYTE							m_pPadding[16 - sizeof(size_t) - sizeof(UINT)];
+};
+
+static_assert(sizeof(MEMORY_BLOCK_HEADER) == 16, "MEMORY_BLOCK_HEADER must be a fixed 16 bytes so the returned pointer keeps malloc alignment");
+
+// Ӹ   ϳ Ѵ. ( 2 ŵ̹Ƿ 16 ũ 16 ̴)
+inline size_t GetMemoryBlockOffset(size_t nAlignment)
+{
+	return((nAlignment > sizeof(MEMORY_BLOCK_HEADER)) ? nAlignment : sizeof(MEMORY_BLOCK_HEADER));
+}
+
+void *CMemoryTracker::AllocateMemory(size_t nBytes, UINT nTag, size_t nAlignment)
+{
+	size_t nOffset = GetMemoryBlockOffset(nAlignment);
+	BYTE *pBlock = (BYTE *)((nAlignment == 0) ? ::malloc(nOffset + nBytes) : ::_aligned_malloc(nOffset + nBytes, nOffset));
+	if (!pBlock) return(NULL);
+
+	MEMORY_BLOCK_HEADER *pHeader = (MEMORY_BLOCK_HEADER *)(pBlock + nOffset) - 1;
+	pHeader->m_nBytes = nBytes;
+	pHeader->m_nTag = nTag;
+	Allocate(MEMORY_POOL_CPU, nTag, __int64(nBytes));
+	return(pBlock + nOffset);
+}
+
+void CMemoryTracker::FreeMemory(void *pMemory, size_t nAlignment)
+{
+	if (!pMemory) return;
+	MEMORY_BLOCK_HEADER *pHeader = (MEMORY_BLOCK_HEADER *)pMemory - 1;
+	Free(MEMORY_POOL_CPU, pHeader->m_nTag, __int64(pHeader->m_nBytes));
+
+	BYTE *pBlock = (BYTE *)pMemory - GetMemoryBlockOffset(nAlignment);
+	if (nAlignment == 0) ::free(pBlock); else ::_aligned_free(pBlock);
+}
+
+// ҽ private data پ ִٰ ҽ    Release()Ǿ Ʈ .
+class CResourceMemoryTracker : public IUnknown
+{
+public:
+	CResourceMemoryTracker(UINT nTag, __int64 nBytes) { m_nReferences = 1; m_nTag = nTag; m_nBytes = nBytes; }
+
+	STDMETHOD(QueryInterface)(REFIID riid, void **ppvObject)
+	{
+		if (riid == __uuidof(IUnknown))
+		{
+			*ppvObject = this;
+			AddRef();
+			return(S_OK);
+		}
+		*ppvObject = NULL;
+		return(E_NOINTERFACE);
+	}
+	STDMETHOD_(ULONG, AddRef)() { return(++m_nReferences); }
+	STDMETHOD_(ULONG, Release)()
+	{
+		ULONG nReferences = --m_nReferences;
+		if (nReferences == 0)
+		{
+			::gMemoryTracker.Free(MEMORY_POOL_GPU, m_nTag, m_nBytes);
+			delete this;
+		}
+		return(nReferences);
+	}
+
+private:
+	std::atomic<ULONG>				m_nReferences;
+	UINT							m_nTag;
+	__int64							m_nBytes;
+};
+
+void CMemoryTracker::TrackResource(ID3D12Resource *pd3dResource, UINT nTag)
+{
+	if (!pd3dResource) return;
+
+	ID3D12Device *pd3dDevice = NULL;
+	if (FAILED(pd3dResource->GetDevice(__uuidof(ID3D12Device), (void **)&pd3dDevice))) return;
+	D3D12_RESOURCE_DESC d3dResourceDesc = pd3dResource->GetDesc();
+	D3D12_RESOURCE_ALLOCATION_INFO d3dAllocationInfo = pd3dDevice->GetResourceAllocationInfo(0, 1, &d3dResourceDesc);
+	pd3dDevice->Release();
+	if (d3dAllocationInfo.SizeInBytes == UINT64_MAX) return;
+
+	Allocate(MEMORY_POOL_GPU, nTag, __int64(d3dAllocationInfo.SizeInBytes));
+	// ̹ پ ִ ü ٲ鼭 Release()Ǿ  ±׿ .
+	CResourceMemoryTracker *pTracker = new CResourceMemoryTracker(nTag, __int64(d3dAllocationInfo.SizeInBytes));
+	pd3dResource->SetPrivateDataInterface(MEMORY_TRACKER_GUID, pTracker);
+	pTracker->Release();
+}
+
+LPCTSTR CMemoryTracker::GetTagName(UINT nTag)
+{
+	static LPCTSTR ppszTagNames[MEMORY_TAGS + 1] = { _T("Other"), _T("Terrain"), _T("Vegetation"), _T("Texture"), _T("Upload"), _T("Render Target"), _T("Constant Buffer"), _T("Object Pool"), _T("Level Arena"), _T("Total") };
+	return(ppszTagNames[min(nTag, UINT(MEMORY_TAGS))]);
+}
+
+void CMemoryTracker::Update(float fTimeElapsed)
+{
+	m_fDumpTime += fTimeElapsed;
+	if (m_fDumpTime < MEMORY_DUMP_INTERVAL) return;
+	m_fDumpTime = 0.0f;
+	Dump();
+}
+
+void CMemoryTracker::Dump(FILE *pFile)
+{
+	TCHAR pstrLine[256];
+	_stprintf_s(pstrLine, 256, _T("Memory (MB)          CPU       Peak  Allocs        GPU       Peak  Resources\n"));
+	if (pFile) _fputts(pstrLine, pFile); else ::OutputDebugString(pstrLine);
+	for (UINT i = 0; i <= MEMORY_TAGS; i++)
+	{
+		_stprintf_s(pstrLine, 256, _T("%-16s %10.3f %10.3f %7lld %10.3f %10.3f %10lld\n"), GetTagName(i),
+			GetBytes(MEMORY_POOL_CPU, i) / (1024.0 * 1024.0), GetPeakBytes(MEMORY_POOL_CPU, i) / (1024.0 * 1024.0), GetAllocations(MEMORY_POOL_CPU, i),
+			GetBytes(MEMORY_POOL_GPU, i) / (1024.0 * 1024.0), GetPeakBytes(MEMORY_POOL_GPU, i) / (1024.0 * 1024.0), GetAllocations(MEMORY_POOL_GPU, i));
+		if (pFile) _fputts(pstrLine, pFile); else ::OutputDebugString(pstrLine);
+	}
+}
+
+bool CMemoryTracker::WriteReport(LPCTSTR pszFileName)
+{
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (!pFile) return(false);
+	Dump(pFile);
+	fclose(pFile);
+
+	TCHAR pstrDebug[MAX_PATH + 64];
+	_stprintf_s(pstrDebug, MAX_PATH + 64, _T("Memory: report written to %s\n"), pszFileName);
+	::OutputDebugString(pstrDebug);
+	return(true);
+}
+
+#ifdef _WITH_MEMORY_TRACKING
+inline void *AllocateTrackedMemory(size_t nBytes, size_t nAlignment = 0)
+{
+	return(::gMemoryTracker.AllocateMemory(nBytes, tnMemoryTag, nAlignment));
+}
+
+inline void FreeTrackedMemory(void *pMemory, size_t nAlignment = 0)
+{
+	::gMemoryTracker.FreeMemory(pMemory, nAlignment);
+}
+
+void *operator new(size_t nBytes)
+{
+	void *pMemory = AllocateTrackedMemory(nBytes);
+	if (!pMemory) throw std::bad_alloc();
+	return(pMemory);
+}
+
+void *operator new[](size_t nBytes)
+{
+	void *pMemory = AllocateTrackedMemory(nBytes);
+	if (!pMemory) throw std::bad_alloc();
+	return(pMemory);
+}
+
+void *operator new(size_t nBytes, const std::nothrow_t&) noexcept { return(AllocateTrackedMemory(nBytes)); }
+void *operator new[](size_t nBytes, const std::nothrow_t&) noexcept { return(AllocateTrackedMemory(nBytes)); }
+void operator delete(void *pMemory) noexcept { FreeTrackedMemory(pMemory); }
+void operator delete[](void *pMemory) noexcept { FreeTrackedMemory(pMemory); }
+void operator delete(void *pMemory, size_t) noexcept { FreeTrackedMemory(pMemory); }
+void operator delete[](void *pMemory, size_t) noexcept { FreeTrackedMemory(pMemory); }
+void operator delete(void *pMemory, const std::nothrow_t&) noexcept { FreeTrackedMemory(pMemory); }
+void operator delete[](void *pMemory, const std::nothrow_t&) noexcept { FreeTrackedMemory(pMemory); }
+
+#ifdef __cpp_aligned_new
+// alignas ⺻ (x64 16Ʈ, Win32 8Ʈ) ū Ÿ(: XMMATRIX  ü) new/delete. ٲ   Ҵ  delete ߸ ȴ.
+void *operator new(size_t nBytes, std::align_val_t nAlignment)
+{
+	void *pMemory = AllocateTrackedMemory(nBytes, size_t(nAlignment));
+	if (!pMemory) throw std::bad_alloc();
+	return(pMemory);
+}
+
+void *operator new[](size_t nBytes, std::align_val_t nAlignment)
+{
+	void *pMemory = AllocateTrackedMemory(nBytes, size_t(nAlignment));
+	if (!pMemory) throw std::bad_alloc();
+	return(pMemory);
+}
+
+void *operator new(size_t nBytes, std::align_val_t nAlignment, const std::nothrow_t&) noexcept { return(AllocateTrackedMemory(nBytes, size_t(nAlignment))); }
+void *operator new[](size_t nBytes, std::align_val_t nAlignment, const std::nothrow_t&) noexcept { return(AllocateTrackedMemory(nBytes, size_t(nAlignment))); }
+void operator delete(void *pMemory, std::align_val_t nAlignment) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+void operator delete[](void *pMemory, std::align_val_t nAlignment) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+void operator delete(void *pMemory, size_t, std::align_val_t nAlignment) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+void operator delete[](void *pMemory, size_t, std::align_val_t nAlignment) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+void operator delete(void *pMemory, std::align_val_t nAlignment, const std::nothrow_t&) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+void operator delete[](void *pMemory, std::align_val_t nAlignment, const std::nothrow_t&) noexcept { FreeTrackedMemory(pMemory, size_t(nAlignment)); }
+#endif
+#endif
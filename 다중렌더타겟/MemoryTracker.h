@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// File: MemoryTracker.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Profiler.h"
+
+// ϸ  new/delete ٲ㼭  CPU Ҵ   ±׷ . (Ҵ縶 16Ʈ Ӹ    )
+#define _WITH_MEMORY_TRACKING
+
+#define MEMORY_TAG_OTHER				0
+#define MEMORY_TAG_TERRAIN				1
+#define MEMORY_TAG_VEGETATION			2
+#define MEMORY_TAG_TEXTURE				3
+#define MEMORY_TAG_UPLOAD				4
+#define MEMORY_TAG_RENDER_TARGET		5
+#define MEMORY_TAG_CONSTANT_BUFFER		6
+#define MEMORY_TAG_OBJECT_POOL			7			//CObjectPool  (Ǯ ߶  ü   ʴ´)
+#define MEMORY_TAG_LEVEL_ARENA			8			//CLevelArena 
+#define MEMORY_TAGS						9
+
+#define MEMORY_POOL_CPU					0
+#define MEMORY_POOL_GPU					1
+#define MEMORY_POOLS					2
+
+#define MEMORY_DUMP_INTERVAL			10.0f		// ð()   ǥ 
+#define MEMORY_REPORT_NAME				_T("MemoryReport.txt")
+
+struct MEMORY_COUNTERS
+{
+	std::atomic<__int64>			m_nBytes;
+	std::atomic<__int64>			m_nPeakBytes;
+	std::atomic<__int64>			m_nAllocations;			// ִ Ҵ(GPU ҽ) 
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ±( ý) CPU  GPU ҽ  Ʈ ִ Ʈ .
+// GPU ҽ ũ ҽ  GetResourceAllocationInfo() ϰ( ), ҽ   private data  ü .
+// ׷ Release() θ (  ť ) ġ ʾƵ ȴ.
+//  new  ʱȭ  θ  Ƿ ڰ . (0 ʱȭȴ)
+class CMemoryTracker
+{
+private:
+	MEMORY_COUNTERS					m_ppCounters[MEMORY_POOLS][MEMORY_TAGS + 1];	// ü
+	float							m_fDumpTime;
+
+	MEMORY_COUNTERS *GetCounters(UINT nPool, UINT nTag) { return(&m_ppCounters[nPool][(nTag < MEMORY_TAGS) ? nTag : MEMORY_TAG_OTHER]); }
+
+public:
+	void Allocate(UINT nPool, UINT nTag, __int64 nBytes);
+	void Free(UINT nPool, UINT nTag, __int64 nBytes);
+
+	//  new ġ ʴ CPU Ҵ(Ǯ Ʒ ). ũ ±׸ տ ٿ nTag , FreeMemory()  ±׿ .
+	// nAlignment 0̸ malloc()  . ƴϸ FreeMemory()   Ѱܾ Ѵ.
+	void *AllocateMemory(size_t nBytes, UINT nTag, size_t nAlignment = 0);
+	void FreeMemory(void *pMemory, size_t nAlignment = 0);
+
+	// ҽ   θ.  ҽ ٽ ѱ  ±׸ ٲ۴.
+	void TrackResource(ID3D12Resource *pd3dResource, UINT nTag);
+
+	// nTag MEMORY_TAGS̸ ü
+	__int64 GetBytes(UINT nPool, UINT nTag = MEMORY_TAGS) { return(m_ppCounters[nPool][min(nTag, UINT(MEMORY_TAGS))].m_nBytes.load()); }
+	__int64 GetPeakBytes(UINT nPool, UINT nTag = MEMORY_TAGS) { return(m_ppCounters[nPool][min(nTag, UINT(MEMORY_TAGS))].m_nPeakBytes.load()); }
+	__int64 GetAllocations(UINT nPool, UINT nTag = MEMORY_TAGS) { return(m_ppCounters[nPool][min(nTag, UINT(MEMORY_TAGS))].m_nAllocations.load()); }
+	static LPCTSTR GetTagName(UINT nTag);
+
+	// Ӹ θ. MEMORY_DUMP_INTERVALʸ Dump()Ѵ.
+	void Update(float fTimeElapsed);
+	void Dump(FILE *pFile = NULL);
+	bool WriteReport(LPCTSTR pszFileName);
+};
+
+extern CMemoryTracker gMemoryTracker;
+
+//  忡  CPU Ҵ  ҽ ±׸   ٲ۴. (ؽ,  Ÿ, ε ۴  ±׸ Ѵ)
+class CMemoryTagScope
+{
+public:
+	CMemoryTagScope(UINT nTag);
+	~CMemoryTagScope();
+
+	static UINT GetCurrentTag();
+
+private:
+	UINT							m_nPreviousTag;
+};
+
+#define MEMORY_TAG_SCOPE(nTag)		CMemoryTagScope PROFILE_CONCATENATE(xMemoryTagScope, __LINE__)(nTag)
@@ -25,19 +25,25 @@ void CMesh::ReleaseUploadBuffers()
 	m_pd3dIndexUploadBuffer = NULL;
 };
 
-void CMesh::Render(ID3D12GraphicsCommandList *pd3dCommandList)
+void CMesh::OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	::gFilteredCommandList.IASetPrimitiveTopology(pd3dCommandList, m_d3dPrimitiveTopology);
+	::gFilteredCommandList.IASetVertexBuffers(pd3dCommandList, m_nSlot, 1, &m_d3dVertexBufferView);
+	if (m_pd3dIndexBuffer) ::gFilteredCommandList.IASetIndexBuffer(pd3dCommandList, &m_d3dIndexBufferView);
+}
+
+void CMesh::Draw(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	pd3dCommandList->IASetPrimitiveTopology(m_d3dPrimitiveTopology);
-	pd3dCommandList->IASetVertexBuffers(m_nSlot, 1, &m_d3dVertexBufferView);
 	if (m_pd3dIndexBuffer)
-	{
-		pd3dCommandList->IASetIndexBuffer(&m_d3dIndexBufferView);
-		pd3dCommandList->DrawIndexedInstanced(m_nIndices, 1, 0, 0, 0);
-	}
+		::gFilteredCommandList.DrawIndexedInstanced(pd3dCommandList, m_nIndices, 1, 0, 0, 0);
 	else
-	{
-		pd3dCommandList->DrawInstanced(m_nVertices, 1, m_nOffset, 0);
-	}
+		::gFilteredCommandList.DrawInstanced(pd3dCommandList, m_nVertices, 1, m_nOffset, 0);
+}
+
+void CMesh::Render(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	OnPrepareRender(pd3dCommandList);
+	Draw(pd3dCommandList);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +57,7 @@ CCubeMeshDiffused::CCubeMeshDiffused(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
 	float fx = fWidth*0.5f, fy = fHeight*0.5f, fz = fDepth*0.5f;
+	m_xmBoundingBox = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(fx, fy, fz));
 
 	CDiffusedVertex pVertices[8];
 
@@ -107,6 +114,7 @@ CCubeMeshTextured::CCubeMeshTextured(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
 	float fx = fWidth*0.5f, fy = fHeight*0.5f, fz = fDepth*0.5f;
+	m_xmBoundingBox = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(fx, fy, fz));
 
 	CTexturedVertex pVertices[36];
 	int i = 0;
@@ -180,6 +188,7 @@ CTexturedRectMesh::CTexturedRectMesh(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	CTexturedVertex pVertices[6];
 	float fx = (fWidth * 0.5) + fxPosition, fy = (fHeight * 0.5) + fyPosition, fz = (fDepth * 0.5) + fzPosition;
+	m_xmBoundingBox = BoundingBox(XMFLOAT3(fxPosition, fyPosition, fzPosition), XMFLOAT3(fWidth * 0.5f, fHeight * 0.5f, fDepth * 0.5f));
 	if (fWidth == 0.f) {
 		if (fxPosition > 0.f) {
 			pVertices[0] = CTexturedVertex(XMFLOAT3(fx, +fy, -fz), XMFLOAT2(1.f, 0.f));
@@ -252,6 +261,7 @@ CAirplaneMeshDiffused::CAirplaneMeshDiffused(ID3D12Device *pd3dDevice, ID3D12Gra
 	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
 	float fx = fWidth*0.5f, fy = fHeight*0.5f, fz = fDepth*0.5f;
+	m_xmBoundingBox = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(fx, fy, fz));
 
 	CDiffusedVertex pVertices[24 * 3];
 
@@ -386,7 +396,8 @@ CHeightMapImage::CHeightMapImage(LPCTSTR pFileName, int nWidth, int nLength, XMF
 	::ReadFile(hFile, pHeightMapPixels, (m_nWidth * m_nLength), &dwBytesRead, NULL);
 	::CloseHandle(hFile);
 
-	m_pHeightMapPixels = new BYTE[m_nWidth * m_nLength];
+	//    Բ    ǹǷ  Ʒ д.
+	m_pHeightMapPixels = ::gLevelArena.AllocateArray<BYTE>(m_nWidth * m_nLength);
 	for (int y = 0; y < m_nLength; y++)
 	{
 		for (int x = 0; x < m_nWidth; x++)
@@ -398,9 +409,19 @@ CHeightMapImage::CHeightMapImage(LPCTSTR pFileName, int nWidth, int nLength, XMF
 	if (pHeightMapPixels) delete[] pHeightMapPixels;
 }
 
+CHeightMapImage::CHeightMapImage(const BYTE *pHeightMapPixels, int nWidth, int nLength, XMFLOAT3 xmf3Scale)
+{
+	m_nWidth = nWidth;
+	m_nLength = nLength;
+	m_xmf3Scale = xmf3Scale;
+
+	m_pHeightMapPixels = ::gLevelArena.AllocateArray<BYTE>(m_nWidth * m_nLength);
+	::memcpy(m_pHeightMapPixels, pHeightMapPixels, m_nWidth * m_nLength);
+}
+
 CHeightMapImage::~CHeightMapImage()
 {
-	if (m_pHeightMapPixels) delete[] m_pHeightMapPixels;
+	// m_pHeightMapPixels gLevelArena.Reset() ȴ.
 	m_pHeightMapPixels = NULL;
 }
 
@@ -505,6 +526,9 @@ CHeightMapGridMesh::CHeightMapGridMesh(ID3D12Device *pd3dDevice, ID3D12GraphicsC
 
 	delete[] pVertices;
 
+	XMFLOAT3 xmf3Extents = XMFLOAT3(((nWidth - 1) * m_xmf3Scale.x) * 0.5f, (fMaxHeight - fMinHeight) * 0.5f, ((nLength - 1) * m_xmf3Scale.z) * 0.5f);
+	m_xmBoundingBox = BoundingBox(XMFLOAT3((xStart * m_xmf3Scale.x) + xmf3Extents.x, (fMinHeight + fMaxHeight) * 0.5f, (zStart * m_xmf3Scale.z) + xmf3Extents.z), xmf3Extents);
+
 	m_nIndices = ((nWidth * 2)*(nLength - 1)) + ((nLength - 1) - 1);
 	UINT *pnIndices = new UINT[m_nIndices];
 
@@ -577,6 +601,8 @@ CTreeVertexMesh::CTreeVertexMesh(ID3D12Device *pd3dDevice, ID3D12GraphicsCommand
 	m_nStride = sizeof(CBillboardVertex);
 	m_nVertices = 1;
 	m_d3dPrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_POINTLIST;
+	//  ̴  ߽ fxSize x fySize 簢 ȮѴ.
+	m_xmBoundingBox = BoundingBox(XMFLOAT3(fxPosition, fyPosition, fzPosition), XMFLOAT3(fxSize * 0.5f, fySize * 0.5f, fxSize * 0.5f));
 	CBillboardVertex *pTreeVertex = new CBillboardVertex(XMFLOAT3(fxPosition, fyPosition, fzPosition), XMFLOAT2(fxSize, fySize));
 	m_pd3dVertexBuffer = ::CreateBufferResource(pd3dDevice, pd3dCommandList, pTreeVertex,
 		m_nStride*m_nVertices, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,
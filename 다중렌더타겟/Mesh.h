@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include "FilteredCommandList.h"
+#include "Pool.h"
+#include "DeferredDeletion.h"
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 class CVertex
@@ -89,12 +93,15 @@ public:
     CMesh(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
     virtual ~CMesh();
 
+	DECLARE_POOLED_OBJECT()
+
 private:
-	int								m_nReferences = 0;
+	std::atomic<int>				m_nReferences{ 0 };
 
 public:
-	void AddRef() { m_nReferences++; }
-	void Release() { if (--m_nReferences <= 0) delete this; }
+	// ø   ʿ ,  Release() ٸ  ⸦    .
+	void AddRef() { m_nReferences.fetch_add(1, std::memory_order_relaxed); }
+	void Release() { if (m_nReferences.fetch_sub(1, std::memory_order_acq_rel) <= 1) ::gDeferredDeletionQueue.Push(this, ::DeleteDeferredObject<CMesh>); }
 
 	void ReleaseUploadBuffers();
 
@@ -118,7 +125,15 @@ protected:
 	UINT							m_nStartIndex = 0;
 	int								m_nBaseVertex = 0;
 
+	//  ǥ   (ø  ҿ )
+	BoundingBox						m_xmBoundingBox = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f));
+
 public:
+	BoundingBox& GetBoundingBox() { return(m_xmBoundingBox); }
+
+	//  ť ӵ  ޽  Է  ܰ踦   ϰ Draw() ݺѴ.
+	virtual void OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList);
+	virtual void Draw(ID3D12GraphicsCommandList *pd3dCommandList);
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList);
 };
 
@@ -173,6 +188,8 @@ private:
 
 public:
 	CHeightMapImage(LPCTSTR pFileName, int nWidth, int nLength, XMFLOAT3 xmf3Scale);
+	// ̹ Ʒ ٺ   ( ) Ѵ.
+	CHeightMapImage(const BYTE *pHeightMapPixels, int nWidth, int nLength, XMFLOAT3 xmf3Scale);
 	~CHeightMapImage(void);
 
 	float GetHeight(float x, float z, bool bReverseQuad = false);
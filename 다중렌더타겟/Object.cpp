@@ -5,6 +5,9 @@
 #include "stdafx.h"
 #include "Object.h"
 #include "Shader.h"
+#include "RenderQueue.h"
+#include "RenderStats.h"
+#include "FrameUploadBuffer.h"
 
 CTexture::CTexture(int nTextures, UINT nTextureType, int nSamplers)
 {
@@ -51,20 +54,20 @@ void CTexture::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
 {
 	if (m_nTextureType == RESOURCE_TEXTURE2D_ARRAY)
 	{
-		pd3dCommandList->SetGraphicsRootDescriptorTable(m_pRootArgumentInfos[0].m_nRootParameterIndex, m_pRootArgumentInfos[0].m_d3dSrvGpuDescriptorHandle);
+		::gFilteredCommandList.SetGraphicsRootDescriptorTable(pd3dCommandList, m_pRootArgumentInfos[0].m_nRootParameterIndex, m_pRootArgumentInfos[0].m_d3dSrvGpuDescriptorHandle);
 	}
 	else
 	{
 		for (int i = 0; i < m_nTextures; i++)
 		{
-			pd3dCommandList->SetGraphicsRootDescriptorTable(m_pRootArgumentInfos[i].m_nRootParameterIndex, m_pRootArgumentInfos[i].m_d3dSrvGpuDescriptorHandle);
+			::gFilteredCommandList.SetGraphicsRootDescriptorTable(pd3dCommandList, m_pRootArgumentInfos[i].m_nRootParameterIndex, m_pRootArgumentInfos[i].m_d3dSrvGpuDescriptorHandle);
 		}
 	}
 }
 
 void CTexture::UpdateShaderVariable(ID3D12GraphicsCommandList *pd3dCommandList, int nIndex)
 {
-	pd3dCommandList->SetGraphicsRootDescriptorTable(m_pRootArgumentInfos[nIndex].m_nRootParameterIndex, m_pRootArgumentInfos[nIndex].m_d3dSrvGpuDescriptorHandle);
+	::gFilteredCommandList.SetGraphicsRootDescriptorTable(pd3dCommandList, m_pRootArgumentInfos[nIndex].m_nRootParameterIndex, m_pRootArgumentInfos[nIndex].m_d3dSrvGpuDescriptorHandle);
 }
 
 void CTexture::ReleaseUploadBuffers()
@@ -136,9 +139,9 @@ void CMaterial::ReleaseUploadBuffers()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-CGameObject::CGameObject(int nMeshes)
+CGameObject::CGameObject(int nMeshes, TRANSFORM_HANDLE hTransform)
 {
-	m_xmf4x4World = Matrix4x4::Identity();
+	m_hTransform = (hTransform != TRANSFORM_HANDLE_NULL) ? hTransform : ::gTransformStorage.Allocate();
 
 	m_nMeshes = nMeshes;
 	m_ppMeshes = NULL;
@@ -163,6 +166,8 @@ CGameObject::~CGameObject()
 		delete[] m_ppMeshes;
 	}
 	if (m_pMaterial) m_pMaterial->Release();
+
+	::gTransformStorage.Free(m_hTransform);
 }
 
 void CGameObject::SetMesh(int nIndex, CMesh *pMesh)
@@ -194,25 +199,25 @@ void CGameObject::SetMaterial(CMaterial *pMaterial)
 
 void CGameObject::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255); //256 
-	m_pd3dcbGameObject = ::CreateBufferResource(pd3dDevice, pd3dCommandList, NULL, ncbElementBytes, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, NULL);
-
-	m_pd3dcbGameObject->Map(0, NULL, (void **)&m_pcbMappedGameObject);
+	// GPU   д   ʵ ۸ ̸  ʰ Ӹ gFrameUploadBuffer ޴´.
+	m_bConstantBuffer = true;
 }
 
 void CGameObject::ReleaseShaderVariables()
 {
-	if (m_pd3dcbGameObject)
-	{
-		m_pd3dcbGameObject->Unmap(0, NULL);
-		m_pd3dcbGameObject->Release();
-	}
 	if (m_pMaterial) m_pMaterial->ReleaseShaderVariables();
 }
 
 void CGameObject::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	XMStoreFloat4x4(&m_pcbMappedGameObject->m_xmf4x4World, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4World)));
+	// ҿ ̹ ġ  Ƿ ״ Ѵ.
+	if (!m_bConstantBuffer) return; //̴  ۸ Ѳ ϴ ü
+
+	::gTransformStorage.UpdateWorldMatrix(m_hTransform);
+	CB_GAMEOBJECT_INFO *pcbMappedGameObject = (CB_GAMEOBJECT_INFO *)::gFrameUploadBuffer.Allocate(sizeof(CB_GAMEOBJECT_INFO), &m_d3dcbGameObject);
+	if (!pcbMappedGameObject) return;
+	::memcpy(pcbMappedGameObject, ::gTransformStorage.GetShaderConstants(m_hTransform), sizeof(CB_GAMEOBJECT_INFO));
+	::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, sizeof(CB_GAMEOBJECT_INFO));
 }
 
 void CGameObject::Animate(float fTimeElapsed)
@@ -221,6 +226,7 @@ void CGameObject::Animate(float fTimeElapsed)
 
 void CGameObject::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
+	RENDER_STATS_SHADER((m_pMaterial) ? m_pMaterial->m_pShader : NULL);
 	OnPrepareRender();
 
 	if (m_pMaterial)
@@ -238,7 +244,7 @@ void CGameObject::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pC
 		}
 	}
 
-	pd3dCommandList->SetGraphicsRootDescriptorTable(2, m_d3dCbvGPUDescriptorHandle);
+	if (m_d3dcbGameObject) ::gFilteredCommandList.SetGraphicsRootConstantBufferView(pd3dCommandList, 2, m_d3dcbGameObject);
 
 	if (m_ppMeshes)
 	{
@@ -249,6 +255,36 @@ void CGameObject::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pC
 	}
 }
 
+void CGameObject::SubmitRenderPackets(CRenderQueue *pRenderQueue, CShader *pShader, CCamera *pCamera, UINT nPass)
+{
+	OnPrepareRender();
+
+	if (m_pMaterial && m_pMaterial->m_pShader) pShader = m_pMaterial->m_pShader;
+	CTexture *pTexture = (m_pMaterial) ? m_pMaterial->m_pTexture : NULL;
+
+	// н   ø  ü Ŷ  ּҸ .
+	{
+		RENDER_STATS_SHADER(pShader);
+		UpdateShaderVariables(NULL);
+	}
+
+	float fDepth = 0.0f;
+	if (pCamera)
+	{
+		XMFLOAT3 xmf3Position = GetPosition(), xmf3CameraPosition = pCamera->GetPosition();
+		XMFLOAT3 xmf3ToCamera = Vector3::Subtract(xmf3Position, xmf3CameraPosition);
+		fDepth = Vector3::Length(xmf3ToCamera);
+	}
+
+	if (m_ppMeshes)
+	{
+		for (int i = 0; i < m_nMeshes; i++)
+		{
+			if (m_ppMeshes[i]) pRenderQueue->Submit(nPass, pShader, pTexture, m_ppMeshes[i], m_d3dcbGameObject, fDepth);
+		}
+	}
+}
+
 void CGameObject::ReleaseUploadBuffers()
 {
 	if (m_ppMeshes)
@@ -264,9 +300,7 @@ void CGameObject::ReleaseUploadBuffers()
 
 void CGameObject::SetPosition(float x, float y, float z)
 {
-	m_xmf4x4World._41 = x;
-	m_xmf4x4World._42 = y;
-	m_xmf4x4World._43 = z;
+	::gTransformStorage.SetPosition(m_hTransform, XMFLOAT3(x, y, z));
 }
 
 void CGameObject::SetPosition(XMFLOAT3 xmf3Position)
@@ -276,22 +310,22 @@ void CGameObject::SetPosition(XMFLOAT3 xmf3Position)
 
 XMFLOAT3 CGameObject::GetPosition()
 {
-	return(XMFLOAT3(m_xmf4x4World._41, m_xmf4x4World._42, m_xmf4x4World._43));
+	return(::gTransformStorage.GetPosition(m_hTransform));
 }
 
 XMFLOAT3 CGameObject::GetLook()
 {
-	return(Vector3::Normalize(XMFLOAT3(m_xmf4x4World._31, m_xmf4x4World._32, m_xmf4x4World._33)));
+	return(Vector3::Normalize(::gTransformStorage.GetLook(m_hTransform)));
 }
 
 XMFLOAT3 CGameObject::GetUp()
 {
-	return(Vector3::Normalize(XMFLOAT3(m_xmf4x4World._21, m_xmf4x4World._22, m_xmf4x4World._23)));
+	return(Vector3::Normalize(::gTransformStorage.GetUp(m_hTransform)));
 }
 
 XMFLOAT3 CGameObject::GetRight()
 {
-	return(Vector3::Normalize(XMFLOAT3(m_xmf4x4World._11, m_xmf4x4World._12, m_xmf4x4World._13)));
+	return(Vector3::Normalize(::gTransformStorage.GetRight(m_hTransform)));
 }
 
 void CGameObject::MoveStrafe(float fDistance)
@@ -321,22 +355,20 @@ void CGameObject::MoveForward(float fDistance)
 void CGameObject::Rotate(float fPitch, float fYaw, float fRoll)
 {
 	XMMATRIX mtxRotate = XMMatrixRotationRollPitchYaw(XMConvertToRadians(fPitch), XMConvertToRadians(fYaw), XMConvertToRadians(fRoll));
-	m_xmf4x4World = Matrix4x4::Multiply(mtxRotate, m_xmf4x4World);
+	::gTransformStorage.PreMultiply(m_hTransform, mtxRotate);
 }
 
 void CGameObject::Rotate(XMFLOAT3 *pxmf3Axis, float fAngle)
 {
 	XMMATRIX mtxRotate = XMMatrixRotationAxis(XMLoadFloat3(pxmf3Axis), XMConvertToRadians(fAngle));
-	m_xmf4x4World = Matrix4x4::Multiply(mtxRotate, m_xmf4x4World);
+	::gTransformStorage.PreMultiply(m_hTransform, mtxRotate);
 }
 
 void CGameObject::SetLookAt(XMFLOAT3& xmf3Target, XMFLOAT3& xmf3Up) {
-	XMFLOAT3 xmf3Position(m_xmf4x4World._41, m_xmf4x4World._42, m_xmf4x4World._43);
+	XMFLOAT3 xmf3Position = ::gTransformStorage.GetPosition(m_hTransform);
 	XMFLOAT3 xmf3Look = Vector3::Subtract(xmf3Target, xmf3Position);
 	XMFLOAT3 xmf3Right = Vector3::CrossProduct(xmf3Up, xmf3Look, true);
-	m_xmf4x4World._11 = xmf3Right.x; m_xmf4x4World._12 = xmf3Right.y; m_xmf4x4World._13 = xmf3Right.z;
-	m_xmf4x4World._21 = xmf3Up.x; m_xmf4x4World._22 = xmf3Up.y; m_xmf4x4World._23 = xmf3Up.z;
-	m_xmf4x4World._31 = xmf3Look.x; m_xmf4x4World._32 = xmf3Look.y; m_xmf4x4World._33 = xmf3Look.z;
+	::gTransformStorage.SetRotation(m_hTransform, xmf3Right, xmf3Up, xmf3Look);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -376,11 +408,11 @@ CRevolvingObject::~CRevolvingObject()
 void CRevolvingObject::Animate(float fTimeElapsed)
 {
 	XMMATRIX mtxRotate = XMMatrixRotationAxis(XMLoadFloat3(&m_xmf3RevolutionAxis), XMConvertToRadians(m_fRevolutionSpeed * fTimeElapsed));
-	m_xmf4x4World = Matrix4x4::Multiply(m_xmf4x4World, mtxRotate);
+	::gTransformStorage.PostMultiply(m_hTransform, mtxRotate);
 }
 ////////////////////////////////////////////////////////////////////////
 //  Ʈ
-CBillboardObject::CBillboardObject(int nMeshes) {
+CBillboardObject::CBillboardObject(int nMeshes, TRANSFORM_HANDLE hTransform) : CGameObject(nMeshes, hTransform) {
 	m_xmf3RotationAxis = XMFLOAT3(0.0f, 1.0f, 0.0f);
 	m_fRotationSpeed = 15.0f;
 }
@@ -409,15 +441,36 @@ void CBillboardObject::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamer
 //
 CHeightMapTerrain::CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, LPCTSTR pFileName, int nWidth, int nLength, int nBlockWidth, int nBlockLength, XMFLOAT3 xmf3Scale, XMFLOAT4 xmf4Color) : CGameObject(0)
 {
-	m_nWidth = nWidth;
-	m_nLength = nLength;
+	m_pHeightMapImage = new CHeightMapImage(pFileName, nWidth, nLength, xmf3Scale);
+
+	// ؽó 2 
+	CTexture *pTerrainTexture = new CTexture(2, RESOURCE_TEXTURE2D, 0);
+	
+	// baseؽó detailؽó ε
+	pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/Base_Texture.dds", 0);
+	pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/Detail_Texture_7.dds", 1);
+	//pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"../Assets/Image/Terrain/Base_Texture.dds", 0);
+	//pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"../Assets/Image/Terrain/Detail_Texture_7.dds", 1);
+
+	BuildTerrain(pd3dDevice, pd3dCommandList, pd3dGraphicsRootSignature, nBlockWidth, nBlockLength, xmf4Color, pTerrainTexture);
+}
+
+CHeightMapTerrain::CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, CHeightMapImage *pHeightMapImage, int nBlockWidth, int nBlockLength, XMFLOAT4 xmf4Color, CTexture *pTerrainTexture) : CGameObject(0)
+{
+	m_pHeightMapImage = pHeightMapImage;
+
+	BuildTerrain(pd3dDevice, pd3dCommandList, pd3dGraphicsRootSignature, nBlockWidth, nBlockLength, xmf4Color, pTerrainTexture);
+}
+
+void CHeightMapTerrain::BuildTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, int nBlockWidth, int nBlockLength, XMFLOAT4 xmf4Color, CTexture *pTerrainTexture)
+{
+	m_nWidth = m_pHeightMapImage->GetHeightMapWidth();
+	m_nLength = m_pHeightMapImage->GetHeightMapLength();
 
 	int cxQuadsPerBlock = nBlockWidth - 1;
 	int czQuadsPerBlock = nBlockLength - 1;
 
-	m_xmf3Scale = xmf3Scale;
-
-	m_pHeightMapImage = new CHeightMapImage(pFileName, nWidth, nLength, xmf3Scale);
+	m_xmf3Scale = m_pHeightMapImage->GetScale();
 
 	long cxBlocks = (m_nWidth - 1) / cxQuadsPerBlock;
 	long czBlocks = (m_nLength - 1) / czQuadsPerBlock;
@@ -433,29 +486,18 @@ CHeightMapTerrain::CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 		{
 			xStart = x * (nBlockWidth - 1);
 			zStart = z * (nBlockLength - 1);
-			pHeightMapGridMesh = new CHeightMapGridMesh(pd3dDevice, pd3dCommandList, xStart, zStart, nBlockWidth, nBlockLength, xmf3Scale, xmf4Color, m_pHeightMapImage);
+			pHeightMapGridMesh = new CHeightMapGridMesh(pd3dDevice, pd3dCommandList, xStart, zStart, nBlockWidth, nBlockLength, m_xmf3Scale, xmf4Color, m_pHeightMapImage);
 			SetMesh(x + (z*cxBlocks), pHeightMapGridMesh);
 		}
 	}
 
 	CreateShaderVariables(pd3dDevice, pd3dCommandList);
 
-	// ؽó 2 
-	CTexture *pTerrainTexture = new CTexture(2, RESOURCE_TEXTURE2D, 0);
-	
-	// baseؽó detailؽó ε
-	pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/Base_Texture.dds", 0);
-	pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/Detail_Texture_7.dds", 1);
-	//pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"../Assets/Image/Terrain/Base_Texture.dds", 0);
-	//pTerrainTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"../Assets/Image/Terrain/Detail_Texture_7.dds", 1);
-
-	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255); //256 
-
+	//  ۴ Ʈ ڷ ϹǷ   SRV д.
 	CTerrainShader *pTerrainShader = new CTerrainShader();
 	pTerrainShader->CreateShader(pd3dDevice, pd3dGraphicsRootSignature, 1);
 	pTerrainShader->CreateShaderVariables(pd3dDevice, pd3dCommandList);
-	pTerrainShader->CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 1, 2);
-	pTerrainShader->CreateConstantBufferViews(pd3dDevice, pd3dCommandList, 1, m_pd3dcbGameObject, ncbElementBytes);
+	pTerrainShader->CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 0, 2);
 	
 	// 4 Ķ srv. - baseTexture
 	// ȿ Լȿ 5, 6 ĶͿ srv  - detailTexture
@@ -466,8 +508,6 @@ CHeightMapTerrain::CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 
 	SetMaterial(pTerrainMaterial);
 
-	SetCbvGPUDescriptorHandle(pTerrainShader->GetGPUCbvDescriptorStartHandle());
-
 	SetShader(pTerrainShader);
 }
 
@@ -6,6 +6,7 @@
 
 #include "Mesh.h"
 #include "Camera.h"
+#include "Transform.h"
 
 #define DIR_FORWARD					0x01
 #define DIR_BACKWARD				0x02
@@ -21,6 +22,7 @@
 #define RESOURCE_BUFFER				0x05
 
 class CShader;
+class CRenderQueue;
 
 struct CB_GAMEOBJECT_INFO
 {
@@ -41,8 +43,10 @@ public:
 	CTexture(int nTextureResources = 1, UINT nResourceType = RESOURCE_TEXTURE2D, int nSamplers = 0);
 	virtual ~CTexture();
 
+	DECLARE_POOLED_OBJECT()
+
 private:
-	int								m_nReferences = 0;
+	std::atomic<int>				m_nReferences{ 0 };
 
 	UINT							m_nTextureType = RESOURCE_TEXTURE2D;
 	int								m_nTextures = 0;
@@ -55,8 +59,8 @@ private:
 	D3D12_GPU_DESCRIPTOR_HANDLE		*m_pd3dSamplerGpuDescriptorHandles = NULL;
 
 public:
-	void AddRef() { m_nReferences++; }
-	void Release() { if (--m_nReferences <= 0) delete this; }
+	void AddRef() { m_nReferences.fetch_add(1, std::memory_order_relaxed); }
+	void Release() { if (m_nReferences.fetch_sub(1, std::memory_order_acq_rel) <= 1) ::gDeferredDeletionQueue.Push(this, ::DeleteDeferredObject<CTexture>); }
 
 	void SetRootArgument(int nIndex, UINT nRootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE d3dsrvGpuDescriptorHandle);
 	void SetSampler(int nIndex, D3D12_GPU_DESCRIPTOR_HANDLE d3dSamplerGpuDescriptorHandle);
@@ -81,12 +85,14 @@ public:
 	CMaterial();
 	virtual ~CMaterial();
 
+	DECLARE_POOLED_OBJECT()
+
 private:
-	int								m_nReferences = 0;
+	std::atomic<int>				m_nReferences{ 0 };
 
 public:
-	void AddRef() { m_nReferences++; }
-	void Release() { if (--m_nReferences <= 0) delete this; }
+	void AddRef() { m_nReferences.fetch_add(1, std::memory_order_relaxed); }
+	void Release() { if (m_nReferences.fetch_sub(1, std::memory_order_acq_rel) <= 1) ::gDeferredDeletionQueue.Push(this, ::DeleteDeferredObject<CMaterial>); }
 
 	XMFLOAT4						m_xmf4Albedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -108,32 +114,31 @@ public:
 class CGameObject
 {
 public:
-	CGameObject(int nMeshes=1);
+	CGameObject(int nMeshes=1, TRANSFORM_HANDLE hTransform=TRANSFORM_HANDLE_NULL);
 	virtual ~CGameObject();
 
+	DECLARE_POOLED_OBJECT()
+
 public:
-	XMFLOAT4X4						m_xmf4x4World;
+	// ȯ gTransformStorage ǰ ü ڵ鸸  ִ.
+	TRANSFORM_HANDLE				m_hTransform = TRANSFORM_HANDLE_NULL;
 
 	CMesh							**m_ppMeshes;
 	int								m_nMeshes;
 
 	CMaterial						*m_pMaterial = NULL;
 
-	D3D12_GPU_DESCRIPTOR_HANDLE		m_d3dCbvGPUDescriptorHandle;
-
 protected:
-	ID3D12Resource					*m_pd3dcbGameObject = NULL;
-	CB_GAMEOBJECT_INFO				*m_pcbMappedGameObject = NULL;
+	// CreateShaderVariables() θ ü ڱ  ۸ . (ƴϸ ̴  ۸ Ѳ Ѵ)
+	// ۴ UpdateShaderVariables() Ӹ gFrameUploadBuffer ް Ʈ Ķ 2 Ѵ.
+	bool							m_bConstantBuffer = false;
+	D3D12_GPU_VIRTUAL_ADDRESS		m_d3dcbGameObject = 0;
 
 public:
 	void SetMesh(int nIndex, CMesh *pMesh);
 	void SetShader(CShader *pShader);
 	void SetMaterial(CMaterial *pMaterial);
 
-	void SetCbvGPUDescriptorHandle(D3D12_GPU_DESCRIPTOR_HANDLE d3dCbvGPUDescriptorHandle) { m_d3dCbvGPUDescriptorHandle = d3dCbvGPUDescriptorHandle; }
-	void SetCbvGPUDescriptorHandlePtr(UINT64 nCbvGPUDescriptorHandlePtr) { m_d3dCbvGPUDescriptorHandle.ptr = nCbvGPUDescriptorHandlePtr; }
-	D3D12_GPU_DESCRIPTOR_HANDLE GetCbvGPUDescriptorHandle() { return(m_d3dCbvGPUDescriptorHandle); }
-
 	virtual void CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
 	virtual void ReleaseShaderVariables();
 	virtual void UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList);
@@ -141,10 +146,19 @@ public:
 	virtual void Animate(float fTimeElapsed);
 	virtual void OnPrepareRender() { }
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera=NULL);
+	//  ۸   ø ޽ ׸ Ŷ Ѵ.  ̴  pShader  ¿   Ѵ.
+	virtual void SubmitRenderPackets(CRenderQueue *pRenderQueue, CShader *pShader, CCamera *pCamera, UINT nPass);
 
 	virtual void BuildMaterials(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList) { }
 	virtual void ReleaseUploadBuffers();
 
+	// ġ/ Լ θ   ȯ ٷ. (θ   ȯ )
+	void SetParent(CGameObject *pParent) { ::gTransformStorage.SetParent(m_hTransform, (pParent) ? pParent->m_hTransform : TRANSFORM_HANDLE_NULL); }
+
+	XMFLOAT4X4 GetWorldMatrix() { return(::gTransformStorage.GetWorldMatrix(m_hTransform)); }
+	XMFLOAT4X4 GetLocalMatrix() { return(::gTransformStorage.GetLocalMatrix(m_hTransform)); }
+	void SetLocalMatrix(const XMFLOAT4X4& xmf4x4Local) { ::gTransformStorage.SetLocalMatrix(m_hTransform, xmf4x4Local); }
+
 	XMFLOAT3 GetPosition();
 	XMFLOAT3 GetLook();
 	XMFLOAT3 GetUp();
@@ -186,7 +200,7 @@ public:
 class CBillboardObject : public CGameObject
 {
 public:
-	CBillboardObject(int nMeshes = 1);
+	CBillboardObject(int nMeshes = 1, TRANSFORM_HANDLE hTransform = TRANSFORM_HANDLE_NULL);
 	virtual ~CBillboardObject();
 
 private:
@@ -226,11 +240,15 @@ class CHeightMapTerrain : public CGameObject
 {
 public:
 	CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, LPCTSTR pFileName, int nWidth, int nLength, int nBlockWidth, int nBlockLength, XMFLOAT3 xmf3Scale, XMFLOAT4 xmf4Color);
+	//   ̹ ؽó(base, detail) Ѱܹ޴´. ( )
+	CHeightMapTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, CHeightMapImage *pHeightMapImage, int nBlockWidth, int nBlockLength, XMFLOAT4 xmf4Color, CTexture *pTerrainTexture);
 	virtual ~CHeightMapTerrain();
 
 private:
 	CHeightMapImage					*m_pHeightMapImage;
 
+	void BuildTerrain(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, int nBlockWidth, int nBlockLength, XMFLOAT4 xmf4Color, CTexture *pTerrainTexture);
+
 	int								m_nWidth;
 	int								m_nLength;
 
@@ -240,6 +258,7 @@ public:
 	float GetHeight(float x, float z, bool bReverseQuad = false) { return(m_pHeightMapImage->GetHeight(x, z, bReverseQuad) * m_xmf3Scale.y); } //World
 	XMFLOAT3 GetNormal(float x, float z) { return(m_pHeightMapImage->GetHeightMapNormal(int(x / m_xmf3Scale.x), int(z / m_xmf3Scale.z))); }
 
+	CHeightMapImage *GetHeightMapImage() { return(m_pHeightMapImage); }
 	int GetHeightMapWidth() { return(m_pHeightMapImage->GetHeightMapWidth()); }
 	int GetHeightMapLength() { return(m_pHeightMapImage->GetHeightMapLength()); }
 
@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+// File: OcclusionCulling.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "OcclusionCulling.h"
+
+static_assert(sizeof(RASTER_FLOAT3) == sizeof(XMFLOAT3), "RASTER_FLOAT3 must match XMFLOAT3");
+static_assert(sizeof(RASTER_FLOAT4) == sizeof(XMFLOAT4), "RASTER_FLOAT4 must match XMFLOAT4");
+
+void COcclusionCuller::AddOccluder(const XMFLOAT3 *pxmf3Positions, UINT nVertices, const UINT *pnIndices, UINT nIndices)
+{
+	CSoftwareRasterizer::AddOccluder((const RASTER_FLOAT3 *)pxmf3Positions, nVertices, pnIndices, nIndices);
+}
+
+void COcclusionCuller::AddHeightMapOccluder(const BYTE *pHeightMapPixels, int nWidth, int nLength, const XMFLOAT3& xmf3Scale, int nStep)
+{
+	CSoftwareRasterizer::AddHeightMapOccluder(pHeightMapPixels, nWidth, nLength, { xmf3Scale.x, xmf3Scale.y, xmf3Scale.z }, nStep);
+}
+
+void COcclusionCuller::Render(const XMFLOAT4X4& xmf4x4ViewProjection, const XMFLOAT4 *pxmf4FrustumPlanes)
+{
+	CSoftwareRasterizer::Render(&xmf4x4ViewProjection._11, (const RASTER_FLOAT4 *)pxmf4FrustumPlanes);
+}
+
+bool COcclusionCuller::IsVisible(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max)
+{
+	return(CSoftwareRasterizer::IsVisible({ xmf3Min.x, xmf3Min.y, xmf3Min.z }, { xmf3Max.x, xmf3Max.y, xmf3Max.z }));
+}
+
+bool COcclusionCuller::WriteDepthImage(LPCTSTR pszFileName)
+{
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wb"));
+	if (!pFile) return(false);
+
+	CSoftwareRasterizer::WriteDepthImage(pFile);
+	fclose(pFile);
+
+	return(true);
+}
+
+bool COcclusionCuller::RunReferenceTest(LPCTSTR pszReferenceFileName, LPCTSTR pszReportFileName)
+{
+	COcclusionCuller *pOcclusionCuller = new COcclusionCuller();
+	float pfViewProjection[16];
+	pOcclusionCuller->BuildRidgeScene(pfViewProjection);
+	pOcclusionCuller->CSoftwareRasterizer::Render(pfViewProjection, NULL);
+
+	FILE *pFile = NULL;
+	if (pszReportFileName) _tfopen_s(&pFile, pszReportFileName, _T("wt"));
+	TCHAR pstrReport[160];
+	auto Report = [&]()
+	{
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+	};
+
+	bool bPassed = true;
+	_stprintf_s(pstrReport, 160, _T("Occluder Triangles: %u  Rasterized: %u  Render: %.3f ms\n"), pOcclusionCuller->GetOccluderTriangles(), pOcclusionCuller->GetRasterizedTriangles(), pOcclusionCuller->GetRenderTime());
+	Report();
+
+	for (const RIDGE_TEST_CASE& xCase : CSoftwareRasterizer::m_pRidgeCases)
+	{
+		RASTER_FLOAT3 xmf3Min = { xCase.m_xmf3Center.x - xCase.m_fExtent, xCase.m_xmf3Center.y - xCase.m_fExtent, xCase.m_xmf3Center.z - xCase.m_fExtent };
+		RASTER_FLOAT3 xmf3Max = { xCase.m_xmf3Center.x + xCase.m_fExtent, xCase.m_xmf3Center.y + xCase.m_fExtent, xCase.m_xmf3Center.z + xCase.m_fExtent };
+		bool bVisible = pOcclusionCuller->CSoftwareRasterizer::IsVisible(xmf3Min, xmf3Max);
+		if (bVisible != xCase.m_bVisible) bPassed = false;
+		_stprintf_s(pstrReport, 160, _T("%-20hs %-8s (expected %s) %s\n"), xCase.m_pszName, bVisible ? _T("visible") : _T("hidden"), xCase.m_bVisible ? _T("visible") : _T("hidden"), (bVisible == xCase.m_bVisible) ? _T("OK") : _T("FAIL"));
+		Report();
+	}
+
+	//  ̹ 2 ܰ躸 ũ ٸ ȼ 0.1% Ѱų  ̹  ϸ ̴.
+	vector<BYTE> vnReference;
+	FILE *pReferenceFile = NULL;
+	if (pszReferenceFileName) _tfopen_s(&pReferenceFile, pszReferenceFileName, _T("rb"));
+	bool bRead = pReferenceFile && CSoftwareRasterizer::ReadDepthImage(pReferenceFile, vnReference);
+	if (pReferenceFile) fclose(pReferenceFile);
+	if (bRead)
+	{
+		UINT nMismatches = pOcclusionCuller->CountDepthImageMismatches(vnReference);
+		bool bMatched = (nMismatches <= UINT(vnReference.size() / 1000));
+		if (!bMatched) bPassed = false;
+		_stprintf_s(pstrReport, 160, _T("Reference Image: %u/%u pixels differ %s\n"), nMismatches, UINT(vnReference.size()), bMatched ? _T("OK") : _T("FAIL"));
+	}
+	else
+	{
+		bPassed = false;
+		_stprintf_s(pstrReport, 160, _T("Reference Image: cannot read %s FAIL\n"), pszReferenceFileName ? pszReferenceFileName : _T("(none)"));
+	}
+	Report();
+
+	_stprintf_s(pstrReport, 160, _T("Occlusion Reference Test: %s\n"), bPassed ? _T("PASSED") : _T("FAILED"));
+	Report();
+
+	if (pFile) fclose(pFile);
+	delete pOcclusionCuller;
+
+	return(bPassed);
+}
@@ -0,0 +1,31 @@
+//-----------------------------------------------------------------------------
+// File: OcclusionCulling.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "SoftwareRasterizer.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CPU Ʈ (occlusion) ø.
+// ȭ Hi-Z  CSoftwareRasterizer ϰ,  Ŭ   (XMFLOAT*, LPCTSTR) ޾ ѱ.
+class COcclusionCuller : public CSoftwareRasterizer
+{
+public:
+	COcclusionCuller() { }
+	~COcclusionCuller() { }
+
+	void AddOccluder(const XMFLOAT3 *pxmf3Positions, UINT nVertices, const UINT *pnIndices, UINT nIndices);
+	void AddHeightMapOccluder(const BYTE *pHeightMapPixels, int nWidth, int nLength, const XMFLOAT3& xmf3Scale, int nStep = OCCLUSION_TERRAIN_STEP);
+
+	void Render(const XMFLOAT4X4& xmf4x4ViewProjection, const XMFLOAT4 *pxmf4FrustumPlanes);
+	bool IsVisible(const XMFLOAT3& xmf3Min, const XMFLOAT3& xmf3Max);
+
+	//  ۸ 8Ʈ PGM ̹ .
+	bool WriteDepthImage(LPCTSTR pszFileName);
+
+	// BuildRidgeScene() ɼ   ۸    ̹(Tests/OcclusionReference.pgm) ϰ
+	// ( ̹  ), ɼ // ڵ鿡   ȮϿ  ϰ  ¿ .
+	// ( 񱳿  Tests/OcclusionRasterizerTest.cpp  ȴ)
+	static bool RunReferenceTest(LPCTSTR pszReferenceFileName, LPCTSTR pszReportFileName);
+};
@@ -5,6 +5,8 @@
 #include "stdafx.h"
 #include "Player.h"
 #include "Shader.h"
+#include "RenderStats.h"
+#include "FrameUploadBuffer.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // CPlayer
@@ -31,38 +33,46 @@ CPlayer::~CPlayer()
 {
 	ReleaseShaderVariables();
 
+	if (m_pModel) delete m_pModel;
 	if (m_pCamera) delete m_pCamera;
 }
 
+void CPlayer::SetModel(CMesh *pMesh, const XMFLOAT4X4& xmf4x4Local)
+{
+	if (!m_pModel)
+	{
+		m_pModel = new CGameObject(1);
+		m_pModel->SetParent(this);
+	}
+	m_pModel->SetMesh(0, pMesh);
+	m_pModel->SetLocalMatrix(xmf4x4Local);
+}
+
 void CPlayer::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
 {
+	// ÷̾  ۴ UpdateShaderVariables() Ӹ gFrameUploadBuffer ޴´.
 	if (m_pCamera) m_pCamera->CreateShaderVariables(pd3dDevice, pd3dCommandList);
-
-	UINT ncbElementBytes = ((sizeof(CB_PLAYER_INFO) + 255) & ~255); //256 
-	m_pd3dcbPlayer = ::CreateBufferResource(pd3dDevice, pd3dCommandList, NULL, ncbElementBytes, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, NULL);
-
-	m_pd3dcbPlayer->Map(0, NULL, (void **)&m_pcbMappedPlayer);
 }
 
 void CPlayer::ReleaseShaderVariables()
 {
 	if (m_pCamera) m_pCamera->ReleaseShaderVariables();
 
-	if (m_pd3dcbPlayer)
-	{
-		m_pd3dcbPlayer->Unmap(0, NULL);
-		m_pd3dcbPlayer->Release();
-	}
-
 	CGameObject::ReleaseShaderVariables();
 }
 
 void CPlayer::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	XMStoreFloat4x4(&m_pcbMappedPlayer->m_xmf4x4World, XMMatrixTranspose(XMLoadFloat4x4(&m_xmf4x4World)));
-
-	D3D12_GPU_VIRTUAL_ADDRESS d3dGpuVirtualAddress = m_pd3dcbPlayer->GetGPUVirtualAddress();
-	pd3dCommandList->SetGraphicsRootConstantBufferView(0, d3dGpuVirtualAddress);
+	//     (  ȯ * ÷̾  ȯ) ø. θ  ŵȴ.
+	TRANSFORM_HANDLE hTransform = (m_pModel) ? m_pModel->m_hTransform : m_hTransform;
+	::gTransformStorage.UpdateWorldMatrix(hTransform);
+	CB_PLAYER_INFO *pcbMappedPlayer = (CB_PLAYER_INFO *)::gFrameUploadBuffer.Allocate(sizeof(CB_PLAYER_INFO), &m_d3dcbGameObject);
+	if (!pcbMappedPlayer) return;
+	::memcpy(pcbMappedPlayer, ::gTransformStorage.GetShaderConstants(hTransform), sizeof(CB_PLAYER_INFO));
+	::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, sizeof(CB_PLAYER_INFO));
+
+	//  ۸ ü  (Ʈ Ķ 2)ε . (CGameObject::Render() Ѵ)
+	::gFilteredCommandList.SetGraphicsRootConstantBufferView(pd3dCommandList, 0, m_d3dcbGameObject);
 }
 
 void CPlayer::Move(DWORD dwDirection, float fDistance, bool bUpdateVelocity)
@@ -167,6 +177,7 @@ void CPlayer::Update(float fTimeElapsed)
 	fLength = sqrtf(m_xmf3Velocity.y * m_xmf3Velocity.y);
 	if (fLength > m_fMaxVelocityY) m_xmf3Velocity.y *= (fMaxVelocityY / fLength);
 
+	m_xmf3PreviousPosition = m_xmf3Position;
 	Move(m_xmf3Velocity, false);
 
 	if (m_pPlayerUpdatedContext) OnPlayerUpdateCallback(fTimeElapsed);
@@ -183,6 +194,56 @@ void CPlayer::Update(float fTimeElapsed)
 	m_xmf3Velocity = Vector3::Add(m_xmf3Velocity, Vector3::ScalarProduct(m_xmf3Velocity, -fDeceleration, true));
 }
 
+void CPlayer::GetState(PLAYER_STATE *pState)
+{
+	pState->m_xmf3Position = m_xmf3Position;
+	pState->m_xmf3Right = m_xmf3Right;
+	pState->m_xmf3Up = m_xmf3Up;
+	pState->m_xmf3Look = m_xmf3Look;
+
+	pState->m_xmf3CameraPosition = m_pCamera->GetPosition();
+	pState->m_xmf3CameraRight = m_pCamera->GetRightVector();
+	pState->m_xmf3CameraUp = m_pCamera->GetUpVector();
+	pState->m_xmf3CameraLook = m_pCamera->GetLookVector();
+}
+
+void CPlayer::SetState(const PLAYER_STATE& xState)
+{
+	m_xmf3Position = xState.m_xmf3Position;
+	m_xmf3Right = xState.m_xmf3Right;
+	m_xmf3Up = xState.m_xmf3Up;
+	m_xmf3Look = xState.m_xmf3Look;
+
+	m_pCamera->SetPosition(xState.m_xmf3CameraPosition);
+	m_pCamera->GetRightVector() = xState.m_xmf3CameraRight;
+	m_pCamera->GetUpVector() = xState.m_xmf3CameraUp;
+	m_pCamera->SetLookVector(xState.m_xmf3CameraLook);
+	m_pCamera->RegenerateViewMatrix();
+}
+
+inline XMFLOAT3 LerpVector(const XMFLOAT3& xmf3Vector0, const XMFLOAT3& xmf3Vector1, float t, bool bNormalize)
+{
+	XMVECTOR xmvVector = XMVectorLerp(XMLoadFloat3(&xmf3Vector0), XMLoadFloat3(&xmf3Vector1), t);
+	if (bNormalize) xmvVector = XMVector3Normalize(xmvVector);
+
+	XMFLOAT3 xmf3Result;
+	XMStoreFloat3(&xmf3Result, xmvVector);
+	return(xmf3Result);
+}
+
+void CPlayer::InterpolateState(const PLAYER_STATE& xState0, const PLAYER_STATE& xState1, float t, PLAYER_STATE *pState)
+{
+	pState->m_xmf3Position = LerpVector(xState0.m_xmf3Position, xState1.m_xmf3Position, t, false);
+	pState->m_xmf3Right = LerpVector(xState0.m_xmf3Right, xState1.m_xmf3Right, t, true);
+	pState->m_xmf3Up = LerpVector(xState0.m_xmf3Up, xState1.m_xmf3Up, t, true);
+	pState->m_xmf3Look = LerpVector(xState0.m_xmf3Look, xState1.m_xmf3Look, t, true);
+
+	pState->m_xmf3CameraPosition = LerpVector(xState0.m_xmf3CameraPosition, xState1.m_xmf3CameraPosition, t, false);
+	pState->m_xmf3CameraRight = LerpVector(xState0.m_xmf3CameraRight, xState1.m_xmf3CameraRight, t, true);
+	pState->m_xmf3CameraUp = LerpVector(xState0.m_xmf3CameraUp, xState1.m_xmf3CameraUp, t, true);
+	pState->m_xmf3CameraLook = LerpVector(xState0.m_xmf3CameraLook, xState1.m_xmf3CameraLook, t, true);
+}
+
 CCamera *CPlayer::OnChangeCamera(DWORD nNewCameraMode, DWORD nCurrentCameraMode)
 {
 	CCamera *pNewCamera = NULL;
@@ -229,16 +290,29 @@ CCamera *CPlayer::OnChangeCamera(DWORD nNewCameraMode, DWORD nCurrentCameraMode)
 
 void CPlayer::OnPrepareRender()
 {
-	m_xmf4x4World._11 = m_xmf3Right.x; m_xmf4x4World._12 = m_xmf3Right.y; m_xmf4x4World._13 = m_xmf3Right.z;
-	m_xmf4x4World._21 = m_xmf3Up.x; m_xmf4x4World._22 = m_xmf3Up.y; m_xmf4x4World._23 = m_xmf3Up.z;
-	m_xmf4x4World._31 = m_xmf3Look.x; m_xmf4x4World._32 = m_xmf3Look.y; m_xmf4x4World._33 = m_xmf3Look.z;
-	m_xmf4x4World._41 = m_xmf3Position.x; m_xmf4x4World._42 = m_xmf3Position.y; m_xmf4x4World._43 = m_xmf3Position.z;
+	::gTransformStorage.SetRotation(m_hTransform, m_xmf3Right, m_xmf3Up, m_xmf3Look);
+	::gTransformStorage.SetPosition(m_hTransform, m_xmf3Position);
 }
 
 void CPlayer::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
 	DWORD nCameraMode = (pCamera) ? pCamera->GetMode() : 0x00;
-	if (nCameraMode == THIRD_PERSON_CAMERA) CGameObject::Render(pd3dCommandList, pCamera);
+	if (nCameraMode == THIRD_PERSON_CAMERA)
+	{
+		CGameObject::Render(pd3dCommandList, pCamera);
+		if (m_pModel)
+		{
+			//   Ƿ    ¿  ۸ ״ .
+			RENDER_STATS_SHADER((m_pMaterial) ? m_pMaterial->m_pShader : NULL);
+			m_pModel->Render(pd3dCommandList, pCamera);
+		}
+	}
+}
+
+void CPlayer::ReleaseUploadBuffers()
+{
+	CGameObject::ReleaseUploadBuffers();
+	if (m_pModel) m_pModel->ReleaseUploadBuffers();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -250,17 +324,16 @@ CAirplanePlayer::CAirplanePlayer(ID3D12Device *pd3dDevice, ID3D12GraphicsCommand
 
 	CreateShaderVariables(pd3dDevice, pd3dCommandList);
 
+	//  ޽ y ̹Ƿ  x 90  δ.
 	CAirplaneMeshDiffused *pAirplaneMesh = new CAirplaneMeshDiffused(pd3dDevice, pd3dCommandList, 20.0f, 20.0f, 4.0f, XMFLOAT4(0.0f, 0.5f, 0.0f, 0.0f));
-	SetMesh(0, pAirplaneMesh);
-	UINT ncbElementBytes = ((sizeof(CB_PLAYER_INFO) + 255) & ~255); //256 
-
+	XMFLOAT4X4 xmf4x4Model;
+	XMStoreFloat4x4(&xmf4x4Model, XMMatrixRotationRollPitchYaw(XMConvertToRadians(90.0f), 0.0f, 0.0f));
+	SetModel(pAirplaneMesh, xmf4x4Model);
+	//  ۴ Ʈ ڷ ϹǷ ڴ  ʴ´. (       ĭ д)
 	CPlayerShader *pShader = new CPlayerShader();
 	pShader->CreateShader(pd3dDevice, pd3dGraphicsRootSignature, 1);
 	pShader->CreateShaderVariables(pd3dDevice, pd3dCommandList);
 	pShader->CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 1, 0);
-	pShader->CreateConstantBufferViews(pd3dDevice, pd3dCommandList, 1, m_pd3dcbPlayer, ncbElementBytes);
-
-	SetCbvGPUDescriptorHandle(pShader->GetGPUCbvDescriptorStartHandle());
 
 	SetShader(pShader);
 }
@@ -269,14 +342,6 @@ CAirplanePlayer::~CAirplanePlayer()
 {
 }
 
-void CAirplanePlayer::OnPrepareRender()
-{
-	CPlayer::OnPrepareRender();
-
-	XMMATRIX mtxRotate = XMMatrixRotationRollPitchYaw(XMConvertToRadians(90.0f), 0.0f, 0.0f);
-	m_xmf4x4World = Matrix4x4::Multiply(mtxRotate, m_xmf4x4World);
-}
-
 CCamera *CAirplanePlayer::ChangeCamera(DWORD nNewCameraMode, float fTimeElapsed)
 {
 	DWORD nCurrentCameraMode = (m_pCamera) ? m_pCamera->GetMode() : 0x00;
@@ -337,17 +402,13 @@ CTerrainPlayer::CTerrainPlayer(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandLi
 	CreateShaderVariables(pd3dDevice, pd3dCommandList);	
 
 	CCubeMeshDiffused *pCubeMesh = new CCubeMeshDiffused(pd3dDevice, pd3dCommandList, 4.0f, 12.0f, 4.0f);
-	SetMesh(0, pCubeMesh);
-
-	UINT ncbElementBytes = ((sizeof(CB_PLAYER_INFO) + 255) & ~255); //256 
+	SetModel(pCubeMesh, Matrix4x4::Identity());
 
+	//  ۴ Ʈ ڷ ϹǷ ڴ  ʴ´. (       ĭ д)
 	CPlayerShader *pShader = new CPlayerShader();
 	pShader->CreateShader(pd3dDevice, pd3dGraphicsRootSignature, 1);
 	pShader->CreateShaderVariables(pd3dDevice, pd3dCommandList);
 	pShader->CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 1, 0);
-	pShader->CreateConstantBufferViews(pd3dDevice, pd3dCommandList, 1, m_pd3dcbPlayer, ncbElementBytes);
-
-	SetCbvGPUDescriptorHandle(pShader->GetGPUCbvDescriptorStartHandle());
 
 	SetShader(pShader);
 
@@ -408,6 +469,18 @@ CCamera *CTerrainPlayer::ChangeCamera(DWORD nNewCameraMode, float fTimeElapsed)
 void CTerrainPlayer::OnPlayerUpdateCallback(float fTimeElapsed)
 {
 	CHeightMapTerrain *pTerrain = (CHeightMapTerrain *)m_pPlayerUpdatedContext;
+	if (m_pCollisionWorld)
+	{
+		//  ġ      հ Ƿ ̹ ̵  ü ˻Ѵ.
+		XMFLOAT3 xmf3Position, xmf3Normal;
+		if (m_pCollisionWorld->MoveCapsule(m_xmf3PreviousPosition, m_xmf3Position, m_xCollisionCapsule, &xmf3Position, &xmf3Normal))
+		{
+			SetPosition(xmf3Position);
+			//    ϴ ӵ ش.
+			float fInto = Vector3::DotProduct(m_xmf3Velocity, xmf3Normal);
+			if (fInto < 0.0f) m_xmf3Velocity = Vector3::Add(m_xmf3Velocity, xmf3Normal, -fInto);
+		}
+	}
 	XMFLOAT3 xmf3Scale = pTerrain->GetScale();
 	XMFLOAT3 xmf3PlayerPosition = GetPosition();
 	int z = (int)(xmf3PlayerPosition.z / xmf3Scale.z);
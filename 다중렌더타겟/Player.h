@@ -9,12 +9,27 @@
 
 #include "Object.h"
 #include "Camera.h"
+#include "Collision.h"
 
 struct CB_PLAYER_INFO
 {
 	XMFLOAT4X4					m_xmf4x4World;
 };
 
+//  ð  ùķ̼   ̸ Ͽ ׸  ÷̾ ī޶ 
+struct PLAYER_STATE
+{
+	XMFLOAT3					m_xmf3Position;
+	XMFLOAT3					m_xmf3Right;
+	XMFLOAT3					m_xmf3Up;
+	XMFLOAT3					m_xmf3Look;
+
+	XMFLOAT3					m_xmf3CameraPosition;
+	XMFLOAT3					m_xmf3CameraRight;
+	XMFLOAT3					m_xmf3CameraUp;
+	XMFLOAT3					m_xmf3CameraLook;
+};
+
 class CPlayer : public CGameObject
 {
 protected:
@@ -23,6 +38,8 @@ protected:
 	XMFLOAT3					m_xmf3Up = XMFLOAT3(0.0f, 1.0f, 0.0f);
 	XMFLOAT3					m_xmf3Look = XMFLOAT3(0.0f, 0.0f, 1.0f);
 
+	// Update() ӵŭ ̱  ġ (OnPlayerUpdateCallback() ̵ θ   ִ)
+	XMFLOAT3					m_xmf3PreviousPosition = XMFLOAT3(0.0f, 0.0f, 0.0f);
 	XMFLOAT3					m_xmf3Velocity = XMFLOAT3(0.0f, 0.0f, 0.0f);
 	XMFLOAT3     				m_xmf3Gravity = XMFLOAT3(0.0f, 0.0f, 0.0f);
 
@@ -39,6 +56,10 @@ protected:
 
 	CCamera						*m_pCamera = NULL;
 
+	// ÷̾ ڽ پ Բ ̴ . ޽ ̳ ġ    ȯ Ѵ.
+	// ׸  ÷̾ ̴  (  ) .
+	CGameObject					*m_pModel = NULL;
+
 public:
 	CPlayer(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, void *pContext=NULL, int nMeshes = 1);
 	virtual ~CPlayer();
@@ -60,6 +81,9 @@ public:
 	float GetPitch() const { return(m_fPitch); }
 	float GetRoll() const { return(m_fRoll); }
 
+	void SetModel(CMesh *pMesh, const XMFLOAT4X4& xmf4x4Local);
+	CGameObject *GetModel() { return(m_pModel); }
+
 	CCamera *GetCamera() { return(m_pCamera); }
 	void SetCamera(CCamera *pCamera) { m_pCamera = pCamera; }
 
@@ -70,6 +94,12 @@ public:
 
 	void Update(float fTimeElapsed);
 
+	void GetState(PLAYER_STATE *pState);
+	// ġ ⸸ ٲٰ ī޶ ȯ  ٽ . (ӵ ״)
+	void SetState(const PLAYER_STATE& xState);
+	// ġ  ,  ʹ    ȭѴ.
+	static void InterpolateState(const PLAYER_STATE& xState0, const PLAYER_STATE& xState1, float t, PLAYER_STATE *pState);
+
 	virtual void OnPlayerUpdateCallback(float fTimeElapsed) { }
 	void SetPlayerUpdatedContext(LPVOID pContext) { m_pPlayerUpdatedContext = pContext; }
 
@@ -85,10 +115,7 @@ public:
 	virtual CCamera *ChangeCamera(DWORD nNewCameraMode, float fTimeElapsed) { return(NULL); }
 	virtual void OnPrepareRender();
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera = NULL);
-
-protected:
-	ID3D12Resource					*m_pd3dcbPlayer = NULL;
-	CB_PLAYER_INFO					*m_pcbMappedPlayer = NULL;
+	virtual void ReleaseUploadBuffers();
 };
 
 class CAirplanePlayer : public CPlayer
@@ -98,7 +125,6 @@ public:
 	virtual ~CAirplanePlayer();
 
 	virtual CCamera *ChangeCamera(DWORD nNewCameraMode, float fTimeElapsed);
-	virtual void OnPrepareRender();
 };
 
 class CTerrainPlayer : public CPlayer
@@ -107,6 +133,14 @@ public:
 	CTerrainPlayer(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, ID3D12RootSignature *pd3dGraphicsRootSignature, void *pContext=NULL, int nMeshes = 1);
 	virtual ~CTerrainPlayer();
 
+private:
+	//  ̵ θ    ٱ⸦ հ  ʰ Ѵ. (ٴ ó  6.0 )
+	CCollisionWorld				*m_pCollisionWorld = NULL;
+	COLLISION_CAPSULE			m_xCollisionCapsule = { 3.0f, 3.0f };
+
+public:
+	void SetCollisionWorld(CCollisionWorld *pCollisionWorld) { m_pCollisionWorld = pCollisionWorld; }
+
 	virtual CCamera *ChangeCamera(DWORD nNewCameraMode, float fTimeElapsed);
 
 	virtual void OnPlayerUpdateCallback(float fTimeElapsed);
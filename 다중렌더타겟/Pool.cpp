@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// File: Pool.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Pool.h"
+#include "MemoryTracker.h"
+
+CObjectPool gObjectPool;
+CLevelArena gLevelArena;
+
+CObjectPool::CObjectPool()
+{
+	for (int i = 0; i < POOL_SIZE_CLASSES; i++)
+	{
+		m_ppFreeLists[i] = NULL;
+		m_ppCurrentBlocks[i] = NULL;
+		m_pnCurrentBlockUsed[i] = 0;
+	}
+}
+
+CObjectPool::~CObjectPool()
+{
+	//  ü Ҹ    ִ ü   ִ. ׶   ʴ´.
+	ReleaseBlocks();
+}
+
+BYTE *CObjectPool::AllocateBlock(int nSizeClass)
+{
+	BYTE *pBlock = (BYTE *)::gMemoryTracker.AllocateMemory(POOL_BLOCK_BYTES, MEMORY_TAG_OBJECT_POOL);
+	m_vBlocks.push_back(pBlock);
+	m_ppCurrentBlocks[nSizeClass] = pBlock;
+	m_pnCurrentBlockUsed[nSizeClass] = 0;
+	return(pBlock);
+}
+
+void *CObjectPool::Allocate(size_t nBytes)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_nAllocations++;
+	m_nLiveObjects++;
+	m_nLiveBytes += nBytes;
+
+#ifdef _WITH_POOLED_ALLOCATION
+	int nSizeClass = int((nBytes + POOL_SIZE_CLASS_BYTES - 1) / POOL_SIZE_CLASS_BYTES) - 1;
+	if ((nSizeClass < 0) || (nSizeClass >= POOL_SIZE_CLASSES)) return(::operator new(nBytes));
+
+	if (m_ppFreeLists[nSizeClass])
+	{
+		FREE_NODE *pNode = m_ppFreeLists[nSizeClass];
+		m_ppFreeLists[nSizeClass] = pNode->m_pNext;
+		return(pNode);
+	}
+
+	//       ʿ ߶ ش.
+	UINT nSlotBytes = (nSizeClass + 1) * POOL_SIZE_CLASS_BYTES;
+	if (!m_ppCurrentBlocks[nSizeClass] || (m_pnCurrentBlockUsed[nSizeClass] + nSlotBytes > POOL_BLOCK_BYTES)) AllocateBlock(nSizeClass);
+	void *pObject = m_ppCurrentBlocks[nSizeClass] + m_pnCurrentBlockUsed[nSizeClass];
+	m_pnCurrentBlockUsed[nSizeClass] += nSlotBytes;
+	return(pObject);
+#else
+	return(::operator new(nBytes));
+#endif
+}
+
+void CObjectPool::Free(void *pObject, size_t nBytes)
+{
+	if (!pObject) return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_nFrees++;
+	m_nLiveObjects--;
+	m_nLiveBytes -= nBytes;
+
+#ifdef _WITH_POOLED_ALLOCATION
+	int nSizeClass = int((nBytes + POOL_SIZE_CLASS_BYTES - 1) / POOL_SIZE_CLASS_BYTES) - 1;
+	if ((nSizeClass < 0) || (nSizeClass >= POOL_SIZE_CLASSES))
+	{
+		::operator delete(pObject);
+		return;
+	}
+
+	FREE_NODE *pNode = (FREE_NODE *)pObject;
+	pNode->m_pNext = m_ppFreeLists[nSizeClass];
+	m_ppFreeLists[nSizeClass] = pNode;
+#else
+	::operator delete(pObject);
+#endif
+}
+
+bool CObjectPool::ReleaseBlocks()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	if (m_nLiveObjects > 0) return(false);
+
+	for (size_t i = 0; i < m_vBlocks.size(); i++) ::gMemoryTracker.FreeMemory(m_vBlocks[i]);
+	m_vBlocks.clear();
+	for (int i = 0; i < POOL_SIZE_CLASSES; i++)
+	{
+		m_ppFreeLists[i] = NULL;
+		m_ppCurrentBlocks[i] = NULL;
+		m_pnCurrentBlockUsed[i] = 0;
+	}
+	return(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+CLevelArena::CLevelArena()
+{
+}
+
+CLevelArena::~CLevelArena()
+{
+	Reset();
+}
+
+void *CLevelArena::Allocate(size_t nBytes, size_t nAlignment)
+{
+	m_nAllocations++;
+	m_nAllocatedBytes += nBytes;
+
+	// Ϻ ū û      տ  ִ´.
+	if (nBytes + nAlignment > ARENA_BLOCK_BYTES)
+	{
+		BYTE *pLargeBlock = (BYTE *)::gMemoryTracker.AllocateMemory(nBytes + nAlignment, MEMORY_TAG_LEVEL_ARENA);
+		m_vBlocks.insert(m_vBlocks.end() - (m_vBlocks.empty() ? 0 : 1), pLargeBlock);
+		return((void *)((UINT_PTR(pLargeBlock) + nAlignment - 1) & ~UINT_PTR(nAlignment - 1)));
+	}
+
+	UINT_PTR nAddress = 0;
+	if (!m_vBlocks.empty())
+	{
+		UINT_PTR nBlock = UINT_PTR(m_vBlocks.back());
+		nAddress = (nBlock + m_nBlockUsed + nAlignment - 1) & ~UINT_PTR(nAlignment - 1);
+		if (nAddress + nBytes > nBlock + ARENA_BLOCK_BYTES) nAddress = 0;
+	}
+	if (!nAddress)
+	{
+		m_vBlocks.push_back((BYTE *)::gMemoryTracker.AllocateMemory(ARENA_BLOCK_BYTES, MEMORY_TAG_LEVEL_ARENA));
+		nAddress = (UINT_PTR(m_vBlocks.back()) + nAlignment - 1) & ~UINT_PTR(nAlignment - 1);
+	}
+	m_nBlockUsed = size_t(nAddress + nBytes - UINT_PTR(m_vBlocks.back()));
+
+	return((void *)nAddress);
+}
+
+void CLevelArena::Reset()
+{
+	for (size_t i = 0; i < m_vBlocks.size(); i++) ::gMemoryTracker.FreeMemory(m_vBlocks[i]);
+	m_vBlocks.clear();
+	m_nBlockUsed = ARENA_BLOCK_BYTES;
+	m_nAllocations = 0;
+	m_nAllocatedBytes = 0;
+}
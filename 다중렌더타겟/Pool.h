@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// File: Pool.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+//   Ǯ ġ ʰ  new/delete Ѵ. (Ҵ Ƚ Ȱ )
+#define _WITH_POOLED_ALLOCATION
+
+#define POOL_SIZE_CLASS_BYTES		16
+#define POOL_SIZE_CLASSES			64			//POOL_SIZE_CLASS_BYTES * POOL_SIZE_CLASSES(1024)Ʈ ū ü  new Ѵ.
+#define POOL_BLOCK_BYTES			(64 * 1024)
+
+#define ARENA_BLOCK_BYTES			(1024 * 1024)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ũ⺰(16Ʈ )    ü Ǯ.
+//  ũ ü( Ŭ)  Ͽ  ̰,   ü ȯ    ȴ.
+class CObjectPool
+{
+public:
+	CObjectPool();
+	~CObjectPool();
+
+private:
+	struct FREE_NODE
+	{
+		FREE_NODE					*m_pNext;
+	};
+
+	std::mutex						m_Mutex;
+
+	FREE_NODE						*m_ppFreeLists[POOL_SIZE_CLASSES];
+	BYTE							*m_ppCurrentBlocks[POOL_SIZE_CLASSES];
+	UINT							m_pnCurrentBlockUsed[POOL_SIZE_CLASSES];
+	vector<BYTE *>					m_vBlocks;
+
+	UINT							m_nAllocations = 0;		//new ȣ Ƚ (Ǯ  ̸ŭ  Ҵ Ѵ)
+	UINT							m_nFrees = 0;
+	UINT							m_nLiveObjects = 0;
+	size_t							m_nLiveBytes = 0;
+
+	BYTE *AllocateBlock(int nSizeClass);
+
+public:
+	void *Allocate(size_t nBytes);
+	void Free(void *pObject, size_t nBytes);
+
+	//  ִ ü    Ѵ.
+	bool ReleaseBlocks();
+
+	UINT GetAllocations() { return(m_nAllocations); }
+	UINT GetFrees() { return(m_nFrees); }
+	UINT GetLiveObjects() { return(m_nLiveObjects); }
+	size_t GetLiveBytes() { return(m_nLiveBytes); }
+	UINT GetBlocks() { return(UINT(m_vBlocks.size())); }
+	void ResetCounters() { m_nAllocations = 0; m_nFrees = 0; }
+};
+
+extern CObjectPool gObjectPool;
+
+// Ŭ  ȿ   Ŭ Ļ Ŭ new/delete gObjectPool Ѵ.
+//  Ҹڰ  delete  ü ũ⸦ Ƿ Ļ Ŭ ´ ũ Ŭ ư.
+#define DECLARE_POOLED_OBJECT() \
+	static void *operator new(size_t nBytes) { return(::gObjectPool.Allocate(nBytes)); } \
+	static void operator delete(void *pObject, size_t nBytes) { ::gObjectPool.Free(pObject, nBytes); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ()  ִ ȸ  迭   Ҵ.
+//    Reset()     ش. Ҹڰ ʿ  Ÿ(POD) Ҵؾ Ѵ.
+class CLevelArena
+{
+public:
+	CLevelArena();
+	~CLevelArena();
+
+private:
+	vector<BYTE *>					m_vBlocks;
+	size_t							m_nBlockUsed = ARENA_BLOCK_BYTES;
+
+	UINT							m_nAllocations = 0;
+	size_t							m_nAllocatedBytes = 0;
+
+public:
+	void *Allocate(size_t nBytes, size_t nAlignment = 16);
+	template <class T> T *AllocateArray(size_t nElements) { return((T *)Allocate(sizeof(T) * nElements, (alignof(T) > 16) ? alignof(T) : 16)); }
+
+	void Reset();
+
+	UINT GetAllocations() { return(m_nAllocations); }
+	size_t GetAllocatedBytes() { return(m_nAllocatedBytes); }
+	UINT GetBlocks() { return(UINT(m_vBlocks.size())); }
+};
+
+extern CLevelArena gLevelArena;
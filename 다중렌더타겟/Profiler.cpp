@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------------
+// File: Profiler.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+
+CProfiler gProfiler;
+
+static thread_local PROFILE_THREAD_BUFFER *tpProfileBuffer = NULL;
+static thread_local bool tbProfileBufferRefused = false;
+
+inline __int64 GetProfileTime()
+{
+	return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CProfiler::CProfiler()
+{
+	//  ü̹Ƿ  忡 .
+	m_idMainThread = std::this_thread::get_id();
+	for (int i = 0; i < PROFILER_MAX_THREADS; i++) m_ppBuffers[i] = NULL;
+	m_nBaseTime = GetProfileTime();
+}
+
+CProfiler::~CProfiler()
+{
+	for (int i = 0; i < PROFILER_MAX_THREADS; i++) if (m_ppBuffers[i]) delete m_ppBuffers[i];
+	if (m_pGpuBuffer) delete m_pGpuBuffer;
+}
+
+PROFILE_THREAD_BUFFER *CProfiler::GetThreadBuffer()
+{
+	if (tpProfileBuffer) return(tpProfileBuffer);
+	if (tbProfileBufferRefused) return(NULL);
+
+	// ۾ 尡 ƴ 嵵 ȣ 0 Ƿ  常 0 ۸  Ѵ.
+	int nThread = ::gJobSystem.GetThreadIndex();
+	if ((nThread >= PROFILER_MAX_THREADS) || ((nThread == 0) && (std::this_thread::get_id() != m_idMainThread)))
+	{
+		tbProfileBufferRefused = true;
+		TCHAR pstrDebug[96];
+		_stprintf_s(pstrDebug, 96, _T("Profiler: no buffer for a thread with index %d, its events are dropped\n"), nThread);
+		::OutputDebugString(pstrDebug);
+		return(NULL);
+	}
+
+	//  ȣ  ÿ ϳ̹Ƿ(  join ̴)  ʾƵ ȴ.
+	if (!m_ppBuffers[nThread])
+	{
+		m_ppBuffers[nThread] = new PROFILE_THREAD_BUFFER;
+		m_ppBuffers[nThread]->m_nThread = nThread;
+	}
+	tpProfileBuffer = m_ppBuffers[nThread];
+	return(tpProfileBuffer);
+}
+
+PROFILE_EVENT *CProfiler::BeginEvent(const char *pszName)
+{
+	PROFILE_THREAD_BUFFER *pBuffer = GetThreadBuffer();
+	if (!pBuffer) return(NULL);
+	if (pBuffer->m_nEvents >= PROFILER_MAX_EVENTS_PER_THREAD)
+	{
+		pBuffer->m_nDroppedEvents++;
+		return(NULL);
+	}
+
+	//    ڸ Ƿ ۿ   .
+	PROFILE_EVENT *pEvent = &pBuffer->m_pEvents[pBuffer->m_nEvents++];
+	pEvent->m_pszName = pszName;
+	pEvent->m_nEnd = 0;
+	pEvent->m_nBegin = GetProfileTime();
+	return(pEvent);
+}
+
+void CProfiler::EndEvent(PROFILE_EVENT *pEvent)
+{
+	pEvent->m_nEnd = GetProfileTime();
+}
+
+void CProfiler::AddGpuEvent(const char *pszName, __int64 nBegin, __int64 nEnd)
+{
+	if (!m_bEnabled) return;
+	if (!m_pGpuBuffer)
+	{
+		m_pGpuBuffer = new PROFILE_THREAD_BUFFER;
+		m_pGpuBuffer->m_nThread = PROFILER_GPU_THREAD;
+	}
+	if (m_pGpuBuffer->m_nEvents >= PROFILER_MAX_EVENTS_PER_THREAD)
+	{
+		m_pGpuBuffer->m_nDroppedEvents++;
+		return;
+	}
+	PROFILE_EVENT *pEvent = &m_pGpuBuffer->m_pEvents[m_pGpuBuffer->m_nEvents++];
+	pEvent->m_pszName = pszName;
+	pEvent->m_nBegin = nBegin;
+	pEvent->m_nEnd = nEnd;
+}
+
+void CProfiler::EnableUntilExit()
+{
+	m_bEnabled = true;
+	m_bWriteAtExit = true;
+}
+
+void CProfiler::StartCapture(int nFrames)
+{
+	if (m_bWriteAtExit || (m_nCaptureFrames > 0)) return;
+	// Ѵ  BeginFrame() Ѵ. (  ִ    Ƿ)
+	m_nCaptureFrames = -nFrames;
+}
+
+void CProfiler::BeginFrame()
+{
+	if (m_nCaptureFrames < 0)
+	{
+		Clear();
+		m_nCaptureFrames = -m_nCaptureFrames;
+		m_bEnabled = true;
+	}
+	else if ((m_nCaptureFrames > 0) && (--m_nCaptureFrames == 0))
+	{
+		m_bEnabled = false;
+		WriteTrace(PROFILER_TRACE_NAME);
+		Clear();
+	}
+}
+
+void CProfiler::WriteAtExit()
+{
+	if (!m_bWriteAtExit) return;
+	m_bEnabled = false;
+	WriteTrace(PROFILER_TRACE_NAME);
+	Clear();
+}
+
+void CProfiler::Clear()
+{
+	for (int i = 0; i < PROFILER_MAX_THREADS; i++)
+	{
+		if (!m_ppBuffers[i]) continue;
+		m_ppBuffers[i]->m_nEvents = 0;
+		m_ppBuffers[i]->m_nDroppedEvents = 0;
+	}
+	if (m_pGpuBuffer)
+	{
+		m_pGpuBuffer->m_nEvents = 0;
+		m_pGpuBuffer->m_nDroppedEvents = 0;
+	}
+}
+
+bool CProfiler::WriteTrace(LPCTSTR pszFileName)
+{
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (!pFile) return(false);
+
+	UINT nEvents = 0, nDroppedEvents = 0;
+	UINT nBuffers = PROFILER_MAX_THREADS;
+	fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool bFirst = true;
+	//  ڸ GPU Ʈ̴.
+	for (UINT i = 0; i <= nBuffers; i++)
+	{
+		PROFILE_THREAD_BUFFER *pBuffer = (i < nBuffers) ? m_ppBuffers[i] : m_pGpuBuffer;
+		if (!pBuffer) continue;
+
+		//  ̸ (Ÿ ̺Ʈ)
+		bool bGpu = (pBuffer->m_nThread == PROFILER_GPU_THREAD);
+		int nThread = (bGpu) ? 1000 : pBuffer->m_nThread;
+		if (bGpu)
+			fprintf(pFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"GPU\"}}", bFirst ? "" : ",\n", nThread);
+		else if (pBuffer->m_nThread == 0)
+			fprintf(pFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Main\"}}", bFirst ? "" : ",\n");
+		else
+			fprintf(pFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Worker %d\"}}", bFirst ? "" : ",\n", pBuffer->m_nThread, pBuffer->m_nThread);
+		bFirst = false;
+
+		for (UINT j = 0; j < pBuffer->m_nEvents; j++)
+		{
+			PROFILE_EVENT *pEvent = &pBuffer->m_pEvents[j];
+			if (pEvent->m_nEnd == 0) continue;
+			fprintf(pFile, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", pEvent->m_pszName, (bGpu) ? "gpu" : "cpu", nThread,
+				(pEvent->m_nBegin - m_nBaseTime) * 1.0e-3, (pEvent->m_nEnd - pEvent->m_nBegin) * 1.0e-3);
+			nEvents++;
+		}
+		nDroppedEvents += pBuffer->m_nDroppedEvents;
+	}
+	fprintf(pFile, "\n]}\n");
+	fclose(pFile);
+
+	TCHAR pstrDebug[MAX_PATH + 64];
+	_stprintf_s(pstrDebug, MAX_PATH + 64, _T("Profiler: %u events (%u dropped) written to %s\n"), nEvents, nDroppedEvents, pszFileName);
+	::OutputDebugString(pstrDebug);
+	return(true);
+}
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// File: Profiler.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define _WITH_PROFILER
+
+#define PROFILER_MAX_THREADS			65			//MAX_JOB_WORKERS +  
+#define PROFILER_MAX_EVENTS_PER_THREAD	(1 << 18)	//ġ 
+#define PROFILER_CAPTURE_FRAMES			120			//Ű   
+#define PROFILER_TRACE_NAME				_T("ProfileTrace.json")
+#define PROFILER_GPU_THREAD				-1			//GPU     ȣ ( Ͽ "GPU" Ʈ)
+
+struct PROFILE_EVENT
+{
+	const char						*m_pszName;				//ڿ  (__FUNCTION__ )
+	__int64							m_nBegin;				//
+	__int64							m_nEnd;					//0̸   ʾҴ
+};
+
+// CJobSystem  ȣ ϳ ó   .  ȣ 常 Ƿ  .
+// ۾ 带 ٽ (CJobSystem::Initialize())  ȣ ۸ ̾ .
+struct PROFILE_THREAD_BUFFER
+{
+	int								m_nThread;				//CJobSystem::GetThreadIndex()
+	UINT							m_nEvents = 0;
+	UINT							m_nDroppedEvents = 0;
+	PROFILE_EVENT					m_pEvents[PROFILER_MAX_EVENTS_PER_THREAD];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// (scope) ǥ÷ 庰 ̺Ʈ  Chrome (chrome://tracing, Perfetto) JSON .
+// Ѱ    (۾ 尡   )  忡 Ѵ.
+//    ǥ ϳ      Ǵ б ϳ̴.
+class CProfiler
+{
+public:
+	CProfiler();
+	~CProfiler();
+
+private:
+	bool							m_bEnabled = false;
+	bool							m_bWriteAtExit = false;
+	int								m_nCaptureFrames = 0;	// ĸ   (0̸ ĸ  ƴ)
+	__int64							m_nBaseTime = 0;
+
+	std::thread::id					m_idMainThread;			//ȣ 0   ִ 
+	PROFILE_THREAD_BUFFER			*m_ppBuffers[PROFILER_MAX_THREADS];
+	PROFILE_THREAD_BUFFER			*m_pGpuBuffer = NULL;		//CGpuTimer  忡 ä
+
+	PROFILE_THREAD_BUFFER *GetThreadBuffer();
+
+public:
+	bool IsEnabled() { return(m_bEnabled); }
+
+	// α׷ ۺ ϰ  (WriteAtExit()) . (ε ܰ踦  ̰ )
+	void EnableUntilExit();
+	//  Ӻ nFrames  ϰ PROFILER_TRACE_NAME .
+	void StartCapture(int nFrames = PROFILER_CAPTURE_FRAMES);
+	//  (     ) θ.
+	void BeginFrame();
+	void WriteAtExit();
+
+	PROFILE_EVENT *BeginEvent(const char *pszName);
+	void EndEvent(PROFILE_EVENT *pEvent);
+	// GPU  CPU   ð(steady_clock ) ٲپ ִ´.  忡 θ.
+	void AddGpuEvent(const char *pszName, __int64 nBegin, __int64 nEnd);
+
+	bool WriteTrace(LPCTSTR pszFileName);
+	void Clear();
+};
+
+extern CProfiler gProfiler;
+
+class CProfileScope
+{
+public:
+	CProfileScope(const char *pszName) { if (::gProfiler.IsEnabled()) m_pEvent = ::gProfiler.BeginEvent(pszName); }
+	~CProfileScope() { if (m_pEvent) ::gProfiler.EndEvent(m_pEvent); }
+
+private:
+	PROFILE_EVENT					*m_pEvent = NULL;
+};
+
+#define PROFILE_CONCATENATE_(a, b)	a##b
+#define PROFILE_CONCATENATE(a, b)	PROFILE_CONCATENATE_(a, b)
+
+#ifdef _WITH_PROFILER
+#define PROFILE_SCOPE(name)			CProfileScope PROFILE_CONCATENATE(xProfileScope, __LINE__)(name)
+#define PROFILE_FUNCTION()			PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,135 @@
+//-----------------------------------------------------------------------------
+// File: RenderQueue.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "RenderQueue.h"
+#include "Object.h"
+#include "Shader.h"
+#include "RenderStats.h"
+
+CRenderQueue::CRenderQueue()
+{
+	m_vPackets.reserve(1024);
+}
+
+CRenderQueue::~CRenderQueue()
+{
+}
+
+UINT CRenderQueue::GetSortId(unordered_map<const void *, UINT>& mapIds, const void *pKey, UINT nBits)
+{
+	if (!pKey) return(0);
+
+	auto it = mapIds.find(pKey);
+	if (it != mapIds.end()) return(it->second);
+
+	// 0 NULL. Ʈ   ȣ ġ      .
+	UINT nId = (UINT(mapIds.size()) % ((1 << nBits) - 1)) + 1;
+	mapIds[pKey] = nId;
+	return(nId);
+}
+
+void CRenderQueue::Submit(UINT nPass, CShader *pShader, CTexture *pTexture, CMesh *pMesh, D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject, float fDepth)
+{
+	ID3D12PipelineState *pd3dPipelineState = (pShader) ? pShader->GetPipelineState() : NULL;
+	ID3D12DescriptorHeap *pd3dDescriptorHeap = (pShader) ? pShader->GetDescriptorHeap() : NULL;
+
+	RENDER_PACKET d3dPacket;
+	d3dPacket.m_pShader = pShader;
+	d3dPacket.m_pd3dPipelineState = pd3dPipelineState;
+	d3dPacket.m_pd3dDescriptorHeap = pd3dDescriptorHeap;
+	d3dPacket.m_pTexture = pTexture;
+	d3dPacket.m_pMesh = pMesh;
+	d3dPacket.m_d3dcbGameObject = d3dcbGameObject;
+
+	//  float Ʈ  ũ  Ƿ  16Ʈ ߶  Ű . (տ ڷ)
+	if (fDepth < 0.0f) fDepth = 0.0f;
+	UINT nDepthBits = *(UINT *)&fDepth;
+	UINT64 nDepthKey = (nDepthBits >> 15) & 0xFFFF;
+
+	d3dPacket.m_nSortKey = (UINT64(nPass & 0x0F) << SORTKEY_PASS_SHIFT);
+	d3dPacket.m_nSortKey |= (UINT64(GetSortId(m_mapPipelineStateIds, pd3dPipelineState, 10)) << SORTKEY_PIPELINE_SHIFT);
+	d3dPacket.m_nSortKey |= (UINT64(GetSortId(m_mapDescriptorHeapIds, pd3dDescriptorHeap, 10)) << SORTKEY_HEAP_SHIFT);
+	d3dPacket.m_nSortKey |= (UINT64(GetSortId(m_mapMaterialIds, pTexture, 12)) << SORTKEY_MATERIAL_SHIFT);
+	d3dPacket.m_nSortKey |= (UINT64(GetSortId(m_mapMeshIds, pMesh, 12)) << SORTKEY_MESH_SHIFT);
+	d3dPacket.m_nSortKey |= nDepthKey;
+
+	m_vPackets.push_back(d3dPacket);
+}
+
+void CRenderQueue::Execute(ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	std::stable_sort(m_vPackets.begin(), m_vPackets.end(), [](const RENDER_PACKET& a, const RENDER_PACKET& b) { return(a.m_nSortKey < b.m_nSortKey); });
+
+	ID3D12PipelineState *pd3dPipelineState = NULL;
+	ID3D12DescriptorHeap *pd3dDescriptorHeap = NULL;
+	CTexture *pTexture = NULL;
+	CMesh *pMesh = NULL;
+	D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject = 0;
+
+	// Ŷ  ̴ 迡 ϰ  ٱ  ̴ ǵ.
+	UINT nPreviousStatsShader = ::gRenderStats.GetCurrentShader();
+	CShader *pStatsShader = NULL;
+	::gRenderStats.SetShader(NULL);
+
+	for (size_t i = 0; i < m_vPackets.size(); i++)
+	{
+		RENDER_PACKET& d3dPacket = m_vPackets[i];
+
+		if (d3dPacket.m_pShader != pStatsShader)
+		{
+			pStatsShader = d3dPacket.m_pShader;
+			::gRenderStats.SetShader(pStatsShader);
+		}
+
+		if (d3dPacket.m_pd3dPipelineState && (d3dPacket.m_pd3dPipelineState != pd3dPipelineState))
+		{
+			pd3dPipelineState = d3dPacket.m_pd3dPipelineState;
+			::gFilteredCommandList.SetPipelineState(pd3dCommandList, pd3dPipelineState);
+			m_nPipelineStateChanges++;
+		}
+		if (d3dPacket.m_pd3dDescriptorHeap && (d3dPacket.m_pd3dDescriptorHeap != pd3dDescriptorHeap))
+		{
+			pd3dDescriptorHeap = d3dPacket.m_pd3dDescriptorHeap;
+			::gFilteredCommandList.SetDescriptorHeaps(pd3dCommandList, 1, &pd3dDescriptorHeap);
+			m_nDescriptorHeapChanges++;
+
+			//   ٲ   Ű ̺ ٽ ؾ Ѵ.
+			pTexture = NULL;
+		}
+		if (d3dPacket.m_pTexture && (d3dPacket.m_pTexture != pTexture))
+		{
+			pTexture = d3dPacket.m_pTexture;
+			pTexture->UpdateShaderVariables(pd3dCommandList);
+			m_nMaterialChanges++;
+		}
+
+		// Ʈ      谡 Ƿ  ٲ ٽ  ʴ´.
+		if (d3dPacket.m_d3dcbGameObject && (d3dPacket.m_d3dcbGameObject != d3dcbGameObject))
+		{
+			d3dcbGameObject = d3dPacket.m_d3dcbGameObject;
+			::gFilteredCommandList.SetGraphicsRootConstantBufferView(pd3dCommandList, 2, d3dcbGameObject);
+		}
+
+		if (d3dPacket.m_pMesh != pMesh)
+		{
+			pMesh = d3dPacket.m_pMesh;
+			pMesh->OnPrepareRender(pd3dCommandList);
+			m_nMeshChanges++;
+		}
+		pMesh->Draw(pd3dCommandList);
+	}
+	::gRenderStats.RestoreShader(nPreviousStatsShader);
+
+	m_nSubmittedPackets += UINT(m_vPackets.size());
+}
+
+void CRenderQueue::ResetCounters()
+{
+	m_nSubmittedPackets = 0;
+	m_nPipelineStateChanges = 0;
+	m_nDescriptorHeapChanges = 0;
+	m_nMaterialChanges = 0;
+	m_nMeshChanges = 0;
+}
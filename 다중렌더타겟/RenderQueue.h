@@ -0,0 +1,73 @@
+//-----------------------------------------------------------------------------
+// File: RenderQueue.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+class CMesh;
+class CTexture;
+class CShader;
+
+#define RENDER_PASS_OPAQUE			0
+#define RENDER_PASS_ALPHA_TESTED	1
+
+// 64Ʈ  Ű ( Ʈ  񱳵ȴ)
+// | pass(4) | pipeline state(10) | descriptor heap(10) | material(12) | mesh(12) | depth(16) |
+#define SORTKEY_PASS_SHIFT			60
+#define SORTKEY_PIPELINE_SHIFT		50
+#define SORTKEY_HEAP_SHIFT			40
+#define SORTKEY_MATERIAL_SHIFT		28
+#define SORTKEY_MESH_SHIFT			16
+
+struct RENDER_PACKET
+{
+	UINT64							m_nSortKey = 0;
+
+	CShader							*m_pShader = NULL;				//(CRenderStats)  ̴
+	ID3D12PipelineState				*m_pd3dPipelineState = NULL;
+	ID3D12DescriptorHeap			*m_pd3dDescriptorHeap = NULL;
+	CTexture						*m_pTexture = NULL;
+	CMesh							*m_pMesh = NULL;
+	D3D12_GPU_VIRTUAL_ADDRESS		m_d3dcbGameObject = 0;			//Ʈ Ķ 2   (̹  gFrameUploadBuffer ּ)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ü    ׸ Ŷ ϸ  Ű  
+// ٷ  Ŷ ٸ ¸ Ŀǵ Ʈ ϰ ׸.
+class CRenderQueue
+{
+public:
+	CRenderQueue();
+	~CRenderQueue();
+
+private:
+	vector<RENDER_PACKET>			m_vPackets;
+
+	//  ->  Ű   ȣ ( ٲ )
+	unordered_map<const void *, UINT>	m_mapPipelineStateIds;
+	unordered_map<const void *, UINT>	m_mapDescriptorHeapIds;
+	unordered_map<const void *, UINT>	m_mapMaterialIds;
+	unordered_map<const void *, UINT>	m_mapMeshIds;
+
+	UINT							m_nSubmittedPackets = 0;
+	UINT							m_nPipelineStateChanges = 0;
+	UINT							m_nDescriptorHeapChanges = 0;
+	UINT							m_nMaterialChanges = 0;
+	UINT							m_nMeshChanges = 0;
+
+	UINT GetSortId(unordered_map<const void *, UINT>& mapIds, const void *pKey, UINT nBits);
+
+public:
+	void Clear() { m_vPackets.clear(); }
+	//  ¿   pShader  . (NULL̸ ٲ ʴ´)
+	// d3dcbGameObject   ̹ ø  ̴. (0̸ ٲ ʴ´)
+	void Submit(UINT nPass, CShader *pShader, CTexture *pTexture, CMesh *pMesh, D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject, float fDepth);
+	void Execute(ID3D12GraphicsCommandList *pd3dCommandList);
+
+	UINT GetSubmittedPackets() { return(m_nSubmittedPackets); }
+	UINT GetPipelineStateChanges() { return(m_nPipelineStateChanges); }
+	UINT GetDescriptorHeapChanges() { return(m_nDescriptorHeapChanges); }
+	UINT GetMaterialChanges() { return(m_nMaterialChanges); }
+	UINT GetMeshChanges() { return(m_nMeshChanges); }
+	void ResetCounters();
+};
@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// File: RenderStats.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "RenderStats.h"
+#include "Shader.h"
+#include <typeinfo>
+
+CRenderStats gRenderStats;
+
+CRenderStats::CRenderStats()
+{
+	for (int i = 0; i < RENDER_STATS_MAX_SHADERS; i++) m_ppszShaderNames[i] = NULL;
+	::memset(m_pCurrentStats, 0, sizeof(m_pCurrentStats));
+	::memset(m_pFrameStats, 0, sizeof(m_pFrameStats));
+	::memset(&m_xFrameTotal, 0, sizeof(m_xFrameTotal));
+}
+
+CRenderStats::~CRenderStats()
+{
+}
+
+UINT CRenderStats::GetShaderSlot(CShader *pShader)
+{
+	if (!pShader) return(0);
+
+	// Ŭ ϳ Ƿ  Ŭ ü  ڸ Ѵ. Ŭ    ǹǷ ʷ ã´.
+	const char *pszName = typeid(*pShader).name();
+	for (UINT i = 1; i < m_nShaders; i++)
+	{
+		if (m_ppszShaderNames[i] == pszName) return(i);
+	}
+	if (m_nShaders >= RENDER_STATS_MAX_SHADERS) return(0);
+	m_ppszShaderNames[m_nShaders] = pszName;
+	return(m_nShaders++);
+}
+
+UINT CRenderStats::SetShader(CShader *pShader)
+{
+	UINT nPreviousShader = m_nCurrentShader;
+	m_nCurrentShader = GetShaderSlot(pShader);
+	return(nPreviousShader);
+}
+
+void CRenderStats::AddDraw(UINT nInstances, UINT nTriangles, UINT nPoints)
+{
+	RENDER_STATS *pStats = &m_pCurrentStats[m_nCurrentShader];
+	pStats->m_pnCounters[RENDER_STAT_DRAW_CALLS]++;
+	pStats->m_pnCounters[RENDER_STAT_INSTANCES] += nInstances;
+	pStats->m_pnCounters[RENDER_STAT_TRIANGLES] += nTriangles;
+	pStats->m_pnCounters[RENDER_STAT_POINTS] += nPoints;
+}
+
+void CRenderStats::BeginFrame()
+{
+	::memset(&m_xFrameTotal, 0, sizeof(m_xFrameTotal));
+	for (UINT i = 0; i < m_nShaders; i++)
+	{
+		m_pFrameStats[i] = m_pCurrentStats[i];
+		for (int j = 0; j < RENDER_STAT_TYPES; j++) m_xFrameTotal.m_pnCounters[j] += m_pCurrentStats[i].m_pnCounters[j];
+	}
+	::memset(m_pCurrentStats, 0, sizeof(m_pCurrentStats));
+	m_nCurrentShader = 0;
+	m_nFrame++;
+}
+
+const char *CRenderStats::GetShaderName(UINT nShader)
+{
+	if ((nShader == 0) || (nShader >= m_nShaders)) return("(Frame)");
+	// MSVC type_info::name() "class CTerrainShader" ̴.
+	const char *pszName = m_ppszShaderNames[nShader];
+	return((::strncmp(pszName, "class ", 6) == 0) ? pszName + 6 : pszName);
+}
+
+LPCTSTR CRenderStats::GetStatName(int nType)
+{
+	static const TCHAR *ppszStats[RENDER_STAT_TYPES] = { _T("Draws"), _T("Instances"), _T("Triangles"), _T("Points"), _T("PSO"), _T("Heaps"), _T("RootArgs"), _T("Barriers"), _T("UploadBytes"), _T("CmdLists") };
+	return(((nType >= 0) && (nType < RENDER_STAT_TYPES)) ? ppszStats[nType] : _T("Unknown"));
+}
+
+void CRenderStats::Dump(FILE *pFile)
+{
+	TCHAR pstrLine[512];
+	int nLength = _stprintf_s(pstrLine, 512, _T("Render stats (frame %llu)    "), m_nFrame);
+	for (int j = 0; j < RENDER_STAT_TYPES; j++) nLength += _stprintf_s(pstrLine + nLength, 512 - nLength, _T(" %11s"), GetStatName(j));
+	_stprintf_s(pstrLine + nLength, 512 - nLength, _T("\n"));
+	if (pFile) _fputts(pstrLine, pFile); else ::OutputDebugString(pstrLine);
+
+	// ̴  پ   հ踦 .
+	for (UINT i = 0; i <= m_nShaders; i++)
+	{
+		RENDER_STATS *pStats = (i < m_nShaders) ? &m_pFrameStats[i] : &m_xFrameTotal;
+		nLength = _stprintf_s(pstrLine, 512, _T("%-28hs"), (i < m_nShaders) ? GetShaderName(i) : "Total");
+		for (int j = 0; j < RENDER_STAT_TYPES; j++) nLength += _stprintf_s(pstrLine + nLength, 512 - nLength, _T(" %11llu"), pStats->m_pnCounters[j]);
+		_stprintf_s(pstrLine + nLength, 512 - nLength, _T("\n"));
+		if (pFile) _fputts(pstrLine, pFile); else ::OutputDebugString(pstrLine);
+	}
+}
+
+bool CRenderStats::WriteReport(LPCTSTR pszFileName)
+{
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (!pFile) return(false);
+	Dump(pFile);
+	fclose(pFile);
+
+	TCHAR pstrDebug[MAX_PATH + 64];
+	_stprintf_s(pstrDebug, MAX_PATH + 64, _T("RenderStats: report written to %s\n"), pszFileName);
+	::OutputDebugString(pstrDebug);
+	return(true);
+}
@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// File: RenderStats.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Profiler.h"
+
+class CShader;
+
+#define RENDER_STAT_DRAW_CALLS			0
+#define RENDER_STAT_INSTANCES			1
+#define RENDER_STAT_TRIANGLES			2
+#define RENDER_STAT_POINTS				3
+#define RENDER_STAT_PIPELINE_STATES		4			// (ɷ )   
+#define RENDER_STAT_DESCRIPTOR_HEAPS	5
+#define RENDER_STAT_ROOT_ARGUMENTS		6			// ̺ Ʈ    
+#define RENDER_STAT_BARRIERS			7
+#define RENDER_STAT_UPLOAD_BYTES		8			//CPU ε   Ʈ
+#define RENDER_STAT_COMMAND_LISTS		9			// Ŀǵ Ʈ
+#define RENDER_STAT_TYPES				10
+
+#define RENDER_STATS_MAX_SHADERS		16			//0 ̴ ۿ   (ġ 0 Ѵ)
+#define RENDER_STATS_REPORT_NAME		_T("RenderStats.txt")
+
+struct RENDER_STATS
+{
+	UINT64							m_pnCounters[RENDER_STAT_TYPES];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ӹ Ŀǵ Ʈ    ̴ Ŭ(CShader  Ŭ) .
+// ο   CFilteredCommandList, 踮 SynchronizeResourceTransition()  ˷ ش.
+//  ̴  RENDER_STATS_SHADER()   Ѵ.   忡 ϹǷ  ʴ´.
+class CRenderStats
+{
+public:
+	CRenderStats();
+	~CRenderStats();
+
+private:
+	const char						*m_ppszShaderNames[RENDER_STATS_MAX_SHADERS];	//type_info::name()
+	UINT							m_nShaders = 1;
+	UINT							m_nCurrentShader = 0;
+
+	RENDER_STATS					m_pCurrentStats[RENDER_STATS_MAX_SHADERS];
+	RENDER_STATS					m_pFrameStats[RENDER_STATS_MAX_SHADERS];		// 
+	RENDER_STATS					m_xFrameTotal;
+	UINT64							m_nFrame = 0;
+
+	UINT GetShaderSlot(CShader *pShader);
+
+public:
+	//  ۿ θ. ݱ      ű 0 .
+	void BeginFrame();
+
+	//   pShader(NULL̸ ̴ ) ϰ  ȣ ش.
+	UINT SetShader(CShader *pShader);
+	void RestoreShader(UINT nShader) { m_nCurrentShader = nShader; }
+	UINT GetCurrentShader() { return(m_nCurrentShader); }
+
+	void Add(int nType, UINT64 nCount = 1) { m_pCurrentStats[m_nCurrentShader].m_pnCounters[nType] += nCount; }
+	void AddDraw(UINT nInstances, UINT nTriangles, UINT nPoints);
+
+	//   
+	UINT GetShaders() { return(m_nShaders); }
+	const char *GetShaderName(UINT nShader);
+	UINT64 GetFrameStat(int nType) { return(m_xFrameTotal.m_pnCounters[nType]); }
+	UINT64 GetFrameStat(int nType, UINT nShader) { return(m_pFrameStats[nShader].m_pnCounters[nType]); }
+	UINT64 GetFrame() { return(m_nFrame); }
+	static LPCTSTR GetStatName(int nType);
+
+	void Dump(FILE *pFile = NULL);
+	bool WriteReport(LPCTSTR pszFileName);
+};
+
+extern CRenderStats gRenderStats;
+
+// pShader NULL̸ ٱ  ̴ ״ .
+class CRenderStatsScope
+{
+public:
+	CRenderStatsScope(CShader *pShader) { m_nPreviousShader = (pShader) ? ::gRenderStats.SetShader(pShader) : ::gRenderStats.GetCurrentShader(); }
+	~CRenderStatsScope() { ::gRenderStats.RestoreShader(m_nPreviousShader); }
+
+private:
+	UINT							m_nPreviousShader;
+};
+
+#define RENDER_STATS_SHADER(pShader)	CRenderStatsScope PROFILE_CONCATENATE(xRenderStatsScope, __LINE__)(pShader)
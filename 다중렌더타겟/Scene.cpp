@@ -4,6 +4,13 @@
 
 #include "stdafx.h"
 #include "Scene.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
+
+#define _WITH_PARALLEL_ANIMATION
+#define _WITH_BVH_CULLING
+#define _WITH_OCCLUSION_CULLING
 
 CScene::CScene()
 {
@@ -15,33 +22,151 @@ CScene::~CScene()
 
 //#define _WITH_TERRAIN_PARTITION
 
-void CScene::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
+void CScene::BuildProceduralScene(CSceneFileWriter *pSceneFileWriter)
 {
-	m_pd3dGraphicsRootSignature = CreateGraphicsRootSignature(pd3dDevice);
-
 	XMFLOAT3 xmf3Scale(8.0f, 2.0f, 8.0f);
 	XMFLOAT4 xmf4Color(0.0f, 0.5f, 0.0f, 0.0f);
 #ifdef _WITH_TERRAIN_PARTITION
-	m_pTerrain = new CHeightMapTerrain(pd3dDevice, pd3dCommandList, m_pd3dGraphicsRootSignature, _T("Image/ImageHeightMap.raw"), 257, 257, 17, 17, xmf3Scale, xmf4Color);
-//	m_pTerrain = new CHeightMapTerrain(pd3dDevice, pd3dCommandList, m_pd3dGraphicsRootSignature, _T("../Assets/Image/Terrain/HeightMap.raw"), 257, 257, 17, 17, xmf3Scale, xmf4Color);
+	CHeightMapImage *pHeightMapImage = new CHeightMapImage(_T("Image/ImageHeightMap.raw"), 257, 257, xmf3Scale);
+	int nBlockWidth = 17, nBlockLength = 17;
 #else
-	m_pTerrain = new CHeightMapTerrain(pd3dDevice, pd3dCommandList, m_pd3dGraphicsRootSignature, _T("Image/HeightMap.raw"), 257, 257, 257, 257, xmf3Scale, xmf4Color);
-//	m_pTerrain = new CHeightMapTerrain(pd3dDevice, pd3dCommandList, m_pd3dGraphicsRootSignature, _T("../Assets/Image/Terrain/HeightMap.raw"), 257, 257, 257, 257, xmf3Scale, xmf4Color);
+	CHeightMapImage *pHeightMapImage = new CHeightMapImage(_T("Image/HeightMap.raw"), 257, 257, xmf3Scale);
+	int nBlockWidth = 257, nBlockLength = 257;
 #endif
 
-	m_nShaders = 2;
+	LPCWSTR ppstrTerrainTextures[2] = { L"Image/Base_Texture.dds", L"Image/Detail_Texture_7.dds" };
+	LPCWSTR ppstrTreeTextures[5] = { L"Image/tree1.dds", L"Image/tree2.dds", L"Image/tree3.dds", L"Image/tree4.dds", L"Image/tree5.dds" };
+	LPCWSTR ppstrTreeArrayTextures[1] = { L"Image/treearray.dds" };
+
+	UINT nTerrainMaterial = pSceneFileWriter->AddMaterial(RESOURCE_TEXTURE2D, ppstrTerrainTextures, 2);
+	pSceneFileWriter->SetTerrain(pHeightMapImage->GetHeightMapPixels(), pHeightMapImage->GetHeightMapWidth(), pHeightMapImage->GetHeightMapLength(), nBlockWidth, nBlockLength, xmf3Scale, xmf4Color, nTerrainMaterial);
+
+	vector<SCENE_INSTANCE> vInstances;
+	CBillboardTreeShader::GenerateInstances(pHeightMapImage, vInstances);
+	pSceneFileWriter->AddShader(SCENE_SHADER_BILLBOARD_TREES, pSceneFileWriter->AddMaterial(RESOURCE_TEXTURE2D_ARRAY, ppstrTreeTextures, 5), vInstances.data(), UINT(vInstances.size()));
+
+	CGeometryBillboardTreeShader::GenerateInstances(pHeightMapImage, vInstances);
+	pSceneFileWriter->AddShader(SCENE_SHADER_GEOMETRY_TREES, pSceneFileWriter->AddMaterial(RESOURCE_TEXTURE2DARRAY, ppstrTreeArrayTextures, 1), vInstances.data(), UINT(vInstances.size()));
+
+	delete pHeightMapImage;
+}
+
+bool CScene::WriteProceduralSceneFile(LPCTSTR pszFileName)
+{
+	CSceneFileWriter xSceneFileWriter;
+	BuildProceduralScene(&xSceneFileWriter);
+	bool bResult = xSceneFileWriter.Write(pszFileName);
+
+	//   д  Ʒ Ҵ  ش.
+	::gLevelArena.Reset();
+	return(bResult);
+}
+
+bool CScene::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
+{
+	PROFILE_SCOPE("CScene::LoadSceneFile");
+	TCHAR pstrDebug[128];
+	CSceneFile xSceneFile;
+	if (xSceneFile.Open(SCENE_FILE_NAME))
+	{
+		_stprintf_s(pstrDebug, 128, _T("Scene: %s %u bytes mapped in %.3f ms\n"), SCENE_FILE_NAME, xSceneFile.GetSize(), xSceneFile.GetOpenTime());
+	}
+	else
+	{
+		//   (Ǵ  ٸ) ó  .
+		auto tStart = std::chrono::high_resolution_clock::now();
+		CSceneFileWriter xSceneFileWriter;
+		BuildProceduralScene(&xSceneFileWriter);
+		const vector<BYTE>& vSceneData = xSceneFileWriter.Finish();
+		if (!xSceneFile.Open(vSceneData.data(), UINT(vSceneData.size())))
+		{
+			::OutputDebugString(_T("Scene: procedural scene data failed validation\n"));
+			return(false);
+		}
+		double fTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+		_stprintf_s(pstrDebug, 128, _T("Scene: procedural %u bytes built in %.3f ms\n"), xSceneFile.GetSize(), fTime);
+	}
+	::OutputDebugString(pstrDebug);
+
+	BuildObjects(pd3dDevice, pd3dCommandList, &xSceneFile);
+
+	return(true);
+}
+
+void CScene::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, CSceneFile *pSceneFile)
+{
+	PROFILE_FUNCTION();
+	m_pd3dGraphicsRootSignature = CreateGraphicsRootSignature(pd3dDevice);
+
+	m_pRenderQueue = new CRenderQueue();
+
+	const SCENE_TERRAIN *pSceneTerrain = pSceneFile->GetTerrain();
+	CHeightMapImage *pHeightMapImage = NULL;
+	{
+		MEMORY_TAG_SCOPE(MEMORY_TAG_TERRAIN);
+		pHeightMapImage = new CHeightMapImage(pSceneFile->GetHeightMapPixels(), pSceneTerrain->m_nWidth, pSceneTerrain->m_nLength, pSceneTerrain->m_xmf3Scale);
+		CTexture *pTerrainTexture = pSceneFile->CreateTexture(pd3dDevice, pd3dCommandList, pSceneTerrain->m_nMaterial);
+		m_pTerrain = new CHeightMapTerrain(pd3dDevice, pd3dCommandList, m_pd3dGraphicsRootSignature, pHeightMapImage, pSceneTerrain->m_nBlockWidth, pSceneTerrain->m_nBlockLength, pSceneTerrain->m_xmf4Color, pTerrainTexture);
+	}
+
+	m_nShaders = int(pSceneFile->GetShaders());
 	m_ppShaders = new CShader*[m_nShaders];
 
-	CBillboardTreeShader *pbillBoardTreeShader = new CBillboardTreeShader();
-	pbillBoardTreeShader->CreateShader(pd3dDevice, m_pd3dGraphicsRootSignature, 1);
-	pbillBoardTreeShader->BuildObjects(pd3dDevice, pd3dCommandList, m_pTerrain);
+	for (int i = 0; i < m_nShaders; i++)
+	{
+		SCENE_SHADER_CONTEXT xSceneContext = { pSceneFile, pSceneFile->GetShader(i) };
+		switch (xSceneContext.m_pShader->m_nType)
+		{
+			case SCENE_SHADER_BILLBOARD_TREES:
+			{
+				PROFILE_SCOPE("CScene::BuildObjects(BillboardTrees)");
+				MEMORY_TAG_SCOPE(MEMORY_TAG_VEGETATION);
+				CBillboardTreeShader *pbillBoardTreeShader = new CBillboardTreeShader();
+				pbillBoardTreeShader->CreateShader(pd3dDevice, m_pd3dGraphicsRootSignature, 1);
+				pbillBoardTreeShader->BuildObjects(pd3dDevice, pd3dCommandList, &xSceneContext);
+				m_ppShaders[i] = pbillBoardTreeShader;
+				break;
+			}
+			case SCENE_SHADER_GEOMETRY_TREES:
+			{
+				PROFILE_SCOPE("CScene::BuildObjects(GeometryTrees)");
+				MEMORY_TAG_SCOPE(MEMORY_TAG_VEGETATION);
+				CGeometryBillboardTreeShader *pbillBoardTreeArrayShader = new CGeometryBillboardTreeShader();
+				pbillBoardTreeArrayShader->CreateShader(pd3dDevice, m_pd3dGraphicsRootSignature);
+				pbillBoardTreeArrayShader->BuildObjects(pd3dDevice, pd3dCommandList, &xSceneContext);
+				m_ppShaders[i] = pbillBoardTreeArrayShader;
+				break;
+			}
+		}
+	}
 
-	CGeometryBillboardTreeShader *pbillBoardTreeArrayShader = new CGeometryBillboardTreeShader();
-	pbillBoardTreeArrayShader->CreateShader(pd3dDevice, m_pd3dGraphicsRootSignature);
-	pbillBoardTreeArrayShader->BuildObjects(pd3dDevice, pd3dCommandList, m_pTerrain);
+	BuildBoundingVolumeHierarchy();
 
-	m_ppShaders[0] = pbillBoardTreeShader;
-	m_ppShaders[1] = pbillBoardTreeArrayShader;
+	//   ģ ڷ ٿ  ޽ .
+	{
+		PROFILE_SCOPE("CScene::BuildObjects(Occluders)");
+		m_pOcclusionCuller = new COcclusionCuller();
+		m_pOcclusionCuller->AddHeightMapOccluder(pHeightMapImage->GetHeightMapPixels(), pHeightMapImage->GetHeightMapWidth(), pHeightMapImage->GetHeightMapLength(), m_pTerrain->GetScale());
+	}
+
+	//   ߽ Ʒ  ̸ŭ ٱ  .
+	{
+		PROFILE_SCOPE("CScene::BuildObjects(Collision)");
+		m_pCollisionWorld = new CCollisionWorld();
+		m_pCollisionWorld->SetTerrain(pHeightMapImage);
+		for (UINT i = 0; i < pSceneFile->GetShaders(); i++)
+		{
+			const SCENE_SHADER *pSceneShader = pSceneFile->GetShader(i);
+			const SCENE_INSTANCE *pInstances = pSceneFile->GetInstances(pSceneShader);
+			for (UINT j = 0; j < pSceneShader->m_nInstances; j++)
+			{
+				const SCENE_INSTANCE& xInstance = pInstances[j];
+				XMFLOAT3 xmf3Base(xInstance.m_xmf3Position.x, xInstance.m_xmf3Position.y - (xInstance.m_xmf2Size.y * 0.5f), xInstance.m_xmf3Position.z);
+				m_pCollisionWorld->AddCylinder(xmf3Base, xInstance.m_xmf2Size.x * SCENE_TRUNK_RADIUS_RATIO, xInstance.m_xmf2Size.y);
+			}
+		}
+		m_pCollisionWorld->Build();
+	}
 
 	CreateShaderVariables(pd3dDevice, pd3dCommandList);
 }
@@ -64,6 +189,18 @@ void CScene::ReleaseObjects()
 	ReleaseShaderVariables();
 
 	if (m_pTerrain) delete m_pTerrain;
+
+	if (m_pRenderQueue) delete m_pRenderQueue;
+
+	if (m_pBoundingVolumeHierarchy) delete m_pBoundingVolumeHierarchy;
+	m_umEntityProxies.clear();
+
+	if (m_pOcclusionCuller) delete m_pOcclusionCuller;
+
+	if (m_pCollisionWorld) delete m_pCollisionWorld;
+
+	//    迭( , Ƽ )   Ѵ.
+	::gLevelArena.Reset();
 }
 
 void CScene::ReleaseUploadBuffers()
@@ -76,50 +213,44 @@ ID3D12RootSignature *CScene::CreateGraphicsRootSignature(ID3D12Device *pd3dDevic
 {
 	ID3D12RootSignature *pd3dGraphicsRootSignature = NULL;
 
-	D3D12_DESCRIPTOR_RANGE pd3dDescriptorRanges[7];
+	D3D12_DESCRIPTOR_RANGE pd3dDescriptorRanges[6];
 
-	pd3dDescriptorRanges[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+	pd3dDescriptorRanges[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 	pd3dDescriptorRanges[0].NumDescriptors = 1;
-	pd3dDescriptorRanges[0].BaseShaderRegister = 2; //GameObject
+	pd3dDescriptorRanges[0].BaseShaderRegister = 0; //t0: gtxtTexture
 	pd3dDescriptorRanges[0].RegisterSpace = 0;
 	pd3dDescriptorRanges[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
 	pd3dDescriptorRanges[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 	pd3dDescriptorRanges[1].NumDescriptors = 1;
-	pd3dDescriptorRanges[1].BaseShaderRegister = 0; //t0: gtxtTexture
+	pd3dDescriptorRanges[1].BaseShaderRegister = 1; //t1: gtxtTerrainBaseTexture
 	pd3dDescriptorRanges[1].RegisterSpace = 0;
 	pd3dDescriptorRanges[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
 	pd3dDescriptorRanges[2].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 	pd3dDescriptorRanges[2].NumDescriptors = 1;
-	pd3dDescriptorRanges[2].BaseShaderRegister = 1; //t1: gtxtTerrainBaseTexture
+	pd3dDescriptorRanges[2].BaseShaderRegister = 2; //t2: gtxtTerrainDetailTexture
 	pd3dDescriptorRanges[2].RegisterSpace = 0;
 	pd3dDescriptorRanges[2].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
 	pd3dDescriptorRanges[3].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-	pd3dDescriptorRanges[3].NumDescriptors = 1;
-	pd3dDescriptorRanges[3].BaseShaderRegister = 2; //t2: gtxtTerrainDetailTexture
+	pd3dDescriptorRanges[3].NumDescriptors = 5;
+	pd3dDescriptorRanges[3].BaseShaderRegister = 3; //t3 ~ t7: tree
 	pd3dDescriptorRanges[3].RegisterSpace = 0;
 	pd3dDescriptorRanges[3].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
 	pd3dDescriptorRanges[4].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-	pd3dDescriptorRanges[4].NumDescriptors = 5;
-	pd3dDescriptorRanges[4].BaseShaderRegister = 3; //t3 ~ t7: tree
+	pd3dDescriptorRanges[4].NumDescriptors = 1;
+	pd3dDescriptorRanges[4].BaseShaderRegister = 8; //t8: treeArray
 	pd3dDescriptorRanges[4].RegisterSpace = 0;
 	pd3dDescriptorRanges[4].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
 	pd3dDescriptorRanges[5].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 	pd3dDescriptorRanges[5].NumDescriptors = 1;
-	pd3dDescriptorRanges[5].BaseShaderRegister = 8; //t8: treeArray
+	pd3dDescriptorRanges[5].BaseShaderRegister = 9; //t9: postprocessing
 	pd3dDescriptorRanges[5].RegisterSpace = 0;
 	pd3dDescriptorRanges[5].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-	pd3dDescriptorRanges[6].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-	pd3dDescriptorRanges[6].NumDescriptors = 1;
-	pd3dDescriptorRanges[6].BaseShaderRegister = 9; //t9: postprocessing
-	pd3dDescriptorRanges[6].RegisterSpace = 0;
-	pd3dDescriptorRanges[6].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
-
 	D3D12_ROOT_PARAMETER pd3dRootParameters[9];
 
 	pd3dRootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -132,39 +263,40 @@ ID3D12RootSignature *CScene::CreateGraphicsRootSignature(ID3D12Device *pd3dDevic
 	pd3dRootParameters[1].Descriptor.RegisterSpace = 0;
 	pd3dRootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 
-	pd3dRootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-	pd3dRootParameters[2].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[2].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[0];
+	// ü  ۴ Ӹ gFrameUploadBuffer ٸ ġ Ƿ   ּҷ Ѵ.
+	pd3dRootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	pd3dRootParameters[2].Descriptor.ShaderRegister = 2; //GameObject
+	pd3dRootParameters[2].Descriptor.RegisterSpace = 0;
 	pd3dRootParameters[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 
 	pd3dRootParameters[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[3].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[3].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[1];
+	pd3dRootParameters[3].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[0];
 	pd3dRootParameters[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	pd3dRootParameters[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[4].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[4].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[2];
+	pd3dRootParameters[4].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[1];
 	pd3dRootParameters[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	pd3dRootParameters[5].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[5].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[5].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[3];
+	pd3dRootParameters[5].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[2];
 	pd3dRootParameters[5].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	pd3dRootParameters[6].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[6].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[6].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[4];
+	pd3dRootParameters[6].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[3];
 	pd3dRootParameters[6].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	pd3dRootParameters[7].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[7].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[7].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[5];
+	pd3dRootParameters[7].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[4];
 	pd3dRootParameters[7].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	pd3dRootParameters[8].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 	pd3dRootParameters[8].DescriptorTable.NumDescriptorRanges = 1;
-	pd3dRootParameters[8].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[6];
+	pd3dRootParameters[8].DescriptorTable.pDescriptorRanges = &pd3dDescriptorRanges[5];
 	pd3dRootParameters[8].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 	D3D12_STATIC_SAMPLER_DESC d3dSamplerDesc;
@@ -215,6 +347,24 @@ void CScene::ReleaseShaderVariables()
 
 bool CScene::OnProcessingMouseMessage(HWND hWnd, UINT nMessageID, WPARAM wParam, LPARAM lParam)
 {
+	switch (nMessageID)
+	{
+	case WM_RBUTTONDOWN:
+		if (m_pPlayer && m_pPlayer->GetCamera())
+		{
+			float fDistance = 0.0f;
+			ENTITY nEntity = PickEntityPointedByCursor(LOWORD(lParam), HIWORD(lParam), m_pPlayer->GetCamera(), &fDistance);
+			if (nEntity != ENTITY_NULL)
+			{
+				TCHAR pstrDebug[64];
+				_stprintf_s(pstrDebug, 64, _T("Picked entity 0x%08X (%.1f)\n"), nEntity, fDistance);
+				::OutputDebugString(pstrDebug);
+			}
+		}
+		break;
+	default:
+		break;
+	}
 	return(false);
 }
 
@@ -230,26 +380,281 @@ bool CScene::ProcessInput(UCHAR *pKeysBuffer)
 
 void CScene::AnimateObjects(float fTimeElapsed)
 {
+	PROFILE_FUNCTION();
+#ifdef _WITH_PARALLEL_ANIMATION
+	AnimateStage(fTimeElapsed, true);
+#else
+	AnimateStage(fTimeElapsed, false);
+#endif
+
+	UpdateBoundingVolumeHierarchy();
+}
+
+void CScene::AnimateStage(float fTimeElapsed, bool bParallel)
+{
+	AnimateShaders(fTimeElapsed, bParallel);
+
+	// ý۰    ο ķ óȴ.
+	::RotationSystem(&::gEntityManager, fTimeElapsed);
+	::RevolutionSystem(&::gEntityManager, fTimeElapsed);
+	if (m_pPlayer && m_pPlayer->GetCamera()) ::BillboardSystem(&::gEntityManager, m_pPlayer->GetCamera()->GetPosition());
+
+	::gTransformStorage.UpdateWorldMatrices();
+}
+
+void CScene::UpdateCameraFacingObjects()
+{
+	PROFILE_FUNCTION();
+	if (m_pPlayer && m_pPlayer->GetCamera()) ::BillboardSystem(&::gEntityManager, m_pPlayer->GetCamera()->GetPosition());
+	::gTransformStorage.UpdateWorldMatrices();
+}
+
+void CScene::AnimateShaders(float fTimeElapsed, bool bParallel)
+{
+	CCamera *pCamera = (m_pPlayer) ? m_pPlayer->GetCamera() : NULL;
+	for (int i = 0; i < m_nShaders; i++) m_ppShaders[i]->PrepareAnimation(pCamera);
+
+	if (bParallel)
+	{
+		// ü  ϴ ̴  óѴ.
+		m_vAnimationChunks.clear();
+		for (int i = 0; i < m_nShaders; i++)
+		{
+			if (!m_ppShaders[i]->HasIndependentObjects())
+			{
+				m_ppShaders[i]->AnimateObjects(fTimeElapsed);
+				continue;
+			}
+			UINT nObjects = m_ppShaders[i]->GetAnimatedObjects();
+			for (UINT nBegin = 0; nBegin < nObjects; nBegin += ANIMATION_GRAIN) m_vAnimationChunks.push_back({ m_ppShaders[i], nBegin, min(nBegin + ANIMATION_GRAIN, nObjects) });
+		}
+
+		//  ü  ̴  Ѳ  ķ óѴ.
+		ANIMATION_CHUNK *pChunks = m_vAnimationChunks.data();
+		::gJobSystem.ParallelFor(UINT(m_vAnimationChunks.size()), 1, [pChunks, fTimeElapsed](UINT nBegin, UINT nEnd)
+		{
+			for (UINT i = nBegin; i < nEnd; i++) pChunks[i].m_pShader->AnimateObjects(fTimeElapsed, pChunks[i].m_nBegin, pChunks[i].m_nEnd);
+		});
+	}
+	else
+	{
+		for (int i = 0; i < m_nShaders; i++)
+		{
+			m_ppShaders[i]->AnimateObjects(fTimeElapsed);
+		}
+	}
+}
+
+bool CScene::RunAnimationScalingTest(LPCTSTR pszFileName)
+{
+	const float fTimeElapsed = 1.0f / 60.0f;
+	const int nRepeats = 16;
+
+	UINT nAnimatedObjects = 0;
 	for (int i = 0; i < m_nShaders; i++)
 	{
-		m_ppShaders[i]->AnimateObjects(fTimeElapsed);
+		if (m_ppShaders[i]->HasIndependentObjects()) nAnimatedObjects += m_ppShaders[i]->GetAnimatedObjects();
+	}
+
+	//    ӿ ϵ  ȯ  ΰ Ź ǵ.
+	vector<XMFLOAT4X4> vLocals;
+	::gTransformStorage.SaveLocalMatrices(vLocals);
+
+	// 带 ٽ  ʰ óϴ   δ. ( ȣ  ۰ ״ ȿϴ)
+	int nMaxThreads = max(1, ::gJobSystem.GetThreads());
+
+	FILE *pFile = NULL;
+	if (pszFileName) _tfopen_s(&pFile, pszFileName, _T("wt"));
+
+	TCHAR pstrReport[128];
+	_stprintf_s(pstrReport, 128, _T("Animated Objects: %u  Transforms: %u\n"), nAnimatedObjects, ::gTransformStorage.GetLiveTransforms());
+	::OutputDebugString(pstrReport);
+	if (pFile) _fputts(pstrReport, pFile);
+
+	// : ۾    
+	::gJobSystem.SetActiveThreads(1);
+	double fSerialTime = 0.0;
+	for (int k = 0; k < nRepeats; k++)
+	{
+		::gTransformStorage.RestoreLocalMatrices(vLocals);
+		auto tStart = std::chrono::high_resolution_clock::now();
+		AnimateStage(fTimeElapsed, false);
+		auto tEnd = std::chrono::high_resolution_clock::now();
+		fSerialTime += std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+	}
+	fSerialTime /= nRepeats;
+
+	UINT nSlots = ::gTransformStorage.GetSlots();
+	vector<XMFLOAT4X4> vReferenceWorlds(::gTransformStorage.GetWorldMatrices(), ::gTransformStorage.GetWorldMatrices() + nSlots);
+
+	_stprintf_s(pstrReport, 128, _T("Serial:       Time: %8.3f ms\n"), fSerialTime);
+	::OutputDebugString(pstrReport);
+	if (pFile) _fputts(pstrReport, pFile);
+
+	bool bAllMatched = true;
+	for (int nThreads = 1; nThreads <= nMaxThreads; nThreads++)
+	{
+		::gJobSystem.SetActiveThreads(nThreads);
+
+		double fTime = 0.0;
+		bool bMatched = true;
+		for (int k = 0; k < nRepeats; k++)
+		{
+			::gTransformStorage.RestoreLocalMatrices(vLocals);
+			auto tStart = std::chrono::high_resolution_clock::now();
+			AnimateStage(fTimeElapsed, true);
+			auto tEnd = std::chrono::high_resolution_clock::now();
+			fTime += std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+
+			//  ü ڱ Ը Ƿ Ұ ϰ Ʈ  ƾ Ѵ.
+			if (nSlots && memcmp(vReferenceWorlds.data(), ::gTransformStorage.GetWorldMatrices(), nSlots * sizeof(XMFLOAT4X4))) bMatched = false;
+		}
+		fTime /= nRepeats;
+		if (!bMatched) bAllMatched = false;
+
+		_stprintf_s(pstrReport, 128, _T("Threads: %2d  Time: %8.3f ms  Speedup: %5.2fx  Match: %s\n"), nThreads, fTime, fSerialTime / fTime, bMatched ? _T("yes") : _T("NO"));
+		::OutputDebugString(pstrReport);
+		if (pFile) _fputts(pstrReport, pFile);
+	}
+
+	if (pFile) fclose(pFile);
+
+	// ׽Ʈ   ǵ.
+	::gJobSystem.SetActiveThreads(::gJobSystem.GetThreads());
+	::gTransformStorage.RestoreLocalMatrices(vLocals);
+	::gTransformStorage.UpdateWorldMatrices();
+
+	assert(bAllMatched);
+	return(bAllMatched);
+}
+
+// ó   ȸϴ Ƽ ڸ ٽ  ʵ ȸ (  δ) ڸ .
+static void GetEntityBounds(CMesh *pMesh, TRANSFORM_HANDLE hTransform, XMFLOAT3& xmf3Min, XMFLOAT3& xmf3Max)
+{
+	BoundingBox& xmBoundingBox = pMesh->GetBoundingBox();
+	float fRadius = Vector3::Length(xmBoundingBox.Center) + Vector3::Length(xmBoundingBox.Extents);
+	XMFLOAT4X4 xmf4x4World = ::gTransformStorage.GetWorldMatrix(hTransform);
+	xmf3Min = XMFLOAT3(xmf4x4World._41 - fRadius, xmf4x4World._42 - fRadius, xmf4x4World._43 - fRadius);
+	xmf3Max = XMFLOAT3(xmf4x4World._41 + fRadius, xmf4x4World._42 + fRadius, xmf4x4World._43 + fRadius);
+}
+
+void CScene::BuildBoundingVolumeHierarchy()
+{
+	PROFILE_FUNCTION();
+	if (!m_pBoundingVolumeHierarchy) m_pBoundingVolumeHierarchy = new CBoundingVolumeHierarchy();
+	m_pBoundingVolumeHierarchy->Clear();
+	m_umEntityProxies.clear();
+
+	XMFLOAT3 xmf3Min, xmf3Max;
+	for (int i = 0; i < ::gEntityManager.GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = ::gEntityManager.GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_RENDERABLE)) continue;
+		for (UINT j = 0; j < pArchetype->GetRows(); j++)
+		{
+			if (!pArchetype->m_vMeshes[j].m_pMesh) continue;
+			GetEntityBounds(pArchetype->m_vMeshes[j].m_pMesh, pArchetype->m_vTransforms[j], xmf3Min, xmf3Max);
+			m_umEntityProxies[pArchetype->m_vEntities[j]] = m_pBoundingVolumeHierarchy->Insert(xmf3Min, xmf3Max, pArchetype->m_vEntities[j]);
+		}
+	}
+	m_pBoundingVolumeHierarchy->Build();
+}
+
+void CScene::UpdateBoundingVolumeHierarchy()
+{
+	if (!m_pBoundingVolumeHierarchy) return;
+
+	// ġ ٲ  ϴ Ƽ̴. (  ȸ Ѵ)
+	XMFLOAT3 xmf3Min, xmf3Max;
+	for (int i = 0; i < ::gEntityManager.GetArchetypes(); i++)
+	{
+		CArchetype *pArchetype = ::gEntityManager.GetArchetype(i);
+		if (!pArchetype->Has(COMPONENT_RENDERABLE | COMPONENT_REVOLUTION)) continue;
+		for (UINT j = 0; j < pArchetype->GetRows(); j++)
+		{
+			auto itProxy = m_umEntityProxies.find(pArchetype->m_vEntities[j]);
+			if ((itProxy == m_umEntityProxies.end()) || !pArchetype->m_vMeshes[j].m_pMesh) continue;
+			GetEntityBounds(pArchetype->m_vMeshes[j].m_pMesh, pArchetype->m_vTransforms[j], xmf3Min, xmf3Max);
+			m_pBoundingVolumeHierarchy->UpdateProxy(itProxy->second, xmf3Min, xmf3Max);
+		}
 	}
+
+	if (m_pBoundingVolumeHierarchy->IsRefitNeeded()) m_pBoundingVolumeHierarchy->Refit();
+}
+
+ENTITY CScene::PickEntity(const XMFLOAT3& xmf3Origin, const XMFLOAT3& xmf3Direction, float fMaxDistance, float *pfDistance)
+{
+	UINT nEntity = ENTITY_NULL;
+	if (!m_pBoundingVolumeHierarchy || !m_pBoundingVolumeHierarchy->Raycast(xmf3Origin, xmf3Direction, fMaxDistance, &nEntity, pfDistance)) return(ENTITY_NULL);
+	return(nEntity);
+}
+
+ENTITY CScene::PickEntityPointedByCursor(int xClient, int yClient, CCamera *pCamera, float *pfDistance)
+{
+	// ȭ ǥ ī޶ ǥ  ٲ   ǥ ȯѴ.
+	XMFLOAT4X4 xmf4x4Projection = pCamera->GetProjectionMatrix();
+	D3D12_VIEWPORT d3dViewport = pCamera->GetViewport();
+
+	XMFLOAT3 xmf3PickDirection;
+	xmf3PickDirection.x = (((2.0f * (xClient - d3dViewport.TopLeftX)) / d3dViewport.Width) - 1.0f) / xmf4x4Projection._11;
+	xmf3PickDirection.y = -(((2.0f * (yClient - d3dViewport.TopLeftY)) / d3dViewport.Height) - 1.0f) / xmf4x4Projection._22;
+	xmf3PickDirection.z = 1.0f;
+
+	XMMATRIX xmmtxInverseView = XMLoadFloat4x4(&pCamera->GetInverseViewMatrix());
+	XMFLOAT3 xmf3Direction = Vector3::TransformNormal(xmf3PickDirection, xmmtxInverseView);
+	xmf3Direction = Vector3::Normalize(xmf3Direction);
+
+	return(PickEntity(pCamera->GetPosition(), xmf3Direction, FLT_MAX, pfDistance));
 }
 
 void CScene::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
-	pd3dCommandList->SetGraphicsRootSignature(m_pd3dGraphicsRootSignature);
+	PROFILE_FUNCTION();
+	::gFilteredCommandList.SetGraphicsRootSignature(pd3dCommandList, m_pd3dGraphicsRootSignature);
 
 	pCamera->SetViewportsAndScissorRects(pd3dCommandList);
 	pCamera->UpdateShaderVariables(pd3dCommandList);
 
 	UpdateShaderVariables(pd3dCommandList);
 
-	if (m_pTerrain) m_pTerrain->Render(pd3dCommandList, pCamera);
+	//     Ű  ׷  ¿    δ.
+	m_pRenderQueue->Clear();
+	if (m_pTerrain) m_pTerrain->SubmitRenderPackets(m_pRenderQueue, NULL, pCamera, RENDER_PASS_OPAQUE);
+	for (int i = 0; i < m_nShaders; i++)
+	{
+		if (m_ppShaders[i]->UsesRenderQueue()) m_ppShaders[i]->SubmitRenderPackets(m_pRenderQueue, pCamera);
+	}
+	const XMFLOAT4X4& xmf4x4ViewProjection = pCamera->GetViewProjectionMatrix();
+	const XMFLOAT4 *pxmf4FrustumPlanes = pCamera->GetFrustum().m_pxmf4Planes;
+#ifdef _WITH_OCCLUSION_CULLING
+	// ü  ģ   CPU  ۿ ׸.
+	m_pOcclusionCuller->ResetCounters();
+	m_pOcclusionCuller->Render(xmf4x4ViewProjection, pxmf4FrustumPlanes);
+	for (int i = 0; i < m_nShaders; i++) m_ppShaders[i]->OcclusionCull(m_pOcclusionCuller);
+#endif
+#ifdef _WITH_BVH_CULLING
+	m_vVisibleEntities.clear();
+	m_pBoundingVolumeHierarchy->Cull(pxmf4FrustumPlanes, m_vVisibleEntities);
+#ifdef _WITH_OCCLUSION_CULLING
+	// ü ø  Ƽ     .
+	UINT nVisibleEntities = 0;
+	XMFLOAT3 xmf3Min, xmf3Max;
+	for (ENTITY nEntity : m_vVisibleEntities)
+	{
+		GetEntityBounds(::gEntityManager.GetMesh(nEntity)->m_pMesh, ::gEntityManager.GetTransform(nEntity), xmf3Min, xmf3Max);
+		if (m_pOcclusionCuller->IsVisible(xmf3Min, xmf3Max)) m_vVisibleEntities[nVisibleEntities++] = nEntity;
+	}
+	m_vVisibleEntities.resize(nVisibleEntities);
+#endif
+	::RenderSystem(&::gEntityManager, m_pRenderQueue, pCamera, m_vVisibleEntities.data(), UINT(m_vVisibleEntities.size()));
+#else
+	::RenderSystem(&::gEntityManager, m_pRenderQueue, pCamera);
+#endif
+	m_pRenderQueue->Execute(pd3dCommandList);
 
 	for (int i = 0; i < m_nShaders; i++)
 	{
-		m_ppShaders[i]->Render(pd3dCommandList, pCamera);
+		if (!m_ppShaders[i]->UsesRenderQueue()) m_ppShaders[i]->Render(pd3dCommandList, pCamera);
 	}
 }
 
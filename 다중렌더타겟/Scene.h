@@ -5,6 +5,24 @@
 #pragma once
 
 #include "Shader.h"
+#include "RenderQueue.h"
+#include "BoundingVolumeHierarchy.h"
+#include "OcclusionCulling.h"
+#include "Collision.h"
+#include "SceneFile.h"
+
+#define ANIMATION_GRAIN				256
+
+struct ANIMATION_CHUNK
+{
+	CShader						*m_pShader;
+	UINT						m_nBegin;
+	UINT						m_nEnd;
+};
+
+#define SCENE_FILE_NAME				_T("Scene.bin")
+
+#define SCENE_TRUNK_RADIUS_RATIO	0.1f		//    ٱ 浹  
 
 class CScene
 {
@@ -15,9 +33,16 @@ public:
 	bool OnProcessingMouseMessage(HWND hWnd, UINT nMessageID, WPARAM wParam, LPARAM lParam);
 	bool OnProcessingKeyboardMessage(HWND hWnd, UINT nMessageID, WPARAM wParam, LPARAM lParam);
 
-	void BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
+	//  (SCENE_FILE_NAME)  ؼ     ޸𸮿   η .
+	//  (    )  ϸ ƹ͵  ʰ false ȯѴ.
+	bool BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
+	void BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, CSceneFile *pSceneFile);
 	void ReleaseObjects();
 
+	// ݱ BuildObjects() ϵ ڵǾ ִ , ̴,  ġ
+	static void BuildProceduralScene(CSceneFileWriter *pSceneFileWriter);
+	static bool WriteProceduralSceneFile(LPCTSTR pszFileName);
+
 	ID3D12RootSignature *CreateGraphicsRootSignature(ID3D12Device *pd3dDevice);
 	ID3D12RootSignature *GetGraphicsRootSignature() { return(m_pd3dGraphicsRootSignature); }
 	void SetGraphicsRootSignature(ID3D12GraphicsCommandList *pd3dCommandList) { pd3dCommandList->SetGraphicsRootSignature(m_pd3dGraphicsRootSignature); }
@@ -28,11 +53,29 @@ public:
 
 	bool ProcessInput(UCHAR *pKeysBuffer);
     void AnimateObjects(float fTimeElapsed);
+	// ̴ ִϸ̼, ý,   ű (bParallel̸  ü   ķ óѴ)
+	void AnimateStage(float fTimeElapsed, bool bParallel);
+	void AnimateShaders(float fTimeElapsed, bool bParallel);
+	//  ī޶ ׸  ȣѴ. ð 긮 ʰ BillboardSystem() ٽ  尡  ī޶ ϰ Ѵ.
+	void UpdateCameraFacingObjects();
+	//   /ķ ִϸ̼ؼ    Ȯϰ ۾    ð Ѵ.
+	bool RunAnimationScalingTest(LPCTSTR pszFileName);
     void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera=NULL);
 
 	void ReleaseUploadBuffers();
 
 	CHeightMapTerrain *GetTerrain() { return(m_pTerrain); }
+	CRenderQueue *GetRenderQueue() { return(m_pRenderQueue); }
+	CBoundingVolumeHierarchy *GetBoundingVolumeHierarchy() { return(m_pBoundingVolumeHierarchy); }
+	UINT GetVisibleEntities() { return(UINT(m_vVisibleEntities.size())); }
+	COcclusionCuller *GetOcclusionCuller() { return(m_pOcclusionCuller); }
+	CCollisionWorld *GetCollisionWorld() { return(m_pCollisionWorld); }
+
+	void BuildBoundingVolumeHierarchy();
+	void UpdateBoundingVolumeHierarchy();
+	//     Ƽ ( ENTITY_NULL)
+	ENTITY PickEntity(const XMFLOAT3& xmf3Origin, const XMFLOAT3& xmf3Direction, float fMaxDistance, float *pfDistance);
+	ENTITY PickEntityPointedByCursor(int xClient, int yClient, CCamera *pCamera, float *pfDistance);
 
 	CPlayer						*m_pPlayer = NULL;
 
@@ -42,5 +85,20 @@ protected:
 
 	CHeightMapTerrain			*m_pTerrain = NULL;
 
+	CRenderQueue				*m_pRenderQueue = NULL;
+
+	//   ִ Ƽ    (  = ENTITY)
+	CBoundingVolumeHierarchy	*m_pBoundingVolumeHierarchy = NULL;
+	unordered_map<ENTITY, UINT>	m_umEntityProxies;
+	vector<ENTITY>				m_vVisibleEntities;
+
+	//   ޽  CPU  
+	COcclusionCuller			*m_pOcclusionCuller = NULL;
+
+	//   ٱ⿡  ̵ 浹
+	CCollisionWorld				*m_pCollisionWorld = NULL;
+
+	vector<ANIMATION_CHUNK>		m_vAnimationChunks;
+
 	ID3D12RootSignature			*m_pd3dGraphicsRootSignature = NULL;
 };
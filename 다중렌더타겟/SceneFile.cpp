@@ -0,0 +1,235 @@
+//-----------------------------------------------------------------------------
+// File: SceneFile.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "SceneFile.h"
+#include "Object.h"
+
+static_assert(sizeof(SCENE_INSTANCE) == sizeof(CBillboardVertex), "SCENE_INSTANCE must match CBillboardVertex");
+
+bool CSceneFile::Open(LPCTSTR pszFileName)
+{
+	Close();
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	m_hFile = ::CreateFile(pszFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (m_hFile == INVALID_HANDLE_VALUE) return(false);
+
+	LARGE_INTEGER nFileSize;
+	if (!::GetFileSizeEx(m_hFile, &nFileSize) || (nFileSize.QuadPart < LONGLONG(sizeof(SCENE_FILE_HEADER))) || (nFileSize.QuadPart > 0x7FFFFFFF))
+	{
+		Close();
+		return(false);
+	}
+	m_nSize = UINT(nFileSize.QuadPart);
+
+	m_hFileMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_hFileMapping) m_pData = (const BYTE *)::MapViewOfFile(m_hFileMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_pData)
+	{
+		Close();
+		return(false);
+	}
+
+	//  Ʈ ũ ٸ ʵ  ü   ū б ̸ ø.
+	WIN32_MEMORY_RANGE_ENTRY xRange = { (PVOID)m_pData, m_nSize };
+	::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &xRange, 0);
+
+	if (!Validate())
+	{
+		Close();
+		return(false);
+	}
+
+	m_fOpenTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	return(true);
+}
+
+bool CSceneFile::Open(const BYTE *pData, UINT nSize)
+{
+	Close();
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	if (nSize < sizeof(SCENE_FILE_HEADER)) return(false);
+	m_vMemory.assign(pData, pData + nSize);
+	m_pData = m_vMemory.data();
+	m_nSize = nSize;
+
+	if (!Validate())
+	{
+		Close();
+		return(false);
+	}
+
+	m_fOpenTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	return(true);
+}
+
+void CSceneFile::Close()
+{
+	if (m_hFileMapping)
+	{
+		if (m_pData) ::UnmapViewOfFile(m_pData);
+		::CloseHandle(m_hFileMapping);
+	}
+	if (m_hFile != INVALID_HANDLE_VALUE) ::CloseHandle(m_hFile);
+
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_hFileMapping = NULL;
+	m_pData = NULL;
+	m_nSize = 0;
+	m_vMemory.clear();
+	m_vMemory.shrink_to_fit();
+}
+
+bool CSceneFile::IsRangeValid(UINT nOffset, UINT64 nCount, UINT nElementSize)
+{
+	if (nCount == 0) return(true);
+	if ((nOffset < sizeof(SCENE_FILE_HEADER)) || (nOffset % SCENE_FILE_ALIGNMENT) || (nOffset > m_nSize)) return(false);
+	//  ʰ  ϹǷ nCount Ŀ ġ ʴ´.
+	return(nCount <= UINT64((m_nSize - nOffset) / nElementSize));
+}
+
+bool CSceneFile::IsStringValid(const SCENE_OFFSET<WCHAR>& xString)
+{
+	if ((xString.m_nOffset >= m_nSize) || !IsRangeValid(xString.m_nOffset, 1, sizeof(WCHAR))) return(false);
+	const WCHAR *pstrString = xString.Get(m_pData);
+	UINT nMaxLength = (m_nSize - xString.m_nOffset) / sizeof(WCHAR);
+	for (UINT i = 0; i < nMaxLength; i++) if (pstrString[i] == 0) return(true);
+	return(false);
+}
+
+bool CSceneFile::Validate()
+{
+	// ջǰų ٸ   ɷ. 迭   Ƿ  ũ    .
+	const SCENE_FILE_HEADER *pHeader = GetHeader();
+	if ((pHeader->m_nMagic != SCENE_FILE_MAGIC) || (pHeader->m_nVersion != SCENE_FILE_VERSION) || (pHeader->m_nFileSize != m_nSize)) return(false);
+
+	const SCENE_TERRAIN *pTerrain = &pHeader->m_xTerrain;
+	// ũ int̹Ƿ 0̳   Ÿ, ȼ  int ϸ ĥ  Ƿ 64Ʈ Ѵ.
+	if ((pTerrain->m_nWidth < 2) || (pTerrain->m_nLength < 2) || (pTerrain->m_nBlockWidth < 2) || (pTerrain->m_nBlockLength < 2)) return(false);
+	UINT64 nHeightMapPixels = UINT64(pTerrain->m_nWidth) * pTerrain->m_nLength;
+	if (!pTerrain->m_pHeightMapPixels.m_nOffset || !IsRangeValid(pTerrain->m_pHeightMapPixels.m_nOffset, nHeightMapPixels, sizeof(BYTE))) return(false);
+	if (pTerrain->m_nMaterial >= pHeader->m_nMaterials) return(false);
+
+	if (!IsRangeValid(pHeader->m_pMaterials.m_nOffset, pHeader->m_nMaterials, sizeof(SCENE_MATERIAL))) return(false);
+	for (UINT i = 0; i < pHeader->m_nMaterials; i++)
+	{
+		const SCENE_MATERIAL *pMaterial = GetMaterial(i);
+		if ((pMaterial->m_nTextures == 0) || !IsRangeValid(pMaterial->m_pTextureFileNames.m_nOffset, pMaterial->m_nTextures, sizeof(SCENE_OFFSET<WCHAR>))) return(false);
+		const SCENE_OFFSET<WCHAR> *pTextureFileNames = pMaterial->m_pTextureFileNames.Get(m_pData);
+		for (UINT j = 0; j < pMaterial->m_nTextures; j++) if (!IsStringValid(pTextureFileNames[j])) return(false);
+	}
+
+	if (!IsRangeValid(pHeader->m_pShaders.m_nOffset, pHeader->m_nShaders, sizeof(SCENE_SHADER))) return(false);
+	for (UINT i = 0; i < pHeader->m_nShaders; i++)
+	{
+		const SCENE_SHADER *pShader = GetShader(i);
+		if ((pShader->m_nType >= SCENE_SHADER_TYPES) || (pShader->m_nMaterial >= pHeader->m_nMaterials)) return(false);
+		if ((pShader->m_nInstances == 0) || !IsRangeValid(pShader->m_pInstances.m_nOffset, pShader->m_nInstances, sizeof(SCENE_INSTANCE))) return(false);
+	}
+
+	return(true);
+}
+
+CTexture *CSceneFile::CreateTexture(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, UINT nMaterial)
+{
+	const SCENE_MATERIAL *pMaterial = GetMaterial(nMaterial);
+	CTexture *pTexture = new CTexture(pMaterial->m_nTextures, pMaterial->m_nResourceType, 0);
+	for (UINT i = 0; i < pMaterial->m_nTextures; i++) pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, (wchar_t *)GetTextureFileName(pMaterial, i), i);
+	return(pTexture);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+CSceneFileWriter::CSceneFileWriter()
+{
+	::ZeroMemory(&m_xTerrain, sizeof(SCENE_TERRAIN));
+
+	//  ڸ  ΰ Finish() ä.
+	m_vData.resize((sizeof(SCENE_FILE_HEADER) + SCENE_FILE_ALIGNMENT - 1) & ~(SCENE_FILE_ALIGNMENT - 1), 0);
+}
+
+UINT CSceneFileWriter::Append(const void *pData, UINT nBytes)
+{
+	UINT nOffset = UINT(m_vData.size());
+	UINT nAlignedBytes = (nBytes + SCENE_FILE_ALIGNMENT - 1) & ~(SCENE_FILE_ALIGNMENT - 1);
+	m_vData.resize(nOffset + nAlignedBytes, 0);
+	if (pData) ::memcpy(&m_vData[nOffset], pData, nBytes);
+	return(nOffset);
+}
+
+void CSceneFileWriter::SetTerrain(const BYTE *pHeightMapPixels, int nWidth, int nLength, int nBlockWidth, int nBlockLength, XMFLOAT3 xmf3Scale, XMFLOAT4 xmf4Color, UINT nMaterial)
+{
+	assert(!m_bFinished);
+	m_xTerrain.m_pHeightMapPixels.m_nOffset = Append(pHeightMapPixels, UINT(nWidth * nLength));
+	m_xTerrain.m_nWidth = nWidth;
+	m_xTerrain.m_nLength = nLength;
+	m_xTerrain.m_nBlockWidth = nBlockWidth;
+	m_xTerrain.m_nBlockLength = nBlockLength;
+	m_xTerrain.m_xmf3Scale = xmf3Scale;
+	m_xTerrain.m_xmf4Color = xmf4Color;
+	m_xTerrain.m_nMaterial = nMaterial;
+}
+
+UINT CSceneFileWriter::AddMaterial(UINT nResourceType, const LPCWSTR *ppstrTextureFileNames, UINT nTextures)
+{
+	assert(!m_bFinished);
+	vector<SCENE_OFFSET<WCHAR>> vTextureFileNames(nTextures);
+	for (UINT i = 0; i < nTextures; i++) vTextureFileNames[i].m_nOffset = Append(ppstrTextureFileNames[i], UINT((wcslen(ppstrTextureFileNames[i]) + 1) * sizeof(WCHAR)));
+
+	SCENE_MATERIAL xMaterial;
+	xMaterial.m_nResourceType = nResourceType;
+	xMaterial.m_pTextureFileNames.m_nOffset = Append(vTextureFileNames.data(), UINT(nTextures * sizeof(SCENE_OFFSET<WCHAR>)));
+	xMaterial.m_nTextures = nTextures;
+	m_vMaterials.push_back(xMaterial);
+
+	return(UINT(m_vMaterials.size() - 1));
+}
+
+void CSceneFileWriter::AddShader(UINT nType, UINT nMaterial, const SCENE_INSTANCE *pInstances, UINT nInstances)
+{
+	assert(!m_bFinished);
+	SCENE_SHADER xShader;
+	xShader.m_nType = nType;
+	xShader.m_nMaterial = nMaterial;
+	xShader.m_pInstances.m_nOffset = Append(pInstances, UINT(nInstances * sizeof(SCENE_INSTANCE)));
+	xShader.m_nInstances = nInstances;
+	m_vShaders.push_back(xShader);
+}
+
+const vector<BYTE>& CSceneFileWriter::Finish()
+{
+	if (m_bFinished) return(m_vData);
+
+	SCENE_FILE_HEADER xHeader;
+	::ZeroMemory(&xHeader, sizeof(SCENE_FILE_HEADER));
+	xHeader.m_nMagic = SCENE_FILE_MAGIC;
+	xHeader.m_nVersion = SCENE_FILE_VERSION;
+	xHeader.m_xTerrain = m_xTerrain;
+	xHeader.m_pMaterials.m_nOffset = m_vMaterials.size() ? Append(m_vMaterials.data(), UINT(m_vMaterials.size() * sizeof(SCENE_MATERIAL))) : 0;
+	xHeader.m_nMaterials = UINT(m_vMaterials.size());
+	xHeader.m_pShaders.m_nOffset = m_vShaders.size() ? Append(m_vShaders.data(), UINT(m_vShaders.size() * sizeof(SCENE_SHADER))) : 0;
+	xHeader.m_nShaders = UINT(m_vShaders.size());
+	xHeader.m_nFileSize = UINT(m_vData.size());
+	::memcpy(m_vData.data(), &xHeader, sizeof(SCENE_FILE_HEADER));
+
+	m_bFinished = true;
+	return(m_vData);
+}
+
+bool CSceneFileWriter::Write(LPCTSTR pszFileName)
+{
+	const vector<BYTE>& vData = Finish();
+
+	HANDLE hFile = ::CreateFile(pszFileName, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return(false);
+	DWORD dwBytesWritten = 0;
+	BOOL bResult = ::WriteFile(hFile, vData.data(), DWORD(vData.size()), &dwBytesWritten, NULL);
+	::CloseHandle(hFile);
+
+	return(bResult && (dwBytesWritten == vData.size()));
+}
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// File: SceneFile.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#define SCENE_FILE_MAGIC			0x314E4353	//"SCN1"
+#define SCENE_FILE_VERSION			1
+#define SCENE_FILE_ALIGNMENT		16
+
+#define SCENE_SHADER_BILLBOARD_TREES	0		//CBillboardTreeShader
+#define SCENE_SHADER_GEOMETRY_TREES		1		//CGeometryBillboardTreeShader
+#define SCENE_SHADER_TYPES				2
+
+class CTexture;
+class CSceneFile;
+
+//  κ Ʈ ġ.   ϹǷ  ޸𸮿  ״   ִ. (0̸ NULL)
+template <class T> struct SCENE_OFFSET
+{
+	UINT							m_nOffset;
+
+	const T *Get(const void *pBase) const { return(m_nOffset ? (const T *)((const BYTE *)pBase + m_nOffset) : NULL); }
+};
+
+// ؽó ϵ ϳ CTexture д´.
+struct SCENE_MATERIAL
+{
+	UINT							m_nResourceType;	//RESOURCE_TEXTURE2D, ...
+	SCENE_OFFSET<SCENE_OFFSET<WCHAR>>	m_pTextureFileNames;
+	UINT							m_nTextures;
+};
+
+// CBillboardVertex ġ Ƿ  ̴   ۷ ٷ ø  ִ.
+struct SCENE_INSTANCE
+{
+	XMFLOAT3						m_xmf3Position;
+	XMFLOAT2						m_xmf2Size;
+};
+
+struct SCENE_SHADER
+{
+	UINT							m_nType;			//SCENE_SHADER_BILLBOARD_TREES, ...
+	UINT							m_nMaterial;
+	SCENE_OFFSET<SCENE_INSTANCE>	m_pInstances;
+	UINT							m_nInstances;
+};
+
+struct SCENE_TERRAIN
+{
+	SCENE_OFFSET<BYTE>				m_pHeightMapPixels;	//CHeightMapImage  Ʒ ٺ (nWidth x nLength)
+	int								m_nWidth;
+	int								m_nLength;
+	int								m_nBlockWidth;
+	int								m_nBlockLength;
+	XMFLOAT3						m_xmf3Scale;
+	XMFLOAT4						m_xmf4Color;
+	UINT							m_nMaterial;
+};
+
+struct SCENE_FILE_HEADER
+{
+	UINT							m_nMagic;
+	UINT							m_nVersion;
+	UINT							m_nFileSize;
+	SCENE_TERRAIN					m_xTerrain;
+	SCENE_OFFSET<SCENE_MATERIAL>	m_pMaterials;
+	UINT							m_nMaterials;
+	SCENE_OFFSET<SCENE_SHADER>		m_pShaders;
+	UINT							m_nShaders;
+};
+
+// ̴ BuildObjects() pContext ѱ.
+struct SCENE_SHADER_CONTEXT
+{
+	CSceneFile						*m_pSceneFile;
+	const SCENE_SHADER				*m_pShader;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   б  ޸𸮿 Ѵ. ؼ   Open()  ġ/  ȿ ִ ȮѴ.
+class CSceneFile
+{
+public:
+	CSceneFile() { }
+	~CSceneFile() { Close(); }
+
+private:
+	HANDLE							m_hFile = INVALID_HANDLE_VALUE;
+	HANDLE							m_hFileMapping = NULL;
+	const BYTE						*m_pData = NULL;
+	UINT							m_nSize = 0;
+
+	//  ƴ ޸ (CSceneFileWriter)  
+	vector<BYTE>					m_vMemory;
+
+	double							m_fOpenTime = 0.0;
+
+	bool IsRangeValid(UINT nOffset, UINT64 nCount, UINT nElementSize);
+	bool IsStringValid(const SCENE_OFFSET<WCHAR>& xString);
+	bool Validate();
+
+public:
+	bool Open(LPCTSTR pszFileName);
+	bool Open(const BYTE *pData, UINT nSize);
+	void Close();
+
+	bool IsOpen() { return(m_pData != NULL); }
+	bool IsMapped() { return(m_hFileMapping != NULL); }
+	UINT GetSize() { return(m_nSize); }
+	double GetOpenTime() { return(m_fOpenTime); }
+
+	const SCENE_FILE_HEADER *GetHeader() { return((const SCENE_FILE_HEADER *)m_pData); }
+	const SCENE_TERRAIN *GetTerrain() { return(&GetHeader()->m_xTerrain); }
+	const BYTE *GetHeightMapPixels() { return(GetTerrain()->m_pHeightMapPixels.Get(m_pData)); }
+
+	UINT GetMaterials() { return(GetHeader()->m_nMaterials); }
+	const SCENE_MATERIAL *GetMaterial(UINT nMaterial) { return(GetHeader()->m_pMaterials.Get(m_pData) + nMaterial); }
+	const WCHAR *GetTextureFileName(const SCENE_MATERIAL *pMaterial, UINT nTexture) { return(pMaterial->m_pTextureFileNames.Get(m_pData)[nTexture].Get(m_pData)); }
+
+	UINT GetShaders() { return(GetHeader()->m_nShaders); }
+	const SCENE_SHADER *GetShader(UINT nShader) { return(GetHeader()->m_pShaders.Get(m_pData) + nShader); }
+	const SCENE_INSTANCE *GetInstances(const SCENE_SHADER *pShader) { return(pShader->m_pInstances.Get(m_pData)); }
+
+	//  ؽó ϵ  CTexture .
+	CTexture *CreateTexture(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, UINT nMaterial);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  CSceneFile ؼ ٷ   ִ ġ .  SCENE_FILE_ALIGNMENT  ĵȴ.
+class CSceneFileWriter
+{
+public:
+	CSceneFileWriter();
+	~CSceneFileWriter() { }
+
+private:
+	vector<BYTE>					m_vData;
+
+	SCENE_TERRAIN					m_xTerrain;
+	vector<SCENE_MATERIAL>			m_vMaterials;
+	vector<SCENE_SHADER>			m_vShaders;
+
+	bool							m_bFinished = false;
+
+	UINT Append(const void *pData, UINT nBytes);
+
+public:
+	void SetTerrain(const BYTE *pHeightMapPixels, int nWidth, int nLength, int nBlockWidth, int nBlockLength, XMFLOAT3 xmf3Scale, XMFLOAT4 xmf4Color, UINT nMaterial);
+	UINT AddMaterial(UINT nResourceType, const LPCWSTR *ppstrTextureFileNames, UINT nTextures);
+	void AddShader(UINT nType, UINT nMaterial, const SCENE_INSTANCE *pInstances, UINT nInstances);
+
+	//  ̴ ǥ,  ä. Ŀ  ߰  .
+	const vector<BYTE>& Finish();
+	bool Write(LPCTSTR pszFileName);
+};
@@ -4,7 +4,12 @@
 
 #include "stdafx.h"
 #include "Shader.h"
+#include "RenderQueue.h"
+#include "OcclusionCulling.h"
 #include "DDSTextureLoader12.h"
+#include "Profiler.h"
+#include "RenderStats.h"
+#include "FrameUploadBuffer.h"
 
 CShader::CShader()
 {
@@ -281,8 +286,8 @@ void CShader::ReleaseUploadBuffers()
 
 void CShader::OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	if (m_ppd3dPipelineStates) pd3dCommandList->SetPipelineState(m_ppd3dPipelineStates[0]);
-	pd3dCommandList->SetDescriptorHeaps(1, &m_pd3dCbvSrvDescriptorHeap);
+	if (m_ppd3dPipelineStates) ::gFilteredCommandList.SetPipelineState(pd3dCommandList, m_ppd3dPipelineStates[0]);
+	::gFilteredCommandList.SetDescriptorHeaps(pd3dCommandList, 1, &m_pd3dCbvSrvDescriptorHeap);
 
 	UpdateShaderVariables(pd3dCommandList);
 
@@ -290,6 +295,8 @@ void CShader::OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList)
 
 void CShader::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
+	PROFILE_FUNCTION();
+	RENDER_STATS_SHADER(this);
 	OnPrepareRender(pd3dCommandList);
 }
 
@@ -409,33 +416,29 @@ D3D12_BLEND_DESC CBillboardTreeShader::CreateBlendState()
 	return(d3dBlendDesc);
 }
 
-void CBillboardTreeShader::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
-{
-	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255); //256 
-	m_pd3dcbTreeGameObjects = ::CreateBufferResource(pd3dDevice, pd3dCommandList, NULL, ncbElementBytes * m_nTreeObjects, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, NULL);
-
-	m_pd3dcbTreeGameObjects->Map(0, NULL, (void **)&m_pcbMappedTreeGameObjects);
-}
-
 void CBillboardTreeShader::UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList)
 {
+	if (m_nTreeObjects <= 0) return;
+	//  н ̿  Ƿ  ӿ   ø.
+	if (m_nUploadFrame == ::gFrameUploadBuffer.GetFrame()) return;
+
 	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255);
-	for (int j = 0; j < m_nTreeObjects; j++)
-	{
-		CB_GAMEOBJECT_INFO *pbMappedcbTreeGameObject = (CB_GAMEOBJECT_INFO *)((UINT8 *)m_pcbMappedTreeGameObjects + (j * ncbElementBytes));
-		XMStoreFloat4x4(&pbMappedcbTreeGameObject->m_xmf4x4World, XMMatrixTranspose(XMLoadFloat4x4(&m_ppTreeObjects[j]->m_xmf4x4World)));
-	}
+	assert(ncbElementBytes == TRANSFORM_CB_STRIDE);
+
+	void *pcbMappedTreeGameObjects = ::gFrameUploadBuffer.Allocate(ncbElementBytes * m_nTreeObjects, &m_d3dcbTreeGameObjects);
+	if (!pcbMappedTreeGameObjects) return;
+	m_nUploadFrame = ::gFrameUploadBuffer.GetFrame();
+
+	::gTransformStorage.UpdateWorldMatrices(::gTransformStorage.GetIndex(m_hFirstTreeTransform), m_nTreeObjects);
+	::memcpy(pcbMappedTreeGameObjects, ::gTransformStorage.GetShaderConstants(m_hFirstTreeTransform), ncbElementBytes * m_nTreeObjects);
+	::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, ncbElementBytes * m_nTreeObjects);
 }
 
-void CBillboardTreeShader::ReleaseShaderVariables()
+D3D12_GPU_VIRTUAL_ADDRESS CBillboardTreeShader::GetObjectConstantBuffer(UINT nIndex)
 {
-	if (m_pd3dcbTreeGameObjects)
-	{
-		m_pd3dcbTreeGameObjects->Unmap(0, NULL);
-		m_pd3dcbTreeGameObjects->Release();
-	}
-
-	CTexturedShader::ReleaseShaderVariables();
+	if (!m_d3dcbTreeGameObjects || (int(nIndex) >= m_nTreeObjects)) return(0);
+	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255);
+	return(m_d3dcbTreeGameObjects + UINT64(ncbElementBytes) * nIndex);
 }
 
 D3D12_SHADER_BYTECODE CBillboardTreeShader::CreateVertexShader(ID3DBlob **ppd3dShaderBlob)
@@ -448,48 +451,21 @@ D3D12_SHADER_BYTECODE CBillboardTreeShader::CreatePixelShader(ID3DBlob **ppd3dSh
 	return(CShader::CompileShaderFromFile(L"Shaders.hlsl", "PSTree", "ps_5_1", ppd3dShaderBlob));
 }
 
-void CBillboardTreeShader::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext)
+void CBillboardTreeShader::GenerateInstances(CHeightMapImage *pHeightMapImage, vector<SCENE_INSTANCE>& vInstances)
 {
-	CHeightMapTerrain *pTerrain = (CHeightMapTerrain *)pContext;
+	XMFLOAT3 xmf3Scale = pHeightMapImage->GetScale();
 	//
 	float fxPitch = 200.0f;
 	float fzPitch = 200.0f;
 	//
-	float fTerrainWidth = pTerrain->GetWidth();
-	float fTerrainLength = pTerrain->GetLength();
+	float fTerrainWidth = pHeightMapImage->GetHeightMapWidth() * xmf3Scale.x;
+	float fTerrainLength = pHeightMapImage->GetHeightMapLength() * xmf3Scale.z;
 	//
 	int xObjects = int(fTerrainWidth / fxPitch);	// x  ׸.  x   .
 	int zObjects = int(fTerrainLength / fzPitch);	// z  ׸.	 z   .
 
-	m_nTreeObjects = (xObjects * zObjects);			//  ü ׸ Ʈ .
-	// ؽó 
-	CTexture* pTexture;
-
-	pTexture = new CTexture(5, RESOURCE_TEXTURE2D_ARRAY, 0);
-	pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/tree1.dds", 0);
-	pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/tree2.dds", 1);
-	pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/tree3.dds", 2);
-	pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/tree4.dds", 3);
-	pTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/tree5.dds", 4);
-	
-	UINT ncbElementBytes = ((sizeof(CB_GAMEOBJECT_INFO) + 255) & ~255);
+	vInstances.resize(xObjects * zObjects);			//  ü ׸ Ʈ .
 
-	CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, m_nTreeObjects, 5);			// srv 5. ؽó 5 ϱ.
-	CreateShaderVariables(pd3dDevice, pd3dCommandList);
-	CreateConstantBufferViews(pd3dDevice, pd3dCommandList, m_nTreeObjects, m_pd3dcbTreeGameObjects, ncbElementBytes);
-	CreateShaderResourceViews(pd3dDevice, pd3dCommandList, pTexture, 6, false);
-
-	//    ؽó 
-	CMaterial *m_pMaterial = new CMaterial();
-	m_pMaterial->SetTexture(pTexture);
-
-	// ޽ 
-	CTexturedRectMesh *pRectMesh = new CTexturedRectMesh(pd3dDevice, pd3dCommandList, 50.0f, 70.0f, 0.0f, 0, 0, 0);
-
-	// ü Ҵ
-	m_ppTreeObjects = new CBillboardObject*[m_nTreeObjects];
-
-	CBillboardObject *pBillboardObject = NULL;
 	float xPosition;
 	float zPosition;
 	for (int i = 0, x = 0; x < xObjects; x++)
@@ -503,61 +479,100 @@ void CBillboardTreeShader::BuildObjects(ID3D12Device *pd3dDevice, ID3D12Graphics
 			xPosition = x * fxPitch / 2;		//    x fxPitchŭ ֵ.
 			zPosition = z * fzPitch;		//    z fxPitchŭ ֵ.
 
-			pBillboardObject = new CBillboardObject(1);
-
-			pBillboardObject->SetMesh(0, pRectMesh);
-			pBillboardObject->SetMaterial(m_pMaterial);
-			float fHeight = pTerrain->GetHeight(xPosition, zPosition);
-			pBillboardObject->SetPosition(xPosition, fHeight + 35.0f, zPosition);
-			pBillboardObject->SetCbvGPUDescriptorHandlePtr(m_d3dCbvGPUDescriptorStartHandle.ptr + (::gnCbvSrvDescriptorIncrementSize * i));
-			m_ppTreeObjects[i++] = pBillboardObject;
+			float fHeight = pHeightMapImage->GetHeight(xPosition, zPosition) * xmf3Scale.y;
+			vInstances[i].m_xmf3Position = XMFLOAT3(xPosition, fHeight + 35.0f, zPosition);
+			vInstances[i++].m_xmf2Size = XMFLOAT2(50.0f, 70.0f);
 		}
 	}
 }
 
-void CBillboardTreeShader::ReleaseObjects()
+void CBillboardTreeShader::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext)
 {
-	if (m_ppTreeObjects) {
-		for (int i = 0; i < m_nTreeObjects; ++i) {
-			if (m_ppTreeObjects[i]) {
-				delete m_ppTreeObjects[i];
-				m_ppTreeObjects[i] = nullptr;
-			}
-		}
-		delete[] m_ppTreeObjects;
+	SCENE_SHADER_CONTEXT *pSceneContext = (SCENE_SHADER_CONTEXT *)pContext;
+	CSceneFile *pSceneFile = pSceneContext->m_pSceneFile;
+	const SCENE_INSTANCE *pInstances = pSceneFile->GetInstances(pSceneContext->m_pShader);
+
+	m_nTreeObjects = pSceneContext->m_pShader->m_nInstances;	//  ü ׸ Ʈ .
+	// ؽó  (tree1.dds ~ tree5.dds)
+	CTexture* pTexture = pSceneFile->CreateTexture(pd3dDevice, pd3dCommandList, pSceneContext->m_pShader->m_nMaterial);
+
+	//   ۴ Ʈ    ϹǷ   ؽó д.
+	CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 0, pTexture->GetTextures());			// srv 5. ؽó 5 ϱ.
+	CreateShaderResourceViews(pd3dDevice, pd3dCommandList, pTexture, 6, false);
+
+	//    ؽó 
+	CMaterial *m_pMaterial = new CMaterial();
+	m_pMaterial->SetTexture(pTexture);
+
+	// ޽  (   ũ 簢 )
+	CTexturedRectMesh *pRectMesh = new CTexturedRectMesh(pd3dDevice, pd3dCommandList, pInstances[0].m_xmf2Size.x, pInstances[0].m_xmf2Size.y, 0.0f, 0, 0, 0);
+
+	// Ƽ  (ȯ   Ҵ)
+	m_pTreeEntities = ::gLevelArena.AllocateArray<ENTITY>(m_nTreeObjects);
+
+	TRANSFORM_HANDLE *phTreeTransforms = ::gLevelArena.AllocateArray<TRANSFORM_HANDLE>(m_nTreeObjects);
+	::gTransformStorage.AllocateBlock(m_nTreeObjects, phTreeTransforms);
+	m_hFirstTreeTransform = phTreeTransforms[0];
+
+	ENTITY nTreeEntity = ENTITY_NULL;
+	for (int i = 0; i < m_nTreeObjects; i++)
+	{
+		nTreeEntity = ::gEntityManager.CreateEntity(COMPONENT_RENDERABLE | COMPONENT_BILLBOARD, phTreeTransforms[i]);
+
+		::gEntityManager.SetMesh(nTreeEntity, pRectMesh);
+		::gEntityManager.SetMaterial(nTreeEntity, m_pMaterial, this, i, RENDER_PASS_ALPHA_TESTED);
+		::gTransformStorage.SetPosition(phTreeTransforms[i], pInstances[i].m_xmf3Position);
+		m_pTreeEntities[i] = nTreeEntity;
 	}
 }
 
-void CBillboardTreeShader::AnimateObjects(float fTimeElapsed)
+void CBillboardTreeShader::ReleaseObjects()
 {
-	//for (int j = 0; j < m_nTreeObjects; j++)
-	//{
-	//	m_ppTreeObjects[j]->Animate(fTimeElapsed, m_pCamera);
-	//}
+	if (m_pTreeEntities) {
+		for (int i = 0; i < m_nTreeObjects; ++i) ::gEntityManager.DestroyEntity(m_pTreeEntities[i]);
+		// 迭 gLevelArena.Reset() ȴ.
+		m_pTreeEntities = NULL;
+	}
 }
 
 void CBillboardTreeShader::ReleaseUploadBuffers()
 {
-	if (m_ppTreeObjects)
+	//    ޽ .
+	if (m_pTreeEntities && (m_nTreeObjects > 0))
 	{
-		for (int j = 0; j < m_nTreeObjects; ++j) if (m_ppTreeObjects[j]) m_ppTreeObjects[j]->ReleaseUploadBuffers();
+		MESH_COMPONENT *pMesh = ::gEntityManager.GetMesh(m_pTreeEntities[0]);
+		if (pMesh && pMesh->m_pMesh) pMesh->m_pMesh->ReleaseUploadBuffers();
 	}
 }
 
 void CBillboardTreeShader::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
+	PROFILE_FUNCTION();
+	RENDER_STATS_SHADER(this);
+	// ī޶ ϴ  CScene::AnimateObjects() UpdateCameraFacingObjects() BillboardSystem() ŵȴ.
 	CTexturedShader::Render(pd3dCommandList, pCamera);
+	UpdateShaderVariables(pd3dCommandList);
 
-	XMFLOAT3 xmf3CameraPosition = pCamera->GetPosition();
 	for (int j = 0; j < m_nTreeObjects; ++j)
 	{
-		if (m_ppTreeObjects[j]) {
-			m_ppTreeObjects[j]->SetLookAt(xmf3CameraPosition, XMFLOAT3(0.0f, 1.0f, 0.0f));
-			m_ppTreeObjects[j]->Render(pd3dCommandList, pCamera);
-		}
+		MESH_COMPONENT *pMesh = ::gEntityManager.GetMesh(m_pTreeEntities[j]);
+		MATERIAL_COMPONENT *pMaterial = ::gEntityManager.GetMaterial(m_pTreeEntities[j]);
+
+		if (pMaterial->m_pMaterial && pMaterial->m_pMaterial->m_pTexture) pMaterial->m_pMaterial->m_pTexture->UpdateShaderVariables(pd3dCommandList);
+		D3D12_GPU_VIRTUAL_ADDRESS d3dcbGameObject = GetObjectConstantBuffer(pMaterial->m_nConstantBufferIndex);
+		if (d3dcbGameObject) ::gFilteredCommandList.SetGraphicsRootConstantBufferView(pd3dCommandList, 2, d3dcbGameObject);
+		if (pMesh->m_pMesh) pMesh->m_pMesh->Render(pd3dCommandList);
 	}
 }
 
+void CBillboardTreeShader::SubmitRenderPackets(CRenderQueue *pRenderQueue, CCamera *pCamera)
+{
+	//  Ƽ Ŷ CScene::Render() RenderSystem() Ѵ.
+	// ⼭   ۸ Ѳ ø.
+	RENDER_STATS_SHADER(this);
+	UpdateShaderVariables(NULL);
+}
+
 /////////////////////////////////////////////////////////////////////////
 //  Ʈ ̴(Array)
 
@@ -855,49 +870,64 @@ void CGeometryBillboardTreeShader::CreateShader(ID3D12Device *pd3dDevice, ID3D12
 
 }
 
-void CGeometryBillboardTreeShader::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext, int Batch[][257])
+void CGeometryBillboardTreeShader::GenerateInstances(CHeightMapImage *pHeightMapImage, vector<SCENE_INSTANCE>& vInstances)
 {
-	CTexture* pTreeTexture = new CTexture(1, RESOURCE_TEXTURE2DARRAY, 0);
-	pTreeTexture->LoadTextureFromFile(pd3dDevice, pd3dCommandList, L"Image/treearray.dds", 0);
-	CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 0, 1);
-	CreateShaderResourceViews(pd3dDevice, pd3dCommandList, pTreeTexture, 7, true);
-
-	//    ؽó 
-	m_pMaterial = new CMaterial();
-	m_pMaterial->SetTexture(pTreeTexture);
-	CHeightMapTerrain *pTerrain = (CHeightMapTerrain *)pContext;
+	XMFLOAT3 xmf3Scale = pHeightMapImage->GetScale();
 	//
 	float fxPitch = 200.0f;
 	float fzPitch = 200.0f;
 	//
-	int fTerrainWidth = int(pTerrain->GetWidth());
-	int fTerrainLength = int(pTerrain->GetLength());
+	int fTerrainWidth = int(pHeightMapImage->GetHeightMapWidth() * xmf3Scale.x);
+	int fTerrainLength = int(pHeightMapImage->GetHeightMapLength() * xmf3Scale.z);
 	//
 	int xObjects = int(fTerrainWidth / fxPitch);	// x  ׸.  x   .
 	int zObjects = int(fTerrainLength / fzPitch);	// z  ׸.	 z   .
 
-	m_nVertices = (xObjects * zObjects);			//  ü ׸ Ʈ .
-	m_nStride = sizeof(CBillboardVertex);
+	int nInstances = (xObjects * zObjects);			//  ü ׸ Ʈ .
+	vInstances.resize(nInstances);
 	XMFLOAT3 xmf3Position;
 
-	CBillboardVertex *pTreeVertices = new CBillboardVertex[m_nVertices];
-
-	for (int i = 0; i < m_nVertices;) {
+	for (int i = 0; i < nInstances;) {
 		xmf3Position.x = 1000 + (int)(i * fxPitch / 2) % 1000;
 		xmf3Position.z = (int)(i / 10 * fzPitch) % 2100;
-		float fHeight = pTerrain->GetHeight(xmf3Position.x, xmf3Position.z);
+		float fHeight = pHeightMapImage->GetHeight(xmf3Position.x, xmf3Position.z) * xmf3Scale.y;
 		xmf3Position.y = fHeight + 30;
-		pTreeVertices[i++] = CBillboardVertex(xmf3Position, XMFLOAT2(50, 70));
+		vInstances[i].m_xmf3Position = xmf3Position;
+		vInstances[i++].m_xmf2Size = XMFLOAT2(50, 70);
 	}
+}
+
+void CGeometryBillboardTreeShader::BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext, int Batch[][257])
+{
+	SCENE_SHADER_CONTEXT *pSceneContext = (SCENE_SHADER_CONTEXT *)pContext;
+	CSceneFile *pSceneFile = pSceneContext->m_pSceneFile;
 
-	m_pd3dVertexBuffer = ::CreateBufferResource(pd3dDevice, pd3dCommandList, pTreeVertices,
+	CTexture* pTreeTexture = pSceneFile->CreateTexture(pd3dDevice, pd3dCommandList, pSceneContext->m_pShader->m_nMaterial);	// treearray.dds
+	CreateCbvAndSrvDescriptorHeaps(pd3dDevice, pd3dCommandList, 0, 1);
+	CreateShaderResourceViews(pd3dDevice, pd3dCommandList, pTreeTexture, 7, true);
+
+	//    ؽó 
+	m_pMaterial = new CMaterial();
+	m_pMaterial->SetTexture(pTreeTexture);
+
+	m_nVertices = pSceneContext->m_pShader->m_nInstances;			//  ü ׸ Ʈ .
+	m_nStride = sizeof(CBillboardVertex);
+
+	//   νϽ 迭  迭 ġ Ƿ ε ޸𸮿 ٷ εѴ.
+	const CBillboardVertex *pTreeVertices = (const CBillboardVertex *)pSceneFile->GetInstances(pSceneContext->m_pShader);
+
+	m_pd3dVertexBuffer = ::CreateBufferResource(pd3dDevice, pd3dCommandList, (void *)pTreeVertices,
 		m_nStride*m_nVertices, D3D12_HEAP_TYPE_DEFAULT,
 		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, &m_pd3dVertexUploadBuffer);
 
 	m_pd3dVertexBufferView.BufferLocation = m_pd3dVertexBuffer->GetGPUVirtualAddress();
 	m_pd3dVertexBufferView.StrideInBytes = m_nStride;
 	m_pd3dVertexBufferView.SizeInBytes = m_nStride * m_nVertices;
-	if (pTreeVertices) delete[] pTreeVertices;
+
+	m_vTreeVertices.assign(pTreeVertices, pTreeVertices + m_nVertices);
+	m_d3dVisibleVertexBufferView.BufferLocation = 0;
+	m_d3dVisibleVertexBufferView.StrideInBytes = m_nStride;
+	m_d3dVisibleVertexBufferView.SizeInBytes = 0;
 }
 
 void CGeometryBillboardTreeShader::CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList)
@@ -923,14 +953,37 @@ void CGeometryBillboardTreeShader::ReleaseUploadBuffers()
 
 void CGeometryBillboardTreeShader::OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList)
 {
-	if (m_ppd3dPipelineStates) pd3dCommandList->SetPipelineState(m_ppd3dPipelineStates[0]);
-	pd3dCommandList->SetDescriptorHeaps(1, &m_pd3dCbvSrvDescriptorHeap);
+	if (m_ppd3dPipelineStates) ::gFilteredCommandList.SetPipelineState(pd3dCommandList, m_ppd3dPipelineStates[0]);
+	::gFilteredCommandList.SetDescriptorHeaps(pd3dCommandList, 1, &m_pd3dCbvSrvDescriptorHeap);
 
 	UpdateShaderVariables(pd3dCommandList);
 }
 
+void CGeometryBillboardTreeShader::OcclusionCull(COcclusionCuller *pOcclusionCuller)
+{
+	if (m_nVertices <= 0) return;
+
+	// ̴    𸣹Ƿ   ũ⸦ ޴´. н ø  ٸǷ Ź  ޴´.
+	CBillboardVertex *pVisibleVertices = (CBillboardVertex *)::gFrameUploadBuffer.Allocate(m_nStride * m_nVertices, &m_d3dVisibleVertexBufferView.BufferLocation);
+	if (!pVisibleVertices) return;
+
+	//  ̴ 簢 yθ Ƿ x, z δ ʺ ݸŭ  ڷ ˻Ѵ.
+	m_nVisibleVertices = 0;
+	for (const CBillboardVertex& xTreeVertex : m_vTreeVertices)
+	{
+		XMFLOAT3 xmf3Extents(xTreeVertex.m_xmf2Size.x * 0.5f, xTreeVertex.m_xmf2Size.y * 0.5f, xTreeVertex.m_xmf2Size.x * 0.5f);
+		XMFLOAT3 xmf3Min(xTreeVertex.m_xmf3Position.x - xmf3Extents.x, xTreeVertex.m_xmf3Position.y - xmf3Extents.y, xTreeVertex.m_xmf3Position.z - xmf3Extents.z);
+		XMFLOAT3 xmf3Max(xTreeVertex.m_xmf3Position.x + xmf3Extents.x, xTreeVertex.m_xmf3Position.y + xmf3Extents.y, xTreeVertex.m_xmf3Position.z + xmf3Extents.z);
+		if (pOcclusionCuller->IsVisible(xmf3Min, xmf3Max)) pVisibleVertices[m_nVisibleVertices++] = xTreeVertex;
+	}
+	m_d3dVisibleVertexBufferView.SizeInBytes = m_nStride * m_nVisibleVertices;
+	m_bOcclusionCulled = true;
+}
+
 void CGeometryBillboardTreeShader::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
+	PROFILE_FUNCTION();
+	RENDER_STATS_SHADER(this);
 
 	OnPrepareRender(pd3dCommandList);
 
@@ -949,11 +1002,23 @@ void CGeometryBillboardTreeShader::Render(ID3D12GraphicsCommandList *pd3dCommand
 		}
 	}
 
-	pd3dCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_POINTLIST);
+	::gFilteredCommandList.IASetPrimitiveTopology(pd3dCommandList, D3D_PRIMITIVE_TOPOLOGY_POINTLIST);
+
+	if (m_bOcclusionCulled)
+	{
+		// ̹ Render() ռ OcclusionCull()   鸸 ׸.
+		m_bOcclusionCulled = false;
+		if (m_nVisibleVertices == 0) return;
+		// OcclusionCull() ̴  ̹  ε  .
+		::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, m_nVisibleVertices * sizeof(CBillboardVertex));
+		::gFilteredCommandList.IASetVertexBuffers(pd3dCommandList, 0, 1, &m_d3dVisibleVertexBufferView);
+		::gFilteredCommandList.DrawInstanced(pd3dCommandList, m_nVisibleVertices, 1, 0, 0);
+		return;
+	}
 
-	pd3dCommandList->IASetVertexBuffers(0, 1, &m_pd3dVertexBufferView);
+	::gFilteredCommandList.IASetVertexBuffers(pd3dCommandList, 0, 1, &m_pd3dVertexBufferView);
 
-	pd3dCommandList->DrawInstanced(m_nVertices, 1, 0, 0);
+	::gFilteredCommandList.DrawInstanced(pd3dCommandList, m_nVertices, 1, 0, 0);
 	
 }
 
@@ -1077,14 +1142,16 @@ void CPostProcessingShader::ReleaseObjects()
 
 void CPostProcessingShader::Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera)
 {
+	PROFILE_FUNCTION();
+	RENDER_STATS_SHADER(this);
 	pCamera->SetViewportsAndScissorRects(pd3dCommandList);
 
 	CShader::Render(pd3dCommandList, pCamera);
 
 	if (m_pTexture) m_pTexture->UpdateShaderVariables(pd3dCommandList);
 
-	pd3dCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	pd3dCommandList->DrawInstanced(6, 1, 0, 0);
+	::gFilteredCommandList.IASetPrimitiveTopology(pd3dCommandList, D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	::gFilteredCommandList.DrawInstanced(pd3dCommandList, 6, 1, 0, 0);
 }
 
 
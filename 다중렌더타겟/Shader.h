@@ -7,6 +7,10 @@
 #include "Object.h"
 #include "Camera.h"
 #include "Player.h"
+#include "Entity.h"
+#include "SceneFile.h"
+
+class COcclusionCuller;
 
 class CShader
 {
@@ -15,11 +19,11 @@ public:
 	virtual ~CShader();
 
 private:
-	int								m_nReferences = 0;
+	std::atomic<int>				m_nReferences{ 0 };
 
 public:
-	void AddRef() { m_nReferences++; }
-	void Release() { if (--m_nReferences <= 0) delete this; }
+	void AddRef() { m_nReferences.fetch_add(1, std::memory_order_relaxed); }
+	void Release() { if (m_nReferences.fetch_sub(1, std::memory_order_acq_rel) <= 1) ::gDeferredDeletionQueue.Push(this, ::DeleteDeferredObject<CShader>); }
 
 	virtual D3D12_INPUT_LAYOUT_DESC CreateInputLayout();
 	virtual D3D12_RASTERIZER_DESC CreateRasterizerState();
@@ -45,6 +49,13 @@ public:
 
 	virtual void BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext=NULL) { }
 	virtual void AnimateObjects(float fTimeElapsed) { }
+	// ü  ¸ аų   true ȯѴ.
+	// ׷ CScene [nBegin, nEnd)    忡 AnimateObjects() ȣѴ.
+	virtual bool HasIndependentObjects() { return(false); }
+	virtual UINT GetAnimatedObjects() { return(0); }
+	virtual void AnimateObjects(float fTimeElapsed, UINT nBegin, UINT nEnd) { }
+	// ִϸ̼   忡   ȣǾ   ī޶ ѱ. ( Բ  ī޶ ġ  ⼭  д)
+	virtual void PrepareAnimation(CCamera *pCamera) { }
 	virtual void ReleaseObjects() { }
 
 	virtual void ReleaseUploadBuffers();
@@ -52,6 +63,18 @@ public:
 	virtual void OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList);
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera);
 
+	//  ť ϴ ̴ Render()  ׸ Ŷ Ѵ.
+	virtual bool UsesRenderQueue() { return(false); }
+	virtual void SubmitRenderPackets(CRenderQueue *pRenderQueue, CCamera *pCamera) { }
+	//  ť  ʴ ̴ Render()   ü  .
+	virtual void OcclusionCull(COcclusionCuller *pOcclusionCuller) { }
+
+	// Ƽ MATERIAL_COMPONENT::m_nConstantBufferIndex شϴ ̹  ü   (Ʈ Ķ 2)
+	virtual D3D12_GPU_VIRTUAL_ADDRESS GetObjectConstantBuffer(UINT nIndex) { return(0); }
+
+	ID3D12PipelineState *GetPipelineState(int nIndex = 0) { return((m_ppd3dPipelineStates && (nIndex < m_nPipelineStates)) ? m_ppd3dPipelineStates[nIndex] : NULL); }
+	ID3D12DescriptorHeap *GetDescriptorHeap() { return(m_pd3dCbvSrvDescriptorHeap); }
+
 	D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForHeapStart() { return(m_pd3dCbvSrvDescriptorHeap->GetCPUDescriptorHandleForHeapStart()); }
 	D3D12_GPU_DESCRIPTOR_HANDLE GetGPUDescriptorHandleForHeapStart() { return(m_pd3dCbvSrvDescriptorHeap->GetGPUDescriptorHandleForHeapStart()); }
 
@@ -116,27 +139,36 @@ public:
 	CBillboardTreeShader();
 	virtual ~CBillboardTreeShader();
 
+	// pContext SCENE_SHADER_CONTEXT̴.
 	virtual void BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext = NULL);
-	virtual void AnimateObjects(float fTimeElapsed);
+	//      ġѴ. (    )
+	static void GenerateInstances(CHeightMapImage *pHeightMapImage, vector<SCENE_INSTANCE>& vInstances);
+	// ī޶ ϴ ȸ BillboardSystem()  ŰŸ 迭  óϹǷ  ִϸ̼ .
 	virtual void ReleaseObjects();
 	virtual D3D12_BLEND_DESC CreateBlendState();
 	virtual D3D12_SHADER_BYTECODE CreateVertexShader(ID3DBlob **ppd3dShaderBlob);
 	virtual D3D12_SHADER_BYTECODE CreatePixelShader(ID3DBlob **ppd3dShaderBlob);
 
-	virtual void CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
 	virtual void UpdateShaderVariables(ID3D12GraphicsCommandList *pd3dCommandList);
-	virtual void ReleaseShaderVariables();
+	virtual D3D12_GPU_VIRTUAL_ADDRESS GetObjectConstantBuffer(UINT nIndex);
 
 	virtual void ReleaseUploadBuffers();
 
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera);
 
+	virtual bool UsesRenderQueue() { return(true); }
+	virtual void SubmitRenderPackets(CRenderQueue *pRenderQueue, CCamera *pCamera);
+
 private:
-	CBillboardObject** m_ppTreeObjects = 0;
+	ENTITY							*m_pTreeEntities = NULL;
 	int								m_nTreeObjects = 0;
 
-	ID3D12Resource					*m_pd3dcbTreeGameObjects = NULL;
-	CB_GAMEOBJECT_INFO				*m_pcbMappedTreeGameObjects = NULL;
+	//  ȯ   ҴǾ ִ. (  ε memcpy  )
+	TRANSFORM_HANDLE				m_hFirstTreeTransform = TRANSFORM_HANDLE_NULL;
+
+	//   ۴ Ӹ gFrameUploadBuffer Ѳ ޴´. (m_nUploadFrame  )
+	D3D12_GPU_VIRTUAL_ADDRESS		m_d3dcbTreeGameObjects = 0;
+	UINT64							m_nUploadFrame = 0;
 };
 
 /////////////////////////////////////////////////////////////////////////
@@ -188,7 +220,9 @@ public:
 	virtual void CreateShader(ID3D12Device *pd3dDevice, ID3D12RootSignature *pd3dGraphicsRootSignature);
 
 	void CreateShaderResourceViews(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, CTexture *pTexture, UINT nRootParameterStartIndex, bool bAutoIncrement);
+	// pContext SCENE_SHADER_CONTEXT̴.
 	virtual void BuildObjects(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, void *pContext = NULL, int Batch[][257] = { 0 });
+	static void GenerateInstances(CHeightMapImage *pHeightMapImage, vector<SCENE_INSTANCE>& vInstances);
 	virtual void CreateShaderVariables(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList);
 	virtual void UpdateShaderVariables(ID3D12GraphicsCommandList* pd3dCommandList);
 
@@ -197,6 +231,7 @@ public:
 
 	virtual void OnPrepareRender(ID3D12GraphicsCommandList *pd3dCommandList);
 
+	virtual void OcclusionCull(COcclusionCuller *pOcclusionCuller);
 	virtual void Render(ID3D12GraphicsCommandList *pd3dCommandList, CCamera *pCamera);
 
 protected:
@@ -207,6 +242,12 @@ protected:
 	ID3D12Resource* m_pd3dVertexUploadBuffer;
 
 	D3D12_VERTEX_BUFFER_VIEW m_pd3dVertexBufferView;
+
+	//  ø  鸸   gFrameUploadBuffer   ۿ Ƽ ׸.
+	vector<CBillboardVertex>		m_vTreeVertices;
+	D3D12_VERTEX_BUFFER_VIEW		m_d3dVisibleVertexBufferView;
+	int								m_nVisibleVertices = 0;
+	bool							m_bOcclusionCulled = false;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
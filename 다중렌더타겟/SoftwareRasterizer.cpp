@@ -0,0 +1,471 @@
+//-----------------------------------------------------------------------------
+// File: SoftwareRasterizer.cpp
+//-----------------------------------------------------------------------------
+
+#include "SoftwareRasterizer.h"
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+inline bool IsBoxOutsideFrustum(const RASTER_FLOAT4 *pxmf4Planes, const RASTER_FLOAT3& xmf3Min, const RASTER_FLOAT3& xmf3Max)
+{
+	//      (p-vertex) ٱ̸  ü ٱ̴.
+	for (int i = 0; i < 6; i++)
+	{
+		const RASTER_FLOAT4& xmf4Plane = pxmf4Planes[i];
+		float fDistance = (xmf4Plane.x * ((xmf4Plane.x >= 0.0f) ? xmf3Max.x : xmf3Min.x)) + (xmf4Plane.y * ((xmf4Plane.y >= 0.0f) ? xmf3Max.y : xmf3Min.y)) + (xmf4Plane.z * ((xmf4Plane.z >= 0.0f) ? xmf3Max.z : xmf3Min.z)) + xmf4Plane.w;
+		if (fDistance < 0.0f) return(true);
+	}
+	return(false);
+}
+
+inline float HorizontalMin(__m128 xmmValue)
+{
+	xmmValue = _mm_min_ps(xmmValue, _mm_shuffle_ps(xmmValue, xmmValue, _MM_SHUFFLE(2, 3, 0, 1)));
+	xmmValue = _mm_min_ps(xmmValue, _mm_shuffle_ps(xmmValue, xmmValue, _MM_SHUFFLE(1, 0, 3, 2)));
+	return(_mm_cvtss_f32(xmmValue));
+}
+
+inline float HorizontalMax(__m128 xmmValue)
+{
+	xmmValue = _mm_max_ps(xmmValue, _mm_shuffle_ps(xmmValue, xmmValue, _MM_SHUFFLE(2, 3, 0, 1)));
+	xmmValue = _mm_max_ps(xmmValue, _mm_shuffle_ps(xmmValue, xmmValue, _MM_SHUFFLE(1, 0, 3, 2)));
+	return(_mm_cvtss_f32(xmmValue));
+}
+
+CSoftwareRasterizer::CSoftwareRasterizer()
+{
+	int nWidth = OCCLUSION_BUFFER_WIDTH, nHeight = OCCLUSION_BUFFER_HEIGHT;
+	for (m_nLevels = 0; m_nLevels < OCCLUSION_MAX_LEVELS; )
+	{
+		m_pnLevelWidths[m_nLevels] = nWidth;
+		m_pnLevelHeights[m_nLevels] = nHeight;
+		m_ppfDepthLevels[m_nLevels] = (float *)_mm_malloc(nWidth * nHeight * sizeof(float), 16);
+		for (int i = 0; i < nWidth * nHeight; i++) m_ppfDepthLevels[m_nLevels][i] = 1.0f;
+		m_nLevels++;
+		if ((nWidth == 1) && (nHeight == 1)) break;
+		nWidth = std::max(1, (nWidth + 1) / 2);
+		nHeight = std::max(1, (nHeight + 1) / 2);
+	}
+
+	memset(m_pfViewProjection, 0, sizeof(m_pfViewProjection));
+}
+
+CSoftwareRasterizer::~CSoftwareRasterizer()
+{
+	for (int i = 0; i < m_nLevels; i++) _mm_free(m_ppfDepthLevels[i]);
+}
+
+void CSoftwareRasterizer::ClearOccluders()
+{
+	m_vOccluderPositions.clear();
+	m_vOccluderIndices.clear();
+	m_vOccluderBlocks.clear();
+}
+
+void CSoftwareRasterizer::AddOccluder(const RASTER_FLOAT3 *pxmf3Positions, unsigned int nVertices, const unsigned int *pnIndices, unsigned int nIndices)
+{
+	if ((nVertices == 0) || (nIndices < 3)) return;
+
+	OCCLUDER_BLOCK xBlock;
+	xBlock.m_xmf3Min = xBlock.m_xmf3Max = pxmf3Positions[0];
+	xBlock.m_nFirstIndex = (unsigned int)(m_vOccluderIndices.size());
+	xBlock.m_nIndices = nIndices - (nIndices % 3);
+
+	unsigned int nBaseVertex = (unsigned int)(m_vOccluderPositions.size());
+	for (unsigned int i = 0; i < nVertices; i++)
+	{
+		const RASTER_FLOAT3& xmf3Position = pxmf3Positions[i];
+		xBlock.m_xmf3Min = RASTER_FLOAT3{ std::min(xBlock.m_xmf3Min.x, xmf3Position.x), std::min(xBlock.m_xmf3Min.y, xmf3Position.y), std::min(xBlock.m_xmf3Min.z, xmf3Position.z) };
+		xBlock.m_xmf3Max = RASTER_FLOAT3{ std::max(xBlock.m_xmf3Max.x, xmf3Position.x), std::max(xBlock.m_xmf3Max.y, xmf3Position.y), std::max(xBlock.m_xmf3Max.z, xmf3Position.z) };
+		m_vOccluderPositions.push_back(xmf3Position);
+	}
+	for (unsigned int i = 0; i < xBlock.m_nIndices; i++) m_vOccluderIndices.push_back(nBaseVertex + pnIndices[i]);
+
+	m_vOccluderBlocks.push_back(xBlock);
+}
+
+void CSoftwareRasterizer::AddHeightMapOccluder(const unsigned char *pHeightMapPixels, int nWidth, int nLength, const RASTER_FLOAT3& xmf3Scale, int nStep)
+{
+	int cxVertices = ((nWidth - 1) / nStep) + 1;
+	int czVertices = ((nLength - 1) / nStep) + 1;
+
+	// ģ  ̴ ̿ ģ 簢    ĭ ּҰ̴.
+	// ׷ ģ ﰢ     Ʒ   ų . (  ̴)
+	std::vector<RASTER_FLOAT3> vxmf3Grid(cxVertices * czVertices);
+	for (int z = 0; z < czVertices; z++)
+	{
+		for (int x = 0; x < cxVertices; x++)
+		{
+			int xHeightMap = x * nStep, zHeightMap = z * nStep;
+			unsigned char nMinHeight = 255;
+			for (int j = std::max(0, zHeightMap - nStep); j <= std::min(nLength - 1, zHeightMap + nStep); j++)
+			{
+				for (int i = std::max(0, xHeightMap - nStep); i <= std::min(nWidth - 1, xHeightMap + nStep); i++) nMinHeight = std::min(nMinHeight, pHeightMapPixels[i + (j * nWidth)]);
+			}
+			vxmf3Grid[x + (z * cxVertices)] = RASTER_FLOAT3{ xHeightMap * xmf3Scale.x, nMinHeight * xmf3Scale.y, zHeightMap * xmf3Scale.z };
+		}
+	}
+
+	// OCCLUSION_TERRAIN_BLOCK x OCCLUSION_TERRAIN_BLOCK 簢   .
+	std::vector<RASTER_FLOAT3> vxmf3Positions;
+	std::vector<unsigned int> vnIndices;
+	for (int zBlock = 0; zBlock < czVertices - 1; zBlock += OCCLUSION_TERRAIN_BLOCK)
+	{
+		for (int xBlock = 0; xBlock < cxVertices - 1; xBlock += OCCLUSION_TERRAIN_BLOCK)
+		{
+			int cxBlockVertices = std::min(OCCLUSION_TERRAIN_BLOCK, cxVertices - 1 - xBlock) + 1;
+			int czBlockVertices = std::min(OCCLUSION_TERRAIN_BLOCK, czVertices - 1 - zBlock) + 1;
+
+			vxmf3Positions.clear();
+			vnIndices.clear();
+			for (int z = 0; z < czBlockVertices; z++)
+			{
+				for (int x = 0; x < cxBlockVertices; x++) vxmf3Positions.push_back(vxmf3Grid[(xBlock + x) + ((zBlock + z) * cxVertices)]);
+			}
+			for (int z = 0; z < czBlockVertices - 1; z++)
+			{
+				for (int x = 0; x < cxBlockVertices - 1; x++)
+				{
+					unsigned int nVertex = x + (z * cxBlockVertices);
+					vnIndices.push_back(nVertex); vnIndices.push_back(nVertex + cxBlockVertices); vnIndices.push_back(nVertex + 1);
+					vnIndices.push_back(nVertex + 1); vnIndices.push_back(nVertex + cxBlockVertices); vnIndices.push_back(nVertex + cxBlockVertices + 1);
+				}
+			}
+			AddOccluder(vxmf3Positions.data(), (unsigned int)(vxmf3Positions.size()), vnIndices.data(), (unsigned int)(vnIndices.size()));
+		}
+	}
+}
+
+void CSoftwareRasterizer::Render(const float *pfViewProjection, const RASTER_FLOAT4 *pxmf4FrustumPlanes)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	memcpy(m_pfViewProjection, pfViewProjection, sizeof(m_pfViewProjection));
+	m_nRasterizedTriangles = 0;
+
+	__m128 xmmFar = _mm_set1_ps(1.0f);
+	float *pfDepthBuffer = m_ppfDepthLevels[0];
+	for (int i = 0; i < OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT; i += 4) _mm_store_ps(pfDepthBuffer + i, xmmFar);
+
+	//      Ŭ ǥ ȯѴ. (  * )
+	__m128 xmmRow0 = _mm_loadu_ps(pfViewProjection + 0), xmmRow1 = _mm_loadu_ps(pfViewProjection + 4);
+	__m128 xmmRow2 = _mm_loadu_ps(pfViewProjection + 8), xmmRow3 = _mm_loadu_ps(pfViewProjection + 12);
+	m_vClipPositions.resize(m_vOccluderPositions.size());
+	for (size_t i = 0; i < m_vOccluderPositions.size(); i++)
+	{
+		const RASTER_FLOAT3& xmf3Position = m_vOccluderPositions[i];
+		__m128 xmmClip = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(xmf3Position.x), xmmRow0), _mm_mul_ps(_mm_set1_ps(xmf3Position.y), xmmRow1)), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(xmf3Position.z), xmmRow2), xmmRow3));
+		_mm_storeu_ps(&m_vClipPositions[i].x, xmmClip);
+	}
+
+	for (const OCCLUDER_BLOCK& xBlock : m_vOccluderBlocks)
+	{
+		if (pxmf4FrustumPlanes && IsBoxOutsideFrustum(pxmf4FrustumPlanes, xBlock.m_xmf3Min, xBlock.m_xmf3Max)) continue;
+
+		const unsigned int *pnIndices = &m_vOccluderIndices[xBlock.m_nFirstIndex];
+		for (unsigned int i = 0; i < xBlock.m_nIndices; i += 3) RasterizeTriangle(m_vClipPositions[pnIndices[i]], m_vClipPositions[pnIndices[i + 1]], m_vClipPositions[pnIndices[i + 2]]);
+	}
+
+	BuildHierarchicalDepth();
+
+	m_fRenderTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+}
+
+void CSoftwareRasterizer::RasterizeTriangle(const RASTER_FLOAT4& xmf4Clip0, const RASTER_FLOAT4& xmf4Clip1, const RASTER_FLOAT4& xmf4Clip2)
+{
+	//     Ŭ (x, y) ٱ̸ ׸ ʴ´.
+	if ((xmf4Clip0.x > xmf4Clip0.w) && (xmf4Clip1.x > xmf4Clip1.w) && (xmf4Clip2.x > xmf4Clip2.w)) return;
+	if ((xmf4Clip0.x < -xmf4Clip0.w) && (xmf4Clip1.x < -xmf4Clip1.w) && (xmf4Clip2.x < -xmf4Clip2.w)) return;
+	if ((xmf4Clip0.y > xmf4Clip0.w) && (xmf4Clip1.y > xmf4Clip1.w) && (xmf4Clip2.y > xmf4Clip2.w)) return;
+	if ((xmf4Clip0.y < -xmf4Clip0.w) && (xmf4Clip1.y < -xmf4Clip1.w) && (xmf4Clip2.y < -xmf4Clip2.w)) return;
+
+	//  (z >= 0) ߶󳽴. ﰢ ϳ ڸ  ִ 4̴.
+	const RASTER_FLOAT4 *pxmf4Inputs[3] = { &xmf4Clip0, &xmf4Clip1, &xmf4Clip2 };
+	RASTER_FLOAT4 pxmf4Clipped[4];
+	int nClipped = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		const RASTER_FLOAT4& a = *pxmf4Inputs[i];
+		const RASTER_FLOAT4& b = *pxmf4Inputs[(i + 1) % 3];
+		bool bInsideA = (a.z >= 0.0f), bInsideB = (b.z >= 0.0f);
+		if (bInsideA) pxmf4Clipped[nClipped++] = a;
+		if (bInsideA != bInsideB)
+		{
+			float t = a.z / (a.z - b.z);
+			pxmf4Clipped[nClipped++] = RASTER_FLOAT4{ a.x + ((b.x - a.x) * t), a.y + ((b.y - a.y) * t), 0.0f, a.w + ((b.w - a.w) * t) };
+		}
+	}
+	if (nClipped < 3) return;
+
+	RASTER_FLOAT3 pxmf3Screen[4];
+	for (int i = 0; i < nClipped; i++)
+	{
+		float fInverseW = 1.0f / pxmf4Clipped[i].w;
+		pxmf3Screen[i].x = ((pxmf4Clipped[i].x * fInverseW * 0.5f) + 0.5f) * OCCLUSION_BUFFER_WIDTH;
+		pxmf3Screen[i].y = (0.5f - (pxmf4Clipped[i].y * fInverseW * 0.5f)) * OCCLUSION_BUFFER_HEIGHT;
+		pxmf3Screen[i].z = pxmf4Clipped[i].z * fInverseW;
+	}
+
+	RasterizeScreenTriangle(pxmf3Screen);
+	if (nClipped == 4)
+	{
+		RASTER_FLOAT3 pxmf3Fan[3] = { pxmf3Screen[0], pxmf3Screen[2], pxmf3Screen[3] };
+		RasterizeScreenTriangle(pxmf3Fan);
+	}
+	m_nRasterizedTriangles++;
+}
+
+void CSoftwareRasterizer::RasterizeScreenTriangle(const RASTER_FLOAT3 *pxmf3Vertices)
+{
+	RASTER_FLOAT3 v0 = pxmf3Vertices[0], v1 = pxmf3Vertices[1], v2 = pxmf3Vertices[2];
+
+	//  ޽ ̴.   ϳ ߾ 𼭸 Լ ʿ  ǰ Ѵ.
+	float fArea = ((v1.x - v0.x) * (v2.y - v0.y)) - ((v1.y - v0.y) * (v2.x - v0.x));
+	if (fabsf(fArea) < 1.0e-6f) return;
+	if (fArea < 0.0f)
+	{
+		std::swap(v1, v2);
+		fArea = -fArea;
+	}
+
+	int xMin = std::max(0, int(floorf(std::min(v0.x, std::min(v1.x, v2.x)))));
+	int xMax = std::min(OCCLUSION_BUFFER_WIDTH - 1, int(ceilf(std::max(v0.x, std::max(v1.x, v2.x)))));
+	int yMin = std::max(0, int(floorf(std::min(v0.y, std::min(v1.y, v2.y)))));
+	int yMax = std::min(OCCLUSION_BUFFER_HEIGHT - 1, int(ceilf(std::max(v0.y, std::max(v1.y, v2.y)))));
+	if ((xMin > xMax) || (yMin > yMax)) return;
+	xMin &= ~3;
+
+	// 𼭸 Լ E(p) = A * px + B * py + C, ߽ ǥ = E / 
+	float A0 = v1.y - v2.y, B0 = v2.x - v1.x, C0 = (v2.y - v1.y) * v1.x - (v2.x - v1.x) * v1.y;
+	float A1 = v2.y - v0.y, B1 = v0.x - v2.x, C1 = (v0.y - v2.y) * v2.x - (v0.x - v2.x) * v2.y;
+	float A2 = v0.y - v1.y, B2 = v1.x - v0.x, C2 = (v1.y - v0.y) * v0.x - (v1.x - v0.x) * v0.y;
+
+	// ȭ  ̴ ̴.
+	float fInverseArea = 1.0f / fArea;
+	float Az = ((A0 * v0.z) + (A1 * v1.z) + (A2 * v2.z)) * fInverseArea;
+	float Bz = ((B0 * v0.z) + (B1 * v1.z) + (B2 * v2.z)) * fInverseArea;
+	float Cz = ((C0 * v0.z) + (C1 * v1.z) + (C2 * v2.z)) * fInverseArea;
+
+	__m128 xmmX = _mm_add_ps(_mm_set1_ps(float(xMin)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+	__m128 xmmA0 = _mm_set1_ps(A0), xmmA1 = _mm_set1_ps(A1), xmmA2 = _mm_set1_ps(A2), xmmAz = _mm_set1_ps(Az);
+	__m128 xmmStep0 = _mm_set1_ps(A0 * 4.0f), xmmStep1 = _mm_set1_ps(A1 * 4.0f), xmmStep2 = _mm_set1_ps(A2 * 4.0f), xmmStepZ = _mm_set1_ps(Az * 4.0f);
+	__m128 xmmZero = _mm_setzero_ps();
+
+	for (int y = yMin; y <= yMax; y++)
+	{
+		float py = float(y) + 0.5f;
+		__m128 xmmE0 = _mm_add_ps(_mm_mul_ps(xmmA0, xmmX), _mm_set1_ps((B0 * py) + C0));
+		__m128 xmmE1 = _mm_add_ps(_mm_mul_ps(xmmA1, xmmX), _mm_set1_ps((B1 * py) + C1));
+		__m128 xmmE2 = _mm_add_ps(_mm_mul_ps(xmmA2, xmmX), _mm_set1_ps((B2 * py) + C2));
+		__m128 xmmZ = _mm_add_ps(_mm_mul_ps(xmmAz, xmmX), _mm_set1_ps((Bz * py) + Cz));
+
+		float *pfRow = m_ppfDepthLevels[0] + (y * OCCLUSION_BUFFER_WIDTH);
+		for (int x = xMin; x <= xMax; x += 4)
+		{
+			__m128 xmmInside = _mm_cmpge_ps(_mm_min_ps(xmmE0, _mm_min_ps(xmmE1, xmmE2)), xmmZero);
+			if (_mm_movemask_ps(xmmInside))
+			{
+				__m128 xmmDepth = _mm_load_ps(pfRow + x);
+				__m128 xmmNearer = _mm_min_ps(xmmDepth, xmmZ);
+				_mm_store_ps(pfRow + x, _mm_or_ps(_mm_and_ps(xmmInside, xmmNearer), _mm_andnot_ps(xmmInside, xmmDepth)));
+			}
+			xmmE0 = _mm_add_ps(xmmE0, xmmStep0);
+			xmmE1 = _mm_add_ps(xmmE1, xmmStep1);
+			xmmE2 = _mm_add_ps(xmmE2, xmmStep2);
+			xmmZ = _mm_add_ps(xmmZ, xmmStepZ);
+		}
+	}
+}
+
+void CSoftwareRasterizer::BuildHierarchicalDepth()
+{
+	//  ؼ Ʒ  2x2 ؼ    ̴. (Ȧ ũ  ؼ ڸ ݺѴ)
+	for (int l = 1; l < m_nLevels; l++)
+	{
+		const float *pfSource = m_ppfDepthLevels[l - 1];
+		float *pfDestination = m_ppfDepthLevels[l];
+		int nSourceWidth = m_pnLevelWidths[l - 1], nSourceHeight = m_pnLevelHeights[l - 1];
+		for (int y = 0; y < m_pnLevelHeights[l]; y++)
+		{
+			const float *pfRow0 = pfSource + ((y * 2) * nSourceWidth);
+			const float *pfRow1 = pfSource + (std::min((y * 2) + 1, nSourceHeight - 1) * nSourceWidth);
+			for (int x = 0; x < m_pnLevelWidths[l]; x++)
+			{
+				int x0 = x * 2, x1 = std::min(x0 + 1, nSourceWidth - 1);
+				pfDestination[x + (y * m_pnLevelWidths[l])] = std::max(std::max(pfRow0[x0], pfRow0[x1]), std::max(pfRow1[x0], pfRow1[x1]));
+			}
+		}
+	}
+}
+
+bool CSoftwareRasterizer::IsVisible(const RASTER_FLOAT3& xmf3Min, const RASTER_FLOAT3& xmf3Max)
+{
+	m_nTestedBoxes++;
+
+	// 8  4   ȯѴ.
+	const float *m = m_pfViewProjection;
+	__m128 xmmX = _mm_setr_ps(xmf3Min.x, xmf3Max.x, xmf3Min.x, xmf3Max.x);
+	__m128 xmmY = _mm_setr_ps(xmf3Min.y, xmf3Min.y, xmf3Max.y, xmf3Max.y);
+	__m128 xmmMinX = _mm_set1_ps(FLT_MAX), xmmMaxX = _mm_set1_ps(-FLT_MAX);
+	__m128 xmmMinY = _mm_set1_ps(FLT_MAX), xmmMaxY = _mm_set1_ps(-FLT_MAX);
+	__m128 xmmMinZ = _mm_set1_ps(FLT_MAX);
+	int nBehindCorners = 0;
+	for (int k = 0; k < 2; k++)
+	{
+		__m128 xmmZ = _mm_set1_ps((k == 0) ? xmf3Min.z : xmf3Max.z);
+		__m128 xmmClipX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, _mm_set1_ps(m[0])), _mm_mul_ps(xmmY, _mm_set1_ps(m[4]))), _mm_add_ps(_mm_mul_ps(xmmZ, _mm_set1_ps(m[8])), _mm_set1_ps(m[12])));
+		__m128 xmmClipY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, _mm_set1_ps(m[1])), _mm_mul_ps(xmmY, _mm_set1_ps(m[5]))), _mm_add_ps(_mm_mul_ps(xmmZ, _mm_set1_ps(m[9])), _mm_set1_ps(m[13])));
+		__m128 xmmClipZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, _mm_set1_ps(m[2])), _mm_mul_ps(xmmY, _mm_set1_ps(m[6]))), _mm_add_ps(_mm_mul_ps(xmmZ, _mm_set1_ps(m[10])), _mm_set1_ps(m[14])));
+		__m128 xmmClipW = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xmmX, _mm_set1_ps(m[3])), _mm_mul_ps(xmmY, _mm_set1_ps(m[7]))), _mm_add_ps(_mm_mul_ps(xmmZ, _mm_set1_ps(m[11])), _mm_set1_ps(m[15])));
+
+		//       .
+		nBehindCorners |= _mm_movemask_ps(_mm_cmplt_ps(xmmClipZ, _mm_setzero_ps())) << (k * 4);
+		if (nBehindCorners) continue;
+
+		__m128 xmmInverseW = _mm_div_ps(_mm_set1_ps(1.0f), xmmClipW);
+		__m128 xmmNdcX = _mm_mul_ps(xmmClipX, xmmInverseW), xmmNdcY = _mm_mul_ps(xmmClipY, xmmInverseW);
+		xmmMinX = _mm_min_ps(xmmMinX, xmmNdcX); xmmMaxX = _mm_max_ps(xmmMaxX, xmmNdcX);
+		xmmMinY = _mm_min_ps(xmmMinY, xmmNdcY); xmmMaxY = _mm_max_ps(xmmMaxY, xmmNdcY);
+		xmmMinZ = _mm_min_ps(xmmMinZ, _mm_mul_ps(xmmClipZ, xmmInverseW));
+	}
+
+	//  ڿ   ʰ,  鿡   ̴  Ѵ.
+	if (nBehindCorners == 0xFF) return(false);
+	if (nBehindCorners) return(true);
+
+	float fMinX = HorizontalMin(xmmMinX), fMaxX = HorizontalMax(xmmMaxX);
+	float fMinY = HorizontalMin(xmmMinY), fMaxY = HorizontalMax(xmmMaxY);
+	float fMinZ = HorizontalMin(xmmMinZ);
+	if ((fMaxX < -1.0f) || (fMinX > 1.0f) || (fMaxY < -1.0f) || (fMinY > 1.0f) || (fMinZ > 1.0f)) return(false);
+
+	int x0 = std::max(0, std::min(OCCLUSION_BUFFER_WIDTH - 1, int(((fMinX * 0.5f) + 0.5f) * OCCLUSION_BUFFER_WIDTH)));
+	int x1 = std::max(0, std::min(OCCLUSION_BUFFER_WIDTH - 1, int(((fMaxX * 0.5f) + 0.5f) * OCCLUSION_BUFFER_WIDTH)));
+	int y0 = std::max(0, std::min(OCCLUSION_BUFFER_HEIGHT - 1, int((0.5f - (fMaxY * 0.5f)) * OCCLUSION_BUFFER_HEIGHT)));
+	int y1 = std::max(0, std::min(OCCLUSION_BUFFER_HEIGHT - 1, int((0.5f - (fMinY * 0.5f)) * OCCLUSION_BUFFER_HEIGHT)));
+
+	// 簢 2x2 ؼ ϰ Ǵ    ̸ Ѵ.
+	int l = 0;
+	while ((l < m_nLevels - 1) && ((((x1 >> l) - (x0 >> l)) > 1) || (((y1 >> l) - (y0 >> l)) > 1))) l++;
+
+	const float *pfLevel = m_ppfDepthLevels[l];
+	float fMaxDepth = 0.0f;
+	for (int y = (y0 >> l); y <= (y1 >> l); y++)
+	{
+		for (int x = (x0 >> l); x <= (x1 >> l); x++) fMaxDepth = std::max(fMaxDepth, pfLevel[x + (y * m_pnLevelWidths[l])]);
+	}
+
+	if (fMinZ > fMaxDepth)
+	{
+		m_nOccludedBoxes++;
+		return(false);
+	}
+	return(true);
+}
+
+unsigned char CSoftwareRasterizer::DepthToPixel(float fDepth)
+{
+	float fDistance = 1.0f - std::max(0.0f, std::min(1.0f, fDepth));
+	if (fDistance < 1.0e-5f) return(0);
+	return((unsigned char)((255.0f * (1.0f + (log10f(fDistance) / 5.0f))) + 0.5f));
+}
+
+void CSoftwareRasterizer::WriteDepthImage(FILE *pFile)
+{
+	fprintf(pFile, "P5\n%d %d\n255\n", OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
+	std::vector<unsigned char> vnPixels(OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT);
+	for (size_t i = 0; i < vnPixels.size(); i++) vnPixels[i] = DepthToPixel(m_ppfDepthLevels[0][i]);
+	fwrite(vnPixels.data(), 1, vnPixels.size(), pFile);
+}
+
+bool CSoftwareRasterizer::ReadDepthImage(FILE *pFile, std::vector<unsigned char>& vnPixels)
+{
+	// WriteDepthImage()  Ӹ  ϳ ƾ Ѵ.
+	char pszExpected[32], pszHeader[32];
+	int nHeader = snprintf(pszExpected, sizeof(pszExpected), "P5\n%d %d\n255\n", OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
+	if ((fread(pszHeader, 1, nHeader, pFile) != size_t(nHeader)) || (memcmp(pszHeader, pszExpected, nHeader) != 0)) return(false);
+
+	vnPixels.resize(OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT);
+	return(fread(vnPixels.data(), 1, vnPixels.size(), pFile) == vnPixels.size());
+}
+
+unsigned int CSoftwareRasterizer::CountDepthImageMismatches(const std::vector<unsigned char>& vnReference, int nTolerance)
+{
+	if (vnReference.size() != size_t(OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT)) return((unsigned int)(OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT));
+
+	unsigned int nMismatches = 0;
+	for (size_t i = 0; i < vnReference.size(); i++)
+	{
+		if (abs(int(DepthToPixel(m_ppfDepthLevels[0][i])) - int(vnReference[i])) > nTolerance) nMismatches++;
+	}
+	return(nMismatches);
+}
+
+void CSoftwareRasterizer::BuildViewProjection(const RASTER_FLOAT3& xmf3Eye, const RASTER_FLOAT3& xmf3At, float fFovAngleY, float fAspectRatio, float fNearZ, float fFarZ, float *pfViewProjection)
+{
+	RASTER_FLOAT3 xmf3Look = { xmf3At.x - xmf3Eye.x, xmf3At.y - xmf3Eye.y, xmf3At.z - xmf3Eye.z };
+	float fLength = sqrtf((xmf3Look.x * xmf3Look.x) + (xmf3Look.y * xmf3Look.y) + (xmf3Look.z * xmf3Look.z));
+	xmf3Look = { xmf3Look.x / fLength, xmf3Look.y / fLength, xmf3Look.z / fLength };
+	RASTER_FLOAT3 xmf3Right = { xmf3Look.z, 0.0f, -xmf3Look.x };
+	fLength = sqrtf((xmf3Right.x * xmf3Right.x) + (xmf3Right.z * xmf3Right.z));
+	xmf3Right = { xmf3Right.x / fLength, 0.0f, xmf3Right.z / fLength };
+	RASTER_FLOAT3 xmf3Up = { (xmf3Look.y * xmf3Right.z) - (xmf3Look.z * xmf3Right.y), (xmf3Look.z * xmf3Right.x) - (xmf3Look.x * xmf3Right.z), (xmf3Look.x * xmf3Right.y) - (xmf3Look.y * xmf3Right.x) };
+
+	auto Dot = [](const RASTER_FLOAT3& a, const RASTER_FLOAT3& b) { return((a.x * b.x) + (a.y * b.y) + (a.z * b.z)); };
+	float pfView[16] =
+	{
+		xmf3Right.x, xmf3Up.x, xmf3Look.x, 0.0f,
+		xmf3Right.y, xmf3Up.y, xmf3Look.y, 0.0f,
+		xmf3Right.z, xmf3Up.z, xmf3Look.z, 0.0f,
+		-Dot(xmf3Right, xmf3Eye), -Dot(xmf3Up, xmf3Eye), -Dot(xmf3Look, xmf3Eye), 1.0f
+	};
+
+	float fHeight = 1.0f / tanf(fFovAngleY * 0.5f), fRange = fFarZ / (fFarZ - fNearZ);
+	float pfProjection[16] =
+	{
+		fHeight / fAspectRatio, 0.0f, 0.0f, 0.0f,
+		0.0f, fHeight, 0.0f, 0.0f,
+		0.0f, 0.0f, fRange, 1.0f,
+		0.0f, 0.0f, -fRange * fNearZ, 0.0f
+	};
+
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			float fSum = 0.0f;
+			for (int k = 0; k < 4; k++) fSum += pfView[(i * 4) + k] * pfProjection[(k * 4) + j];
+			pfViewProjection[(i * 4) + j] = fSum;
+		}
+	}
+}
+
+const RIDGE_TEST_CASE CSoftwareRasterizer::m_pRidgeCases[OCCLUSION_RIDGE_CASES] =
+{
+	{ "In front of ridge", { 512.0f, 100.0f, 300.0f }, 20.0f, true },
+	{ "Behind ridge", { 512.0f, 100.0f, 800.0f }, 20.0f, false },
+	{ "Above ridge", { 512.0f, 420.0f, 800.0f }, 20.0f, true },
+	{ "Behind camera", { 512.0f, 100.0f, -300.0f }, 20.0f, false },
+};
+
+void CSoftwareRasterizer::BuildRidgeScene(float *pfViewProjection)
+{
+	const int nSize = 129;
+	std::vector<unsigned char> vnHeightMap(nSize * nSize);
+	for (int z = 0; z < nSize; z++)
+	{
+		for (int x = 0; x < nSize; x++)
+		{
+			float fRidge = 240.0f * expf(-((z - 64) * (z - 64)) / 400.0f);
+			float fHills = 20.0f + (10.0f * sinf(x * 0.2f)) + (10.0f * cosf(z * 0.15f));
+			vnHeightMap[x + (z * nSize)] = (unsigned char)(std::min(255.0f, std::max(fRidge, fHills)));
+		}
+	}
+	AddHeightMapOccluder(vnHeightMap.data(), nSize, nSize, { 8.0f, 1.0f, 8.0f });
+
+	BuildViewProjection({ 512.0f, 120.0f, 100.0f }, { 512.0f, 120.0f, 1000.0f }, 60.0f * 3.14159265f / 180.0f, 640.0f / 480.0f, 1.0f, 5000.0f, pfViewProjection);
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// File: SoftwareRasterizer.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+// stdafx.h(Windows, D3D12, DirectXMath)  ȴ. ǥ ̺귯 SSE .
+// (Tests/OcclusionRasterizerTest.cpp  ϸ    )
+#include <xmmintrin.h>
+#include <stdio.h>
+#include <vector>
+
+#define OCCLUSION_BUFFER_WIDTH		256			//4  (  4ȼ ȭѴ)
+#define OCCLUSION_BUFFER_HEIGHT		192
+#define OCCLUSION_MAX_LEVELS		10
+
+#define OCCLUSION_TERRAIN_STEP		8			//  8ĭ   ϳ
+#define OCCLUSION_TERRAIN_BLOCK		4			//  ϳ = 4x4 ģ 簢
+
+#define OCCLUSION_RIDGE_CASES		4
+#define OCCLUSION_REFERENCE_TOLERANCE	2		// ̹ ȼ  ̺ ũ ٸ ġ
+
+// XMFLOAT3, XMFLOAT4 ġ .
+struct RASTER_FLOAT3
+{
+	float							x, y, z;
+};
+
+struct RASTER_FLOAT4
+{
+	float							x, y, z, w;
+};
+
+//   ü ø  ȭѴ.
+struct OCCLUDER_BLOCK
+{
+	RASTER_FLOAT3					m_xmf3Min;
+	RASTER_FLOAT3					m_xmf3Max;
+	unsigned int					m_nFirstIndex;
+	unsigned int					m_nIndices;
+};
+
+// ɼ 鿡  ڿ  
+struct RIDGE_TEST_CASE
+{
+	const char						*m_pszName;
+	RASTER_FLOAT3					m_xmf3Center;
+	float							m_fExtent;
+	bool							m_bVisible;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CPU Ʈ  ȭ.
+//  ޽(ģ  ϰ ǥõ ū ü)   ۿ SSE ȭϰ Hi-Z  ü(2x2    ) .
+// IsVisible() ڸ ȭ鿡 Ͽ  簢  Hi-Z ؼ ̺    ̰ ָ ٰ ǴѴ.
+// ̴ D3D  0( ) ~ 1( )̰,  XMFLOAT4X4    Ծ float[16]̴.
+class CSoftwareRasterizer
+{
+public:
+	CSoftwareRasterizer();
+	~CSoftwareRasterizer();
+
+private:
+	std::vector<RASTER_FLOAT3>		m_vOccluderPositions;
+	std::vector<unsigned int>		m_vOccluderIndices;
+	std::vector<OCCLUDER_BLOCK>		m_vOccluderBlocks;
+
+	std::vector<RASTER_FLOAT4>		m_vClipPositions;
+
+	// 0  ̴.
+	float							*m_ppfDepthLevels[OCCLUSION_MAX_LEVELS];
+	int								m_pnLevelWidths[OCCLUSION_MAX_LEVELS];
+	int								m_pnLevelHeights[OCCLUSION_MAX_LEVELS];
+	int								m_nLevels = 0;
+
+	float							m_pfViewProjection[16];
+
+	unsigned int					m_nRasterizedTriangles = 0;
+	unsigned int					m_nTestedBoxes = 0;
+	unsigned int					m_nOccludedBoxes = 0;
+	double							m_fRenderTime = 0.0;
+
+	void RasterizeTriangle(const RASTER_FLOAT4& xmf4Clip0, const RASTER_FLOAT4& xmf4Clip1, const RASTER_FLOAT4& xmf4Clip2);
+	void RasterizeScreenTriangle(const RASTER_FLOAT3 *pxmf3Vertices);
+	void BuildHierarchicalDepth();
+
+public:
+	void ClearOccluders();
+	//  ǥ ﰢ    ϳ ߰Ѵ.
+	void AddOccluder(const RASTER_FLOAT3 *pxmf3Positions, unsigned int nVertices, const unsigned int *pnIndices, unsigned int nIndices);
+	//   nStep ĭ  ģ ڷ ٿ ߰Ѵ.  ̴ ֺ ĭ ּ ̹Ƿ   ׻ .
+	void AddHeightMapOccluder(const unsigned char *pHeightMapPixels, int nWidth, int nLength, const RASTER_FLOAT3& xmf3Scale, int nStep = OCCLUSION_TERRAIN_STEP);
+	unsigned int GetOccluderTriangles() { return((unsigned int)(m_vOccluderIndices.size() / 3)); }
+
+	//  ۸  ü   ϵ ׸  Hi-Z . ( NULL̸   ׸)
+	void Render(const float *pfViewProjection, const RASTER_FLOAT4 *pxmf4FrustumPlanes);
+	// Render()  - ķ  ǥ ڸ ˻Ѵ. ȭ ̰ų  false.
+	bool IsVisible(const RASTER_FLOAT3& xmf3Min, const RASTER_FLOAT3& xmf3Max);
+
+	const float *GetDepthBuffer() { return(m_ppfDepthLevels[0]); }
+	int GetLevels() { return(m_nLevels); }
+	const float *GetDepthLevel(int nLevel) { return(m_ppfDepthLevels[nLevel]); }
+	int GetLevelWidth(int nLevel) { return(m_pnLevelWidths[nLevel]); }
+	int GetLevelHeight(int nLevel) { return(m_pnLevelHeights[nLevel]); }
+
+	unsigned int GetRasterizedTriangles() { return(m_nRasterizedTriangles); }
+	unsigned int GetTestedBoxes() { return(m_nTestedBoxes); }
+	unsigned int GetOccludedBoxes() { return(m_nOccludedBoxes); }
+	double GetRenderTime() { return(m_fRenderTime); }
+	void ResetCounters() { m_nTestedBoxes = m_nOccludedBoxes = 0; }
+
+	//   ̴ κ 1 Ƿ log10(1 - ) [-5, 0] [0, 255] ģ. ( )
+	static unsigned char DepthToPixel(float fDepth);
+
+	//  ۸ 8Ʈ PGM(P5) ̹  д´.   ũⰡ  ۿ ٸ false.
+	void WriteDepthImage(FILE *pFile);
+	static bool ReadDepthImage(FILE *pFile, std::vector<unsigned char>& vnPixels);
+	// DepthToPixel()  ۰  ̹ nTolerance ũ ٸ ȼ 
+	unsigned int CountDepthImageMismatches(const std::vector<unsigned char>& vnReference, int nTolerance = OCCLUSION_REFERENCE_TOLERANCE);
+
+	// XMMatrixLookAtLH() * XMMatrixPerspectiveFovLH()    Ծ  ( (0, 1, 0))
+	static void BuildViewProjection(const RASTER_FLOAT3& xmf3Eye, const RASTER_FLOAT3& xmf3At, float fFovAngleY, float fAspectRatio, float fNearZ, float fFarZ, float *pfViewProjection);
+
+	//  ̹ : 129x129     ̷ z = 512 ó   ɼ ְ, ī޶ ɼ տ ɼ .
+	//  ޽ ߰ϰ ī޶ -  ش. (COcclusionCuller::RunReferenceTest() Tests/OcclusionRasterizerTest.cpp  )
+	void BuildRidgeScene(float *pfViewProjection);
+	static const RIDGE_TEST_CASE m_pRidgeCases[OCCLUSION_RIDGE_CASES];
+};
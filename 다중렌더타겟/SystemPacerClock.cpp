@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// File: SystemPacerClock.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "SystemPacerClock.h"
+
+#pragma comment(lib, "winmm.lib")
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION	0x00000002
+#endif
+
+CSystemPacerClock::CSystemPacerClock()
+{
+	// Windows 10 1803 ִ ػ Ÿ̸Ӹ ,  Ÿ̸ ػ󵵸 1ms ø ::Sleep() .
+	m_hTimer = ::CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!m_hTimer) m_bTimerPeriod = (::timeBeginPeriod(1) == TIMERR_NOERROR);
+}
+
+CSystemPacerClock::~CSystemPacerClock()
+{
+	if (m_hTimer) ::CloseHandle(m_hTimer);
+	if (m_bTimerPeriod) ::timeEndPeriod(1);
+}
+
+int64_t CSystemPacerClock::GetTime()
+{
+	return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void CSystemPacerClock::Sleep(int64_t nTime)
+{
+	if (m_hTimer)
+	{
+		LARGE_INTEGER nDueTime;
+		nDueTime.QuadPart = -((nTime + 99) / 100);		//100ns ,  ݺ  ð
+		if (::SetWaitableTimer(m_hTimer, &nDueTime, 0, NULL, NULL, FALSE))
+		{
+			::WaitForSingleObject(m_hTimer, INFINITE);
+			return;
+		}
+	}
+	::Sleep(DWORD((nTime + 999999) / 1000000));
+}
+
+void CSystemPacerClock::Spin()
+{
+	YieldProcessor();
+}
+
+bool GetDisplayRefreshRate(UINT *pnNumerator, UINT *pnDenominator)
+{
+	DEVMODE dmDisplay;
+	::ZeroMemory(&dmDisplay, sizeof(DEVMODE));
+	dmDisplay.dmSize = sizeof(DEVMODE);
+	// 0 1 ϵ ⺻̶ ̴.
+	if (!::EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &dmDisplay) || (dmDisplay.dmDisplayFrequency <= 1)) return(false);
+
+	UINT nFrequency = dmDisplay.dmDisplayFrequency;
+	if ((((nFrequency + 1) % 24) == 0) || (((nFrequency + 1) % 30) == 0))
+	{
+		*pnNumerator = (nFrequency + 1) * 1000;
+		*pnDenominator = 1001;
+	}
+	else
+	{
+		*pnNumerator = nFrequency;
+		*pnDenominator = 1;
+	}
+	return(true);
+}
+
+bool RunFramePacerTest(LPCTSTR pszFileName)
+{
+	std::string strReport;
+	bool bPassed = CFramePacer::RunFakeClockTest(&strReport);
+
+	//  ð  Ȯ (踶 ٸǷ ˻ ʰ ˸⸸ Ѵ)
+	{
+		CFramePacer xFramePacer(new CSystemPacerClock());
+		xFramePacer.SetTargetFrameRate(60.0f);
+		for (int i = 0; i < 10; i++) xFramePacer.WaitForNextFrame();
+		xFramePacer.ResetStats();
+		for (int i = 0; i < 60; i++) xFramePacer.WaitForNextFrame();
+		char pstrLine[256];
+		sprintf_s(pstrLine, 256, " System clock 60 fps: lateness %.4f ms (jitter %.4f, max %.4f), spinning %.1f%% of wait\n", xFramePacer.GetMeanLateness(), xFramePacer.GetLatenessJitter(),
+			xFramePacer.GetStats().m_nMaxLateness * 1.0e-6, xFramePacer.GetSpinFraction() * 100.0f);
+		strReport += pstrLine;
+	}
+	::OutputDebugStringA(strReport.c_str());
+
+	FILE *pFile = NULL;
+	_tfopen_s(&pFile, pszFileName, _T("wt"));
+	if (pFile)
+	{
+		fputs(strReport.c_str(), pFile);
+		fclose(pFile);
+	}
+	return(bPassed);
+}
@@ -0,0 +1,32 @@
+//-----------------------------------------------------------------------------
+// File: SystemPacerClock.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "FramePacer.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// steady_clock ػ  Ÿ̸( timeBeginPeriod(1) + ::Sleep())  Windows ð
+class CSystemPacerClock : public CPacerClock
+{
+public:
+	CSystemPacerClock();
+	virtual ~CSystemPacerClock();
+
+private:
+	HANDLE							m_hTimer = NULL;			//ػ  Ÿ̸ ( ::Sleep() )
+	bool							m_bTimerPeriod = false;
+
+public:
+	virtual int64_t GetTime();
+	virtual void Sleep(int64_t nTime);
+	virtual void Spin();
+};
+
+// EnumDisplaySettings()  ÷  Ѵ. (59, 119ó  ˷ ִ NTSC  x000/1001 ٲ۴)
+extern bool GetDisplayRefreshRate(UINT *pnNumerator, UINT *pnDenominator);
+
+// CFramePacer::RunFakeClockTest()  ý ð  Ȯ  ϰ  ¿ .
+// (¥ ð ˻ Tests/FramePacerTest.cpp  ȴ)
+extern bool RunFramePacerTest(LPCTSTR pszFileName);
@@ -0,0 +1,19 @@
+//-----------------------------------------------------------------------------
+// File: FramePacerTest.cpp
+//-----------------------------------------------------------------------------
+
+// CFramePacer  ׽Ʈ. stdafx.h ý ð  ¥ ð ǹǷ Windows ƴϾ ȴ.
+//  ˻簡  1 ȯѴ. ( ȿ Insert Ű ý ð   FramePacerTest.txt )
+
+#include "../FramePacer.h"
+
+#include <stdio.h>
+
+int main()
+{
+	std::string strReport;
+	bool bPassed = CFramePacer::RunFakeClockTest(&strReport);
+	fputs(strReport.c_str(), stdout);
+
+	return(bPassed ? 0 : 1);
+}
@@ -0,0 +1,19 @@
+//-----------------------------------------------------------------------------
+// File: GpuTimerTest.cpp
+//-----------------------------------------------------------------------------
+
+// CGpuTimestampRing  ׽Ʈ. stdafx.h d3d12.h  ¥ 鿣 ǹǷ Windows ƴϾ ȴ.
+//  ˻簡  1 ȯѴ. ( ȿ F5  ˻縦 GpuTimerTest.txt )
+
+#include "../GpuTimestampRing.h"
+
+#include <stdio.h>
+
+int main()
+{
+	std::string strReport;
+	bool bPassed = CGpuTimestampRing::RunMockTest(&strReport);
+	fputs(strReport.c_str(), stdout);
+
+	return(bPassed ? 0 : 1);
+}
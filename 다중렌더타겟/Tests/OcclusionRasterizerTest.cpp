@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+// File: OcclusionRasterizerTest.cpp
+//-----------------------------------------------------------------------------
+
+// CSoftwareRasterizer  ׽Ʈ. stdafx.h DirectXMath  ǹǷ Windows ƴϾ ȴ.
+//  ˻簡  1 ȯѴ. ù ° ڴ  ̹ ̴. ( ȿ F7 COcclusionCuller::RunReferenceTest())
+
+#include "../SoftwareRasterizer.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+
+static int gnFailures = 0;
+
+static void Check(bool bPassed, const char *pszName)
+{
+	printf("%-44s %s\n", pszName, bPassed ? "OK" : "FAIL");
+	if (!bPassed) gnFailures++;
+}
+
+static bool IsBoxVisible(CSoftwareRasterizer *pRasterizer, const RASTER_FLOAT3& xmf3Center, float fExtent)
+{
+	RASTER_FLOAT3 xmf3Min = { xmf3Center.x - fExtent, xmf3Center.y - fExtent, xmf3Center.z - fExtent };
+	RASTER_FLOAT3 xmf3Max = { xmf3Center.x + fExtent, xmf3Center.y + fExtent, xmf3Center.z + fExtent };
+	return(pRasterizer->IsVisible(xmf3Min, xmf3Max));
+}
+
+// COcclusionCuller::RunReferenceTest()  ɼ 
+static void TestTerrainRidge()
+{
+	CSoftwareRasterizer *pRasterizer = new CSoftwareRasterizer();
+	float pfViewProjection[16];
+	pRasterizer->BuildRidgeScene(pfViewProjection);
+	pRasterizer->Render(pfViewProjection, NULL);
+
+	Check(pRasterizer->GetRasterizedTriangles() > 0, "Ridge: triangles rasterized");
+	char pszName[64];
+	for (const RIDGE_TEST_CASE& xCase : CSoftwareRasterizer::m_pRidgeCases)
+	{
+		snprintf(pszName, sizeof(pszName), "Ridge: %s is %s", xCase.m_pszName, xCase.m_bVisible ? "visible" : "hidden");
+		Check(IsBoxVisible(pRasterizer, xCase.m_xmf3Center, xCase.m_fExtent) == xCase.m_bVisible, pszName);
+	}
+	Check(pRasterizer->GetOccludedBoxes() == 1, "Ridge: only the hidden box is counted occluded");
+
+	// Hi-Z  ؼ Ʒ  2x2 ؼ    ̴.
+	bool bConservative = true;
+	for (int l = 1; l < pRasterizer->GetLevels(); l++)
+	{
+		const float *pfSource = pRasterizer->GetDepthLevel(l - 1), *pfLevel = pRasterizer->GetDepthLevel(l);
+		int nSourceWidth = pRasterizer->GetLevelWidth(l - 1), nSourceHeight = pRasterizer->GetLevelHeight(l - 1);
+		for (int y = 0; y < nSourceHeight; y++)
+		{
+			for (int x = 0; x < nSourceWidth; x++)
+			{
+				if (pfLevel[(x / 2) + ((y / 2) * pRasterizer->GetLevelWidth(l))] < pfSource[x + (y * nSourceWidth)]) bConservative = false;
+			}
+		}
+	}
+	Check(bConservative, "Ridge: Hi-Z levels are never nearer than level 0");
+
+	delete pRasterizer;
+}
+
+// ī޶  z = 100 ȭ  簢 ϳ    ׸.
+static void TestFullScreenQuad()
+{
+	const float fNearZ = 1.0f, fFarZ = 1000.0f, fQuadZ = 100.0f;
+	float pfViewProjection[16];
+	CSoftwareRasterizer::BuildViewProjection({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 3.14159265f / 2.0f, 4.0f / 3.0f, fNearZ, fFarZ, pfViewProjection);
+
+	RASTER_FLOAT3 pxmf3Quad[4] = { { -500.0f, -500.0f, fQuadZ }, { 500.0f, -500.0f, fQuadZ }, { -500.0f, 500.0f, fQuadZ }, { 500.0f, 500.0f, fQuadZ } };
+	unsigned int pnClockwise[6] = { 0, 2, 1, 1, 2, 3 };
+	unsigned int pnCounterClockwise[6] = { 0, 1, 2, 1, 3, 2 };
+
+	CSoftwareRasterizer *pClockwise = new CSoftwareRasterizer();
+	pClockwise->AddOccluder(pxmf3Quad, 4, pnClockwise, 6);
+	pClockwise->Render(pfViewProjection, NULL);
+
+	CSoftwareRasterizer *pCounterClockwise = new CSoftwareRasterizer();
+	pCounterClockwise->AddOccluder(pxmf3Quad, 4, pnCounterClockwise, 6);
+	pCounterClockwise->Render(pfViewProjection, NULL);
+
+	float fExpectedDepth = (fFarZ / (fFarZ - fNearZ)) * (1.0f - (fNearZ / fQuadZ));
+	const float *pfDepth = pClockwise->GetDepthBuffer();
+	bool bCovered = true, bSameWinding = true;
+	for (int i = 0; i < OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT; i++)
+	{
+		if (fabsf(pfDepth[i] - fExpectedDepth) > 1.0e-4f) bCovered = false;
+		if (pfDepth[i] != pCounterClockwise->GetDepthBuffer()[i]) bSameWinding = false;
+	}
+	Check(bCovered, "Quad: every pixel has the plane depth");
+	Check(bSameWinding, "Quad: both windings give the same depth");
+	Check(fabsf(pClockwise->GetDepthLevel(pClockwise->GetLevels() - 1)[0] - fExpectedDepth) < 1.0e-4f, "Quad: top Hi-Z level has the plane depth");
+
+	Check(IsBoxVisible(pClockwise, { 0.0f, 0.0f, 50.0f }, 5.0f), "Quad: box in front is visible");
+	Check(!IsBoxVisible(pClockwise, { 0.0f, 0.0f, 200.0f }, 5.0f), "Quad: box behind is hidden");
+	Check(IsBoxVisible(pClockwise, { 0.0f, 0.0f, 100.0f }, 5.0f), "Quad: box crossing the quad is visible");
+
+	delete pClockwise;
+	delete pCounterClockwise;
+}
+
+// ī޶ ڱ ̾ ٴ  鿡 ߷ Ѵ.
+static void TestNearPlaneClipping()
+{
+	float pfViewProjection[16];
+	CSoftwareRasterizer::BuildViewProjection({ 0.0f, 10.0f, 0.0f }, { 0.0f, 10.0f, 1.0f }, 3.14159265f / 2.0f, 4.0f / 3.0f, 1.0f, 1000.0f, pfViewProjection);
+
+	RASTER_FLOAT3 pxmf3Ground[4] = { { -1000.0f, 0.0f, -1000.0f }, { 1000.0f, 0.0f, -1000.0f }, { -1000.0f, 0.0f, 1000.0f }, { 1000.0f, 0.0f, 1000.0f } };
+	unsigned int pnIndices[6] = { 0, 2, 1, 1, 2, 3 };
+
+	CSoftwareRasterizer *pRasterizer = new CSoftwareRasterizer();
+	pRasterizer->AddOccluder(pxmf3Ground, 4, pnIndices, 6);
+	pRasterizer->Render(pfViewProjection, NULL);
+
+	const float *pfDepth = pRasterizer->GetDepthBuffer();
+	bool bInRange = true;
+	for (int i = 0; i < OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT; i++)
+	{
+		if ((pfDepth[i] < 0.0f) || (pfDepth[i] > 1.0f)) bInRange = false;
+	}
+	Check(bInRange, "Clip: depth stays in [0, 1]");
+	Check(pfDepth[(OCCLUSION_BUFFER_HEIGHT - 1) * OCCLUSION_BUFFER_WIDTH] < 1.0f, "Clip: ground covers the bottom row");
+	Check(pfDepth[0] == 1.0f, "Clip: sky in the top row stays clear");
+	Check(!IsBoxVisible(pRasterizer, { 0.0f, -20.0f, 100.0f }, 5.0f), "Clip: box under the ground is hidden");
+	Check(IsBoxVisible(pRasterizer, { 0.0f, 10.0f, 100.0f }, 5.0f), "Clip: box above the ground is visible");
+
+	delete pRasterizer;
+}
+
+// ɼ   ۸ ҿ ִ  ̹(Tests/OcclusionReference.pgm) Ѵ.
+// 2 ܰ躸 ũ ٸ ȼ 0.1% Ѱų  ̹  ̴.
+static void TestReferenceImage(const char *pszReferenceFileName)
+{
+	CSoftwareRasterizer *pRasterizer = new CSoftwareRasterizer();
+	float pfViewProjection[16];
+	pRasterizer->BuildRidgeScene(pfViewProjection);
+	pRasterizer->Render(pfViewProjection, NULL);
+
+	std::vector<unsigned char> vnReference;
+	FILE *pFile = fopen(pszReferenceFileName, "rb");
+	bool bRead = pFile && CSoftwareRasterizer::ReadDepthImage(pFile, vnReference);
+	if (pFile) fclose(pFile);
+	Check(bRead, "Reference: image is readable");
+
+	if (bRead)
+	{
+		unsigned int nMismatches = pRasterizer->CountDepthImageMismatches(vnReference);
+		printf("Reference: %u/%u pixels differ\n", nMismatches, (unsigned int)vnReference.size());
+		Check(nMismatches <= (unsigned int)(vnReference.size() / 1000), "Reference: depth matches the image");
+	}
+
+	delete pRasterizer;
+}
+
+int main(int argc, char *argv[])
+{
+	TestTerrainRidge();
+	TestReferenceImage((argc > 1) ? argv[1] : "OcclusionReference.pgm");
+	TestFullScreenQuad();
+	TestNearPlaneClipping();
+
+	printf("Occlusion Rasterizer Test: %s\n", (gnFailures == 0) ? "PASSED" : "FAILED");
+	return((gnFailures == 0) ? 0 : 1);
+}
@@ -5,112 +5,237 @@
 #include "stdafx.h"
 #include "Timer.h"
 
-CGameTimer::CGameTimer()
+inline __int64 GetMonotonicTime()
 {
-	::QueryPerformanceFrequency((LARGE_INTEGER *)&m_nPerformanceFrequencyPerSec);
-	::QueryPerformanceCounter((LARGE_INTEGER *)&m_nLastPerformanceCounter); 
-	m_fTimeScale = 1.0 / (double)m_nPerformanceFrequencyPerSec;
+	return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
 
-	m_nBasePerformanceCounter = m_nLastPerformanceCounter;
-	m_nPausedPerformanceCounter = 0;
-	m_nStopPerformanceCounter = 0;
+// 2^TIMER_HISTOGRAM_SUB_BITS ̸ 1us ,  δ 2 ŵ     .
+inline UINT GetHistogramBucket(float fTimeElapsed)
+{
+	float fMicroseconds = fTimeElapsed * 1.0e6f;
+	UINT nMicroseconds = (fMicroseconds < 4.0e9f) ? UINT(fMicroseconds) : 0xFFFFFFFF;
+	if (nMicroseconds < TIMER_HISTOGRAM_SUB_BUCKETS) return(nMicroseconds);
+
+	UINT nExponent = 0;
+	for (UINT n = nMicroseconds; n >>= 1; ) nExponent++;
+	UINT nBucket = (nExponent - TIMER_HISTOGRAM_SUB_BITS + 1) * TIMER_HISTOGRAM_SUB_BUCKETS + ((nMicroseconds >> (nExponent - TIMER_HISTOGRAM_SUB_BITS)) - TIMER_HISTOGRAM_SUB_BUCKETS);
+	return(min(nBucket, UINT(TIMER_HISTOGRAM_BUCKETS - 1)));
+}
 
-	m_nSampleCount = 0;
+//    ()
+inline float GetHistogramBucketTime(UINT nBucket)
+{
+	if (nBucket < TIMER_HISTOGRAM_SUB_BUCKETS) return((nBucket + 0.5f) * 1.0e-6f);
+
+	UINT nExponent = (nBucket / TIMER_HISTOGRAM_SUB_BUCKETS) + TIMER_HISTOGRAM_SUB_BITS - 1;
+	UINT nSubBucket = nBucket % TIMER_HISTOGRAM_SUB_BUCKETS;
+	float fWidth = float(1 << (nExponent - TIMER_HISTOGRAM_SUB_BITS));
+	float fLower = (TIMER_HISTOGRAM_SUB_BUCKETS + nSubBucket) * fWidth;
+	return((fLower + fWidth * 0.5f) * 1.0e-6f);
+}
+
+inline float GetHistogramPercentile(const UINT *pnHistogram, UINT64 nSamples, float fPercentile)
+{
+	if (nSamples == 0) return(0.0f);
+	UINT64 nRank = UINT64(double(fPercentile) * nSamples + 0.5);
+	if (nRank < 1) nRank = 1;
+	UINT64 nCount = 0;
+	for (UINT i = 0; i < TIMER_HISTOGRAM_BUCKETS; i++)
+	{
+		nCount += pnHistogram[i];
+		if (nCount >= nRank) return(GetHistogramBucketTime(i));
+	}
+	return(GetHistogramBucketTime(TIMER_HISTOGRAM_BUCKETS - 1));
+}
+
+CGameTimer::CGameTimer() : m_FramePacer(new CSystemPacerClock())
+{
+	m_nLastTime = GetMonotonicTime();
+	m_fTimeScale = 1.0e-9;
+
+	m_nBaseTime = m_nLastTime;
+	m_nCurrentTime = m_nLastTime;
+	m_nPausedTime = 0;
+	m_nStopTime = 0;
+
+	m_fTimeElapsed = 0.0f;
 	m_nCurrentFrameRate = 0;
 	m_nFramesPerSecond = 0;
 	m_fFPSTimeElapsed = 0.0f;
+
+	ResetSamples();
 }
 
 CGameTimer::~CGameTimer()
 {
 }
 
+void CGameTimer::ResetSamples()
+{
+	m_nSampleCount = 0;
+	m_nNextSample = 0;
+	m_fSampleSum = 0.0;
+
+	m_nWindowSamples = 0;
+	m_nNextWindowSample = 0;
+	m_nWindowHitches = 0;
+	::memset(m_pnWindowHistogram, 0, sizeof(m_pnWindowHistogram));
+
+	m_nSessionSamples = 0;
+	m_nSessionHitches = 0;
+	::memset(m_pnSessionHistogram, 0, sizeof(m_pnSessionHistogram));
+}
+
+void CGameTimer::AddSample(float fTimeElapsed)
+{
+	//  Ƣ       ִ´. (  ̹Ƿ)
+    if (fabsf(fTimeElapsed - m_fTimeElapsed) < 1.0f)
+    {
+		if (m_nSampleCount == MAX_SAMPLE_COUNT) m_fSampleSum -= m_fFrameTime[m_nNextSample];
+		else m_nSampleCount++;
+		m_fFrameTime[m_nNextSample] = fTimeElapsed;
+		m_fSampleSum += fTimeElapsed;
+		m_nNextSample = (m_nNextSample + 1) % MAX_SAMPLE_COUNT;
+    }
+
+	//    ֱ   ߾Ӱ Ѵ.
+	bool bHitch = false;
+	if (m_nWindowSamples >= TIMER_HITCH_MIN_SAMPLES)
+	{
+		float fMedian = GetHistogramPercentile(m_pnWindowHistogram, m_nWindowSamples, 0.5f);
+		bHitch = (fTimeElapsed > TIMER_HITCH_MIN_TIME) && (fTimeElapsed > fMedian * TIMER_HITCH_FACTOR);
+	}
+
+	if (m_nWindowSamples == TIMER_WINDOW_SAMPLES)
+	{
+		m_pnWindowHistogram[GetHistogramBucket(m_pfWindowFrameTimes[m_nNextWindowSample])]--;
+		if (m_pbWindowHitches[m_nNextWindowSample]) m_nWindowHitches--;
+	}
+	else
+	{
+		m_nWindowSamples++;
+	}
+	UINT nBucket = GetHistogramBucket(fTimeElapsed);
+	m_pfWindowFrameTimes[m_nNextWindowSample] = fTimeElapsed;
+	m_pbWindowHitches[m_nNextWindowSample] = bHitch;
+	m_pnWindowHistogram[nBucket]++;
+	m_nNextWindowSample = (m_nNextWindowSample + 1) % TIMER_WINDOW_SAMPLES;
+
+	m_pnSessionHistogram[nBucket]++;
+	m_nSessionSamples++;
+	if (bHitch)
+	{
+		m_nWindowHitches++;
+		m_nSessionHitches++;
+	}
+}
+
 void CGameTimer::Tick(float fLockFPS)
 {
 	if (m_bStopped)
 	{
 		m_fTimeElapsed = 0.0f;
+		m_fFrameTimeElapsed = 0.0f;
 		return;
 	}
 	float fTimeElapsed;
 
-	::QueryPerformanceCounter((LARGE_INTEGER *)&m_nCurrentPerformanceCounter);
-	fTimeElapsed = float((m_nCurrentPerformanceCounter - m_nLastPerformanceCounter) * m_fTimeScale);
+	//  ð 鼭 ٸ ʰ κ . (CFramePacer)
+	if (fLockFPS > 0.0f) m_FramePacer.SetTargetFrameRate(fLockFPS);
+	m_nCurrentTime = (m_FramePacer.IsEnabled()) ? m_FramePacer.WaitForNextFrame() : GetMonotonicTime();
+	fTimeElapsed = float((m_nCurrentTime - m_nLastTime) * m_fTimeScale);
 
-    if (fLockFPS > 0.0f)
-    {
-        while (fTimeElapsed < (1.0f / fLockFPS))
-        {
-	        ::QueryPerformanceCounter((LARGE_INTEGER *)&m_nCurrentPerformanceCounter);
-	        fTimeElapsed = float((m_nCurrentPerformanceCounter - m_nLastPerformanceCounter) * m_fTimeScale);
-        }
-    } 
+	m_nLastTime = m_nCurrentTime;
+	m_fFrameTimeElapsed = fTimeElapsed;
 
-	m_nLastPerformanceCounter = m_nCurrentPerformanceCounter;
-
-    if (fabsf(fTimeElapsed - m_fTimeElapsed) < 1.0f)
-    {
-        ::memmove(&m_fFrameTime[1], m_fFrameTime, (MAX_SAMPLE_COUNT - 1) * sizeof(float));
-        m_fFrameTime[0] = fTimeElapsed;
-        if (m_nSampleCount < MAX_SAMPLE_COUNT) m_nSampleCount++;
-    }
+	AddSample(fTimeElapsed);
 
 	m_nFramesPerSecond++;
 	m_fFPSTimeElapsed += fTimeElapsed;
-	if (m_fFPSTimeElapsed > 1.0f) 
+	if (m_fFPSTimeElapsed > 1.0f)
     {
 		m_nCurrentFrameRate	= m_nFramesPerSecond;
 		m_nFramesPerSecond = 0;
 		m_fFPSTimeElapsed = 0.0f;
-	} 
+	}
 
-    m_fTimeElapsed = 0.0f;
-    for (ULONG i = 0; i < m_nSampleCount; i++) m_fTimeElapsed += m_fFrameTime[i];
-    if (m_nSampleCount > 0) m_fTimeElapsed /= m_nSampleCount;
+	m_fTimeElapsed = (m_nSampleCount > 0) ? float(m_fSampleSum / m_nSampleCount) : 0.0f;
 }
 
-unsigned long CGameTimer::GetFrameRate(LPTSTR lpszString, int nCharacters) 
+unsigned long CGameTimer::GetFrameRate(LPTSTR lpszString, int nCharacters)
 {
     if (lpszString)
     {
         _itow_s(m_nCurrentFrameRate, lpszString, nCharacters, 10);
         wcscat_s(lpszString, nCharacters, _T(" FPS)"));
-    } 
+    }
 
     return(m_nCurrentFrameRate);
 }
 
-float CGameTimer::GetTimeElapsed() 
+float CGameTimer::GetTimeElapsed()
 {
     return(m_fTimeElapsed);
 }
 
+float CGameTimer::GetPercentile(float fPercentile, bool bSession)
+{
+	if (bSession) return(GetHistogramPercentile(m_pnSessionHistogram, m_nSessionSamples, fPercentile));
+	return(GetHistogramPercentile(m_pnWindowHistogram, m_nWindowSamples, fPercentile));
+}
+
+float CGameTimer::GetWorstFrameTime(UINT nFrames)
+{
+	nFrames = min(nFrames, m_nWindowSamples);
+	float fWorst = 0.0f;
+	for (UINT i = 1; i <= nFrames; i++)
+	{
+		fWorst = max(fWorst, m_pfWindowFrameTimes[(m_nNextWindowSample + TIMER_WINDOW_SAMPLES - i) % TIMER_WINDOW_SAMPLES]);
+	}
+	return(fWorst);
+}
+
+UINT CGameTimer::GetHitches(UINT nFrames)
+{
+	if (nFrames >= m_nWindowSamples) return(m_nWindowHitches);
+	UINT nHitches = 0;
+	for (UINT i = 1; i <= nFrames; i++)
+	{
+		if (m_pbWindowHitches[(m_nNextWindowSample + TIMER_WINDOW_SAMPLES - i) % TIMER_WINDOW_SAMPLES]) nHitches++;
+	}
+	return(nHitches);
+}
+
 float CGameTimer::GetTotalTime()
 {
-	if (m_bStopped) return(float(((m_nStopPerformanceCounter - m_nPausedPerformanceCounter) - m_nBasePerformanceCounter) * m_fTimeScale));
-	return(float(((m_nCurrentPerformanceCounter - m_nPausedPerformanceCounter) - m_nBasePerformanceCounter) * m_fTimeScale));
+	if (m_bStopped) return(float(((m_nStopTime - m_nPausedTime) - m_nBaseTime) * m_fTimeScale));
+	return(float(((m_nCurrentTime - m_nPausedTime) - m_nBaseTime) * m_fTimeScale));
 }
 
 void CGameTimer::Reset()
 {
-	__int64 nPerformanceCounter;
-	::QueryPerformanceCounter((LARGE_INTEGER*)&nPerformanceCounter);
+	__int64 nTime = GetMonotonicTime();
 
-	m_nBasePerformanceCounter = nPerformanceCounter;
-	m_nLastPerformanceCounter = nPerformanceCounter;
-	m_nStopPerformanceCounter = 0;
+	m_nBaseTime = nTime;
+	m_nLastTime = nTime;
+	m_nCurrentTime = nTime;
+	m_nPausedTime = 0;
+	m_nStopTime = 0;
 	m_bStopped = false;
+
+	// εó Reset()  ɸ ð   ʴ´.
+	ResetSamples();
 }
 
 void CGameTimer::Start()
 {
-	__int64 nPerformanceCounter;
-	::QueryPerformanceCounter((LARGE_INTEGER *)&nPerformanceCounter);
+	__int64 nTime = GetMonotonicTime();
 	if (m_bStopped)
 	{
-		m_nPausedPerformanceCounter += (nPerformanceCounter - m_nStopPerformanceCounter);
-		m_nLastPerformanceCounter = nPerformanceCounter;
-		m_nStopPerformanceCounter = 0;
+		m_nPausedTime += (nTime - m_nStopTime);
+		m_nLastTime = nTime;
+		m_nStopTime = 0;
 		m_bStopped = false;
 	}
 }
@@ -119,7 +244,7 @@ void CGameTimer::Stop()
 {
 	if (!m_bStopped)
 	{
-		::QueryPerformanceCounter((LARGE_INTEGER *)&m_nStopPerformanceCounter);
+		m_nStopTime = GetMonotonicTime();
 		m_bStopped = true;
 	}
 }
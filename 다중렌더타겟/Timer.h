@@ -3,14 +3,31 @@
 // File: CGameTimer.h
 //-----------------------------------------------------------------------------
 
+#include "SystemPacerClock.h"
+
 const ULONG MAX_SAMPLE_COUNT = 50; // Maximum frame time sample count
 
+//  ð  ֱ TIMER_WINDOW_SAMPLES (̵ ) Reset()  ü()   .
+#define TIMER_WINDOW_SAMPLES			1024
+
+// α  ׷ (ũ). 2 ŵ  2^TIMER_HISTOGRAM_SUB_BITS Ƿ    3%̴.
+#define TIMER_HISTOGRAM_SUB_BITS		5
+#define TIMER_HISTOGRAM_SUB_BUCKETS		(1 << TIMER_HISTOGRAM_SUB_BITS)
+#define TIMER_HISTOGRAM_MAX_EXPONENT	25			//2^25us( 33)     ִ´
+#define TIMER_HISTOGRAM_BUCKETS			((TIMER_HISTOGRAM_MAX_EXPONENT - TIMER_HISTOGRAM_SUB_BITS + 1) * TIMER_HISTOGRAM_SUB_BUCKETS)
+
+//  ߾Ӱ TIMER_HITCH_FACTOR ̻  TIMER_HITCH_MIN_TIME   (hitch) .
+#define TIMER_HITCH_FACTOR				2.0f
+#define TIMER_HITCH_MIN_TIME			(1.0f / 60.0f)
+#define TIMER_HITCH_MIN_SAMPLES			30			// ̸ŭ ̱   ʴ´
+
 class CGameTimer
 {
 public:
 	CGameTimer();
 	virtual ~CGameTimer();
 
+	// fLockFPS 0 ũ  ̼ ǥ   ٲ۴. ̼ ǥ    ۱ ٸ.
 	void Tick(float fLockFPS = 0.0f);
 	void Start();
 	void Stop();
@@ -18,26 +35,59 @@ public:
 
     unsigned long GetFrameRate(LPTSTR lpszString = NULL, int nCharacters=0);
     float GetTimeElapsed();
+	//       ð 
+	float GetFrameTimeElapsed() { return(m_fFrameTimeElapsed); }
 	float GetTotalTime();
 
-private:
-	double							m_fTimeScale;						
-	float							m_fTimeElapsed;		
+	//  ð  (fPercentile 0~1, ). bSession̸ Reset()  ü, ƴϸ ֱ  Ѵ.
+	float GetPercentile(float fPercentile, bool bSession = false);
+	// ֱ nFrames (ִ TIMER_WINDOW_SAMPLES)     ð  
+	float GetWorstFrameTime(UINT nFrames = TIMER_WINDOW_SAMPLES);
+	UINT GetHitches(UINT nFrames = TIMER_WINDOW_SAMPLES);
+	UINT GetSessionHitches() { return(m_nSessionHitches); }
+	UINT GetWindowSamples() { return(m_nWindowSamples); }
+	UINT64 GetSessionSamples() { return(m_nSessionSamples); }
 
-	__int64							m_nBasePerformanceCounter;
-	__int64							m_nPausedPerformanceCounter;
-	__int64							m_nStopPerformanceCounter;
-	__int64							m_nCurrentPerformanceCounter;
-    __int64							m_nLastPerformanceCounter;
+	CFramePacer *GetFramePacer() { return(&m_FramePacer); }
 
-	__int64							m_nPerformanceFrequencyPerSec;				
+private:
+	double							m_fTimeScale;
+	float							m_fTimeElapsed;
+	float							m_fFrameTimeElapsed = 0.0f;
 
+	// steady_clock . (QueryPerformanceCounter ޸  ÷  Ѵ)
+	__int64							m_nBaseTime;
+	__int64							m_nPausedTime;
+	__int64							m_nStopTime;
+	__int64							m_nCurrentTime;
+    __int64							m_nLastTime;
+
+	// (GetTimeElapsed)  ֱ  ð.  ۶ Tick() ű ʴ´.
     float							m_fFrameTime[MAX_SAMPLE_COUNT];
     ULONG							m_nSampleCount;
+	ULONG							m_nNextSample = 0;
+	double							m_fSampleSum = 0.0;
+
+	// ֱ TIMER_WINDOW_SAMPLES  ð  ,  .    ׷ .
+	float							m_pfWindowFrameTimes[TIMER_WINDOW_SAMPLES];
+	bool							m_pbWindowHitches[TIMER_WINDOW_SAMPLES];
+	UINT							m_pnWindowHistogram[TIMER_HISTOGRAM_BUCKETS];
+	UINT							m_nWindowSamples = 0;
+	UINT							m_nNextWindowSample = 0;
+	UINT							m_nWindowHitches = 0;
+
+	UINT							m_pnSessionHistogram[TIMER_HISTOGRAM_BUCKETS];
+	UINT64							m_nSessionSamples = 0;
+	UINT							m_nSessionHitches = 0;
+
+    unsigned long					m_nCurrentFrameRate;
+	unsigned long					m_nFramesPerSecond;
+	float							m_fFPSTimeElapsed;
+
+	bool							m_bStopped = false;
 
-    unsigned long					m_nCurrentFrameRate;				
-	unsigned long					m_nFramesPerSecond;					
-	float							m_fFPSTimeElapsed;		
+	CFramePacer						m_FramePacer;
 
-	bool							m_bStopped;
+	void AddSample(float fTimeElapsed);
+	void ResetSamples();
 };
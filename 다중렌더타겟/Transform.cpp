@@ -0,0 +1,372 @@
+//-----------------------------------------------------------------------------
+// File: Transform.cpp
+//-----------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Transform.h"
+#include "JobSystem.h"
+
+#define TRANSFORM_FLAG_ALIVE		0x01
+#define TRANSFORM_FLAG_DIRTY		0x02
+
+CTransformStorage gTransformStorage;
+
+template <class T>
+static void ResizeArray(T **ppArray, UINT nOldCount, UINT nNewCount)
+{
+	T *pNewArray = new T[nNewCount];
+	if (*ppArray)
+	{
+		::memcpy(pNewArray, *ppArray, sizeof(T) * nOldCount);
+		delete[] *ppArray;
+	}
+	*ppArray = pNewArray;
+}
+
+CTransformStorage::CTransformStorage()
+{
+	ResetCounters();
+}
+
+CTransformStorage::~CTransformStorage()
+{
+	if (m_pxmf3Positions) delete[] m_pxmf3Positions;
+	if (m_pxmf3Rights) delete[] m_pxmf3Rights;
+	if (m_pxmf3Ups) delete[] m_pxmf3Ups;
+	if (m_pxmf3Looks) delete[] m_pxmf3Looks;
+	if (m_pxmf4x4Worlds) delete[] m_pxmf4x4Worlds;
+	if (m_pcbWorlds) delete[] m_pcbWorlds;
+	if (m_pnFlags) delete[] m_pnFlags;
+	if (m_pnGenerations) delete[] m_pnGenerations;
+	if (m_pnParents) delete[] m_pnParents;
+	if (m_pnFirstChildren) delete[] m_pnFirstChildren;
+	if (m_pnNextSiblings) delete[] m_pnNextSiblings;
+	if (m_pnWorldVersions) delete[] m_pnWorldVersions;
+	if (m_pnParentVersions) delete[] m_pnParentVersions;
+}
+
+void CTransformStorage::Reserve(UINT nCapacity)
+{
+	if (nCapacity <= m_nCapacity) return;
+
+	UINT nNewCapacity = (m_nCapacity) ? m_nCapacity : 256;
+	while (nNewCapacity < nCapacity) nNewCapacity *= 2;
+	assert(nNewCapacity <= (TRANSFORM_INDEX_MASK + 1));
+
+	// 迭 ҴǾ ڵ(ε) ״̹Ƿ ü ͸ ĳ ʰ ڵθ Ѵ.
+	ResizeArray(&m_pxmf3Positions, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pxmf3Rights, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pxmf3Ups, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pxmf3Looks, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pxmf4x4Worlds, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pcbWorlds, m_nCapacity * TRANSFORM_CB_STRIDE, nNewCapacity * TRANSFORM_CB_STRIDE);
+	ResizeArray(&m_pnFlags, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnGenerations, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnParents, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnFirstChildren, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnNextSiblings, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnWorldVersions, m_nCapacity, nNewCapacity);
+	ResizeArray(&m_pnParentVersions, m_nCapacity, nNewCapacity);
+
+	::memset(m_pnFlags + m_nCapacity, 0, sizeof(UINT8) * (nNewCapacity - m_nCapacity));
+	::memset(m_pnGenerations + m_nCapacity, 0, sizeof(USHORT) * (nNewCapacity - m_nCapacity));
+
+	m_nCapacity = nNewCapacity;
+}
+
+UINT CTransformStorage::AllocateSlot(UINT nSlot)
+{
+	m_pxmf3Positions[nSlot] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	m_pxmf3Rights[nSlot] = XMFLOAT3(1.0f, 0.0f, 0.0f);
+	m_pxmf3Ups[nSlot] = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	m_pxmf3Looks[nSlot] = XMFLOAT3(0.0f, 0.0f, 1.0f);
+	m_pnFlags[nSlot] = TRANSFORM_FLAG_ALIVE | TRANSFORM_FLAG_DIRTY;
+
+	m_pnParents[nSlot] = m_pnFirstChildren[nSlot] = m_pnNextSiblings[nSlot] = TRANSFORM_SLOT_NONE;
+	m_pnWorldVersions[nSlot] = m_pnParentVersions[nSlot] = 0;
+	m_bUpdateOrderChanged = true;
+
+	return((UINT(m_pnGenerations[nSlot]) << TRANSFORM_INDEX_BITS) | nSlot);
+}
+
+TRANSFORM_HANDLE CTransformStorage::Allocate()
+{
+	if (!m_vFreeSlots.empty())
+	{
+		UINT nSlot = m_vFreeSlots.back();
+		m_vFreeSlots.pop_back();
+		return(AllocateSlot(nSlot));
+	}
+
+	Reserve(m_nSlots + 1);
+	return(AllocateSlot(m_nSlots++));
+}
+
+void CTransformStorage::AllocateBlock(UINT nCount, TRANSFORM_HANDLE *phTransforms)
+{
+	// ̴ ϳ ׸ ü  ӵǵ ׻  ҴѴ.
+	Reserve(m_nSlots + nCount);
+	for (UINT i = 0; i < nCount; i++) phTransforms[i] = AllocateSlot(m_nSlots++);
+}
+
+void CTransformStorage::Free(TRANSFORM_HANDLE hTransform)
+{
+	if (!IsValid(hTransform)) return;
+
+	UINT nSlot = GetIndex(hTransform);
+
+	// ڽĵ Ʈ . ( ġ Ƣ ʵ     ķ ű)
+	while (m_pnFirstChildren[nSlot] != TRANSFORM_SLOT_NONE)
+	{
+		UINT nChild = m_pnFirstChildren[nSlot];
+		UINT hChild = (UINT(m_pnGenerations[nChild]) << TRANSFORM_INDEX_BITS) | nChild;
+		SetLocalMatrix(hChild, GetWorldMatrix(hChild));
+		UnlinkChild(nChild);
+	}
+	if (m_pnParents[nSlot] != TRANSFORM_SLOT_NONE) UnlinkChild(nSlot);
+
+	m_pnFlags[nSlot] = 0;
+	m_pnGenerations[nSlot] = (m_pnGenerations[nSlot] + 1) & TRANSFORM_GENERATION_MASK;
+	m_vFreeSlots.push_back(nSlot);
+	m_bUpdateOrderChanged = true;
+}
+
+bool CTransformStorage::IsValid(TRANSFORM_HANDLE hTransform)
+{
+	if (hTransform == TRANSFORM_HANDLE_NULL) return(false);
+	UINT nSlot = GetIndex(hTransform);
+	if (nSlot >= m_nSlots) return(false);
+	return((m_pnFlags[nSlot] & TRANSFORM_FLAG_ALIVE) && (m_pnGenerations[nSlot] == (hTransform >> TRANSFORM_INDEX_BITS)));
+}
+
+void CTransformStorage::LinkChild(UINT nParentSlot, UINT nSlot)
+{
+	m_pnParents[nSlot] = nParentSlot;
+	m_pnNextSiblings[nSlot] = m_pnFirstChildren[nParentSlot];
+	m_pnFirstChildren[nParentSlot] = nSlot;
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+	m_bUpdateOrderChanged = true;
+}
+
+void CTransformStorage::UnlinkChild(UINT nSlot)
+{
+	UINT nParentSlot = m_pnParents[nSlot];
+	UINT *pnLink = &m_pnFirstChildren[nParentSlot];
+	while (*pnLink != nSlot) pnLink = &m_pnNextSiblings[*pnLink];
+	*pnLink = m_pnNextSiblings[nSlot];
+
+	m_pnParents[nSlot] = m_pnNextSiblings[nSlot] = TRANSFORM_SLOT_NONE;
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+	m_bUpdateOrderChanged = true;
+}
+
+void CTransformStorage::SetParent(TRANSFORM_HANDLE hTransform, TRANSFORM_HANDLE hParent)
+{
+	UINT nSlot = GetIndex(hTransform);
+	UINT nParentSlot = IsValid(hParent) ? GetIndex(hParent) : TRANSFORM_SLOT_NONE;
+	if (m_pnParents[nSlot] == nParentSlot) return;
+
+#ifdef _DEBUG
+	for (UINT nAncestor = nParentSlot; nAncestor != TRANSFORM_SLOT_NONE; nAncestor = m_pnParents[nAncestor]) assert(nAncestor != nSlot);
+#endif
+
+	if (m_pnParents[nSlot] != TRANSFORM_SLOT_NONE) UnlinkChild(nSlot);
+	if (nParentSlot != TRANSFORM_SLOT_NONE) LinkChild(nParentSlot, nSlot);
+}
+
+TRANSFORM_HANDLE CTransformStorage::GetParent(TRANSFORM_HANDLE hTransform)
+{
+	UINT nParentSlot = m_pnParents[GetIndex(hTransform)];
+	if (nParentSlot == TRANSFORM_SLOT_NONE) return(TRANSFORM_HANDLE_NULL);
+	return((UINT(m_pnGenerations[nParentSlot]) << TRANSFORM_INDEX_BITS) | nParentSlot);
+}
+
+void CTransformStorage::BuildUpdateOrder()
+{
+	m_vUpdateOrder.clear();
+	m_vLevelStarts.clear();
+
+	m_vLevelStarts.push_back(0);
+	for (UINT i = 0; i < m_nSlots; i++)
+	{
+		if ((m_pnFlags[i] & TRANSFORM_FLAG_ALIVE) && (m_pnParents[i] == TRANSFORM_SLOT_NONE)) m_vUpdateOrder.push_back(i);
+	}
+
+	UINT nLevelStart = 0;
+	while (nLevelStart < UINT(m_vUpdateOrder.size()))
+	{
+		UINT nLevelEnd = UINT(m_vUpdateOrder.size());
+		m_vLevelStarts.push_back(nLevelEnd);
+		for (UINT i = nLevelStart; i < nLevelEnd; i++)
+		{
+			for (UINT nChild = m_pnFirstChildren[m_vUpdateOrder[i]]; nChild != TRANSFORM_SLOT_NONE; nChild = m_pnNextSiblings[nChild]) m_vUpdateOrder.push_back(nChild);
+		}
+		nLevelStart = nLevelEnd;
+	}
+
+	m_bUpdateOrderChanged = false;
+}
+
+void CTransformStorage::SetPosition(TRANSFORM_HANDLE hTransform, const XMFLOAT3& xmf3Position)
+{
+	UINT nSlot = GetIndex(hTransform);
+	m_pxmf3Positions[nSlot] = xmf3Position;
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+}
+
+void CTransformStorage::SetRotation(TRANSFORM_HANDLE hTransform, const XMFLOAT3& xmf3Right, const XMFLOAT3& xmf3Up, const XMFLOAT3& xmf3Look)
+{
+	UINT nSlot = GetIndex(hTransform);
+	m_pxmf3Rights[nSlot] = xmf3Right;
+	m_pxmf3Ups[nSlot] = xmf3Up;
+	m_pxmf3Looks[nSlot] = xmf3Look;
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+}
+
+XMFLOAT4X4 CTransformStorage::GetLocalMatrix(TRANSFORM_HANDLE hTransform)
+{
+	UINT nSlot = GetIndex(hTransform);
+	XMFLOAT3& xmf3Right = m_pxmf3Rights[nSlot];
+	XMFLOAT3& xmf3Up = m_pxmf3Ups[nSlot];
+	XMFLOAT3& xmf3Look = m_pxmf3Looks[nSlot];
+	XMFLOAT3& xmf3Position = m_pxmf3Positions[nSlot];
+
+	return(XMFLOAT4X4(xmf3Right.x, xmf3Right.y, xmf3Right.z, 0.0f, xmf3Up.x, xmf3Up.y, xmf3Up.z, 0.0f, xmf3Look.x, xmf3Look.y, xmf3Look.z, 0.0f, xmf3Position.x, xmf3Position.y, xmf3Position.z, 1.0f));
+}
+
+void CTransformStorage::SetLocalMatrix(TRANSFORM_HANDLE hTransform, const XMFLOAT4X4& xmf4x4Local)
+{
+	UINT nSlot = GetIndex(hTransform);
+	m_pxmf3Rights[nSlot] = XMFLOAT3(xmf4x4Local._11, xmf4x4Local._12, xmf4x4Local._13);
+	m_pxmf3Ups[nSlot] = XMFLOAT3(xmf4x4Local._21, xmf4x4Local._22, xmf4x4Local._23);
+	m_pxmf3Looks[nSlot] = XMFLOAT3(xmf4x4Local._31, xmf4x4Local._32, xmf4x4Local._33);
+	m_pxmf3Positions[nSlot] = XMFLOAT3(xmf4x4Local._41, xmf4x4Local._42, xmf4x4Local._43);
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+}
+
+XMFLOAT4X4 CTransformStorage::GetWorldMatrix(TRANSFORM_HANDLE hTransform)
+{
+	UINT nSlot = GetIndex(hTransform);
+	UpdateSlot(nSlot);
+	return(m_pxmf4x4Worlds[nSlot]);
+}
+
+void CTransformStorage::PreMultiply(TRANSFORM_HANDLE hTransform, FXMMATRIX mtxTransform)
+{
+	UINT nSlot = GetIndex(hTransform);
+	XMStoreFloat3(&m_pxmf3Rights[nSlot], XMVector3TransformNormal(XMLoadFloat3(&m_pxmf3Rights[nSlot]), mtxTransform));
+	XMStoreFloat3(&m_pxmf3Ups[nSlot], XMVector3TransformNormal(XMLoadFloat3(&m_pxmf3Ups[nSlot]), mtxTransform));
+	XMStoreFloat3(&m_pxmf3Looks[nSlot], XMVector3TransformNormal(XMLoadFloat3(&m_pxmf3Looks[nSlot]), mtxTransform));
+	m_pnFlags[nSlot] |= TRANSFORM_FLAG_DIRTY;
+}
+
+void CTransformStorage::PostMultiply(TRANSFORM_HANDLE hTransform, FXMMATRIX mtxTransform)
+{
+	XMFLOAT4X4 xmf4x4Local = GetLocalMatrix(hTransform);
+	XMStoreFloat4x4(&xmf4x4Local, XMMatrixMultiply(XMLoadFloat4x4(&xmf4x4Local), mtxTransform));
+	SetLocalMatrix(hTransform, xmf4x4Local);
+}
+
+bool CTransformStorage::IsOutOfDate(UINT nSlot)
+{
+	if (m_pnFlags[nSlot] & TRANSFORM_FLAG_DIRTY) return(true);
+	UINT nParentSlot = m_pnParents[nSlot];
+	return((nParentSlot != TRANSFORM_SLOT_NONE) && (m_pnWorldVersions[nParentSlot] != m_pnParentVersions[nSlot]));
+}
+
+void CTransformStorage::Compose(UINT nSlot)
+{
+	XMFLOAT3& xmf3Right = m_pxmf3Rights[nSlot];
+	XMFLOAT3& xmf3Up = m_pxmf3Ups[nSlot];
+	XMFLOAT3& xmf3Look = m_pxmf3Looks[nSlot];
+	XMFLOAT3& xmf3Position = m_pxmf3Positions[nSlot];
+
+	XMFLOAT4X4& xmf4x4World = m_pxmf4x4Worlds[nSlot];
+	xmf4x4World._11 = xmf3Right.x; xmf4x4World._12 = xmf3Right.y; xmf4x4World._13 = xmf3Right.z; xmf4x4World._14 = 0.0f;
+	xmf4x4World._21 = xmf3Up.x; xmf4x4World._22 = xmf3Up.y; xmf4x4World._23 = xmf3Up.z; xmf4x4World._24 = 0.0f;
+	xmf4x4World._31 = xmf3Look.x; xmf4x4World._32 = xmf3Look.y; xmf4x4World._33 = xmf3Look.z; xmf4x4World._34 = 0.0f;
+	xmf4x4World._41 = xmf3Position.x; xmf4x4World._42 = xmf3Position.y; xmf4x4World._43 = xmf3Position.z; xmf4x4World._44 = 1.0f;
+
+	UINT nParentSlot = m_pnParents[nSlot];
+	if (nParentSlot != TRANSFORM_SLOT_NONE)
+	{
+		XMStoreFloat4x4(&xmf4x4World, XMMatrixMultiply(XMLoadFloat4x4(&xmf4x4World), XMLoadFloat4x4(&m_pxmf4x4Worlds[nParentSlot])));
+		m_pnParentVersions[nSlot] = m_pnWorldVersions[nParentSlot];
+	}
+
+	// ̴ ѱ  ̸ ġ д.
+	XMFLOAT4X4 *pxmf4x4Constant = (XMFLOAT4X4 *)(m_pcbWorlds + (nSlot * TRANSFORM_CB_STRIDE));
+	XMStoreFloat4x4(pxmf4x4Constant, XMMatrixTranspose(XMLoadFloat4x4(&xmf4x4World)));
+
+	m_pnFlags[nSlot] &= ~TRANSFORM_FLAG_DIRTY;
+	m_pnWorldVersions[nSlot]++;
+	m_pThreadCounters[::gJobSystem.GetThreadIndex()].m_nRecomputedMatrices++;
+}
+
+void CTransformStorage::UpdateSlot(UINT nSlot)
+{
+	// θ  ֽ̾ Ѵ. ( ̸ŭ ö󰣴)
+	if (m_pnParents[nSlot] != TRANSFORM_SLOT_NONE) UpdateSlot(m_pnParents[nSlot]);
+	if (IsOutOfDate(nSlot)) Compose(nSlot);
+}
+
+void CTransformStorage::UpdateWorldMatrices()
+{
+	if (m_bUpdateOrderChanged) BuildUpdateOrder();
+
+	//   ϹǷ θ ׻ ڽĺ  ȴ.
+	//     ڱ Ը    θ Ƿ  ̴.
+	for (UINT nLevel = 0; nLevel < GetLevels(); nLevel++)
+	{
+		UINT nLevelStart = m_vLevelStarts[nLevel];
+		::gJobSystem.ParallelFor(m_vLevelStarts[nLevel + 1] - nLevelStart, TRANSFORM_PARALLEL_GRAIN, [this, nLevelStart](UINT nBegin, UINT nEnd)
+		{
+			for (UINT i = nLevelStart + nBegin; i < nLevelStart + nEnd; i++)
+			{
+				UINT nSlot = m_vUpdateOrder[i];
+				if (IsOutOfDate(nSlot)) Compose(nSlot);
+			}
+		});
+	}
+}
+
+UINT CTransformStorage::GetRecomputedMatrices()
+{
+	UINT nRecomputedMatrices = 0;
+	for (int i = 0; i < TRANSFORM_MAX_THREADS; i++) nRecomputedMatrices += m_pThreadCounters[i].m_nRecomputedMatrices;
+	return(nRecomputedMatrices);
+}
+
+void CTransformStorage::ResetCounters()
+{
+	for (int i = 0; i < TRANSFORM_MAX_THREADS; i++) m_pThreadCounters[i].m_nRecomputedMatrices = 0;
+}
+
+void CTransformStorage::UpdateWorldMatrices(UINT nFirstSlot, UINT nSlots)
+{
+	UINT nLastSlot = min(nFirstSlot + nSlots, m_nSlots);
+	for (UINT i = nFirstSlot; i < nLastSlot; i++)
+	{
+		if (m_pnFlags[i] & TRANSFORM_FLAG_ALIVE) UpdateSlot(i);
+	}
+}
+
+void CTransformStorage::UpdateWorldMatrix(TRANSFORM_HANDLE hTransform)
+{
+	UpdateSlot(GetIndex(hTransform));
+}
+
+void CTransformStorage::SaveLocalMatrices(vector<XMFLOAT4X4>& vLocals)
+{
+	vLocals.resize(m_nSlots);
+	for (UINT i = 0; i < m_nSlots; i++) vLocals[i] = GetLocalMatrix(i);
+}
+
+void CTransformStorage::RestoreLocalMatrices(const vector<XMFLOAT4X4>& vLocals)
+{
+	UINT nSlots = min(UINT(vLocals.size()), m_nSlots);
+	for (UINT i = 0; i < nSlots; i++)
+	{
+		if (m_pnFlags[i] & TRANSFORM_FLAG_ALIVE) SetLocalMatrix(i, vLocals[i]);
+	}
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// File: Transform.h
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+// ڵ = ( 12Ʈ) |  ε( 20Ʈ)
+//  Ǳ   ̵ Ƿ ڵ ü   ȿϴ.
+typedef UINT						TRANSFORM_HANDLE;
+
+#define TRANSFORM_HANDLE_NULL		0xFFFFFFFF
+#define TRANSFORM_INDEX_BITS		20
+#define TRANSFORM_INDEX_MASK		((1 << TRANSFORM_INDEX_BITS) - 1)
+#define TRANSFORM_GENERATION_MASK	0x0FFF
+
+#define TRANSFORM_CB_STRIDE			((sizeof(XMFLOAT4X4) + 255) & ~255) //256 
+
+#define TRANSFORM_SLOT_NONE			0xFFFFFFFF
+
+#define TRANSFORM_MAX_THREADS		64		//MAX_JOB_WORKERS
+#define TRANSFORM_PARALLEL_GRAIN	1024
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   ü ȯ SoA(Structure of Arrays) · ӵ 迭 Ѵ.
+// ġ/ ʹ θ   ȯ̰,   UpdateWorldMatrices() Ѳ ռѴ.
+// (World = Local * ParentWorld, ٲ   ڽĵ鸸 ٽ )
+// m_pcbWorlds  ۿ  ġ(ġ + 256Ʈ )̹Ƿ ӵ  memcpy   ε  ִ.
+class CTransformStorage
+{
+public:
+	CTransformStorage();
+	~CTransformStorage();
+
+private:
+	UINT							m_nCapacity = 0;
+	UINT							m_nSlots = 0;			//  ִ  (high-water mark)
+
+	XMFLOAT3						*m_pxmf3Positions = NULL;
+	XMFLOAT3						*m_pxmf3Rights = NULL;
+	XMFLOAT3						*m_pxmf3Ups = NULL;
+	XMFLOAT3						*m_pxmf3Looks = NULL;
+
+	XMFLOAT4X4						*m_pxmf4x4Worlds = NULL;
+	UINT8							*m_pcbWorlds = NULL;
+
+	UINT8							*m_pnFlags = NULL;
+	USHORT							*m_pnGenerations = NULL;
+
+	//   ( ȣ )
+	UINT							*m_pnParents = NULL;
+	UINT							*m_pnFirstChildren = NULL;
+	UINT							*m_pnNextSiblings = NULL;
+
+	//   ٽ   Ѵ. ڽ   θ  ؼ  θ ǴѴ.
+	UINT							*m_pnWorldVersions = NULL;
+	UINT							*m_pnParentVersions = NULL;
+
+	vector<UINT>					m_vFreeSlots;
+
+	// ʺ 켱  . m_vLevelStarts[d] ~ m_vLevelStarts[d+1]   d ̴.
+	//     ̹Ƿ    ó  ִ.
+	vector<UINT>					m_vUpdateOrder;
+	vector<UINT>					m_vLevelStarts;
+	bool							m_bUpdateOrderChanged = true;
+
+	// 帶     ģ. (ĳ   ʵ 64Ʈ )
+	struct THREAD_COUNTER { UINT m_nRecomputedMatrices; UINT m_pnPadding[15]; };
+	THREAD_COUNTER					m_pThreadCounters[TRANSFORM_MAX_THREADS];
+
+	void Reserve(UINT nCapacity);
+	UINT AllocateSlot(UINT nSlot);
+	void LinkChild(UINT nParentSlot, UINT nSlot);
+	void UnlinkChild(UINT nSlot);
+	void BuildUpdateOrder();
+
+	bool IsOutOfDate(UINT nSlot);
+	void Compose(UINT nSlot);
+	void UpdateSlot(UINT nSlot);
+
+public:
+	TRANSFORM_HANDLE Allocate();
+	void AllocateBlock(UINT nCount, TRANSFORM_HANDLE *phTransforms);
+	void Free(TRANSFORM_HANDLE hTransform);
+
+	bool IsValid(TRANSFORM_HANDLE hTransform);
+	UINT GetIndex(TRANSFORM_HANDLE hTransform) { return(hTransform & TRANSFORM_INDEX_MASK); }
+
+	UINT GetSlots() { return(m_nSlots); }
+	UINT GetLiveTransforms() { return(m_nSlots - UINT(m_vFreeSlots.size())); }
+
+	XMFLOAT3 GetPosition(TRANSFORM_HANDLE hTransform) { return(m_pxmf3Positions[GetIndex(hTransform)]); }
+	XMFLOAT3 GetRight(TRANSFORM_HANDLE hTransform) { return(m_pxmf3Rights[GetIndex(hTransform)]); }
+	XMFLOAT3 GetUp(TRANSFORM_HANDLE hTransform) { return(m_pxmf3Ups[GetIndex(hTransform)]); }
+	XMFLOAT3 GetLook(TRANSFORM_HANDLE hTransform) { return(m_pxmf3Looks[GetIndex(hTransform)]); }
+
+	void SetPosition(TRANSFORM_HANDLE hTransform, const XMFLOAT3& xmf3Position);
+	void SetRotation(TRANSFORM_HANDLE hTransform, const XMFLOAT3& xmf3Right, const XMFLOAT3& xmf3Up, const XMFLOAT3& xmf3Look);
+
+	void SetParent(TRANSFORM_HANDLE hTransform, TRANSFORM_HANDLE hParent);
+	TRANSFORM_HANDLE GetParent(TRANSFORM_HANDLE hTransform);
+
+	XMFLOAT4X4 GetLocalMatrix(TRANSFORM_HANDLE hTransform);
+	void SetLocalMatrix(TRANSFORM_HANDLE hTransform, const XMFLOAT4X4& xmf4x4Local);
+	XMFLOAT4X4 GetWorldMatrix(TRANSFORM_HANDLE hTransform);
+
+	// mtxTransform * Local (ȸ, ġ ״)
+	void PreMultiply(TRANSFORM_HANDLE hTransform, FXMMATRIX mtxTransform);
+	// Local * mtxTransform (ó ġ Բ ȯ)
+	void PostMultiply(TRANSFORM_HANDLE hTransform, FXMMATRIX mtxTransform);
+
+	//    TRANSFORM_PARALLEL_GRAIN   ķ Ѵ.
+	void UpdateWorldMatrices();
+	void UpdateWorldMatrices(UINT nFirstSlot, UINT nSlots);
+	void UpdateWorldMatrix(TRANSFORM_HANDLE hTransform);
+
+	const XMFLOAT4X4 *GetWorldMatrices() { return(m_pxmf4x4Worlds); }
+
+	// ˻:    ȯ ߴٰ ǵ. ǵ   ſ  ٽ ȴ.
+	void SaveLocalMatrices(vector<XMFLOAT4X4>& vLocals);
+	void RestoreLocalMatrices(const vector<XMFLOAT4X4>& vLocals);
+	const void *GetShaderConstants(TRANSFORM_HANDLE hTransform) { return(m_pcbWorlds + (GetIndex(hTransform) * TRANSFORM_CB_STRIDE)); }
+
+	UINT GetLevels() { return((m_vLevelStarts.size() > 0) ? UINT(m_vLevelStarts.size() - 1) : 0); }
+	UINT GetRecomputedMatrices();
+	void ResetCounters();
+};
+
+extern CTransformStorage gTransformStorage;
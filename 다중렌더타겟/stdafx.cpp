@@ -5,6 +5,8 @@
 #include "stdafx.h"
 
 #include "DDSTextureLoader12.h"
+#include "MemoryTracker.h"
+#include "RenderStats.h"
 
 UINT gnCbvSrvDescriptorIncrementSize = 0;
 
@@ -42,6 +44,7 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 	else if (d3dHeapType == D3D12_HEAP_TYPE_READBACK) d3dResourceInitialStates = D3D12_RESOURCE_STATE_COPY_DEST;
 
 	HRESULT hResult = pd3dDevice->CreateCommittedResource(&d3dHeapPropertiesDesc, D3D12_HEAP_FLAG_NONE, &d3dResourceDesc, d3dResourceInitialStates, NULL, __uuidof(ID3D12Resource), (void **)&pd3dBuffer);
+	::gMemoryTracker.TrackResource(pd3dBuffer, CMemoryTagScope::GetCurrentTag());
 
 	if (pData)
 	{
@@ -53,6 +56,7 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 			{
 				d3dHeapPropertiesDesc.Type = D3D12_HEAP_TYPE_UPLOAD;
 				pd3dDevice->CreateCommittedResource(&d3dHeapPropertiesDesc, D3D12_HEAP_FLAG_NONE, &d3dResourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, NULL, __uuidof(ID3D12Resource), (void **)ppd3dUploadBuffer);
+				::gMemoryTracker.TrackResource(*ppd3dUploadBuffer, MEMORY_TAG_UPLOAD);
 #ifdef _WITH_MAPPING
 				D3D12_RANGE d3dReadRange = { 0, 0 };
 				UINT8 *pBufferDataBegin = NULL;
@@ -69,6 +73,7 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 				::UpdateSubresources<1>(pd3dCommandList, pd3dBuffer, *ppd3dUploadBuffer, 0, 0, 1, &d3dSubResourceData);
 
 #endif
+				::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, nBytes);
 				D3D12_RESOURCE_BARRIER d3dResourceBarrier;
 				::ZeroMemory(&d3dResourceBarrier, sizeof(D3D12_RESOURCE_BARRIER));
 				d3dResourceBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -78,6 +83,7 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 				d3dResourceBarrier.Transition.StateAfter = d3dResourceStates;
 				d3dResourceBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
 				pd3dCommandList->ResourceBarrier(1, &d3dResourceBarrier);
+				::gRenderStats.Add(RENDER_STAT_BARRIERS);
 			}
 			break;
 		}
@@ -88,6 +94,7 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 			pd3dBuffer->Map(0, &d3dReadRange, (void **)&pBufferDataBegin);
 			memcpy(pBufferDataBegin, pData, nBytes);
 			pd3dBuffer->Unmap(0, NULL);
+			::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, nBytes);
 			break;
 		}
 		case D3D12_HEAP_TYPE_READBACK:
@@ -99,6 +106,9 @@ ID3D12Resource *CreateBufferResource(ID3D12Device *pd3dDevice, ID3D12GraphicsCom
 
 ID3D12Resource *CreateTextureResourceFromFile(ID3D12Device *pd3dDevice, ID3D12GraphicsCommandList *pd3dCommandList, wchar_t *pszFileName, ID3D12Resource **ppd3dUploadBuffer, D3D12_RESOURCE_STATES d3dResourceStates)
 {
+	// DDS  (CPU) ؽķ .
+	MEMORY_TAG_SCOPE(MEMORY_TAG_TEXTURE);
+
 	ID3D12Resource *pd3dTexture = NULL;
 	std::unique_ptr<uint8_t[]> ddsData;
 	std::vector<D3D12_SUBRESOURCE_DATA> vSubresources;
@@ -106,6 +116,7 @@ ID3D12Resource *CreateTextureResourceFromFile(ID3D12Device *pd3dDevice, ID3D12Gr
 	bool bIsCubeMap = false;
 
 	HRESULT hResult = DirectX::LoadDDSTextureFromFileEx(pd3dDevice, pszFileName, 0, D3D12_RESOURCE_FLAG_NONE, DDS_LOADER_DEFAULT, &pd3dTexture, ddsData, vSubresources, &ddsAlphaMode, &bIsCubeMap);
+	::gMemoryTracker.TrackResource(pd3dTexture, MEMORY_TAG_TEXTURE);
 
 	D3D12_HEAP_PROPERTIES d3dHeapPropertiesDesc;
 	::ZeroMemory(&d3dHeapPropertiesDesc, sizeof(D3D12_HEAP_PROPERTIES));
@@ -137,6 +148,7 @@ ID3D12Resource *CreateTextureResourceFromFile(ID3D12Device *pd3dDevice, ID3D12Gr
 	d3dResourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
 	pd3dDevice->CreateCommittedResource(&d3dHeapPropertiesDesc, D3D12_HEAP_FLAG_NONE, &d3dResourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, NULL, __uuidof(ID3D12Resource), (void **)ppd3dUploadBuffer);
+	::gMemoryTracker.TrackResource(*ppd3dUploadBuffer, MEMORY_TAG_UPLOAD);
 
 	//UINT nSubResources = (UINT)vSubresources.size();
 	//D3D12_SUBRESOURCE_DATA *pd3dSubResourceData = new D3D12_SUBRESOURCE_DATA[nSubResources];
@@ -144,6 +156,7 @@ ID3D12Resource *CreateTextureResourceFromFile(ID3D12Device *pd3dDevice, ID3D12Gr
 
 	//	std::vector<D3D12_SUBRESOURCE_DATA>::pointer ptr = &vSubresources[0];
 	::UpdateSubresources(pd3dCommandList, pd3dTexture, *ppd3dUploadBuffer, 0, 0, nSubResources, &vSubresources[0]);
+	::gRenderStats.Add(RENDER_STAT_UPLOAD_BYTES, nBytes);
 
 	D3D12_RESOURCE_BARRIER d3dResourceBarrier;
 	::ZeroMemory(&d3dResourceBarrier, sizeof(D3D12_RESOURCE_BARRIER));
@@ -154,6 +167,7 @@ ID3D12Resource *CreateTextureResourceFromFile(ID3D12Device *pd3dDevice, ID3D12Gr
 	d3dResourceBarrier.Transition.StateAfter = d3dResourceStates;
 	d3dResourceBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
 	pd3dCommandList->ResourceBarrier(1, &d3dResourceBarrier);
+	::gRenderStats.Add(RENDER_STAT_BARRIERS);
 
 	//	delete[] pd3dSubResourceData;
 
@@ -186,6 +200,8 @@ ID3D12Resource *CreateTexture2DResource(ID3D12Device *pd3dDevice, ID3D12Graphics
 	d3dTextureResourceDesc.Flags = d3dResourceFlags;
 
 	HRESULT hResult = pd3dDevice->CreateCommittedResource(&d3dHeapPropertiesDesc, D3D12_HEAP_FLAG_NONE, &d3dTextureResourceDesc, d3dResourceStates, pd3dClearValue, __uuidof(ID3D12Resource), (void **)&pd3dTexture);
+	bool bRenderTarget = (d3dResourceFlags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+	::gMemoryTracker.TrackResource(pd3dTexture, (bRenderTarget) ? MEMORY_TAG_RENDER_TARGET : MEMORY_TAG_TEXTURE);
 
 	return(pd3dTexture);
 }
@@ -200,5 +216,6 @@ void SynchronizeResourceTransition(ID3D12GraphicsCommandList *pd3dCommandList, I
 	d3dResourceBarrier.Transition.StateAfter = d3dStateAfter;
 	d3dResourceBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
 	pd3dCommandList->ResourceBarrier(1, &d3dResourceBarrier);
+	::gRenderStats.Add(RENDER_STAT_BARRIERS);
 }
 
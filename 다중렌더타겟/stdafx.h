@@ -34,6 +34,14 @@
 #include <wrl.h>
 
 #include <vector>
+#include <unordered_map>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <iostream>
 using namespace std;
 using namespace DirectX;
@@ -44,9 +52,12 @@ using Microsoft::WRL::ComPtr;
 #define FRAME_BUFFER_WIDTH		640
 #define FRAME_BUFFER_HEIGHT		480
 
+// CPU GPU ռ   ִ  . Ӹ Ŀǵ Ҵ, 潺 , ε (gFrameUploadBuffer)  .
+#define FRAMES_IN_FLIGHT		2
+
 //#define _WITH_CB_GAMEOBJECT_32BIT_CONSTANTS
-//#define _WITH_CB_GAMEOBJECT_ROOT_DESCRIPTOR
-#define _WITH_CB_WORLD_MATRIX_DESCRIPTOR_TABLE
+#define _WITH_CB_GAMEOBJECT_ROOT_DESCRIPTOR
+//#define _WITH_CB_WORLD_MATRIX_DESCRIPTOR_TABLE
 
 #pragma comment(lib, "d3dcompiler.lib")
 #pragma comment(lib, "d3d12.lib")